@@ -1,39 +1,144 @@
 #include "MomentumCorrection.h"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
 void MomentumCorrection::AddPiecewiseCorrection(int pid, const RegionWithDetector& region, CorrectionFunction func) {
   p_corrections_[pid].emplace_back(RegionCorrection{region, func});
+  RebuildIndex(pid);
 }
 
-bool MomentumCorrection::InRegion(const RegionWithDetector& region, double p, double theta, double phi, short status) {
+MomentumCorrection::DetectorRegion MomentumCorrection::DetectorFromStatus(short status) {
   int abs_status = std::abs(status);
-  DetectorRegion particle_detector = DetectorRegion::ANY;
-  if (abs_status >= 1000 && abs_status < 2000)
-    particle_detector = DetectorRegion::FT;
-  else if (abs_status >= 2000 && abs_status < 3000)
-    particle_detector = DetectorRegion::FD;
-  else if (abs_status >= 4000 && abs_status < 5000)
-    particle_detector = DetectorRegion::CD;
+  if (abs_status >= 1000 && abs_status < 2000) return DetectorRegion::FT;
+  if (abs_status >= 2000 && abs_status < 3000) return DetectorRegion::FD;
+  if (abs_status >= 4000 && abs_status < 5000) return DetectorRegion::CD;
+  return DetectorRegion::ANY;
+}
+
+bool MomentumCorrection::InRegion(const RegionWithDetector& region, double p, double theta, double phi, short status) {
+  return InRegion(region, p, theta, phi, DetectorFromStatus(status));
+}
 
+bool MomentumCorrection::InRegion(const RegionWithDetector& region, double p, double theta, double phi, DetectorRegion particle_detector) {
   return (p >= region.pmin && p < region.pmax &&
           theta >= region.thetamin && theta < region.thetamax &&
           phi >= region.phimin && phi < region.phimax &&
           (region.detector == DetectorRegion::ANY || region.detector == particle_detector));
 }
 
+// Recompile the lookup index for one PID.  With dozens of regions this is
+// microseconds per AddPiecewiseCorrection call, all during task setup.
+void MomentumCorrection::RebuildIndex(int pid) {
+  const auto& regions = p_corrections_[pid];
+  RegionIndex& index = p_index_[pid];
+
+  const DetectorRegion bucketDet[4] = {DetectorRegion::ANY, DetectorRegion::FT,
+                                       DetectorRegion::FD, DetectorRegion::CD};
+
+  for (int b = 0; b < 4; ++b) {
+    DetectorBucket& bucket = index.buckets[b];
+    bucket.thetaEdges.clear();
+    bucket.candidates.clear();
+
+    // A particle classified into this bucket can only match regions declared
+    // for the same detector or for ANY.  (The ANY bucket holds particles with
+    // an unclassified status, which match only ANY regions.)
+    std::vector<int> bucketRegions;
+    for (int i = 0; i < static_cast<int>(regions.size()); ++i) {
+      const DetectorRegion d = regions[i].region.detector;
+      if (d == DetectorRegion::ANY || d == bucketDet[b]) bucketRegions.push_back(i);
+    }
+    if (bucketRegions.empty()) continue;
+
+    for (int i : bucketRegions) {
+      bucket.thetaEdges.push_back(regions[i].region.thetamin);
+      bucket.thetaEdges.push_back(regions[i].region.thetamax);
+    }
+    std::sort(bucket.thetaEdges.begin(), bucket.thetaEdges.end());
+    bucket.thetaEdges.erase(
+        std::unique(bucket.thetaEdges.begin(), bucket.thetaEdges.end()),
+        bucket.thetaEdges.end());
+
+    // One candidate list per theta interval between consecutive breakpoints;
+    // indices stay in registration order so first-match semantics survive.
+    bucket.candidates.resize(bucket.thetaEdges.size() - 1);
+    for (std::size_t cell = 0; cell + 1 < bucket.thetaEdges.size(); ++cell) {
+      const double lo = bucket.thetaEdges[cell];
+      const double hi = bucket.thetaEdges[cell + 1];
+      for (int i : bucketRegions) {
+        if (regions[i].region.thetamin < hi && regions[i].region.thetamax > lo) {
+          bucket.candidates[cell].push_back(i);
+        }
+      }
+    }
+  }
+}
+
 double MomentumCorrection::GetCorrectedP(int pid, double p, double theta, double phi, short status) const {
-  auto it = p_corrections_.find(pid);
-  if (it == p_corrections_.end()) return p;
+  return GetCorrectedP(pid, p, theta, phi, DetectorFromStatus(status));
+}
+
+double MomentumCorrection::GetCorrectedP(int pid, double p, double theta, double phi, DetectorRegion detector) const {
+  auto it = p_index_.find(pid);
+  if (it == p_index_.end()) return p;
+
+  const DetectorBucket& bucket = it->second.buckets[static_cast<int>(detector)];
+  if (bucket.thetaEdges.size() < 2 ||
+      theta < bucket.thetaEdges.front() || theta >= bucket.thetaEdges.back()) {
+    return p;
+  }
 
-  for (const auto& rc : it->second) {
-    if (InRegion(rc.region, p, theta, phi, status)) {
+  const std::size_t cell =
+      std::upper_bound(bucket.thetaEdges.begin(), bucket.thetaEdges.end(), theta) -
+      bucket.thetaEdges.begin() - 1;
+
+  const auto& regions = p_corrections_.at(pid);
+  for (int i : bucket.candidates[cell]) {
+    const auto& rc = regions[i];
+    if (InRegion(rc.region, p, theta, phi, detector)) {
       return rc.func(p, theta, phi);
     }
   }
   return p;
 }
 
+MomentumCorrection::RECCorrStoreType MomentumCorrection::RECParticleCorrected() const {
+  return [this](const std::vector<int>& pid,
+                const std::vector<float>& /*px*/,
+                const std::vector<float>& /*py*/,
+                const std::vector<float>& /*pz*/,
+                const std::vector<float>& /*vx*/,
+                const std::vector<float>& /*vy*/,
+                const std::vector<float>& /*vz*/,
+                const std::vector<float>& /*vt*/,
+                const std::vector<short>& /*charge*/,
+                const std::vector<float>& /*beta*/,
+                const std::vector<float>& /*chi2pid*/,
+                const std::vector<short>& status,
+                const std::vector<float>& phi,
+                const std::vector<float>& theta,
+                const std::vector<float>& p) -> CorrectedKinematics {
+    CorrectedKinematics out;
+    const std::size_t n = p.size();
+    out.px.resize(n); out.py.resize(n); out.pz.resize(n);
+    out.p.resize(n);  out.theta.resize(n); out.phi.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      const float p_corr = GetCorrectedP(pid[i], p[i], theta[i], phi[i], status[i]);
+      const float sin_th = std::sin(theta[i]);
+      out.px[i] = p_corr * sin_th * std::cos(phi[i]);
+      out.py[i] = p_corr * sin_th * std::sin(phi[i]);
+      out.pz[i] = p_corr * std::cos(theta[i]);
+      // The correction rescales |p| only, so theta/phi pass through
+      // unchanged and no downstream kinematics re-Define is needed.
+      out.p[i] = p_corr;
+      out.theta[i] = theta[i];
+      out.phi[i] = phi[i];
+    }
+    return out;
+  };
+}
+
 MomentumCorrection::RECExtendStoreType MomentumCorrection::RECParticlePxCorrected() const {
   return [this](const std::vector<int>& pid,
                 const std::vector<float>& /*px*/,
@@ -47,17 +47,75 @@ public:
     CorrectionFunction func;
   };
 
+  // Fused output of RECParticleCorrected(): corrected momentum components
+  // plus the corrected p and the (unchanged) theta/phi, all filled by one
+  // traversal.  Mirrors the RECParticleKin pattern in Math/: the columns are
+  // peeled off the struct with cheap accessor Defines.
+  struct CorrectedKinematics {
+    std::vector<float> px, py, pz;
+    std::vector<float> p, theta, phi;
+  };
+
+  using RECCorrStoreType = std::function<CorrectedKinematics(
+    const std::vector<int>&,
+    const std::vector<float>&,
+    const std::vector<float>&,
+    const std::vector<float>&,
+    const std::vector<float>&,
+    const std::vector<float>&,
+    const std::vector<float>&,
+    const std::vector<float>&,
+    const std::vector<short>&,
+    const std::vector<float>&,
+    const std::vector<float>&,
+    const std::vector<short>&,
+    const std::vector<float>&,
+    const std::vector<float>&,
+    const std::vector<float>&
+  )>;
+
   void AddPiecewiseCorrection(int pid, const RegionWithDetector& region, CorrectionFunction func);
 
+  // Fused kernel: resolves the region and evaluates the correction once per
+  // particle and emits all six output arrays.  The per-component functors
+  // below each redo that work for the same particles; prefer the fused one
+  // in new code.
+  RECCorrStoreType RECParticleCorrected() const;
+
   RECExtendStoreType RECParticlePxCorrected() const;
   RECExtendStoreType RECParticlePyCorrected() const;
   RECExtendStoreType RECParticlePzCorrected() const;
 
 private:
+  // Compiled lookup structure, rebuilt by AddPiecewiseCorrection (setup-time
+  // only, so the hot path stays lock-free).  Regions are bucketed by the
+  // detector a particle's status maps to, and each bucket carries the sorted
+  // theta breakpoints of its regions plus, per theta interval, the indices of
+  // the regions overlapping it in registration order.  GetCorrectedP then
+  // resolves a particle with one binary search over theta and tests only the
+  // few candidate regions of that cell, instead of scanning every registered
+  // region per particle per component.  First-match-wins order is preserved
+  // because candidate indices stay sorted by registration.
+  struct DetectorBucket {
+    std::vector<double> thetaEdges;            // sorted region boundaries
+    std::vector<std::vector<int>> candidates;  // per theta cell, region indices
+  };
+  struct RegionIndex {
+    DetectorBucket buckets[4];  // indexed by DetectorRegion
+  };
+
   std::map<int, std::vector<RegionCorrection>> p_corrections_;
+  std::map<int, RegionIndex> p_index_;
 
+  void RebuildIndex(int pid);
   double GetCorrectedP(int pid, double p, double theta, double phi, short status) const;
+  // Region-resolved variants: the status overloads delegate here after a
+  // single DetectorFromStatus call, so the candidate-region scan no longer
+  // re-decodes the status word once per overlapping region.
+  double GetCorrectedP(int pid, double p, double theta, double phi, DetectorRegion detector) const;
+  static DetectorRegion DetectorFromStatus(short status);
   static bool InRegion(const RegionWithDetector& region, double p, double theta, double phi, short status);
+  static bool InRegion(const RegionWithDetector& region, double p, double theta, double phi, DetectorRegion detector);
 };
 
 #endif  // MOMENTUM_CORRECTION_H
@@ -1,12 +1,83 @@
 #include "EventCut.h"
 #include "./../Math/ParticleMassTable.h"
+#include "./../core/Columns.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <iostream>
+#include <mutex>
+#include <numeric>
+
+namespace {
+
+// Scratch buffers for the two-body pair-mass kernel, reused across events
+// (one instance per thread) so the gather/compute passes never allocate in
+// steady state.
+struct PairMassScratch {
+  std::vector<int> idx1, idx2;
+  std::vector<float> px1, py1, pz1, E1;
+  std::vector<float> px2, py2, pz2, E2;
+  std::vector<float> mass;  // row-major [cand1][cand2]
+};
+
+// Fills scratch.mass with the invariant mass of every (cand1, cand2) pair.
+// The candidates are gathered into contiguous arrays with one energy sqrt
+// each, and the inner loop is branch-free arithmetic over those arrays so
+// the compiler can vectorize it — instead of the per-pair sqrt-heavy math
+// the nested particle loops used to do.
+inline void ComputePairMasses(PairMassScratch& scratch) {
+  const size_t n1 = scratch.idx1.size();
+  const size_t n2 = scratch.idx2.size();
+  scratch.mass.resize(n1 * n2);
+  const float* qx = scratch.px2.data();
+  const float* qy = scratch.py2.data();
+  const float* qz = scratch.pz2.data();
+  const float* qE = scratch.E2.data();
+  for (size_t a = 0; a < n1; ++a) {
+    const float pxa = scratch.px1[a];
+    const float pya = scratch.py1[a];
+    const float pza = scratch.pz1[a];
+    const float Ea = scratch.E1[a];
+    float* out = scratch.mass.data() + a * n2;
+    for (size_t b = 0; b < n2; ++b) {
+      const float px_sum = pxa + qx[b];
+      const float py_sum = pya + qy[b];
+      const float pz_sum = pza + qz[b];
+      const float E_sum = Ea + qE[b];
+      const float invMass2 = E_sum * E_sum - (px_sum * px_sum + py_sum * py_sum + pz_sum * pz_sum);
+      out[b] = (invMass2 > 0) ? std::sqrt(invMass2) : 0;
+    }
+  }
+}
+
+}  // namespace
+
+// Counters are atomic so the per-slot EventCut copies (which share the plan
+// through the shared_ptr) can calibrate concurrently; the order vector is
+// written exactly once, under the once_flag, before frozen is set.
+struct EventCut::CutPlan {
+  CutPlan(size_t nCuts, unsigned long long calibEvents)
+      : minCount(nCuts, 0), satisfied(nCuts), calibrationEvents(calibEvents) {}
+  std::vector<int> minCount;                                // per cut, map order
+  std::vector<std::atomic<unsigned long long>> satisfied;   // events with count >= minCount
+  std::atomic<unsigned long long> events{0};
+  unsigned long long calibrationEvents;
+  std::once_flag freezeOnce;
+  std::vector<size_t> order;  // evaluation order, tightest first
+  std::atomic<bool> frozen{false};
+};
 
 EventCut::EventCut() = default;
 EventCut::~EventCut() = default;
 
+void EventCut::Compile(unsigned long long calibrationEvents) {
+  auto plan = std::make_shared<CutPlan>(fParticleCuts.size(), std::max<unsigned long long>(1, calibrationEvents));
+  size_t c = 0;
+  for (const auto& [name, cut] : fParticleCuts) plan->minCount[c++] = cut.minCount;
+  fPlan = std::move(plan);
+}
+
 void EventCut::AddParticleCut(const std::string& name, const ParticleCut& userCut) {
   ParticleCut cut = userCut;
 
@@ -77,6 +148,14 @@ const ParticleCut* EventCut::GetParticleCut(const std::string& name) const {
   return (it != fParticleCuts.end()) ? &it->second : nullptr;
 }
 
+std::vector<std::pair<int, int>> EventCut::RequiredPidCounts() const {
+  std::vector<std::pair<int, int>> required;
+  if (fAcceptEverything) return required;
+  for (const auto& [name, cut] : fParticleCuts)
+    if (cut.pid != 0 && cut.minCount > 0) required.emplace_back(cut.pid, cut.minCount);
+  return required;
+}
+
 EventCut* EventCut::ProtonCuts() {
   EventCut* cuts = new EventCut();
   cuts->AddParticleCut("proton", ParticleCut());
@@ -95,25 +174,87 @@ EventCut* EventCut::PhotonCuts() {
   return cuts;
 }
 
-EventCutResult EventCut::operator()(const std::vector<int>& pid, const std::vector<float>& px, const std::vector<float>& py, const std::vector<float>& pz,
-                                    const std::vector<float>& vx, const std::vector<float>& vy, const std::vector<float>& vz, const std::vector<float>& vt,
-                                    const std::vector<short>& charge, const std::vector<float>& beta, const std::vector<float>& chi2pid, const std::vector<short>& status,
-                                    const std::vector<int>& REC_Track_pass_fid) const {
-  EventCutResult result;
-  result.particlePass.resize(pid.size(), 0);
-  result.particleDaughterPass.resize(pid.size(), 0);
-  result.MaxPhotonEnergyPass.resize(pid.size(), 0);
-  result.MotherMass.resize(pid.size(), -999);
+EventCutClassification EventCut::Classify(const std::vector<int>& pid, const std::vector<float>& px, const std::vector<float>& py, const std::vector<float>& pz,
+                                          const std::vector<float>& vx, const std::vector<float>& vy, const std::vector<float>& vz, const std::vector<float>& vt,
+                                          const std::vector<short>& charge, const std::vector<float>& beta, const std::vector<float>& chi2pid,
+                                          const std::vector<short>& status) const {
+  EventCutClassification cls;
+  Classify(pid, px, py, pz, vx, vy, vz, vt, charge, beta, chi2pid, status, cls);
+  return cls;
+}
 
-  bool allCutsPassed = true;
-  float MaxEphotonEnergy = 0.0f;
-  size_t MaxPhotonEnergyIndex = 0;
+void EventCut::Classify(const std::vector<int>& pid, const std::vector<float>& px, const std::vector<float>& py, const std::vector<float>& pz,
+                        const std::vector<float>& vx, const std::vector<float>& vy, const std::vector<float>& vz, const std::vector<float>& vt,
+                        const std::vector<short>& charge, const std::vector<float>& beta, const std::vector<float>& chi2pid,
+                        const std::vector<short>& status, EventCutClassification& cls) const {
+  const size_t n = pid.size();
+  cls.region.resize(n);
+  for (size_t i = 0; i < n; ++i) cls.region[i] = Columns::RegionFromStatus(status[i]);
+  ClassifyCore(pid, px, py, pz, vz, charge, beta, chi2pid, cls);
+}
 
-  for (const auto& [name, cut] : fParticleCuts) {
-    int count = 0;
-    for (size_t i = 0; i < pid.size(); ++i) {
-      const float p2 = px[i] * px[i] + py[i] * py[i] + pz[i] * pz[i];
-      if (p2 < 1e-4f) continue;
+void EventCut::Classify(const std::vector<int>& pid, const std::vector<float>& px, const std::vector<float>& py, const std::vector<float>& pz,
+                        const std::vector<float>& vx, const std::vector<float>& vy, const std::vector<float>& vz, const std::vector<float>& vt,
+                        const std::vector<short>& charge, const std::vector<float>& beta, const std::vector<float>& chi2pid,
+                        const std::vector<unsigned char>& regsec, EventCutClassification& cls) const {
+  const size_t n = pid.size();
+  cls.region.resize(n);
+  for (size_t i = 0; i < n; ++i) cls.region[i] = Columns::RegionOf(regsec[i]);
+  ClassifyCore(pid, px, py, pz, vz, charge, beta, chi2pid, cls);
+}
+
+void EventCut::ClassifyCore(const std::vector<int>& pid, const std::vector<float>& px, const std::vector<float>& py, const std::vector<float>& pz,
+                            const std::vector<float>& vz,
+                            const std::vector<short>& charge, const std::vector<float>& beta, const std::vector<float>& chi2pid,
+                            EventCutClassification& cls) const {
+  const size_t n = pid.size();
+  // assign()/resize() reuse the buffers' capacity, so a classification that is
+  // kept around between events (one per RDataFrame slot) stops allocating once
+  // it has seen the largest event.
+  cls.kinPass.resize(fParticleCuts.size());
+  cls.minCount.resize(fParticleCuts.size());
+  cls.maxCount.resize(fParticleCuts.size());
+  cls.momentum.resize(n);
+  cls.isPhoton.resize(n);
+  cls.particleDaughterPass.assign(n, 0);
+  cls.MotherMass.assign(n, -999);
+
+  for (size_t i = 0; i < n; ++i) {
+    const float p2 = px[i] * px[i] + py[i] * py[i] + pz[i] * pz[i];
+    cls.momentum[i] = std::sqrt(p2);
+    cls.isPhoton[i] = (pid[i] == 22) ? 1 : 0;
+  }
+
+  // Count windows are filled for every cut up front so an early rejection
+  // below still leaves a well-formed classification.
+  {
+    size_t c = 0;
+    for (const auto& [name, cut] : fParticleCuts) {
+      cls.minCount[c] = cut.minCount;
+      cls.maxCount[c] = cut.maxCount;
+      ++c;
+    }
+  }
+
+  // Flat view of the cuts in map order, so a compiled plan can evaluate them
+  // by index in selectivity order.
+  thread_local std::vector<const ParticleCut*> cuts;
+  cuts.clear();
+  for (const auto& [name, cut] : fParticleCuts) cuts.push_back(&cut);
+
+  const bool planActive = fPlan && !fAcceptEverything;
+  const bool planFrozen = planActive && fPlan->frozen.load(std::memory_order_acquire);
+  bool rejected = false;
+
+  for (size_t step = 0; step < cuts.size(); ++step) {
+    const size_t c = planFrozen ? fPlan->order[step] : step;
+    const ParticleCut& cut = *cuts[c];
+    std::vector<int>& pass = cls.kinPass[c];
+    pass.assign(n, 0);
+    int passCount = 0;
+    for (size_t i = 0; i < n; ++i) {
+      const float momentum = cls.momentum[i];
+      if (momentum < 1e-2f) continue;  // p^2 < 1e-4
 
       // pid==0 is the wildcard sentinel used by "Pos Hadron" / "Neg Hadron" cuts.
       // In that mode we match by charge sign only and explicitly veto the
@@ -123,22 +264,20 @@ EventCutResult EventCut::operator()(const std::vector<int>& pid, const std::vect
         if (charge[i] != cut.charge)   continue;  // wrong charge sign
         if (std::abs(pid[i]) == 11)    continue;  // veto e+/-
         if (pid[i] == 2212)            continue;  // veto proton
-        if (REC_Track_pass_fid[i] != 1) continue;
       } else {
         // Original strict PID matching (K+K-, photon, proton, electron, ...)
-        if (pid[i] != cut.pid || charge[i] != cut.charge || REC_Track_pass_fid[i] != 1) continue;
+        if (pid[i] != cut.pid || charge[i] != cut.charge) continue;
       }
       if (!IsInRange(chi2pid[i], cut.minChi2PID, cut.maxChi2PID)) continue;
 
-      const float momentum = std::sqrt(p2);
       const float theta = std::atan2(std::sqrt(px[i] * px[i] + py[i] * py[i]), pz[i]);
       float phi = std::atan2(py[i], px[i]);
       if (phi < 0) phi += 2 * M_PI;
-      int statusAbs = std::abs(status[i]);
-      // cut based on momentum and status of th detector of the particle
-      bool momentumFTCut = IsInRange(momentum, cut.minFTMomentum, cut.maxFTMomentum) && (statusAbs >= 1000 && statusAbs < 2000);
-      bool momentumFDCut = IsInRange(momentum, cut.minFDMomentum, cut.maxFDMomentum) && (statusAbs >= 2000 && statusAbs < 3000);
-      bool momentumCDCut = IsInRange(momentum, cut.minCDMomentum, cut.maxCDMomentum) && (statusAbs >= 4000 && statusAbs < 5000);
+      const unsigned char region = cls.region[i];
+      // cut based on momentum and the pre-decoded detector region of the particle
+      bool momentumFTCut = IsInRange(momentum, cut.minFTMomentum, cut.maxFTMomentum) && region == Columns::kRegionFT;
+      bool momentumFDCut = IsInRange(momentum, cut.minFDMomentum, cut.maxFDMomentum) && region == Columns::kRegionFD;
+      bool momentumCDCut = IsInRange(momentum, cut.minCDMomentum, cut.maxCDMomentum) && region == Columns::kRegionCD;
       bool momentumCut = momentumFTCut || momentumFDCut || momentumCDCut;
 
       bool betaCut = IsInRange(beta[i], cut.minBeta, cut.maxBeta);
@@ -146,63 +285,148 @@ EventCutResult EventCut::operator()(const std::vector<int>& pid, const std::vect
       bool phiCut = IsInRange(phi, cut.minPhi, cut.maxPhi);
       bool vzCut = IsInRange(vz[i], cut.minVz, cut.maxVz);
       if (momentumCut && betaCut && thetaCut && phiCut && vzCut) {
-        result.particlePass[i] = 1;
-        if (pid[i] == 22 && momentum > MaxEphotonEnergy) {
-            MaxEphotonEnergy = momentum;
-            result.MaxPhotonEnergyPass[MaxPhotonEnergyIndex] = 0;
-            result.MaxPhotonEnergyPass[i] = 1;
-            MaxPhotonEnergyIndex = i;
-        }
-        ++count;
+        pass[i] = 1;
+        ++passCount;
       }
     }
 
-
-    if (!IsInRange(count, cut.minCount, cut.maxCount)) {
-      allCutsPassed = false;
+    if (planFrozen) {
+      // minCount already unsatisfiable at the kinematic level: the fiducial
+      // masks only remove candidates, so neither chain can accept this event.
+      // Zero the not-yet-evaluated masks and stop.
+      if (passCount < cut.minCount) {
+        for (size_t rest = step + 1; rest < cuts.size(); ++rest) cls.kinPass[fPlan->order[rest]].assign(n, 0);
+        rejected = true;
+        break;
+      }
+    } else if (planActive) {
+      if (passCount >= cut.minCount) fPlan->satisfied[c].fetch_add(1, std::memory_order_relaxed);
     }
   }
 
-  if (fAcceptEverything) {
-    allCutsPassed = true;
+  if (planActive && !planFrozen) {
+    const unsigned long long seen = fPlan->events.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (seen >= fPlan->calibrationEvents) {
+      std::call_once(fPlan->freezeOnce, [plan = fPlan.get()] {
+        std::vector<size_t> order(plan->minCount.size());
+        std::iota(order.begin(), order.end(), 0);
+        // Cuts that can actually reject (minCount >= 1) run first, tightest
+        // (least often satisfied) ahead; count-free cuts go last.  Stable so
+        // ties keep the map order and stay deterministic.
+        std::stable_sort(order.begin(), order.end(), [plan](size_t a, size_t b) {
+          const bool aRejects = plan->minCount[a] > 0;
+          const bool bRejects = plan->minCount[b] > 0;
+          if (aRejects != bRejects) return aRejects;
+          return plan->satisfied[a].load(std::memory_order_relaxed) < plan->satisfied[b].load(std::memory_order_relaxed);
+        });
+        plan->order = std::move(order);
+        plan->frozen.store(true, std::memory_order_release);
+      });
+    }
   }
 
-  if (fCutTwoBodyMotherDecay) {
+  if (fCutTwoBodyMotherDecay && !rejected) {
+    thread_local PairMassScratch scratch;
     for (const auto& [name, cut] : fTwoBodyMotherCuts) {
-      for (size_t i = 0; i < pid.size(); ++i) {
-        if (pid[i] != cut.pidDaug1) continue;
-        for (size_t j = i + 1; j < pid.size(); ++j) {
-          if (pid[j] != cut.pidDaug2) continue;
-
-          float minMass = cut.expectedMotherMass - cut.massSigma * cut.nSigmaMass;
-          float maxMass = cut.expectedMotherMass + cut.massSigma * cut.nSigmaMass;
-
-          float massDaug1 = getParticleMass( pid[i]);
-          float massDaug2 = getParticleMass( pid[j]);
-
-          float E1 = std::sqrt(px[i] * px[i] + py[i] * py[i] + pz[i] * pz[i] + massDaug1 * massDaug1);
-          float E2 = std::sqrt(px[j] * px[j] + py[j] * py[j] + pz[j] * pz[j] + massDaug2 * massDaug2);
-          float px_sum = px[i] + px[j];
-          float py_sum = py[i] + py[j];
-          float pz_sum = pz[i] + pz[j];
-          float E_sum = E1 + E2;
-
-          float invMass2 = E_sum * E_sum - (px_sum * px_sum + py_sum * py_sum + pz_sum * pz_sum);
-          float invMass = (invMass2 > 0) ? std::sqrt(invMass2) : 0;
+      // Gather the daughter candidates once, with one energy sqrt each.
+      const float massDaug1 = getParticleMass(cut.pidDaug1);
+      const float massDaug2 = getParticleMass(cut.pidDaug2);
+      scratch.idx1.clear(); scratch.px1.clear(); scratch.py1.clear(); scratch.pz1.clear(); scratch.E1.clear();
+      scratch.idx2.clear(); scratch.px2.clear(); scratch.py2.clear(); scratch.pz2.clear(); scratch.E2.clear();
+      for (size_t i = 0; i < n; ++i) {
+        const float p2 = px[i] * px[i] + py[i] * py[i] + pz[i] * pz[i];
+        if (pid[i] == cut.pidDaug1) {
+          scratch.idx1.push_back(static_cast<int>(i));
+          scratch.px1.push_back(px[i]);
+          scratch.py1.push_back(py[i]);
+          scratch.pz1.push_back(pz[i]);
+          scratch.E1.push_back(std::sqrt(p2 + massDaug1 * massDaug1));
+        }
+        if (pid[i] == cut.pidDaug2) {
+          scratch.idx2.push_back(static_cast<int>(i));
+          scratch.px2.push_back(px[i]);
+          scratch.py2.push_back(py[i]);
+          scratch.pz2.push_back(pz[i]);
+          scratch.E2.push_back(std::sqrt(p2 + massDaug2 * massDaug2));
+        }
+      }
+      if (scratch.idx1.empty() || scratch.idx2.empty()) continue;
+
+      ComputePairMasses(scratch);
+
+      // Apply the mass window pair by pair, in the same (i, j > i) order as
+      // the original nested loops so overlapping pairs overwrite MotherMass
+      // identically.
+      const float minMass = cut.expectedMotherMass - cut.massSigma * cut.nSigmaMass;
+      const float maxMass = cut.expectedMotherMass + cut.massSigma * cut.nSigmaMass;
+      const size_t n2 = scratch.idx2.size();
+      for (size_t a = 0; a < scratch.idx1.size(); ++a) {
+        const int i = scratch.idx1[a];
+        for (size_t b = 0; b < n2; ++b) {
+          const int j = scratch.idx2[b];
+          if (j <= i) continue;
+          const float invMass = scratch.mass[a * n2 + b];
           // Store invariant mass regardless
-          result.MotherMass[i] = invMass;
-          result.MotherMass[j] = invMass;
+          cls.MotherMass[i] = invMass;
+          cls.MotherMass[j] = invMass;
           // Flag if passes the mass window
           if (invMass >= minMass && invMass <= maxMass) {
-            result.particleDaughterPass[i] = 1;
-            result.particleDaughterPass[j] = 1;
+            cls.particleDaughterPass[i] = 1;
+            cls.particleDaughterPass[j] = 1;
           }
         }
       }
     }
   }
+}
 
-  result.eventPass = allCutsPassed;
-  
+EventCutResult EventCut::ApplyFiducialMask(const EventCutClassification& cls, const std::vector<int>& REC_Track_pass_fid) const {
+  EventCutResult result;
+  ApplyFiducialMask(cls, REC_Track_pass_fid, result);
   return result;
+}
+
+void EventCut::ApplyFiducialMask(const EventCutClassification& cls, const std::vector<int>& REC_Track_pass_fid, EventCutResult& result) const {
+  const size_t n = cls.momentum.size();
+  result.particlePass.assign(n, 0);
+  result.MaxPhotonEnergyPass.assign(n, 0);
+  // mask-independent, just carried over from the classification
+  result.particleDaughterPass = cls.particleDaughterPass;
+  result.MotherMass = cls.MotherMass;
+
+  bool allCutsPassed = true;
+  float MaxEphotonEnergy = 0.0f;
+  size_t MaxPhotonEnergyIndex = 0;
+
+  for (size_t c = 0; c < cls.kinPass.size(); ++c) {
+    const auto& pass = cls.kinPass[c];
+    int count = 0;
+    for (size_t i = 0; i < n; ++i) {
+      if (!pass[i] || REC_Track_pass_fid[i] != 1) continue;
+      result.particlePass[i] = 1;
+      if (cls.isPhoton[i] && cls.momentum[i] > MaxEphotonEnergy) {
+        MaxEphotonEnergy = cls.momentum[i];
+        result.MaxPhotonEnergyPass[MaxPhotonEnergyIndex] = 0;
+        result.MaxPhotonEnergyPass[i] = 1;
+        MaxPhotonEnergyIndex = i;
+      }
+      ++count;
+    }
+    if (!IsInRange(count, cls.minCount[c], cls.maxCount[c])) {
+      allCutsPassed = false;
+    }
+  }
+
+  if (fAcceptEverything) {
+    allCutsPassed = true;
+  }
+
+  result.eventPass = allCutsPassed;
+}
+
+EventCutResult EventCut::operator()(const std::vector<int>& pid, const std::vector<float>& px, const std::vector<float>& py, const std::vector<float>& pz,
+                                    const std::vector<float>& vx, const std::vector<float>& vy, const std::vector<float>& vz, const std::vector<float>& vt,
+                                    const std::vector<short>& charge, const std::vector<float>& beta, const std::vector<float>& chi2pid, const std::vector<short>& status,
+                                    const std::vector<int>& REC_Track_pass_fid) const {
+  return ApplyFiducialMask(Classify(pid, px, py, pz, vx, vy, vz, vt, charge, beta, chi2pid, status), REC_Track_pass_fid);
 }
\ No newline at end of file
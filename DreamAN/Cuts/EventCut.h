@@ -4,10 +4,13 @@
 
 #include <string>
 #include <map>
+#include <memory>
 #include <vector>
 #include <cfloat>
 #include <cmath>
 
+#include "../Math/PDGTable.h"
+
 struct ParticleCut {
   int charge = 0;
   int pid = 0;
@@ -55,26 +58,29 @@ struct EventCutResult {
   std::vector<float> MotherMass; // corresponding
 };
 
-static inline float ParticleMassPDG(int pid) {
-  switch (std::abs(pid)) {
-    case 11:   return 0.000510999f;
-    case 13:   return 0.105658375f;
-    case 22:   return 0.0f;
-    case 111:  return 0.1349768f;
-    case 211:  return 0.13957039f;
-    case 130:  return 0.497611f;
-    case 310:  return 0.497611f;
-    case 321:  return 0.493677f;
-    case 2112: return 0.939565413f;
-    case 2212: return 0.938272081f;
-    case 113:  return 0.77526f;
-    case 213:  return 0.77526f;
-    case 323:  return 0.89166f;
-    case 333:  return 1.019461f;
-    default:   return 0.0f;
-          // add more as needed
-  }
-}
+// Mask-independent part of the event selection: everything operator() decides
+// per particle except the fiducial-mask test.  Computed once per event by
+// Classify() and combined with the nofid/fid masks by ApplyFiducialMask(),
+// so the two EventCutResult chains share one kinematic classification.
+struct EventCutClassification {
+  // per configured particle cut, in fParticleCuts iteration order
+  std::vector<std::vector<int>> kinPass;  // [cut][particle]
+  std::vector<int> minCount;
+  std::vector<int> maxCount;
+  // per particle
+  std::vector<float> momentum;
+  std::vector<int> isPhoton;
+  // detector region codes (Columns::kRegionFT/FD/CD/Unknown), filled by the
+  // Classify() front-ends so the per-cut loop never re-decodes the status word
+  std::vector<unsigned char> region;
+  // two-body mother results (do not depend on the mask either)
+  std::vector<int> particleDaughterPass;
+  std::vector<float> MotherMass;
+};
+
+// Masses come from the shared constexpr table (Math/PDGTable.h); the name is
+// kept for the existing call sites.
+static inline float ParticleMassPDG(int pid) { return PDG::Mass(pid); }
 
 class EventCut {
  public:
@@ -87,6 +93,25 @@ class EventCut {
 
   const ParticleCut* GetParticleCut(const std::string& name) const;
 
+  /// Topology declaration derived from the configured particle cuts: every
+  /// (pid, minCount) pair a passing event must at least contain.  Raw-pid
+  /// counting is a necessary condition — the kinematic and fiducial cuts only
+  /// shrink the candidate counts — so an event failing these counts can be
+  /// rejected before any Define runs.  maxCount is deliberately excluded (the
+  /// selection may still reduce an over-populated species below its cap).
+  /// Empty when AcceptEverything is set or no pid-specific cut is registered.
+  std::vector<std::pair<int, int>> RequiredPidCounts() const;
+
+  /// Build the selectivity-ordered cut plan.  The first calibrationEvents
+  /// classified events evaluate every cut and record how often each
+  /// required-count constraint is satisfied; once frozen, the per-cut loop
+  /// runs the tightest cuts first and stops as soon as a minCount constraint
+  /// is unsatisfiable at the kinematic level — the fiducial masks only shrink
+  /// the candidate counts, so neither result chain can pass such an event.
+  /// The plan is shared by copies of this EventCut, so the per-slot copies
+  /// captured into the RDF Defines calibrate and freeze one common order.
+  void Compile(unsigned long long calibrationEvents = 20000);
+
   static EventCut* ProtonCuts();
   static EventCut* ElectronCuts();
   static EventCut* PhotonCuts();
@@ -101,11 +126,75 @@ class EventCut {
                             const std::vector<short>& status,
                             const std::vector<int>& REC_Track_pass_fid) const;
 
+  /// Mask-independent per-particle classification (pid/charge matching plus
+  /// the momentum/beta/theta/phi/vz/chi2 windows).  Evaluate once per event
+  /// and derive each EventCutResult with ApplyFiducialMask().
+  EventCutClassification Classify(const std::vector<int>& pid,
+                                  const std::vector<float>& px, const std::vector<float>& py, const std::vector<float>& pz,
+                                  const std::vector<float>& vx, const std::vector<float>& vy, const std::vector<float>& vz,
+                                  const std::vector<float>& vt,
+                                  const std::vector<short>& charge,
+                                  const std::vector<float>& beta,
+                                  const std::vector<float>& chi2pid,
+                                  const std::vector<short>& status) const;
+
+  /// In-place variant: fills a caller-owned classification, reusing the
+  /// capacity of its vectors.  With one buffer per RDataFrame slot the
+  /// selection does no per-event heap allocation in steady state.
+  void Classify(const std::vector<int>& pid,
+                const std::vector<float>& px, const std::vector<float>& py, const std::vector<float>& pz,
+                const std::vector<float>& vx, const std::vector<float>& vy, const std::vector<float>& vz,
+                const std::vector<float>& vt,
+                const std::vector<short>& charge,
+                const std::vector<float>& beta,
+                const std::vector<float>& chi2pid,
+                const std::vector<short>& status,
+                EventCutClassification& cls) const;
+
+  /// Same in-place classification, but taking the packed region/sector column
+  /// ("REC_Particle_regsec") instead of the raw status word, so the per-cut
+  /// momentum-window test reads pre-decoded region codes.
+  void Classify(const std::vector<int>& pid,
+                const std::vector<float>& px, const std::vector<float>& py, const std::vector<float>& pz,
+                const std::vector<float>& vx, const std::vector<float>& vy, const std::vector<float>& vz,
+                const std::vector<float>& vt,
+                const std::vector<short>& charge,
+                const std::vector<float>& beta,
+                const std::vector<float>& chi2pid,
+                const std::vector<unsigned char>& regsec,
+                EventCutClassification& cls) const;
+
+  /// Combine a Classify() result with a fiducial pass mask into the full
+  /// EventCutResult (per-cut counting, max-energy photon, event pass).
+  EventCutResult ApplyFiducialMask(const EventCutClassification& cls,
+                                   const std::vector<int>& REC_Track_pass_fid) const;
+
+  /// In-place variant of ApplyFiducialMask(), reusing the result's buffers.
+  void ApplyFiducialMask(const EventCutClassification& cls,
+                         const std::vector<int>& REC_Track_pass_fid,
+                         EventCutResult& result) const;
+
  private:
+  /// Shared body of the two in-place Classify() overloads; expects cls.region
+  /// to be filled (one code per particle) before it runs.
+  void ClassifyCore(const std::vector<int>& pid,
+                    const std::vector<float>& px, const std::vector<float>& py, const std::vector<float>& pz,
+                    const std::vector<float>& vz,
+                    const std::vector<short>& charge,
+                    const std::vector<float>& beta,
+                    const std::vector<float>& chi2pid,
+                    EventCutClassification& cls) const;
+
+  // Selectivity-ordered evaluation plan built by Compile(); holds the
+  // calibration counters and, once frozen, the per-cut evaluation order.
+  // Shared (not deep-copied) so all per-slot copies feed one calibration.
+  struct CutPlan;
+
   bool fCutTwoBodyMotherDecay = false;
   bool fAcceptEverything = false;
   std::map<std::string, ParticleCut> fParticleCuts;
   std::map<std::string, TwoBodyMotherCut> fTwoBodyMotherCuts;
+  std::shared_ptr<CutPlan> fPlan;
 
   template <typename T>
   bool IsInRange(T value, T min, T max) const {
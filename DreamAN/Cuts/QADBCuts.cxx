@@ -1,3 +1,15 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
 #include <utility>
 
 #include "QADBCuts.h"
@@ -24,6 +36,52 @@ std::mutex& QADBCuts::GetMutex() {
   return m;
 }
 
+std::map<std::pair<int, int>, double>& QADBCuts::GetCountedCharge() {
+  static std::map<std::pair<int, int>, double> counted;  // (run, QA bin) -> charge
+  return counted;
+}
+
+std::shared_ptr<const QADBCuts::RunDecisions>& QADBCuts::DecisionTableRef() {
+  static std::shared_ptr<const RunDecisions> table = std::make_shared<const RunDecisions>();
+  return table;
+}
+
+const QADBCuts::QADecision* QADBCuts::FindDecision(const RunDecisions& table, int run, int ev) {
+  auto runIt = table.find(run);
+  if (runIt == table.end()) return nullptr;
+  const auto& bins = runIt->second;
+  auto it = std::upper_bound(bins.begin(), bins.end(), ev,
+                             [](int value, const QADecision& d) { return value < d.evMin; });
+  if (it == bins.begin()) return nullptr;
+  --it;
+  return (ev >= it->evMin && ev <= it->evMax) ? &(*it) : nullptr;
+}
+
+bool QADBCuts::QueryAndCacheDecision(int run, int ev, bool accumulate) {
+  std::lock_guard<std::mutex> lock(GetMutex());
+  QA::QADB& qa = GetQADB();
+  const bool pass = qa.Pass(run, ev);
+
+  // Only cache when the query actually resolved the bin containing (run, ev);
+  // after a failed lookup the accessors still hold the previous bin.
+  if (qa.GetRunnum() == run && qa.GetEvnumMin() <= ev && ev <= qa.GetEvnumMax()) {
+    if (accumulate && pass) {
+      // This bin was resolved for one of our own events, so its charge counts
+      // toward this job's total.
+      GetCountedCharge().emplace(std::make_pair(run, static_cast<int>(qa.GetFilenum())), qa.GetCharge());
+    }
+    auto updated = std::make_shared<RunDecisions>(*DecisionTableRef());
+    auto& bins = (*updated)[run];
+    const QADecision decision{static_cast<int>(qa.GetEvnumMin()), static_cast<int>(qa.GetEvnumMax()),
+                              static_cast<int>(qa.GetFilenum()), pass ? qa.GetCharge() : 0.0, pass};
+    auto pos = std::upper_bound(bins.begin(), bins.end(), decision.evMin,
+                                [](int value, const QADecision& d) { return value < d.evMin; });
+    bins.insert(pos, decision);
+    std::atomic_store_explicit(&DecisionTableRef(), std::shared_ptr<const RunDecisions>(updated), std::memory_order_release);
+  }
+  return pass;
+}
+
 // ---------- constructors / destructor ----------
 
 QADBCuts::QADBCuts() : fAccumulateCharge(true) {}
@@ -76,91 +134,211 @@ void QADBCuts::SetAccumulateCharge(bool on) { fAccumulateCharge = on; }
 bool QADBCuts::Pass(int run, int ev) {
   if (GetExcludedRuns().count(run)) return false;
   if (run <= 0 || ev <= 0) return true;  // permissive on missing meta
+
+  // Lock-free fast path: every event of an already-seen QADB bin is answered
+  // from the published decision table without touching the mutex.  Pure
+  // decision — pass-only callers (QAOk, SetAccumulateCharge(false)) never
+  // add bins to the charge total.
+  auto table = std::atomic_load_explicit(&DecisionTableRef(), std::memory_order_acquire);
+  if (const QADecision* d = FindDecision(*table, run, ev)) return d->pass;
+
+  return QueryAndCacheDecision(run, ev, /*accumulate=*/false);
+}
+
+void QADBCuts::RecordBinCharge(int run, int filenum, double charge) {
+  // Events arrive largely bin-ordered, so this thread-local set keeps the
+  // per-bin accounting off the mutex on the fast path: each thread takes the
+  // lock at most once per (run, QA bin) it actually sees.
+  thread_local std::set<std::pair<int, int>> seen;
+  if (!seen.insert({run, filenum}).second) return;
   std::lock_guard<std::mutex> lock(GetMutex());
-  return GetQADB().Pass(run, ev);
+  GetCountedCharge().emplace(std::make_pair(run, filenum), charge);
 }
 
 void QADBCuts::SetAllowedMiscRuns(const std::vector<int>& runs) {
   std::lock_guard<std::mutex> lock(GetMutex());
   QA::QADB& qa = GetQADB();
-  for (int run : runs) qa.AllowMiscBit(run);
+  for (int run : runs) {
+    qa.AllowMiscBit(run);
+    GetMiscAllowedRuns().insert(run);
+  }
 }
 
 bool QADBCuts::PassAndAccumulate(int run, int ev) {
   if (GetExcludedRuns().count(run)) return false;
-  if (run <= 0 || ev <= 0) return true;
-  std::lock_guard<std::mutex> lock(GetMutex());
-  if (GetQADB().Pass(run, ev)) {
-    GetQADB().AccumulateCharge();
-    return true;
+  if (run <= 0 || ev <= 0) return true;  // permissive on missing meta
+
+  // Same lock-free fast path as Pass, but every passing bin one of our
+  // events lands in is credited to this job's charge total.  Recording is
+  // per (run, QA bin), so the sum is independent of event ordering and
+  // thread count.
+  auto table = std::atomic_load_explicit(&DecisionTableRef(), std::memory_order_acquire);
+  if (const QADecision* d = FindDecision(*table, run, ev)) {
+    if (d->pass) RecordBinCharge(run, d->filenum, d->charge);
+    return d->pass;
   }
-  return false;
+
+  return QueryAndCacheDecision(run, ev, /*accumulate=*/true);
 }
 
 void QADBCuts::AccumulateCharge() {
   std::lock_guard<std::mutex> lock(GetMutex());
-  GetQADB().AccumulateCharge();
+  GetCountedCharge().emplace(std::make_pair(GetQADB().GetRunnum(), GetQADB().GetFilenum()), GetQADB().GetCharge());
 }
 
 double QADBCuts::GetAccumulatedCharge() {
   std::lock_guard<std::mutex> lock(GetMutex());
-  return GetQADB().GetAccumulatedCharge();
+  double total = 0.0;
+  for (const auto& [bin, charge] : GetCountedCharge()) total += charge;
+  return total;
 }
 
 void QADBCuts::ResetAccumulatedCharge() {
   std::lock_guard<std::mutex> lock(GetMutex());
-  GetQADB().ResetAccumulatedCharge();
+  GetCountedCharge().clear();
 }
 
-// ---------- helpers for "scalar-like" vectors ----------
+// ---------- binary decision cache ----------
 
-int QADBCuts::FirstOrMinus1(const std::vector<int>& v) {
-  return v.empty() ? -1 : v.front();
-}
-
-int QADBCuts::FirstOrMinus1(const ROOT::VecOps::RVec<int>& v) {
-  return v.empty() ? -1 : v[0];
+std::set<int>& QADBCuts::GetMiscAllowedRuns() {
+  static std::set<int> runs;
+  return runs;
 }
 
-int QADBCuts::FirstOrMinus1(const std::vector<Long64_t>& v) {
-  return v.empty() ? -1 : static_cast<int>(v.front());
+unsigned long long QADBCuts::ConfigHash() {
+  // FNV-1a over the decision-relevant configuration, so a cache written with a
+  // different defect list or run veto is never reused.
+  unsigned long long h = 1469598103934665603ULL;
+  auto mix = [&h](const void* data, size_t n) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < n; ++i) {
+      h ^= p[i];
+      h *= 1099511628211ULL;
+    }
+  };
+  for (const auto& d : GetDefectSet()) mix(d.data(), d.size());
+  for (int run : GetExcludedRuns()) mix(&run, sizeof(run));
+  for (int run : GetMiscAllowedRuns()) mix(&run, sizeof(run));
+  return h;
 }
 
-int QADBCuts::FirstOrMinus1(const ROOT::VecOps::RVec<Long64_t>& v) {
-  return v.empty() ? -1 : static_cast<int>(v[0]);
+std::string QADBCuts::DefaultCachePath() {
+  const char* qadbDir = std::getenv("QADB");
+  return std::string(qadbDir ? qadbDir : ".") + "/qadb_decision_cache.bin";
 }
 
-// ---------- functor overloads (RDataFrame compatible) ----------
-
-bool QADBCuts::operator()(int run, int ev) const {
-  return fAccumulateCharge ? PassAndAccumulate(run, ev) : Pass(run, ev);
-}
+namespace {
+constexpr unsigned int kQADBCacheMagic = 0x51414443;  // "QADC"
+// v2: the per-bin records carry the bin's filenum and charge; the separate
+// charge list is gone (a job only counts charge for bins its events touch).
+constexpr unsigned int kQADBCacheVersion = 2;
+
+struct QADBCacheHeader {
+  unsigned int magic;
+  unsigned int version;
+  unsigned long long configHash;
+  unsigned int nRuns;
+};
+
+struct QADBCacheBin {
+  int evMin;
+  int evMax;
+  int filenum;
+  int pass;
+  double charge;
+};
+}  // namespace
+
+bool QADBCuts::LoadDecisionCache(const std::string& path) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) return false;
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(QADBCacheHeader)) {
+    ::close(fd);
+    return false;
+  }
+  // Read-only shared mapping: all concurrent jobs on the node resolve their
+  // lookups from the same page-cache copy of the file.
+  void* base = ::mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (base == MAP_FAILED) return false;
+
+  bool ok = false;
+  const char* p = static_cast<const char*>(base);
+  const char* end = p + st.st_size;
+  QADBCacheHeader hdr;
+  std::memcpy(&hdr, p, sizeof(hdr));
+  p += sizeof(hdr);
+
+  if (hdr.magic == kQADBCacheMagic && hdr.version == kQADBCacheVersion && hdr.configHash == ConfigHash()) {
+    auto table = std::make_shared<RunDecisions>();
+    ok = true;
+    for (unsigned int r = 0; ok && r < hdr.nRuns; ++r) {
+      if (p + 2 * sizeof(int) > end) { ok = false; break; }
+      int run, nBins;
+      std::memcpy(&run, p, sizeof(int)); p += sizeof(int);
+      std::memcpy(&nBins, p, sizeof(int)); p += sizeof(int);
+      if (nBins < 0 || p + static_cast<size_t>(nBins) * sizeof(QADBCacheBin) > end) { ok = false; break; }
+      auto& bins = (*table)[run];
+      bins.reserve(nBins);
+      for (int b = 0; b < nBins; ++b) {
+        QADBCacheBin bin;
+        std::memcpy(&bin, p, sizeof(bin)); p += sizeof(bin);
+        bins.push_back({bin.evMin, bin.evMax, bin.filenum, bin.charge, bin.pass != 0});
+      }
+    }
+    if (ok) {
+      // Only the decision table is preloaded.  The charge of a cached bin is
+      // credited to this job when (and only when) one of our events hits the
+      // bin, so GetAccumulatedCharge() reports the charge of the data this
+      // job analyzed — not the union of everything any job ever cached.
+      std::atomic_store_explicit(&DecisionTableRef(), std::shared_ptr<const RunDecisions>(table), std::memory_order_release);
+      std::cout << "[QADB] loaded decision cache " << path << " (" << table->size() << " runs)\n";
+    }
+  }
 
-bool QADBCuts::operator()(const std::vector<int>& run_vec,
-                          const std::vector<int>& ev_vec) const {
-  const int run = FirstOrMinus1(run_vec);
-  const int ev  = FirstOrMinus1(ev_vec);
-  return fAccumulateCharge ? PassAndAccumulate(run, ev) : Pass(run, ev);
+  ::munmap(base, st.st_size);
+  return ok;
 }
 
-bool QADBCuts::operator()(const ROOT::VecOps::RVec<int>& run_vec,
-                          const ROOT::VecOps::RVec<int>& ev_vec) const {
-  const int run = FirstOrMinus1(run_vec);
-  const int ev  = FirstOrMinus1(ev_vec);
-  return fAccumulateCharge ? PassAndAccumulate(run, ev) : Pass(run, ev);
+bool QADBCuts::SaveDecisionCache(const std::string& path) {
+  std::shared_ptr<const RunDecisions> table;
+  unsigned long long hash;
+  {
+    std::lock_guard<std::mutex> lock(GetMutex());
+    table = DecisionTableRef();
+    hash = ConfigHash();
+  }
+  if (!table || table->empty()) return false;
+
+  // Write to a temp file and rename, so a concurrent job never maps a
+  // half-written cache.
+  const std::string tmp = path + ".tmp." + std::to_string(::getpid());
+  std::ofstream out(tmp, std::ios::binary);
+  if (!out.is_open()) return false;
+
+  QADBCacheHeader hdr{kQADBCacheMagic, kQADBCacheVersion, hash, static_cast<unsigned int>(table->size())};
+  out.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+  for (const auto& [run, bins] : *table) {
+    const int nBins = static_cast<int>(bins.size());
+    out.write(reinterpret_cast<const char*>(&run), sizeof(run));
+    out.write(reinterpret_cast<const char*>(&nBins), sizeof(nBins));
+    for (const auto& d : bins) {
+      QADBCacheBin bin{d.evMin, d.evMax, d.filenum, d.pass ? 1 : 0, d.charge};
+      out.write(reinterpret_cast<const char*>(&bin), sizeof(bin));
+    }
+  }
+  out.close();
+  if (!out.good() || std::rename(tmp.c_str(), path.c_str()) != 0) {
+    std::remove(tmp.c_str());
+    return false;
+  }
+  return true;
 }
 
-bool QADBCuts::operator()(const std::vector<Long64_t>& run_vec,
-                          const std::vector<Long64_t>& ev_vec) const {
-  const int run = FirstOrMinus1(run_vec);
-  const int ev  = FirstOrMinus1(ev_vec);
-  return fAccumulateCharge ? PassAndAccumulate(run, ev) : Pass(run, ev);
-}
+// ---------- functor (RDataFrame compatible) ----------
 
-bool QADBCuts::operator()(const ROOT::VecOps::RVec<Long64_t>& run_vec,
-                          const ROOT::VecOps::RVec<Long64_t>& ev_vec) const {
-  const int run = FirstOrMinus1(run_vec);
-  const int ev  = FirstOrMinus1(ev_vec);
+bool QADBCuts::operator()(int run, int ev) const {
   return fAccumulateCharge ? PassAndAccumulate(run, ev) : Pass(run, ev);
 }
 
@@ -1,9 +1,12 @@
 #ifndef QADBCUTS_H_
 #define QADBCUTS_H_
 
+#include <map>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 // For Long64_t
@@ -15,32 +18,20 @@
 #include "QADB.h"  // or "qadb/QADB.h"
 
 // QADB-based event filter with configurable defects and run veto.
-// Compatible with:
-//   - hipo2root output (branches are std::vector<T>)
-//   - hipoDS direct RDF (often ROOT::VecOps::RVec<T>, sometimes scalars)
 //
-// Important: ROOT's RDataFrame CallableTraits cannot deduce return types from
-// a purely-templated operator(). Therefore we provide concrete overloads for
-// the common column types.
+// Every dataframe reaching the cuts carries canonical scalar int
+// RUN_run / RUN_event columns (see core/RunEventColumns.h), so a single
+// (int, int) functor covers all sources; the per-container overloads that
+// used to mirror the raw column types are gone with them.
 class QADBCuts {
  public:
   QADBCuts();
   QADBCuts(const QADBCuts& other);
   ~QADBCuts();
 
-  // --- Functor overloads for RDataFrame ---
+  // --- Functor for RDataFrame ---
   bool operator()(int run, int ev) const;
 
-  bool operator()(const std::vector<int>& run_vec,
-                  const std::vector<int>& ev_vec) const;
-  bool operator()(const ROOT::VecOps::RVec<int>& run_vec,
-                  const ROOT::VecOps::RVec<int>& ev_vec) const;
-
-  bool operator()(const std::vector<Long64_t>& run_vec,
-                  const std::vector<Long64_t>& ev_vec) const;
-  bool operator()(const ROOT::VecOps::RVec<Long64_t>& run_vec,
-                  const ROOT::VecOps::RVec<Long64_t>& ev_vec) const;
-
   // --- Configuration ---
   void SetDefects(const std::vector<std::string>& defects);
 
@@ -67,6 +58,19 @@ class QADBCuts {
   static double GetAccumulatedCharge();
   static void ResetAccumulatedCharge();
 
+  // --- Binary decision cache shared across parallel jobs ---
+  // The cached decision table (see DecisionTableRef), including each bin's
+  // filenum and charge, can be persisted to a small binary file next to the
+  // QADB installation and mmap'd read-only at startup.  Concurrent jobs then
+  // share one page-cache copy and, as long as their lookups hit the cache, the
+  // rapidjson QADB is never parsed at all.  Loading never touches the charge
+  // accounting: a cached bin's charge is only counted once one of this job's
+  // events lands in it.  The file carries a hash of the defect set, excluded
+  // runs and misc-allowed runs; a mismatch silently falls back to live queries.
+  static std::string DefaultCachePath();        // $QADB/qadb_decision_cache.bin
+  static bool LoadDecisionCache(const std::string& path = DefaultCachePath());
+  static bool SaveDecisionCache(const std::string& path = DefaultCachePath());
+
   static bool Pass(int run, int ev);               // no charge
   static bool PassAndAccumulate(int run, int ev);  // with charge
   static void AccumulateCharge();
@@ -74,17 +78,42 @@ class QADBCuts {
  private:
   bool fAccumulateCharge{true};
 
+  // One cached pass/fail decision for a whole QADB event-number bin.  The
+  // bin's file number and charge ride along so a lock-free fast-path hit can
+  // credit the charge to this job without ever re-querying the QADB.
+  struct QADecision {
+    int evMin;
+    int evMax;
+    int filenum;
+    double charge;  // 0 for failing bins
+    bool pass;
+  };
+  using RunDecisions = std::map<int, std::vector<QADecision>>;  // run -> bins sorted by evMin
+
+  // Immutable decision table published with atomic shared_ptr stores.  Readers
+  // load it lock-free; on a miss the slow path takes the mutex, queries the
+  // QADB once for the whole bin, and publishes an extended copy.  With a few
+  // hundred bins per run the table converges after a handful of events and the
+  // event loop stops touching the mutex entirely.
+  static std::shared_ptr<const RunDecisions>& DecisionTableRef();
+  static const QADecision* FindDecision(const RunDecisions& table, int run, int ev);
+  // Slow path, takes the mutex; records the bin's charge only when the
+  // caller accumulates (PassAndAccumulate / the functor with the flag on).
+  static bool QueryAndCacheDecision(int run, int ev, bool accumulate);
+
   static QA::QADB& GetQADB();
+  static std::set<int>& GetMiscAllowedRuns();
+  static unsigned long long ConfigHash();  // defects + excluded + misc runs
+  // (run, QA bin) -> charge for every passing bin THIS JOB's events actually
+  // touched.  Summing this map gives an accumulated charge that does not
+  // depend on the order in which MT workers query the QADB, and a preloaded
+  // decision cache never inflates it: cached bins only enter here when one of
+  // our events lands in them (see RecordBinCharge).
+  static std::map<std::pair<int, int>, double>& GetCountedCharge();
+  static void RecordBinCharge(int run, int filenum, double charge);
   static std::set<int>& GetExcludedRuns();
   static std::set<std::string>& GetDefectSet();
   static std::mutex& GetMutex();
-
-  // Helpers to interpret "scalar-like" vectors (size 0 or 1 typical).
-  // Empty -> -1, then Pass() remains permissive (as your code intended).
-  static int FirstOrMinus1(const std::vector<int>& v);
-  static int FirstOrMinus1(const ROOT::VecOps::RVec<int>& v);
-  static int FirstOrMinus1(const std::vector<Long64_t>& v);
-  static int FirstOrMinus1(const ROOT::VecOps::RVec<Long64_t>& v);
 };
 
 // Optional helper, similar to the old QAOk(run,ev) style.
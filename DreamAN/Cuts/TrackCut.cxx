@@ -1,8 +1,17 @@
 #include "TrackCut.h"
 
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <sstream>
+
+#include "../ParticleInformation/PindexHitIndex.h"
+#include "../core/SlotScratch.h"
 
 TrackCut::TrackCut() = default;
 TrackCut::~TrackCut() = default;
@@ -57,7 +66,14 @@ TrackCut::TrackCut(const TrackCut& other) {
   this->fFiducialCutsECout = other.fFiducialCutsECout;
 
   this->fFiducialCutsCVT = other.fFiducialCutsCVT;
+  this->fFiducialCutsCVT_Bhawani = other.fFiducialCutsCVT_Bhawani;
   this->fFiducialCutsFTCal = other.fFiducialCutsFTCal;
+  this->fMinECALEnergyCutPerPIDLayer = other.fMinECALEnergyCutPerPIDLayer;
+
+  // The configurations are identical at copy time, so the copy shares the
+  // compiled table instead of rebuilding it; a later setter call on either
+  // object resets only that object's cache.
+  this->fCompiledTables = other.fCompiledTables;
 }
 
 void TrackCut::SetSectorCut(int SSector, int selectpid, int selectdetector, bool selectSector) {
@@ -114,6 +130,7 @@ void TrackCut::SetDCEdgeCuts(int pid, const std::vector<float>& edgeCutsPerRegio
     throw std::runtime_error("DC Edge cuts must have 3 values (for regions 1, 2, 3)");
   }
   fDCEdgeCutsPerPID[pid] = edgeCutsPerRegion;
+  InvalidateCompiledTables();
   std::cout << "[Info] DC edge cuts for PID " << pid << ": ";
   for (auto e : edgeCutsPerRegion) std::cout << e << " ";
   std::cout << std::endl;
@@ -132,6 +149,7 @@ void TrackCut::SetCVTEdgeCuts(int pid, const std::vector<float>& edgeCutsPerLaye
     throw std::runtime_error("CVT Edge cuts must have 5 values (for layers 1, 3, 5, 7, 12)");
   }
   fCVTEdgeCutsPerPID[pid] = edgeCutsPerLayer;
+  InvalidateCompiledTables();
   std::cout << "[Info] CVT edge cuts for PID " << pid << ": ";
   for (auto e : edgeCutsPerLayer) std::cout << e << " ";
   std::cout << std::endl;
@@ -150,10 +168,12 @@ void TrackCut::AddCVTFiducialRange(int pid, int layer, const std::string& axis,
     fFiducialCutsCVT[pid][layer].thetaCut.excludedRanges.emplace_back(min, max);
   else if (axis == "phi")
     fFiducialCutsCVT[pid][layer].phiCut.excludedRanges.emplace_back(min, max);
+  InvalidateCompiledTables();
 }
 
 void TrackCut::AddFTCalFiducialRange(int pid, int layer, float x, float y, float rmin, float rmax) {
   fFiducialCutsFTCal[pid][layer].ringCut.excludedRanges.emplace_back(x, y, rmin, rmax);
+  InvalidateCompiledTables();
 }
 
 void TrackCut::AddPCalFiducialRange(int pid, int sector, const std::string& axis, float min, float max) {
@@ -163,6 +183,7 @@ void TrackCut::AddPCalFiducialRange(int pid, int sector, const std::string& axis
     fFiducialCutsPCal[pid][sector].lvCut.excludedRanges.emplace_back(min, max);
   else if (axis == "lw")
     fFiducialCutsPCal[pid][sector].lwCut.excludedRanges.emplace_back(min, max);
+  InvalidateCompiledTables();
 }
 
 void TrackCut::AddECinFiducialRange(int pid, int sector, const std::string& axis, float min, float max) {
@@ -172,6 +193,7 @@ void TrackCut::AddECinFiducialRange(int pid, int sector, const std::string& axis
     fFiducialCutsECin[pid][sector].lvCut.excludedRanges.emplace_back(min, max);
   else if (axis == "lw")
     fFiducialCutsECin[pid][sector].lwCut.excludedRanges.emplace_back(min, max);
+  InvalidateCompiledTables();
 }
 
 void TrackCut::AddECoutFiducialRange(int pid, int sector, const std::string& axis, float min, float max) {
@@ -181,17 +203,144 @@ void TrackCut::AddECoutFiducialRange(int pid, int sector, const std::string& axi
     fFiducialCutsECout[pid][sector].lvCut.excludedRanges.emplace_back(min, max);
   else if (axis == "lw")
     fFiducialCutsECout[pid][sector].lwCut.excludedRanges.emplace_back(min, max);
+  InvalidateCompiledTables();
 }
 
 void TrackCut::SetMinECALEnergyCut(int pid, int layer, float minEnergy) {
   fMinECALEnergyCutPerPIDLayer[pid][layer] = minEnergy;
+  InvalidateCompiledTables();
 }
 
 void TrackCut::AddSamplingFractionMinCut(int pid, int sector, float A0, float Bm1, float Cm2) {
   fSFCutsMinCut[pid][sector] = {A0, Bm1, Cm2};
+  InvalidateCompiledTables();
 }
 void TrackCut::AddSamplingFractionMaxCut(int pid, int sector, float A0, float Bm1, float Cm2) {
   fSFCutsMaxCut[pid][sector] = {A0, Bm1, Cm2};
+  InvalidateCompiledTables();
+}
+
+TrackCut::CompiledAxisCut TrackCut::CompileAxis(const FiducialAxisCut& cut) {
+  CompiledAxisCut out;
+  auto ranges = cut.excludedRanges;
+  std::sort(ranges.begin(), ranges.end());
+  for (const auto& range : ranges) {
+    if (range.second < range.first) continue;  // degenerate range never matches
+    if (!out.starts.empty() && range.first <= out.ends.back()) {
+      out.ends.back() = std::max(out.ends.back(), range.second);
+    } else {
+      out.starts.push_back(range.first);
+      out.ends.push_back(range.second);
+    }
+  }
+  if (!out.starts.empty()) {
+    out.lo = out.starts.front();
+    out.hi = out.ends.back();
+  }
+  return out;
+}
+
+TrackCut::CompiledCut3D TrackCut::CompileCut3D(const FiducialCut3D& cut) {
+  CompiledCut3D out;
+  out.lu = CompileAxis(cut.luCut);
+  out.lv = CompileAxis(cut.lvCut);
+  out.lw = CompileAxis(cut.lwCut);
+  out.any = true;
+  return out;
+}
+
+TrackCut::FlatCutTables TrackCut::BuildFlatCutTables() const {
+  FlatCutTables tables;
+  auto slotFor = [&tables](int pid) -> FlatPIDCuts& {
+    for (size_t s = 0; s < tables.pids.size(); ++s)
+      if (tables.pids[s] == pid) return tables.cuts[s];
+    tables.pids.push_back(pid);
+    tables.cuts.emplace_back();
+    return tables.cuts.back();
+  };
+
+  for (const auto& [pid, edges] : fDCEdgeCutsPerPID) {
+    auto& c = slotFor(pid);
+    c.hasDCEdge = true;
+    for (int r = 0; r < 3; ++r) c.dcEdge[r] = edges[r];
+  }
+  for (const auto& [pid, edges] : fCVTEdgeCutsPerPID) {
+    auto& c = slotFor(pid);
+    c.hasCVTEdge = true;
+    for (int l = 0; l < 5; ++l) c.cvtEdge[l] = edges[l];
+  }
+  for (const auto& [pid, layerMap] : fFiducialCutsCVT) {
+    auto& c = slotFor(pid);
+    c.hasCvtFid = true;
+    for (const auto& [layer, cut] : layerMap) {
+      auto& compiled = c.cvtFid[layer];
+      compiled.theta = CompileAxis(cut.thetaCut);
+      compiled.phi = CompileAxis(cut.phiCut);
+    }
+  }
+  for (const auto& [pid, layerMap] : fFiducialCutsFTCal) {
+    auto& c = slotFor(pid);
+    c.hasFtFid = true;
+    for (const auto& [layer, cut] : layerMap) {
+      auto& ring = c.ftFid[layer];
+      for (const auto& range : cut.ringCut.excludedRanges) {
+        ring.x0.push_back(std::get<0>(range));
+        ring.y0.push_back(std::get<1>(range));
+        ring.rmin2.push_back(std::get<2>(range) * std::get<2>(range));
+        ring.rmax2.push_back(std::get<3>(range) * std::get<3>(range));
+      }
+    }
+  }
+  for (const auto& [pid, sectorMap] : fFiducialCutsPCal) {
+    auto& c = slotFor(pid);
+    for (const auto& [sector, cut] : sectorMap)
+      if (sector >= 0 && sector < 7) c.pcal[sector] = CompileCut3D(cut);
+  }
+  for (const auto& [pid, sectorMap] : fFiducialCutsECin) {
+    auto& c = slotFor(pid);
+    for (const auto& [sector, cut] : sectorMap)
+      if (sector >= 0 && sector < 7) c.ecin[sector] = CompileCut3D(cut);
+  }
+  for (const auto& [pid, sectorMap] : fFiducialCutsECout) {
+    auto& c = slotFor(pid);
+    for (const auto& [sector, cut] : sectorMap)
+      if (sector >= 0 && sector < 7) c.ecout[sector] = CompileCut3D(cut);
+  }
+  for (const auto& [pid, sectorMap] : fSFCutsMinCut) {
+    auto& c = slotFor(pid);
+    for (const auto& [sector, abc] : sectorMap)
+      if (sector >= 0 && sector < 7) {
+        c.sfMin[sector] = abc;
+        c.hasSFMin[sector] = true;
+      }
+  }
+  for (const auto& [pid, sectorMap] : fSFCutsMaxCut) {
+    auto& c = slotFor(pid);
+    for (const auto& [sector, abc] : sectorMap)
+      if (sector >= 0 && sector < 7) {
+        c.sfMax[sector] = abc;
+        c.hasSFMax[sector] = true;
+      }
+  }
+  for (const auto& [pid, byLayer] : fMinECALEnergyCutPerPIDLayer) {
+    auto& c = slotFor(pid);
+    for (const auto& [layer, minE] : byLayer) {
+      const int slot = (layer == 1) ? 0 : (layer == 4) ? 1 : (layer == 7) ? 2 : -1;
+      if (slot < 0 || minE <= 0.0f) continue;
+      c.hasMinLayerE = true;
+      c.minLayerE[slot] = minE;
+    }
+  }
+  for (size_t s = 0; s < tables.pids.size(); ++s) {
+    const int idx = PDG::CompactIndex(tables.pids[s]);
+    if (idx >= 0) tables.byCompact[idx] = static_cast<short>(s + 1);
+  }
+  return tables;
+}
+
+std::shared_ptr<const TrackCut::FlatCutTables> TrackCut::CompiledTables() const {
+  if (!fCompiledTables) fCompiledTables = std::make_shared<const FlatCutTables>(BuildFlatCutTables());
+  return fCompiledTables;
 }
 
 const std::map<int, std::vector<float>>& TrackCut::GetEdgeCuts() const { return fDCEdgeCutsPerPID; }
@@ -214,82 +363,69 @@ std::function<std::vector<int>(const std::vector<int16_t>& pindex,
                                const std::vector<int>& pid,
                                const int& REC_Particle_num)>
 TrackCut::RECTrajPass() const {
-  return [this](const std::vector<int16_t>& pindex, const std::vector<int16_t>& detector, const std::vector<int16_t>& layer,
+  return [this, tables = CompiledTables()](
+                const std::vector<int16_t>& pindex, const std::vector<int16_t>& detector, const std::vector<int16_t>& layer,
                 const std::vector<float>& x, const std::vector<float>& y, const std::vector<float>& z,
                 const std::vector<float>& edge, const std::vector<int>& pid,
                 const int& REC_Particle_num) -> std::vector<int> {
     std::vector<int> pass_values(REC_Particle_num, 1);
-    auto isExcluded = [](float value, const FiducialAxisCut& cut) -> bool {
-      for (const auto& range : cut.excludedRanges) {
-        if (value >= range.first && value <= range.second) return true;
-      }
-      return false;
-    };
-    for (size_t i = 0; i < pindex.size(); ++i) {
-      if (detector[i] == 6) {
-          if (fDoFiducialCut) {
-              int region = 0;
-              int absLayer = std::abs(layer[i]);
-              if (absLayer == 6)       region = 1;
-              else if (absLayer == 18) region = 2;
-              else if (absLayer == 36) region = 3;
-              if (region == 0) continue;
-              if (pindex[i] < 0 || pindex[i] >= static_cast<int>(pid.size())) continue;
-              int cur_pid = pid[pindex[i]];
-              auto pidCuts = fDCEdgeCutsPerPID.find(cur_pid);
-              if (pidCuts == fDCEdgeCutsPerPID.end()) continue;
-
-              float edgeCut = pidCuts->second[region - 1];
-              if (edge[i] <= edgeCut) {
-                  if (pindex[i] < static_cast<int>(pass_values.size()))
-                      pass_values[pindex[i]] = 0;
-                  continue;
-              }
-          }
-      }
+    if (!fDoFiducialCut) return pass_values;
+
+    // Hit rows grouped by particle, built once per event; invalid pindex rows
+    // are dropped during the build so no per-hit validity checks are needed.
+    thread_local PindexHitIndex hitIndex;
+    hitIndex.Build(pindex, REC_Particle_num);
 
+    // CVT hits whose (pid, layer) actually has a theta/phi map are gathered
+    // here and their trig runs in one flat pass after the walk: contiguous
+    // arrays with no map lookups between the acos/atan2 calls vectorize,
+    // and hits without a configured map never pay for the sqrt+acos at all.
+    auto& cvtX = SlotScratch::Cleared<float, 0>();
+    auto& cvtY = SlotScratch::Cleared<float, 1>();
+    auto& cvtZ = SlotScratch::Cleared<float, 2>();
+    auto& cvtPart = SlotScratch::Cleared<int, 0>();
+    auto& cvtCut = SlotScratch::Cleared<const CompiledCut2D_CVT*, 0>();
 
-      if (detector[i] == 5) {  // CVT
-        if (fDoFiducialCut) {
+    for (int part = 0; part < REC_Particle_num; ++part) {
+      const FlatPIDCuts* pc = tables->Find(pid[part]);
+      if (!pc) continue;  // no cuts configured for this PID
+
+      for (int i : hitIndex.RowsOf(part)) {
+        const int absLayer = std::abs(layer[i]);
+
+        if (detector[i] == 6) {  // DC
+          int region = 0;
+          if (absLayer == 6)       region = 1;
+          else if (absLayer == 18) region = 2;
+          else if (absLayer == 36) region = 3;
+          if (region == 0) continue;
+          if (!pc->hasDCEdge) continue;
+          if (edge[i] <= pc->dcEdge[region - 1]) pass_values[part] = 0;
+        } else if (detector[i] == 5) {  // CVT
           int region = 0;
-          int absLayer = std::abs(layer[i]);
-          // AFTER (safe):
-          if (absLayer == 1)  region = 1;
+          if (absLayer == 1)       region = 1;
           else if (absLayer == 3)  region = 2;
           else if (absLayer == 5)  region = 3;
           else if (absLayer == 7)  region = 4;
           else if (absLayer == 12) region = 5;
           if (region == 0) continue;
-          if (pindex[i] < 0 || pindex[i] >= static_cast<int>(pid.size())) continue;
-
-          int cur_pid = pid[pindex[i]];
-          auto pidCuts = fCVTEdgeCutsPerPID.find(cur_pid);
-          if (pidCuts == fCVTEdgeCutsPerPID.end()) continue;
-          float edgeCut = pidCuts->second[region - 1];  // now safe
-          if (edge[i] <= edgeCut) {
-              if (pindex[i] < static_cast<int>(pass_values.size()))  // ADD THIS
-                  pass_values[pindex[i]] = 0;
-              continue;
+          if (!pc->hasCVTEdge) continue;
+          if (edge[i] <= pc->cvtEdge[region - 1]) {
+            pass_values[part] = 0;
+            continue;
           }
-
-          const std::map<int, std::map<int, FiducialCut2D_CVT>>* cutMap = nullptr;
-          cutMap = &fFiducialCutsCVT;
-
-          if (cutMap) {
-            int cur_pid = pid[pindex[i]];
-            auto pidMapIt = cutMap->find(cur_pid);
-            if (pidMapIt != cutMap->end()) {
-              const auto& layerMap = pidMapIt->second;
-              auto it = layerMap.find(layer[i]);
-              if (it != layerMap.end()) {
-                const FiducialCut2D_CVT& cut = it->second;
-                float CVTtheta = 180.0 / TMath::Pi() * TMath::ACos(z[i] / sqrt(x[i]*x[i] + y[i]*y[i] + z[i]*z[i]));
-                float CVTphi = 180.0 / TMath::Pi() * TMath::ATan2(y[i], x[i]);
-                if (isExcluded(CVTtheta, cut.thetaCut) || isExcluded(CVTphi, cut.phiCut)) {
-                  if (pindex[i] < static_cast<int>(pass_values.size()))  // ADD THIS
-                      pass_values[pindex[i]] = 0;
-                  continue;
-              }
+          if (pc->hasCvtFid && pass_values[part]) {
+            auto it = pc->cvtFid.find(layer[i]);
+            if (it != pc->cvtFid.end()) {
+              const CompiledCut2D_CVT& cut = it->second;
+              // An empty compiled axis (lo > hi) can never exclude — only
+              // hits a range could actually veto enter the trig batch.
+              if (cut.theta.lo <= cut.theta.hi || cut.phi.lo <= cut.phi.hi) {
+                cvtX.push_back(x[i]);
+                cvtY.push_back(y[i]);
+                cvtZ.push_back(z[i]);
+                cvtPart.push_back(part);
+                cvtCut.push_back(&cut);
               }
             }
           }
@@ -297,10 +433,220 @@ TrackCut::RECTrajPass() const {
       }
     }
 
+    const float kRadToDeg = 180.0f / static_cast<float>(TMath::Pi());
+    for (std::size_t k = 0; k < cvtX.size(); ++k) {
+      const float r = std::sqrt(cvtX[k] * cvtX[k] + cvtY[k] * cvtY[k] + cvtZ[k] * cvtZ[k]);
+      const float theta = kRadToDeg * std::acos(cvtZ[k] / r);
+      const float phi = kRadToDeg * std::atan2(cvtY[k], cvtX[k]);
+      if (cvtCut[k]->theta.Excludes(theta) || cvtCut[k]->phi.Excludes(phi)) pass_values[cvtPart[k]] = 0;
+    }
+
     return pass_values;
   };
 }
 
+std::function<FiducialPassMasks(const std::vector<int16_t>&, const std::vector<int16_t>&, const std::vector<int16_t>&,
+                                const std::vector<float>&, const std::vector<float>&, const std::vector<float>&, const std::vector<float>&,
+                                const std::vector<int16_t>&, const std::vector<int16_t>&, const std::vector<int16_t>&, const std::vector<int16_t>&,
+                                const std::vector<float>&, const std::vector<float>&, const std::vector<float>&, const std::vector<float>&,
+                                const std::vector<short>&, const std::vector<int16_t>&, const std::vector<int16_t>&,
+                                const std::vector<float>&, const std::vector<float>&,
+                                const std::vector<int>&, const std::vector<float>&, const int&)>
+TrackCut::RECAllFiducialMasks(bool withFT) const {
+  return [this, withFT, tables = CompiledTables()](
+                        const std::vector<int16_t>& traj_pindex, const std::vector<int16_t>& traj_detector, const std::vector<int16_t>& traj_layer,
+                        const std::vector<float>& traj_x, const std::vector<float>& traj_y, const std::vector<float>& traj_z, const std::vector<float>& traj_edge,
+                        const std::vector<int16_t>& calo_pindex, const std::vector<int16_t>& calo_detector, const std::vector<int16_t>& calo_sector,
+                        const std::vector<int16_t>& calo_layer, const std::vector<float>& calo_energy,
+                        const std::vector<float>& calo_lu, const std::vector<float>& calo_lv, const std::vector<float>& calo_lw,
+                        const std::vector<short>& ft_pindex, const std::vector<int16_t>& ft_detector, const std::vector<int16_t>& ft_layer,
+                        const std::vector<float>& ft_x, const std::vector<float>& ft_y,
+                        const std::vector<int>& pid, const std::vector<float>& p,
+                        const int& REC_Particle_num) -> FiducialPassMasks {
+    FiducialPassMasks masks;
+    masks.nofidPass.assign(REC_Particle_num, 1);  // no-fiducial functor never vetoes
+    masks.trajPass.assign(REC_Particle_num, 1);
+    masks.caloPass.assign(REC_Particle_num, 1);
+    masks.ftPass.assign(REC_Particle_num, 1);
+
+    // === DC + CVT (RECTraj) — same logic as RECTrajPass ===
+    if (fDoFiducialCut) {
+      thread_local PindexHitIndex trajIndex;
+      trajIndex.Build(traj_pindex, REC_Particle_num);
+
+      // Same batched CVT trig as RECTrajPass: gather the hits a map could
+      // actually veto and run acos/atan2 in one flat pass after the walk.
+      auto& cvtX = SlotScratch::Cleared<float, 0>();
+      auto& cvtY = SlotScratch::Cleared<float, 1>();
+      auto& cvtZ = SlotScratch::Cleared<float, 2>();
+      auto& cvtPart = SlotScratch::Cleared<int, 0>();
+      auto& cvtCut = SlotScratch::Cleared<const CompiledCut2D_CVT*, 0>();
+
+      for (int part = 0; part < REC_Particle_num; ++part) {
+        const FlatPIDCuts* pc = tables->Find(pid[part]);
+        if (!pc) continue;  // no cuts configured for this PID
+
+        for (int i : trajIndex.RowsOf(part)) {
+          const int absLayer = std::abs(traj_layer[i]);
+
+          if (traj_detector[i] == 6) {  // DC
+            int region = 0;
+            if (absLayer == 6)       region = 1;
+            else if (absLayer == 18) region = 2;
+            else if (absLayer == 36) region = 3;
+            if (region == 0) continue;
+            if (!pc->hasDCEdge) continue;
+            if (traj_edge[i] <= pc->dcEdge[region - 1]) masks.trajPass[part] = 0;
+          } else if (traj_detector[i] == 5) {  // CVT
+            int region = 0;
+            if (absLayer == 1)       region = 1;
+            else if (absLayer == 3)  region = 2;
+            else if (absLayer == 5)  region = 3;
+            else if (absLayer == 7)  region = 4;
+            else if (absLayer == 12) region = 5;
+            if (region == 0) continue;
+            if (!pc->hasCVTEdge) continue;
+            if (traj_edge[i] <= pc->cvtEdge[region - 1]) {
+              masks.trajPass[part] = 0;
+              continue;
+            }
+            if (pc->hasCvtFid && masks.trajPass[part]) {
+              auto it = pc->cvtFid.find(traj_layer[i]);
+              if (it != pc->cvtFid.end()) {
+                const CompiledCut2D_CVT& cut = it->second;
+                if (cut.theta.lo <= cut.theta.hi || cut.phi.lo <= cut.phi.hi) {
+                  cvtX.push_back(traj_x[i]);
+                  cvtY.push_back(traj_y[i]);
+                  cvtZ.push_back(traj_z[i]);
+                  cvtPart.push_back(part);
+                  cvtCut.push_back(&cut);
+                }
+              }
+            }
+          }
+        }
+      }
+
+      const float kRadToDeg = 180.0f / static_cast<float>(TMath::Pi());
+      for (std::size_t k = 0; k < cvtX.size(); ++k) {
+        const float r = std::sqrt(cvtX[k] * cvtX[k] + cvtY[k] * cvtY[k] + cvtZ[k] * cvtZ[k]);
+        const float theta = kRadToDeg * std::acos(cvtZ[k] / r);
+        const float phi = kRadToDeg * std::atan2(cvtY[k], cvtX[k]);
+        if (cvtCut[k]->theta.Excludes(theta) || cvtCut[k]->phi.Excludes(phi)) masks.trajPass[cvtPart[k]] = 0;
+      }
+    }
+
+    // === ECAL (RECCalorimeter) — same logic as RECCalorimeterPass ===
+    // One gather over the bank accumulates the three layer-group energies
+    // per particle (PCal / ECin / ECout); the SF quadratics and the
+    // per-layer minimum-energy thresholds below both read from this table.
+    auto& layerE = SlotScratch::Assigned<float, 12>(static_cast<size_t>(3 * REC_Particle_num), 0.0f);
+    auto& REC_Particle_Sector = SlotScratch::Assigned<int, 10>(REC_Particle_num, -1);
+    if (fDoFiducialCut) {
+      thread_local PindexHitIndex caloIndex;
+      caloIndex.Build(calo_pindex, REC_Particle_num);
+      for (int part = 0; part < REC_Particle_num; ++part) {
+        const FlatPIDCuts* pc = tables->Find(pid[part]);
+        for (int i : caloIndex.RowsOf(part)) {
+          if (calo_detector[i] != 7) continue;
+
+          const int slot = (calo_layer[i] == 1) ? 0 : (calo_layer[i] == 4) ? 1 : (calo_layer[i] == 7) ? 2 : -1;
+          const std::array<CompiledCut3D, 7>* sectorTab = nullptr;
+          if (pc) {
+            if (slot == 0)
+              sectorTab = &pc->pcal;
+            else if (slot == 1)
+              sectorTab = &pc->ecin;
+            else if (slot == 2)
+              sectorTab = &pc->ecout;
+          }
+
+          if (slot >= 0) layerE[3 * part + slot] += calo_energy[i];
+          REC_Particle_Sector[part] = calo_sector[i];
+
+          if (sectorTab && calo_sector[i] >= 0 && calo_sector[i] < 7) {
+            const CompiledCut3D& cut = (*sectorTab)[calo_sector[i]];
+            if (cut.any && (cut.lu.Excludes(calo_lu[i]) || cut.lv.Excludes(calo_lv[i]) || cut.lw.Excludes(calo_lw[i]))) masks.caloPass[part] = 0;
+          }
+        }
+      }
+
+      // Per-layer minimum-energy thresholds (SetMinECALEnergyCut), read off
+      // the gathered table.  Only particles with an ECAL association are
+      // tested — like the lu/lv/lw cuts, hitless particles are untouched.
+      for (int i = 0; i < REC_Particle_num; ++i) {
+        if (REC_Particle_Sector[i] < 0) continue;
+        const FlatPIDCuts* pc = tables->Find(pid[i]);
+        if (!pc || !pc->hasMinLayerE) continue;
+        for (int L = 0; L < 3; ++L)
+          if (pc->minLayerE[L] > 0.0f && layerE[3 * i + L] < pc->minLayerE[L]) {
+            masks.caloPass[i] = 0;
+            break;
+          }
+      }
+    }
+    if (fdoSFCut) {
+      for (int i = 0; i < REC_Particle_num; ++i) {
+        if (p[i] <= 0) continue;
+        const float SF = (layerE[3 * i] + layerE[3 * i + 1] + layerE[3 * i + 2]) / p[i];
+        const float SF14 = (layerE[3 * i] + layerE[3 * i + 1]) / p[i];
+
+        const FlatPIDCuts* pc = tables->Find(pid[i]);
+        const int sec = REC_Particle_Sector[i];
+        const SFCutABC* minABC = (pc && sec >= 0 && sec < 7 && pc->hasSFMin[sec]) ? &pc->sfMin[sec] : nullptr;
+        const SFCutABC* maxABC = (pc && sec >= 0 && sec < 7 && pc->hasSFMax[sec]) ? &pc->sfMax[sec] : nullptr;
+
+        if (minABC) {
+          float minCut = minABC->A0 + minABC->Bm1 * p[i] + minABC->Cm2 * (p[i] * p[i]);
+          if (fPIDSystematics && maxABC) {
+            const float maxCut = maxABC->A0 + maxABC->Bm1 * p[i] + maxABC->Cm2 * (p[i] * p[i]);
+            const float center = 0.5f * (minCut + maxCut);
+            const float halfWidth = 0.5f * (maxCut - minCut);
+            minCut = center - halfWidth * fSFthreeSigmaFactor;
+          }
+          if (SF < minCut) masks.caloPass[i] = 0;
+        }
+
+        if (maxABC) {
+          float maxCut = maxABC->A0 + maxABC->Bm1 * p[i] + maxABC->Cm2 * (p[i] * p[i]);
+          if (fPIDSystematics && minABC) {
+            const float minCut = minABC->A0 + minABC->Bm1 * p[i] + minABC->Cm2 * (p[i] * p[i]);
+            const float center = 0.5f * (minCut + maxCut);
+            const float halfWidth = 0.5f * (maxCut - minCut);
+            maxCut = center + halfWidth * fSFthreeSigmaFactor;
+          }
+          if (SF > maxCut) masks.caloPass[i] = 0;
+        }
+
+        if (pid[i] == fSFpid && SF14 < fSFmin && p[i] > fSFminP) masks.caloPass[i] = 0;
+      }
+    }
+
+    // === FTCal (RECForwardTagger) — same logic as RECForwardTaggerPass ===
+    if (fDoFiducialCut && withFT) {
+      thread_local PindexHitIndex ftIndex;
+      ftIndex.Build(ft_pindex, REC_Particle_num);
+      for (int part = 0; part < REC_Particle_num; ++part) {
+        const FlatPIDCuts* pc = tables->Find(pid[part]);
+        if (!pc || !pc->hasFtFid) continue;
+        for (int i : ftIndex.RowsOf(part)) {
+          if (ft_detector[i] != 10) continue;
+          auto it = pc->ftFid.find(ft_layer[i]);
+          if (it != pc->ftFid.end()) {
+            if (it->second.Excludes(ft_x[i], ft_y[i])) masks.ftPass[part] = 0;
+          }
+        }
+      }
+    }
+
+    masks.trackFidPass.resize(REC_Particle_num, 1);
+    for (int i = 0; i < REC_Particle_num; ++i) {
+      masks.trackFidPass[i] = masks.trajPass[i] && masks.caloPass[i] && (!withFT || masks.ftPass[i]);
+    }
+    return masks;
+  };
+}
+
 std::function<std::vector<int>(const std::vector<int16_t>&,  // pindex
                                const std::vector<int16_t>&,  // detector
                                const std::vector<int16_t>&,  // sector
@@ -313,127 +659,111 @@ std::function<std::vector<int>(const std::vector<int16_t>&,  // pindex
                                const std::vector<float>&,    // p
                                const int& REC_Particle_num)>
 TrackCut::RECCalorimeterPass() const {
-  return [this](const std::vector<int16_t>& pindex, const std::vector<int16_t>& detector, const std::vector<int16_t>& sector,
+  return [this, tables = CompiledTables()](
+                const std::vector<int16_t>& pindex, const std::vector<int16_t>& detector, const std::vector<int16_t>& sector,
                 const std::vector<int16_t>& layer, const std::vector<float>& energy,
                 const std::vector<float>& lu, const std::vector<float>& lv, const std::vector<float>& lw,
                 const std::vector<int>& pid, const std::vector<float>& p,
                 const int& REC_Particle_num) -> std::vector<int> {
     // Initialize return_values with size REC_Particle_num and default value 9999.0
     std::vector<int> return_values(REC_Particle_num, 1);
-    std::vector<float> SF14(REC_Particle_num, 0.0);
-    std::vector<float> SF(REC_Particle_num, 0.0);
-    std::vector<int> REC_Particle_Sector(REC_Particle_num, -1);// Later save it in the RDF
-    auto isExcluded = [](float value, const FiducialAxisCut& cut) -> bool {
-      for (const auto& range : cut.excludedRanges) {
-        if (value >= range.first && value <= range.second) return true;
-      }
-      return false;
-    };
+    // Per-particle layer-group energies from one gather over the bank
+    // (slot 0 = PCal, 1 = ECin, 2 = ECout); the SF quadratics and the
+    // per-layer minimum-energy thresholds both read from this table.
+    auto& layerE = SlotScratch::Assigned<float, 12>(static_cast<size_t>(3 * REC_Particle_num), 0.0f);
+    auto& REC_Particle_Sector = SlotScratch::Assigned<int, 10>(REC_Particle_num, -1);// Later save it in the RDF
 
-    for (size_t i = 0; i < pindex.size(); ++i) {
-      if (detector[i] == 7) {
-        if (fDoFiducialCut) {
-          // Guard: REC::Calorimeter pindex is -1 (or otherwise invalid) for
-          // calorimeter hits that have no matched REC::Particle row.  Without
-          // this check the SF14/SF/REC_Particle_Sector writes below would
-          // index before the start of the heap buffer, corrupting memory and
-          // eventually triggering std::length_error in a later vector resize.
-          if (pindex[i] < 0 || pindex[i] >= REC_Particle_num) continue;
-
-          const std::map<int, std::map<int, FiducialCut3D>>* cutMap = nullptr;
-          if (layer[i] == 1)
-            cutMap = &fFiducialCutsPCal;
-          else if (layer[i] == 4)
-            cutMap = &fFiducialCutsECin;
-          else if (layer[i] == 7)
-            cutMap = &fFiducialCutsECout;
-          
-          if (layer[i] == 1 || layer[i] == 4) SF14[pindex[i]] = SF14[pindex[i]] + energy[i];
-          SF[pindex[i]] = SF[pindex[i]] + energy[i];
-          REC_Particle_Sector[pindex[i]] = sector[i];
-
-          if (cutMap) {
-            int cur_pid = pid[pindex[i]];
-            auto pidMapIt = cutMap->find(cur_pid);
-            if (pidMapIt != cutMap->end()) {
-              const auto& sectorMap = pidMapIt->second;
-              auto it = sectorMap.find(sector[i]);
-              if (it != sectorMap.end()) {
-                const FiducialCut3D& cut = it->second;
-                if (isExcluded(lu[i], cut.luCut) || isExcluded(lv[i], cut.lvCut) || isExcluded(lw[i], cut.lwCut)) {
-                  return_values[pindex[i]] = 0;
-                  continue;
-                }
-              }
+    // Hit rows grouped by particle, built once per event.  Unmatched hits
+    // (pindex = -1) are dropped during the build, which also removes the old
+    // out-of-bounds hazard on the layerE/REC_Particle_Sector writes.
+    if (fDoFiducialCut) {
+      thread_local PindexHitIndex hitIndex;
+      hitIndex.Build(pindex, REC_Particle_num);
+      for (int part = 0; part < REC_Particle_num; ++part) {
+        const FlatPIDCuts* pc = tables->Find(pid[part]);
+        for (int i : hitIndex.RowsOf(part)) {
+          if (detector[i] != 7) continue;
+
+          const int slot = (layer[i] == 1) ? 0 : (layer[i] == 4) ? 1 : (layer[i] == 7) ? 2 : -1;
+          const std::array<CompiledCut3D, 7>* sectorTab = nullptr;
+          if (pc) {
+            if (slot == 0)
+              sectorTab = &pc->pcal;
+            else if (slot == 1)
+              sectorTab = &pc->ecin;
+            else if (slot == 2)
+              sectorTab = &pc->ecout;
+          }
+
+          if (slot >= 0) layerE[3 * part + slot] += energy[i];
+          REC_Particle_Sector[part] = sector[i];
+
+          if (sectorTab && sector[i] >= 0 && sector[i] < 7) {
+            const CompiledCut3D& cut = (*sectorTab)[sector[i]];
+            if (cut.any && (cut.lu.Excludes(lu[i]) || cut.lv.Excludes(lv[i]) || cut.lw.Excludes(lw[i]))) {
+              return_values[part] = 0;
+              continue;
             }
           }
         }
       }
+
+      // Per-layer minimum-energy thresholds (SetMinECALEnergyCut).  Applied
+      // only to particles with an ECAL association — like the lu/lv/lw cuts,
+      // hitless particles are untouched.
+      for (int i = 0; i < REC_Particle_num; ++i) {
+        if (REC_Particle_Sector[i] < 0) continue;
+        const FlatPIDCuts* pc = tables->Find(pid[i]);
+        if (!pc || !pc->hasMinLayerE) continue;
+        for (int L = 0; L < 3; ++L)
+          if (pc->minLayerE[L] > 0.0f && layerE[3 * i + L] < pc->minLayerE[L]) {
+            return_values[i] = 0;
+            break;
+          }
+      }
     }
-    for (size_t i = 0; i < SF.size(); ++i) {
-      if (!fdoSFCut) continue;
-      
-      int cur_pid = pid[i];
-      if (p[i] <= 0) continue;
-      SF[i] = SF[i] / p[i];
-      SF14[i] = SF14[i] / p[i];
-
-      // Sector-dependent minimum cut
-      auto minIt = fSFCutsMinCut.find(cur_pid);
-      if (minIt != fSFCutsMinCut.end()) {
-        auto& sectorMap = minIt->second;
-        if (sectorMap.count(REC_Particle_Sector[i])) {
-          const auto& abc = sectorMap.at(REC_Particle_Sector[i]);
-          float minCut = abc.A0 + abc.Bm1 * p[i] + abc.Cm2 * (p[i] * p[i]);
-          if (fPIDSystematics) {
-            auto maxPidIt = fSFCutsMaxCut.find(cur_pid);
-            if (maxPidIt != fSFCutsMaxCut.end()) {
-              auto maxSectorIt = maxPidIt->second.find(REC_Particle_Sector[i]);
-              if (maxSectorIt != maxPidIt->second.end()) {
-                const auto& maxABC = maxSectorIt->second;
-                const float maxCut =
-                    maxABC.A0 + maxABC.Bm1 * p[i] + maxABC.Cm2 * (p[i] * p[i]);
-                const float center = 0.5f * (minCut + maxCut);
-                const float halfWidth = 0.5f * (maxCut - minCut);
-                minCut = center - halfWidth * fSFthreeSigmaFactor;
-              }
-            }
+    if (fdoSFCut) {
+      for (int i = 0; i < REC_Particle_num; ++i) {
+        if (p[i] <= 0) continue;
+        const float SF = (layerE[3 * i] + layerE[3 * i + 1] + layerE[3 * i + 2]) / p[i];
+        const float SF14 = (layerE[3 * i] + layerE[3 * i + 1]) / p[i];
+
+        const FlatPIDCuts* pc = tables->Find(pid[i]);
+        const int sec = REC_Particle_Sector[i];
+        const SFCutABC* minABC = (pc && sec >= 0 && sec < 7 && pc->hasSFMin[sec]) ? &pc->sfMin[sec] : nullptr;
+        const SFCutABC* maxABC = (pc && sec >= 0 && sec < 7 && pc->hasSFMax[sec]) ? &pc->sfMax[sec] : nullptr;
+
+        // Sector-dependent minimum cut
+        if (minABC) {
+          float minCut = minABC->A0 + minABC->Bm1 * p[i] + minABC->Cm2 * (p[i] * p[i]);
+          if (fPIDSystematics && maxABC) {
+            const float maxCut = maxABC->A0 + maxABC->Bm1 * p[i] + maxABC->Cm2 * (p[i] * p[i]);
+            const float center = 0.5f * (minCut + maxCut);
+            const float halfWidth = 0.5f * (maxCut - minCut);
+            minCut = center - halfWidth * fSFthreeSigmaFactor;
           }
-          if (SF[i] < minCut) {
+          if (SF < minCut) {
             return_values[i] = 0;
           }
         }
-      }
 
-      // Sector-dependent maximum cut
-      auto maxIt = fSFCutsMaxCut.find(cur_pid);
-      if (maxIt != fSFCutsMaxCut.end()) {
-        auto& sectorMap = maxIt->second;
-        if (sectorMap.count(REC_Particle_Sector[i])) {
-          const auto& abc = sectorMap.at(REC_Particle_Sector[i]);
-          float maxCut = abc.A0 + abc.Bm1 * p[i] + abc.Cm2 * (p[i] * p[i]);
-          if (fPIDSystematics) {
-            auto minPidIt = fSFCutsMinCut.find(cur_pid);
-            if (minPidIt != fSFCutsMinCut.end()) {
-              auto minSectorIt = minPidIt->second.find(REC_Particle_Sector[i]);
-              if (minSectorIt != minPidIt->second.end()) {
-                const auto& minABC = minSectorIt->second;
-                const float minCut =
-                    minABC.A0 + minABC.Bm1 * p[i] + minABC.Cm2 * (p[i] * p[i]);
-                const float center = 0.5f * (minCut + maxCut);
-                const float halfWidth = 0.5f * (maxCut - minCut);
-                maxCut = center + halfWidth * fSFthreeSigmaFactor;
-              }
-            }
+        // Sector-dependent maximum cut
+        if (maxABC) {
+          float maxCut = maxABC->A0 + maxABC->Bm1 * p[i] + maxABC->Cm2 * (p[i] * p[i]);
+          if (fPIDSystematics && minABC) {
+            const float minCut = minABC->A0 + minABC->Bm1 * p[i] + minABC->Cm2 * (p[i] * p[i]);
+            const float center = 0.5f * (minCut + maxCut);
+            const float halfWidth = 0.5f * (maxCut - minCut);
+            maxCut = center + halfWidth * fSFthreeSigmaFactor;
           }
-          if (SF[i] > maxCut) {
+          if (SF > maxCut) {
             return_values[i] = 0;
           }
         }
-      }
 
-      if (cur_pid == fSFpid && SF14[i] < fSFmin && p[i] > fSFminP) {
-        return_values[i] = 0;
+        if (pid[i] == fSFpid && SF14 < fSFmin && p[i] > fSFminP) {
+          return_values[i] = 0;
+        }
       }
     }
     return return_values;
@@ -448,52 +778,30 @@ std::function<std::vector<int>(const std::vector<short>&,    // pindex
                                const std::vector<int>&,      // pid
                                const int& REC_Particle_num)>
 TrackCut::RECForwardTaggerPass() const {
-  return [this](const std::vector<short>& pindex, const std::vector<int16_t>& detector,
+  return [this, tables = CompiledTables()](
+                const std::vector<short>& pindex, const std::vector<int16_t>& detector,
                 const std::vector<int16_t>& layer,
                 const std::vector<float>& x, const std::vector<float>& y,
                 const std::vector<int>& pid,
                 const int& REC_Particle_num) -> std::vector<int> {
     // Initialize return_values with size REC_Particle_num and default value 9999.0
 
-    auto isExcluded = [](float x, float y, const FiducialRingCut& cut) -> bool {
-      for (const auto& range : cut.excludedRanges) {
-        float x0 = std::get<0>(range);
-        float y0 = std::get<1>(range);
-        float rmin = std::get<2>(range);
-        float rmax = std::get<3>(range);
-        if ((x0-x)*(x0-x)+(y0-y)*(y0-y) >= rmin*rmin && (x0-x)*(x0-x)+(y0-y)*(y0-y) <= rmax*rmax) return true;
-      }
-      return false;
-    };
-
     std::vector<int> return_values(REC_Particle_num, 1);
+    if (!fDoFiducialCut) return return_values;
 
-    for (size_t i = 0; i < pindex.size(); ++i) {
-      if (detector[i] == 10) {
-        if (fDoFiducialCut) {
-          // Guard: REC::ForwardTagger pindex can be -1 for unmatched hits.
-          if (pindex[i] < 0 || pindex[i] >= REC_Particle_num) continue;
-
-          const std::map<int, std::map<int, FiducialCutRing_FTCal>>* cutMap = nullptr;
-          cutMap = &fFiducialCutsFTCal;
-
-          if (cutMap) {
-            int cur_pid = pid[pindex[i]];
-            auto pidMapIt = cutMap->find(cur_pid);
-            if (pidMapIt != cutMap->end()) {
-              const auto& layerMap = pidMapIt->second;
-              auto it = layerMap.find(layer[i]);
-              if (it != layerMap.end()) {
-                const FiducialCutRing_FTCal& cut = it->second;
-                if (isExcluded(x[i], y[i], cut.ringCut) ) {
-                  return_values[pindex[i]] = 0;
-                  continue;
-                }
-              }
-            }
-          }
+    // Hit rows grouped by particle; unmatched hits (pindex = -1) are dropped
+    // during the build.
+    thread_local PindexHitIndex hitIndex;
+    hitIndex.Build(pindex, REC_Particle_num);
+    for (int part = 0; part < REC_Particle_num; ++part) {
+      const FlatPIDCuts* pc = tables->Find(pid[part]);
+      if (!pc || !pc->hasFtFid) continue;
+      for (int i : hitIndex.RowsOf(part)) {
+        if (detector[i] != 10) continue;
+        auto it = pc->ftFid.find(layer[i]);
+        if (it != pc->ftFid.end()) {
+          if (it->second.Excludes(x[i], y[i])) return_values[part] = 0;
         }
-        
       }
     }
     return return_values;
@@ -615,3 +923,354 @@ TrackCut::RECFiducialPass() const {
     return result;
   };
 }
+
+std::string TrackCut::ConfigFingerprint() const {
+  // Serialize every configuration member into a deterministic text form
+  // (std::map / std::set iterate in key order) and FNV-1a hash it.  Any new
+  // cut knob must be appended here, otherwise stale derived columns could be
+  // reused after that knob changes.
+  std::ostringstream s;
+  s.precision(9);
+  s << fselectSector << '|' << fDoFiducialCut << '|' << fDoDCFiducial << '|' << fDoECALFiducial << '|'
+    << fdoSFCut << '|' << fSFpid << '|' << fSFmin << '|' << fSFminP << '|'
+    << fPIDSystematics << '|' << fSFthreeSigmaFactor << '|'
+    << fSector << '|' << fselectPID << '|' << fselectdetector << '|';
+  for (int sec : fSectors) s << sec << ',';
+  s << '|' << fMinX << ',' << fMaxX << ',' << fMinY << ',' << fMaxY << ',' << fMinZ << ',' << fMaxZ
+    << '|' << fMinCX << ',' << fMaxCX << ',' << fMinCY << ',' << fMaxCY << ',' << fMinCZ << ',' << fMaxCZ
+    << '|' << fMinPath << ',' << fMaxPath
+    << '|' << fDCMinEdge << ',' << fDCMaxEdge << '|' << fECALMinEdge << ',' << fECALMaxEdge << '|';
+  for (const auto& [lo, hi] : fThetaBins) s << lo << ':' << hi << ',';
+
+  auto hashFloatTable = [&s](const std::map<int, std::vector<float>>& table, const char* tag) {
+    s << '|' << tag;
+    for (const auto& [pid, vals] : table) {
+      s << pid << '(';
+      for (float v : vals) s << v << ',';
+      s << ')';
+    }
+  };
+  hashFloatTable(fDCEdgeCutsPerPID, "dc");
+  hashFloatTable(fCVTEdgeCutsPerPID, "cvt");
+
+  auto hashAxis = [&s](const FiducialAxisCut& axis) {
+    for (const auto& [lo, hi] : axis.excludedRanges) s << lo << ':' << hi << ',';
+    s << ';';
+  };
+  auto hashCut3DTable = [&](const std::map<int, std::map<int, FiducialCut3D>>& table, const char* tag) {
+    s << '|' << tag;
+    for (const auto& [pid, bySector] : table)
+      for (const auto& [sector, cut] : bySector) {
+        s << pid << '/' << sector << '[';
+        hashAxis(cut.luCut);
+        hashAxis(cut.lvCut);
+        hashAxis(cut.lwCut);
+        s << ']';
+      }
+  };
+  auto hashCvtTable = [&](const std::map<int, std::map<int, FiducialCut2D_CVT>>& table, const char* tag) {
+    s << '|' << tag;
+    for (const auto& [pid, byLayer] : table)
+      for (const auto& [layer, cut] : byLayer) {
+        s << pid << '/' << layer << '[';
+        hashAxis(cut.thetaCut);
+        hashAxis(cut.phiCut);
+        s << ']';
+      }
+  };
+  hashCvtTable(fFiducialCutsCVT, "cvtfid");
+  hashCvtTable(fFiducialCutsCVT_Bhawani, "cvtfidB");
+  s << "|ft";
+  for (const auto& [pid, byLayer] : fFiducialCutsFTCal)
+    for (const auto& [layer, cut] : byLayer) {
+      s << pid << '/' << layer << '[';
+      for (const auto& [x, y, rmin, rmax] : cut.ringCut.excludedRanges) s << x << ':' << y << ':' << rmin << ':' << rmax << ',';
+      s << ']';
+    }
+  hashCut3DTable(fFiducialCutsPCal, "pcal");
+  hashCut3DTable(fFiducialCutsECin, "ecin");
+  hashCut3DTable(fFiducialCutsECout, "ecout");
+
+  auto hashSFTable = [&s](const std::map<int, std::map<int, SFCutABC>>& table, const char* tag) {
+    s << '|' << tag;
+    for (const auto& [pid, bySector] : table)
+      for (const auto& [sector, abc] : bySector) s << pid << '/' << sector << '(' << abc.A0 << ',' << abc.Bm1 << ',' << abc.Cm2 << ')';
+  };
+  hashSFTable(fSFCutsMinCut, "sfmin");
+  hashSFTable(fSFCutsMaxCut, "sfmax");
+  s << "|emin";
+  for (const auto& [pid, byLayer] : fMinECALEnergyCutPerPIDLayer)
+    for (const auto& [layer, e] : byLayer) s << pid << '/' << layer << '(' << e << ')';
+
+  const std::string text = s.str();
+  std::uint64_t h = 1469598103934665603ull;  // FNV offset basis
+  for (unsigned char c : text) {
+    h ^= c;
+    h *= 1099511628211ull;  // FNV prime
+  }
+  std::ostringstream out;
+  out << std::hex << std::setfill('0') << std::setw(16) << h;
+  return out.str();
+}
+
+namespace {
+// Snapshot file layout: 8-byte magic, uint32 format version, the 16-char
+// ConfigFingerprint of the saved state, then the members in the same order
+// ConfigFingerprint hashes them.  Bump the version whenever a knob is added.
+constexpr char kSnapshotMagic[8] = {'T', 'C', 'U', 'T', 'S', 'N', 'A', 'P'};
+constexpr std::uint32_t kSnapshotVersion = 1;
+}  // namespace
+
+bool TrackCut::SaveConfigSnapshot(const std::string& path) const {
+  std::string b;
+  b.reserve(8192);
+  auto putRaw = [&b](const void* p, size_t n) { b.append(static_cast<const char*>(p), n); };
+  auto putB = [&](bool v) { const std::uint8_t u = v ? 1 : 0; putRaw(&u, 1); };
+  auto putI = [&](std::int32_t v) { putRaw(&v, 4); };
+  auto putN = [&](size_t v) { const std::uint32_t u = static_cast<std::uint32_t>(v); putRaw(&u, 4); };
+  auto putF = [&](float v) { putRaw(&v, 4); };
+  auto putAxis = [&](const FiducialAxisCut& a) {
+    putN(a.excludedRanges.size());
+    for (const auto& [lo, hi] : a.excludedRanges) { putF(lo); putF(hi); }
+  };
+  auto putCut3DTable = [&](const std::map<int, std::map<int, FiducialCut3D>>& table) {
+    putN(table.size());
+    for (const auto& [pid, bySector] : table) {
+      putI(pid);
+      putN(bySector.size());
+      for (const auto& [sector, cut] : bySector) {
+        putI(sector);
+        putAxis(cut.luCut);
+        putAxis(cut.lvCut);
+        putAxis(cut.lwCut);
+      }
+    }
+  };
+
+  putRaw(kSnapshotMagic, sizeof(kSnapshotMagic));
+  putN(kSnapshotVersion);
+  const std::string fp = ConfigFingerprint();
+  putRaw(fp.data(), fp.size());  // fixed 16 hex chars
+
+  putB(fselectSector); putB(fDoFiducialCut); putB(fDoDCFiducial); putB(fDoECALFiducial); putB(fdoSFCut);
+  putI(fSFpid); putF(fSFmin); putF(fSFminP);
+  putB(fPIDSystematics); putF(fSFthreeSigmaFactor);
+  putF(fSector); putI(fselectPID); putI(fselectdetector);
+  putN(fSectors.size());
+  for (int sec : fSectors) putI(sec);
+  for (float v : {fMinX, fMaxX, fMinY, fMaxY, fMinZ, fMaxZ, fMinCX, fMaxCX, fMinCY, fMaxCY, fMinCZ, fMaxCZ,
+                  fMinPath, fMaxPath, fDCMinEdge, fDCMaxEdge, fECALMinEdge, fECALMaxEdge})
+    putF(v);
+  putN(fThetaBins.size());
+  for (const auto& [lo, hi] : fThetaBins) { putF(lo); putF(hi); }
+
+  for (const auto* table : {&fDCEdgeCutsPerPID, &fCVTEdgeCutsPerPID}) {
+    putN(table->size());
+    for (const auto& [pid, vals] : *table) {
+      putI(pid);
+      putN(vals.size());
+      for (float v : vals) putF(v);
+    }
+  }
+
+  for (const auto* table : {&fFiducialCutsCVT, &fFiducialCutsCVT_Bhawani}) {
+    putN(table->size());
+    for (const auto& [pid, byLayer] : *table) {
+      putI(pid);
+      putN(byLayer.size());
+      for (const auto& [layer, cut] : byLayer) {
+        putI(layer);
+        putAxis(cut.thetaCut);
+        putAxis(cut.phiCut);
+      }
+    }
+  }
+
+  putN(fFiducialCutsFTCal.size());
+  for (const auto& [pid, byLayer] : fFiducialCutsFTCal) {
+    putI(pid);
+    putN(byLayer.size());
+    for (const auto& [layer, cut] : byLayer) {
+      putI(layer);
+      putN(cut.ringCut.excludedRanges.size());
+      for (const auto& [x, y, rmin, rmax] : cut.ringCut.excludedRanges) { putF(x); putF(y); putF(rmin); putF(rmax); }
+    }
+  }
+
+  putCut3DTable(fFiducialCutsPCal);
+  putCut3DTable(fFiducialCutsECin);
+  putCut3DTable(fFiducialCutsECout);
+
+  for (const auto* table : {&fSFCutsMinCut, &fSFCutsMaxCut}) {
+    putN(table->size());
+    for (const auto& [pid, bySector] : *table) {
+      putI(pid);
+      putN(bySector.size());
+      for (const auto& [sector, abc] : bySector) { putI(sector); putF(abc.A0); putF(abc.Bm1); putF(abc.Cm2); }
+    }
+  }
+
+  putN(fMinECALEnergyCutPerPIDLayer.size());
+  for (const auto& [pid, byLayer] : fMinECALEnergyCutPerPIDLayer) {
+    putI(pid);
+    putN(byLayer.size());
+    for (const auto& [layer, e] : byLayer) { putI(layer); putF(e); }
+  }
+
+  std::ofstream f(path, std::ios::binary | std::ios::trunc);
+  if (!f) {
+    std::cerr << "[TrackCut] cannot write config snapshot: " << path << std::endl;
+    return false;
+  }
+  f.write(b.data(), static_cast<std::streamsize>(b.size()));
+  return f.good();
+}
+
+bool TrackCut::LoadConfigSnapshot(const std::string& path) {
+  std::ifstream f(path, std::ios::binary);
+  if (!f) return false;
+  const std::string b((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+
+  size_t o = 0;
+  bool ok = true;
+  auto getRaw = [&](void* p, size_t n) {
+    if (!ok || o + n > b.size()) { ok = false; return; }
+    std::memcpy(p, b.data() + o, n);
+    o += n;
+  };
+  auto getB = [&]() { std::uint8_t u = 0; getRaw(&u, 1); return u != 0; };
+  auto getI = [&]() { std::int32_t v = 0; getRaw(&v, 4); return v; };
+  auto getN = [&]() -> size_t {
+    std::uint32_t u = 0;
+    getRaw(&u, 4);
+    // Reject counts that cannot fit in the remaining bytes so a corrupt
+    // file fails cleanly instead of driving a huge allocation.
+    if (u > b.size()) ok = false;
+    return ok ? u : 0;
+  };
+  auto getF = [&]() { float v = 0; getRaw(&v, 4); return v; };
+  auto getAxis = [&](FiducialAxisCut& a) {
+    const size_t n = getN();
+    a.excludedRanges.resize(ok ? n : 0);
+    for (auto& [lo, hi] : a.excludedRanges) { lo = getF(); hi = getF(); }
+  };
+  auto getCut3DTable = [&](std::map<int, std::map<int, FiducialCut3D>>& table) {
+    const size_t nPid = getN();
+    for (size_t ip = 0; ok && ip < nPid; ++ip) {
+      auto& bySector = table[getI()];
+      const size_t nSec = getN();
+      for (size_t is = 0; ok && is < nSec; ++is) {
+        auto& cut = bySector[getI()];
+        getAxis(cut.luCut);
+        getAxis(cut.lvCut);
+        getAxis(cut.lwCut);
+      }
+    }
+  };
+
+  char magic[8] = {};
+  getRaw(magic, sizeof(magic));
+  if (!ok || std::memcmp(magic, kSnapshotMagic, sizeof(magic)) != 0) return false;
+  if (getN() != kSnapshotVersion) {
+    std::cerr << "[TrackCut] config snapshot " << path << " has an unsupported format version, ignoring" << std::endl;
+    return false;
+  }
+  char fp[17] = {};
+  getRaw(fp, 16);
+  const std::string recorded(fp, ok ? 16 : 0);
+
+  TrackCut tmp;
+  tmp.fselectSector = getB(); tmp.fDoFiducialCut = getB(); tmp.fDoDCFiducial = getB();
+  tmp.fDoECALFiducial = getB(); tmp.fdoSFCut = getB();
+  tmp.fSFpid = getI(); tmp.fSFmin = getF(); tmp.fSFminP = getF();
+  tmp.fPIDSystematics = getB(); tmp.fSFthreeSigmaFactor = getF();
+  tmp.fSector = getF(); tmp.fselectPID = getI(); tmp.fselectdetector = getI();
+  const size_t nSectors = getN();
+  for (size_t i = 0; ok && i < nSectors; ++i) tmp.fSectors.insert(getI());
+  for (float* v : {&tmp.fMinX, &tmp.fMaxX, &tmp.fMinY, &tmp.fMaxY, &tmp.fMinZ, &tmp.fMaxZ,
+                   &tmp.fMinCX, &tmp.fMaxCX, &tmp.fMinCY, &tmp.fMaxCY, &tmp.fMinCZ, &tmp.fMaxCZ,
+                   &tmp.fMinPath, &tmp.fMaxPath, &tmp.fDCMinEdge, &tmp.fDCMaxEdge, &tmp.fECALMinEdge, &tmp.fECALMaxEdge})
+    *v = getF();
+  const size_t nTheta = getN();
+  tmp.fThetaBins.resize(ok ? nTheta : 0);
+  for (auto& [lo, hi] : tmp.fThetaBins) { lo = getF(); hi = getF(); }
+
+  for (auto* table : {&tmp.fDCEdgeCutsPerPID, &tmp.fCVTEdgeCutsPerPID}) {
+    const size_t nPid = getN();
+    for (size_t ip = 0; ok && ip < nPid; ++ip) {
+      auto& vals = (*table)[getI()];
+      const size_t nVal = getN();
+      vals.resize(ok ? nVal : 0);
+      for (float& v : vals) v = getF();
+    }
+  }
+
+  for (auto* table : {&tmp.fFiducialCutsCVT, &tmp.fFiducialCutsCVT_Bhawani}) {
+    const size_t nPid = getN();
+    for (size_t ip = 0; ok && ip < nPid; ++ip) {
+      auto& byLayer = (*table)[getI()];
+      const size_t nLayer = getN();
+      for (size_t il = 0; ok && il < nLayer; ++il) {
+        auto& cut = byLayer[getI()];
+        getAxis(cut.thetaCut);
+        getAxis(cut.phiCut);
+      }
+    }
+  }
+
+  {
+    const size_t nPid = getN();
+    for (size_t ip = 0; ok && ip < nPid; ++ip) {
+      auto& byLayer = tmp.fFiducialCutsFTCal[getI()];
+      const size_t nLayer = getN();
+      for (size_t il = 0; ok && il < nLayer; ++il) {
+        auto& cut = byLayer[getI()];
+        const size_t nRing = getN();
+        cut.ringCut.excludedRanges.resize(ok ? nRing : 0);
+        for (auto& [x, y, rmin, rmax] : cut.ringCut.excludedRanges) {
+          x = getF(); y = getF(); rmin = getF(); rmax = getF();
+        }
+      }
+    }
+  }
+
+  getCut3DTable(tmp.fFiducialCutsPCal);
+  getCut3DTable(tmp.fFiducialCutsECin);
+  getCut3DTable(tmp.fFiducialCutsECout);
+
+  for (auto* table : {&tmp.fSFCutsMinCut, &tmp.fSFCutsMaxCut}) {
+    const size_t nPid = getN();
+    for (size_t ip = 0; ok && ip < nPid; ++ip) {
+      auto& bySector = (*table)[getI()];
+      const size_t nSec = getN();
+      for (size_t is = 0; ok && is < nSec; ++is) {
+        auto& abc = bySector[getI()];
+        abc.A0 = getF(); abc.Bm1 = getF(); abc.Cm2 = getF();
+      }
+    }
+  }
+
+  {
+    const size_t nPid = getN();
+    for (size_t ip = 0; ok && ip < nPid; ++ip) {
+      auto& byLayer = tmp.fMinECALEnergyCutPerPIDLayer[getI()];
+      const size_t nLayer = getN();
+      for (size_t il = 0; ok && il < nLayer; ++il) {
+        auto& e = byLayer[getI()];
+        e = getF();
+      }
+    }
+  }
+
+  if (!ok || o != b.size()) {
+    std::cerr << "[TrackCut] config snapshot " << path << " is truncated or corrupt, ignoring" << std::endl;
+    return false;
+  }
+  if (tmp.ConfigFingerprint() != recorded) {
+    std::cerr << "[TrackCut] config snapshot " << path << " fails fingerprint verification, ignoring" << std::endl;
+    return false;
+  }
+  *this = tmp;
+  std::cout << "[TrackCut] cut configuration restored from snapshot " << path << " (fingerprint " << recorded << ")" << std::endl;
+  return true;
+}
@@ -1,13 +1,18 @@
 #ifndef TRACKCUT_H_
 #define TRACKCUT_H_
 
+#include <algorithm>
+#include <array>
 #include <functional>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
 #include <TMath.h>
 
+#include "../Math/PDGTable.h"
+
 struct FiducialAxisCut {
   std::vector<std::pair<float, float>> excludedRanges;  // e.g., {{100, 120}, {240, 260}}
   std::set<float> excludedStrips;                       // e.g., {128.0, 256.0}
@@ -25,6 +30,17 @@ struct SFCutABC {
   float Cm2;
 };
 
+// All per-particle fiducial pass masks produced by one traversal of the
+// trajectory / calorimeter / forward-tagger banks (see RECAllFiducialMasks).
+// Each vector has REC_Particle_num entries, 1 = pass, 0 = fail.
+struct FiducialPassMasks {
+  std::vector<int> nofidPass;    // REC_Track_pass_nofid (fiducial cuts not applied)
+  std::vector<int> trajPass;     // REC_Traj_pass_fid (DC + CVT edge/range cuts)
+  std::vector<int> caloPass;     // REC_Calorimeter_pass_fid (ECAL fiducial + SF cuts)
+  std::vector<int> ftPass;       // REC_ForwardTagger_pass_fid (FTCal ring cuts)
+  std::vector<int> trackFidPass; // AND of the fiducial masks above
+};
+
 class TrackCut {
  public:
   TrackCut();
@@ -85,6 +101,36 @@ class TrackCut {
                                  const int& REC_Particle_num)>
   RECCalorimeterPass() const;
 
+  // Fused fiducial kernel — walks the RECTraj, RECCalorimeter and
+  // RECForwardTagger banks once per event and emits every pass mask that
+  // used to require four independent Defines (nofid, traj, calo, FT) plus
+  // the LogicalAND2 combinations.  withFT=false skips the FT contribution
+  // in trackFidPass (the FT columns are still consumed but ignored).
+  std::function<FiducialPassMasks(const std::vector<int16_t>&,  // traj pindex
+                                  const std::vector<int16_t>&,  // traj detector
+                                  const std::vector<int16_t>&,  // traj layer
+                                  const std::vector<float>&,    // traj x
+                                  const std::vector<float>&,    // traj y
+                                  const std::vector<float>&,    // traj z
+                                  const std::vector<float>&,    // traj edge
+                                  const std::vector<int16_t>&,  // calo pindex
+                                  const std::vector<int16_t>&,  // calo detector
+                                  const std::vector<int16_t>&,  // calo sector
+                                  const std::vector<int16_t>&,  // calo layer
+                                  const std::vector<float>&,    // calo energy
+                                  const std::vector<float>&,    // calo lu
+                                  const std::vector<float>&,    // calo lv
+                                  const std::vector<float>&,    // calo lw
+                                  const std::vector<short>&,    // ft pindex
+                                  const std::vector<int16_t>&,  // ft detector
+                                  const std::vector<int16_t>&,  // ft layer
+                                  const std::vector<float>&,    // ft x
+                                  const std::vector<float>&,    // ft y
+                                  const std::vector<int>&,      // pid
+                                  const std::vector<float>&,    // p
+                                  const int& REC_Particle_num)>
+  RECAllFiducialMasks(bool withFT) const;
+
   // Forward Tagger filter — ForFiducialCut() columns only
   std::function<std::vector<int>(const std::vector<short>&,    // pindex
                                  const std::vector<int16_t>&,  // detector
@@ -162,7 +208,23 @@ void SetSamplingFractionSystematics(bool enabled, float threeSigmaFactor) {
   fSFthreeSigmaFactor = threeSigmaFactor;
 }
 
+// 64-bit FNV-1a hash over the complete cut configuration (every scalar knob,
+// edge-cut table, fiducial range and SF parabola), as a fixed-width hex
+// string.  Two TrackCuts with the same fingerprint produce identical pass
+// masks, which is what keys the derived-column reuse in reprocess mode.
+std::string ConfigFingerprint() const;
 
+// Binary snapshot of the complete cut configuration.  SaveConfigSnapshot
+// serializes every knob the fingerprint covers into one versioned blob with
+// the fingerprint embedded; LoadConfigSnapshot reads the whole file in one
+// pass, rebuilds the configuration, and accepts it only if the fingerprint
+// recomputed from the restored state matches the recorded one.  Shard jobs
+// that load the same snapshot are therefore guaranteed to run bit-identical
+// cuts, and a driver can call LoadConfigSnapshot first and skip the
+// imperative setter replay entirely.  Load returns false (object untouched)
+// on a missing, truncated or version-mismatched file.
+bool SaveConfigSnapshot(const std::string& path) const;
+bool LoadConfigSnapshot(const std::string& path);
 
  private:
   bool fselectSector = false;
@@ -200,6 +262,105 @@ void SetSamplingFractionSystematics(bool enabled, float threeSigmaFactor) {
     FiducialRingCut ringCut;
   };
 
+  // Compiled form of FiducialAxisCut: the excluded ranges are sorted and
+  // merged once when the flat tables are built, so the per-hit membership
+  // test is a bounding-box reject plus one binary search instead of a
+  // linear scan over every registered range.
+  struct CompiledAxisCut {
+    std::vector<float> starts;  // sorted and disjoint after merging
+    std::vector<float> ends;    // ends[k] pairs with starts[k], both inclusive
+    float lo = 0, hi = -1;      // bounding box; an empty cut has lo > hi
+    bool Excludes(float value) const {
+      if (!(value >= lo && value <= hi)) return false;
+      const size_t idx = std::upper_bound(starts.begin(), starts.end(), value) - starts.begin();
+      return idx > 0 && value <= ends[idx - 1];
+    }
+  };
+
+  struct CompiledCut3D {
+    CompiledAxisCut lu, lv, lw;
+    bool any = false;  // a cut is registered for this sector
+  };
+
+  struct CompiledCut2D_CVT {
+    CompiledAxisCut theta, phi;
+  };
+
+  // Ring cuts with the squared radii precomputed.
+  struct CompiledRingCut {
+    std::vector<float> x0, y0, rmin2, rmax2;
+    bool Excludes(float x, float y) const {
+      for (size_t k = 0; k < x0.size(); ++k) {
+        const float d2 = (x0[k] - x) * (x0[k] - x) + (y0[k] - y) * (y0[k] - y);
+        if (d2 >= rmin2[k] && d2 <= rmax2[k]) return true;
+      }
+      return false;
+    }
+  };
+
+  // Flat PID-indexed snapshot of the cut configuration.  The per-hit
+  // pid-keyed std::map::find calls in the fiducial hot loop become a linear
+  // probe over a handful of PIDs plus direct array indexing by sector, and
+  // the excluded ranges are interval-compiled (sorted/merged, binary-search
+  // membership).  The table is fully self-contained (the SF parabolas are
+  // stored by value, not as pointers into the owning TrackCut), so one
+  // immutable instance can be shared by every variant copy and every slot.
+  struct FlatPIDCuts {
+    bool hasDCEdge = false;
+    std::array<float, 3> dcEdge{};   // DC edge cut per region 1..3
+    bool hasCVTEdge = false;
+    std::array<float, 5> cvtEdge{};  // CVT edge cut per region 1..5
+    bool hasCvtFid = false;
+    std::map<int, CompiledCut2D_CVT> cvtFid;  // keyed by layer
+    bool hasFtFid = false;
+    std::map<int, CompiledRingCut> ftFid;     // keyed by layer
+    std::array<CompiledCut3D, 7> pcal{};      // indexed by sector 1..6
+    std::array<CompiledCut3D, 7> ecin{};
+    std::array<CompiledCut3D, 7> ecout{};
+    std::array<SFCutABC, 7> sfMin{};
+    std::array<SFCutABC, 7> sfMax{};
+    std::array<bool, 7> hasSFMin{};
+    std::array<bool, 7> hasSFMax{};
+    // Minimum deposited energy per ECAL layer group (SetMinECALEnergyCut),
+    // slot 0 = PCal (layer 1), 1 = ECin (4), 2 = ECout (7); <= 0 = no cut.
+    bool hasMinLayerE = false;
+    std::array<float, 3> minLayerE{};
+  };
+  struct FlatCutTables {
+    std::vector<int> pids;
+    std::vector<FlatPIDCuts> cuts;
+    // Dense fast path keyed by the shared PDG compact index (filled by
+    // BuildFlatCutTables once the cuts vector stops reallocating): known
+    // species resolve with one array load, the linear probe remains only
+    // for PIDs outside the PDG table.  Entries store slot+1, 0 = no cuts.
+    std::array<short, PDG::kNSpecies> byCompact{};
+    const FlatPIDCuts* Find(int pid) const {
+      const int idx = PDG::CompactIndex(pid);
+      if (idx >= 0) {
+        const short s = byCompact[idx];
+        return s > 0 ? &cuts[s - 1] : nullptr;
+      }
+      for (size_t s = 0; s < pids.size(); ++s)
+        if (pids[s] == pid) return &cuts[s];
+      return nullptr;
+    }
+  };
+  FlatCutTables BuildFlatCutTables() const;
+  static CompiledAxisCut CompileAxis(const FiducialAxisCut& cut);
+  static CompiledCut3D CompileCut3D(const FiducialCut3D& cut);
+
+  // Shared immutable compiled configuration.  Built lazily on first use and
+  // cached; the copy constructor hands the cached pointer to the new object,
+  // so the fiducial-toggle variants (no-fid / with-fid) created per analysis
+  // are thin views over one read-only table instead of each compiling their
+  // own.  The toggles themselves (fDoFiducialCut, fDoDCFiducial,
+  // fDoECALFiducial, SF runtime knobs) are read from `this` in the kernels
+  // and do not enter the table, so flipping them keeps the share.  Setters
+  // that feed the table invalidate the cache.
+  std::shared_ptr<const FlatCutTables> CompiledTables() const;
+  void InvalidateCompiledTables() { fCompiledTables.reset(); }
+  mutable std::shared_ptr<const FlatCutTables> fCompiledTables;
+
   float fSector = -1;
   int fselectPID = -1;
   int fselectdetector = 1000;
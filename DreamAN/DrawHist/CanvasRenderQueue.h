@@ -0,0 +1,97 @@
+#ifndef CANVASRENDERQUEUE_H
+#define CANVASRENDERQUEUE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <TCanvas.h>
+#include <TROOT.h>
+
+// Background canvas renderer.
+//
+// The comparer's Plot* methods used to SaveAs every canvas inline, so a full
+// comparison session spent most of its wall time after the data passes in
+// ROOT's PDF/PNG writers.  CanvasRenderQueue takes ownership of a finished
+// canvas and writes it from a background thread while the caller moves on to
+// the next computation.
+//
+// A single worker drains the queue: ROOT's graphics globals (gPad, gStyle)
+// and the TPDF engine are not safe to drive from several threads, so the
+// win here is overlapping rendering with the analysis, not parallelizing
+// the rendering itself.  Flush() blocks until every queued canvas is on
+// disk; the destructor flushes too, so scoping the queue is enough.
+class CanvasRenderQueue {
+ public:
+  CanvasRenderQueue() = default;
+  ~CanvasRenderQueue() { Flush(); }
+
+  CanvasRenderQueue(const CanvasRenderQueue&) = delete;
+  CanvasRenderQueue& operator=(const CanvasRenderQueue&) = delete;
+
+  /// Queue \p canvas for writing to \p outputPath.  The queue owns the
+  /// canvas from here on; the caller must not touch it again.
+  void Enqueue(std::unique_ptr<TCanvas> canvas, std::string outputPath) {
+    {
+      std::lock_guard<std::mutex> lock(fMutex);
+      fJobs.push_back({std::move(canvas), std::move(outputPath)});
+      if (!fWorker.joinable()) {
+        fStop = false;
+        fWorker = std::thread(&CanvasRenderQueue::WorkerLoop, this);
+      }
+    }
+    fCond.notify_one();
+  }
+
+  /// Block until every queued canvas has been written.
+  void Flush() {
+    {
+      std::lock_guard<std::mutex> lock(fMutex);
+      if (!fWorker.joinable()) return;
+      fStop = true;
+    }
+    fCond.notify_one();
+    fWorker.join();
+  }
+
+  /// Number of canvases written so far.
+  std::size_t Rendered() const { return fRendered.load(); }
+
+ private:
+  struct Job {
+    std::unique_ptr<TCanvas> canvas;
+    std::string path;
+  };
+
+  void WorkerLoop() {
+    ROOT::EnableThreadSafety();
+    while (true) {
+      Job job;
+      {
+        std::unique_lock<std::mutex> lock(fMutex);
+        fCond.wait(lock, [this] { return !fJobs.empty() || fStop; });
+        if (fJobs.empty()) break;  // fStop with an empty queue
+        job = std::move(fJobs.front());
+        fJobs.pop_front();
+      }
+      job.canvas->SaveAs(job.path.c_str());
+      job.canvas.reset();
+      ++fRendered;
+    }
+  }
+
+  std::mutex fMutex;
+  std::condition_variable fCond;
+  std::deque<Job> fJobs;
+  std::thread fWorker;
+  bool fStop = false;
+  std::atomic<std::size_t> fRendered{0};
+};
+
+#endif  // CANVASRENDERQUEUE_H
@@ -0,0 +1,156 @@
+#ifndef DISANA_EXCLUSIVITY_SPARSE_H
+#define DISANA_EXCLUSIVITY_SPARSE_H
+
+#include <TH1D.h>
+#include <THnSparse.h>
+
+#include <ROOT/RDataFrame.hxx>
+#include <ROOT/RVec.hxx>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Single-pass sparse accumulation for the detector-case exclusivity plots.
+//
+// The comparer used to build one filtered branch and one histogram per
+// detector case x exclusivity variable x t-bin x sample, so the pi0
+// background study JIT-compiled dozens of filter strings and the graph grew
+// to hundreds of nodes.  This accumulator folds the whole grid into one
+// THnSparseD with four axes
+//
+//   (detector case, variable index, value, t-bin)
+//
+// filled in a single pass over each data source; every 1D comparison
+// histogram the plot functions need is an axis-2 projection taken offline.
+// The value axis is stored in per-variable normalised units (0..1 across
+// that variable's plot range), so variables with different ranges share one
+// axis; Projection() maps the bins back to real units.  Occupied-bin
+// fraction is tiny — a handful of detector cases and t-bins against 100
+// value bins — so the sparse store stays small.
+class DISANAExclusivitySparse {
+ public:
+  static constexpr int kValueBins = 100;
+
+  // varRanges lists (xmin, xmax) per variable, in the same order the packed
+  // column carries the values.  tEdges with fewer than two entries disables
+  // t binning (everything lands in one t slot).
+  DISANAExclusivitySparse(std::size_t nCases,
+                          const std::vector<std::pair<double, double>>& varRanges,
+                          std::vector<double> tEdges = {})
+      : fNCases(nCases), fRanges(varRanges), fTEdges(std::move(tEdges)) {
+    const Int_t nTBins = fTEdges.size() >= 2 ? static_cast<Int_t>(fTEdges.size()) - 1 : 1;
+    const Int_t nVars = static_cast<Int_t>(fRanges.size());
+    const Int_t bins[4] = {static_cast<Int_t>(nCases), nVars, kValueBins, nTBins};
+    const Double_t mins[4] = {0.0, 0.0, 0.0, 0.0};
+    const Double_t maxs[4] = {static_cast<Double_t>(nCases), static_cast<Double_t>(nVars), 1.0,
+                              static_cast<Double_t>(nTBins)};
+    fSparse = std::make_unique<THnSparseD>("disana_excl_sparse", "exclusivity accumulation", 4,
+                                           bins, mins, maxs);
+    fSparse->Sumw2();
+  }
+
+  // Aggregate copies the seed once per slot, so the sparse store must clone.
+  DISANAExclusivitySparse(const DISANAExclusivitySparse& other)
+      : fNCases(other.fNCases), fRanges(other.fRanges), fTEdges(other.fTEdges) {
+    fSparse.reset(static_cast<THnSparseD*>(other.fSparse->Clone()));
+  }
+  DISANAExclusivitySparse(DISANAExclusivitySparse&&) = default;
+  DISANAExclusivitySparse& operator=(DISANAExclusivitySparse&&) = default;
+
+  // One event, from the packed column layout BookExclusivitySparse defines:
+  // [case flags (nCases)] [t] [variable values (nVars)].  Values outside a
+  // variable's plot range are dropped, as the bounded histograms dropped
+  // them into under/overflow before.
+  void Fill(const ROOT::RVecD& packed) {
+    Int_t tBin = 0;
+    if (fTEdges.size() >= 2) {
+      const double t = packed[fNCases];
+      if (t < fTEdges.front() || t >= fTEdges.back()) return;
+      tBin = static_cast<Int_t>(std::upper_bound(fTEdges.begin(), fTEdges.end(), t) -
+                                fTEdges.begin()) - 1;
+    }
+    for (std::size_t c = 0; c < fNCases; ++c) {
+      if (packed[c] == 0.0) continue;
+      for (std::size_t v = 0; v < fRanges.size(); ++v) {
+        const double value = packed[fNCases + 1 + v];
+        const auto& [xmin, xmax] = fRanges[v];
+        const double u = (value - xmin) / (xmax - xmin);
+        if (!(u >= 0.0 && u < 1.0)) continue;
+        const Double_t x[4] = {c + 0.5, v + 0.5, u, tBin + 0.5};
+        fSparse->Fill(x);
+      }
+    }
+  }
+
+  void Merge(const DISANAExclusivitySparse& other) { fSparse->Add(other.fSparse.get()); }
+
+  // 1D histogram of one variable for one detector case, in real units.
+  // tBin = -1 integrates over all t slots.  The caller owns the result.
+  TH1D* Projection(std::size_t caseIndex, std::size_t varIndex, int tBin,
+                   const std::string& name, const std::string& title = "") const {
+    fSparse->GetAxis(0)->SetRange(static_cast<Int_t>(caseIndex) + 1,
+                                  static_cast<Int_t>(caseIndex) + 1);
+    fSparse->GetAxis(1)->SetRange(static_cast<Int_t>(varIndex) + 1,
+                                  static_cast<Int_t>(varIndex) + 1);
+    if (tBin >= 0)
+      fSparse->GetAxis(3)->SetRange(tBin + 1, tBin + 1);
+    else
+      fSparse->GetAxis(3)->SetRange(0, 0);
+
+    std::unique_ptr<TH1D> raw(fSparse->Projection(2));
+    const auto& [xmin, xmax] = fRanges[varIndex];
+    TH1D* h = new TH1D(name.c_str(), title.c_str(), kValueBins, xmin, xmax);
+    h->SetDirectory(nullptr);
+    for (Int_t b = 1; b <= kValueBins; ++b) {
+      h->SetBinContent(b, raw->GetBinContent(b));
+      h->SetBinError(b, raw->GetBinError(b));
+    }
+    fSparse->GetAxis(0)->SetRange(0, 0);
+    fSparse->GetAxis(1)->SetRange(0, 0);
+    fSparse->GetAxis(3)->SetRange(0, 0);
+    return h;
+  }
+
+  double Entries() const { return fSparse->GetEntries(); }
+
+ private:
+  std::size_t fNCases = 0;
+  std::vector<std::pair<double, double>> fRanges;
+  std::vector<double> fTEdges;
+  std::unique_ptr<THnSparseD> fSparse;
+};
+
+// Lazy single-node booking: the detector-case expressions, t and the
+// variable values are packed into one compiled RVec column so the whole
+// grid costs the graph one Define and one Aggregate, and the per-slot
+// accumulators merge when the result is read (same pattern as
+// BookQuantileSketch).  caseExpressions are the detectorCuts filter strings;
+// passing empty tEdges books without t binning.
+inline ROOT::RDF::RResultPtr<DISANAExclusivitySparse> BookExclusivitySparse(
+    ROOT::RDF::RNode df, const std::vector<std::string>& caseExpressions,
+    const std::vector<std::string>& varColumns,
+    const std::vector<std::pair<double, double>>& varRanges,
+    const std::vector<double>& tEdges = {}) {
+  std::string packed = "ROOT::RVecD{";
+  for (const auto& expr : caseExpressions) packed += "static_cast<double>(" + expr + "), ";
+  packed += tEdges.size() >= 2 ? "static_cast<double>(t), " : "0.0, ";
+  for (const auto& col : varColumns) packed += "static_cast<double>(" + col + "), ";
+  packed += "}";
+
+  static std::atomic<unsigned int> uid{0};
+  const std::string packedName = "disana_excl_packed_" + std::to_string(uid++);
+  auto dfPacked = df.Define(packedName, packed);
+  return dfPacked.Aggregate(
+      [](DISANAExclusivitySparse& acc, const ROOT::RVecD& values) { acc.Fill(values); },
+      [](std::vector<DISANAExclusivitySparse>& accs) {
+        for (std::size_t i = 1; i < accs.size(); ++i) accs.front().Merge(accs[i]);
+      },
+      packedName, DISANAExclusivitySparse(caseExpressions.size(), varRanges, tEdges));
+}
+
+#endif  // DISANA_EXCLUSIVITY_SPARSE_H
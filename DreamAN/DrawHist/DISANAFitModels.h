@@ -0,0 +1,214 @@
+// DISANAFitModels.h
+#pragma once
+
+// Compiled fit models for the standard signal+background shapes used across
+// the phi analysis.  The formula-string TF1s ("gaus(0)+pol3(3)", the
+// threshold-exp + Gaussian total) are interpreted by TFormula at every
+// evaluation point of every Minuit iteration; with hundreds of per-bin fits
+// that interpretation dominates the fit time.  The models here are plain
+// compiled C++ with analytic parameter derivatives, so Minuit2 gets exact
+// gradients and converges in fewer iterations.
+//
+// Each model comes in two flavours sharing one evaluation function:
+//   * a ROOT::Math::IParametricGradFunctionOneDim implementation that
+//     FitHistogramCompiled() hands to ROOT::Fit::Fitter (analytic gradient);
+//   * a Make...TF1() factory wrapping the same evaluation in a compiled
+//     lambda, for drawing and for carrying the fitted parameters around.
+// No TFormula is involved in either flavour.
+
+// ROOT
+#include <TF1.h>
+#include <TH1.h>
+
+#include <Fit/BinData.h>
+#include <Fit/Fitter.h>
+#include <HFitInterface.h>
+#include <Math/IParamFunction.h>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace DISANA {
+namespace FitModels {
+
+// 1/sqrt(2*pi), as spelled in the original formula strings ("0.398942")
+static constexpr double kGausNorm = 0.398942;
+// K+K- threshold offset used by the phi background shape
+static constexpr double kPhiThreshold = 0.9874;
+
+// -------------------------------------------------------------------------------------
+// phi mass total: threshold-power-exponential background + bin-width-scaled
+// Gaussian yield term.  Parameters (identical to the old formula string):
+//   [0]=A  [1]=alpha  [2]=lambda  [3]=Nsig  [4]=mu  [5]=sigma
+//   f(x) = A*(x-thr)^alpha * exp(-lambda*(x-thr))
+//        + Nsig*0.398942*bw * exp(-0.5*((x-mu)/sigma)^2) / |sigma|
+// -------------------------------------------------------------------------------------
+inline double PhiMassTotalEval(double x, const double* p, double bw) {
+  const double d = x - kPhiThreshold;
+  double bkg = 0.0;
+  if (d > 0.0) bkg = p[0] * std::pow(d, p[1]) * std::exp(-p[2] * d);
+  const double z = (x - p[4]) / p[5];
+  const double sig = p[3] * kGausNorm * bw * std::exp(-0.5 * z * z) / std::fabs(p[5]);
+  return bkg + sig;
+}
+
+inline double PhiMassTotalDeriv(double x, const double* p, unsigned int ipar, double bw) {
+  const double d = x - kPhiThreshold;
+  const double z = (x - p[4]) / p[5];
+  const double gaus = kGausNorm * bw * std::exp(-0.5 * z * z) / std::fabs(p[5]);
+  switch (ipar) {
+    case 0: return (d > 0.0) ? std::pow(d, p[1]) * std::exp(-p[2] * d) : 0.0;
+    case 1: return (d > 0.0) ? p[0] * std::pow(d, p[1]) * std::exp(-p[2] * d) * std::log(d) : 0.0;
+    case 2: return (d > 0.0) ? -p[0] * std::pow(d, p[1]) * std::exp(-p[2] * d) * d : 0.0;
+    case 3: return gaus;
+    case 4: return p[3] * gaus * z / p[5];
+    // d/dsigma of exp(-z^2/2)/|sigma| = (z^2 - 1)/sigma * (same), any sign of sigma
+    case 5: return p[3] * gaus * (z * z - 1.0) / p[5];
+    default: return 0.0;
+  }
+}
+
+class PhiMassTotalModel : public ROOT::Math::IParametricGradFunctionOneDim {
+ public:
+  explicit PhiMassTotalModel(double binWidth) : fBw(binWidth) {}
+
+  unsigned int NPar() const override { return 6; }
+  const double* Parameters() const override { return fPars; }
+  void SetParameters(const double* p) override { std::copy(p, p + 6, fPars); }
+  ROOT::Math::IBaseFunctionOneDim* Clone() const override { return new PhiMassTotalModel(*this); }
+
+ private:
+  double DoEvalPar(double x, const double* p) const override { return PhiMassTotalEval(x, p, fBw); }
+  double DoParameterDerivative(double x, const double* p, unsigned int ipar) const override {
+    return PhiMassTotalDeriv(x, p, ipar, fBw);
+  }
+
+  double fPars[6] = {0, 0, 0, 0, 0, 0};
+  double fBw;
+};
+
+// background term alone, same [0]=A [1]=alpha [2]=lambda convention
+inline double PhiMassBkgEval(double x, const double* p) {
+  const double d = x - kPhiThreshold;
+  return (d > 0.0) ? p[0] * std::pow(d, p[1]) * std::exp(-p[2] * d) : 0.0;
+}
+
+// Gaussian yield term alone: [0]=Nsig [1]=mu [2]=sigma
+inline double PhiMassSignalEval(double x, const double* p, double bw) {
+  const double z = (x - p[1]) / p[2];
+  return p[0] * kGausNorm * bw * std::exp(-0.5 * z * z) / std::fabs(p[2]);
+}
+
+// -------------------------------------------------------------------------------------
+// gaus(0)+pol3(3): Gaussian peak on a cubic background (kaon missing mass).
+// Parameters: [0]=A [1]=mu [2]=sigma [3..6]=p0..p3
+// -------------------------------------------------------------------------------------
+inline double GausPlusPoly3Eval(double x, const double* p) {
+  const double z = (x - p[1]) / p[2];
+  return p[0] * std::exp(-0.5 * z * z) + p[3] + x * (p[4] + x * (p[5] + x * p[6]));
+}
+
+inline double GausPlusPoly3Deriv(double x, const double* p, unsigned int ipar) {
+  const double z = (x - p[1]) / p[2];
+  const double g = std::exp(-0.5 * z * z);
+  switch (ipar) {
+    case 0: return g;
+    case 1: return p[0] * g * z / p[2];
+    case 2: return p[0] * g * z * z / p[2];
+    case 3: return 1.0;
+    case 4: return x;
+    case 5: return x * x;
+    case 6: return x * x * x;
+    default: return 0.0;
+  }
+}
+
+class GausPlusPoly3Model : public ROOT::Math::IParametricGradFunctionOneDim {
+ public:
+  unsigned int NPar() const override { return 7; }
+  const double* Parameters() const override { return fPars; }
+  void SetParameters(const double* p) override { std::copy(p, p + 7, fPars); }
+  ROOT::Math::IBaseFunctionOneDim* Clone() const override { return new GausPlusPoly3Model(*this); }
+
+ private:
+  double DoEvalPar(double x, const double* p) const override { return GausPlusPoly3Eval(x, p); }
+  double DoParameterDerivative(double x, const double* p, unsigned int ipar) const override {
+    return GausPlusPoly3Deriv(x, p, ipar);
+  }
+
+  double fPars[7] = {0, 0, 0, 0, 0, 0, 0};
+};
+
+// -------------------------------------------------------------------------------------
+// TF1 factories — compiled lambdas, no TFormula.  The lambda is copied into
+// the TF1, so the returned object is self-contained.
+// -------------------------------------------------------------------------------------
+inline TF1* MakePhiMassTotalTF1(const std::string& name, double bw, double xmin, double xmax) {
+  auto fn = [bw](double* x, double* p) { return PhiMassTotalEval(x[0], p, bw); };
+  return new TF1(name.c_str(), fn, xmin, xmax, 6);
+}
+
+inline TF1* MakePhiMassBkgTF1(const std::string& name, double xmin, double xmax) {
+  auto fn = [](double* x, double* p) { return PhiMassBkgEval(x[0], p); };
+  return new TF1(name.c_str(), fn, xmin, xmax, 3);
+}
+
+inline TF1* MakePhiMassSignalTF1(const std::string& name, double bw, double xmin, double xmax) {
+  auto fn = [bw](double* x, double* p) { return PhiMassSignalEval(x[0], p, bw); };
+  return new TF1(name.c_str(), fn, xmin, xmax, 3);
+}
+
+inline TF1* MakeGausPlusPoly3TF1(const std::string& name, double xmin, double xmax) {
+  auto fn = [](double* x, double* p) { return GausPlusPoly3Eval(x[0], p); };
+  return new TF1(name.c_str(), fn, xmin, xmax, 7);
+}
+
+// -------------------------------------------------------------------------------------
+// Binned fit driver.  Seeds parameters, limits and names from the TF1,
+// hands the gradient model to ROOT::Fit::Fitter (Minuit2/Migrad with exact
+// derivatives), then writes the fitted parameters, errors and chi2/ndf back
+// into the TF1 so callers keep using the TF1 exactly as before.  One Fitter
+// (and one Minuit2 instance) per call, so this is safe from worker threads.
+// Returns false when there is no data in range or the fit did not converge.
+// -------------------------------------------------------------------------------------
+inline bool FitHistogramCompiled(TH1* h, TF1* f,
+                                 ROOT::Math::IParametricGradFunctionOneDim& model,
+                                 bool useLikelihood = false) {
+  if (!h || !f) return false;
+
+  ROOT::Fit::DataOptions opt;
+  ROOT::Fit::DataRange range(f->GetXmin(), f->GetXmax());
+  ROOT::Fit::BinData data(opt, range);
+  ROOT::Fit::FillData(data, h);
+  if (data.Size() == 0) return false;
+
+  const int npar = f->GetNpar();
+  std::vector<double> p0(npar);
+  f->GetParameters(p0.data());
+
+  ROOT::Fit::Fitter fitter;
+  fitter.SetFunction(model);  // gradient overload → analytic derivatives
+  fitter.Config().SetParamsSettings(npar, p0.data());
+  for (int i = 0; i < npar; ++i) {
+    fitter.Config().ParSettings(i).SetName(f->GetParName(i));
+    double lo = 0.0, hi = 0.0;
+    f->GetParLimits(i, lo, hi);
+    if (lo < hi) fitter.Config().ParSettings(i).SetLimits(lo, hi);
+  }
+  fitter.Config().SetMinimizer("Minuit2", "Migrad");
+
+  const bool ok = useLikelihood ? fitter.LikelihoodFit(data) : fitter.Fit(data);
+
+  const auto& res = fitter.Result();
+  f->SetParameters(res.GetParams());
+  if (res.GetErrors()) f->SetParErrors(res.GetErrors());
+  f->SetChisquare(res.Chi2());
+  f->SetNDF(static_cast<int>(res.Ndf()));
+  return ok;
+}
+
+}  // namespace FitModels
+}  // namespace DISANA
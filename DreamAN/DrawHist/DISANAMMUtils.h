@@ -1,11 +1,18 @@
+#include <algorithm>
 #include <cmath>
+#include <functional>
 #include <memory>
+#include <sstream>
+
+#include <ROOT/RDFHelpers.hxx>  // RunGraphs for the one-pass skim train
 
 #include "DISANAMath.h"  // <-- REQUIRED: provides DISANAMath class & methods
 #include "DISANAMathFitUtils.h"
 #include "TF1.h"
+#include "TFile.h"
 #include "TH1D.h"
 #include "TLorentzVector.h"
+#include "TNamed.h"
 
 using ROOT::VecOps::RVec;
 // --- constants for masses
@@ -180,6 +187,26 @@ ROOT::RDF::RNode define_DISCAT(ROOT::RDF::RNode node, const std::string& name, c
                      {"recel_p", "recel_theta", "recel_phi", "recpro_p", "recpro_theta", "recpro_phi", "reckMinus_p", "reckMinus_theta", "reckMinus_phi", "reckPlus_p",
                       "reckPlus_theta", "reckPlus_phi"});
 }
+// Columnar path: one Define evaluates the plain-double batch kernel (see
+// disana_kin in DISANAMath.h) and every kinematic column is then a cheap
+// member read from the shared "DISCAT" struct, instead of rebuilding all
+// four-vectors and boosts once per quantity.
+ROOT::RDF::RNode define_DISCAT_struct(ROOT::RDF::RNode node, float beam_energy) {
+  if (node.HasColumn("DISCAT")) return node;
+  return node.Define("DISCAT",
+                     [beam_energy](double recel_p, double recel_theta, double recel_phi, double recpro_p, double recpro_theta, double recpro_phi, double reckMinus_p,
+                                   double reckMinus_theta, double reckMinus_phi, double reckPlus_p, double reckPlus_theta, double reckPlus_phi) {
+                       return disana_kin::ComputePhiKinematics(beam_energy, recel_p, recel_theta, recel_phi, recpro_p, recpro_theta, recpro_phi, reckMinus_p, reckMinus_theta,
+                                                               reckMinus_phi, reckPlus_p, reckPlus_theta, reckPlus_phi);
+                     },
+                     {"recel_p", "recel_theta", "recel_phi", "recpro_p", "recpro_theta", "recpro_phi", "reckMinus_p", "reckMinus_theta", "reckMinus_phi", "reckPlus_p",
+                      "reckPlus_theta", "reckPlus_phi"});
+}
+
+ROOT::RDF::RNode define_DISCAT(ROOT::RDF::RNode node, const std::string& name, double disana_kin::PhiKin::*field, float beam_energy) {
+  node = define_DISCAT_struct(node, beam_energy);
+  return node.Define(name, [field](const disana_kin::PhiKin& kin) { return kin.*field; }, {"DISCAT"});
+}
 // -----------------------------------------------------------------------------
 // InitKinematics_MissingKm : K⁻ omitted (exclusive K⁺ channel)
 // -----------------------------------------------------------------------------
@@ -489,39 +516,39 @@ ROOT::RDF::RNode InitKinematics_MissingKm(const std::string& filename_, const st
                      {"pro_px", "pro_py", "pro_pz", "kPlus_px", "kPlus_py", "kPlus_pz"});
   // φ mass built from missing K+ and measured K-
   // DISANAMath-driven observables
-  *df_ = define_DISCAT(*df_, "Q2", &DISANAMath::GetQ2, beam_energy);
-  *df_ = define_DISCAT(*df_, "xB", &DISANAMath::GetxB, beam_energy);
-  *df_ = define_DISCAT(*df_, "t", &DISANAMath::GetT, beam_energy);
-  *df_ = define_DISCAT(*df_, "tmin", &DISANAMath::GetTmin, beam_energy);
+  *df_ = define_DISCAT(*df_, "Q2", &disana_kin::PhiKin::Q2, beam_energy);
+  *df_ = define_DISCAT(*df_, "xB", &disana_kin::PhiKin::xB, beam_energy);
+  *df_ = define_DISCAT(*df_, "t", &disana_kin::PhiKin::t, beam_energy);
+  *df_ = define_DISCAT(*df_, "tmin", &disana_kin::PhiKin::tmin, beam_energy);
   *df_ = df_->Define("mtprime",  // non-negative: this is what you’ll plot
                      [](double mt, double tmin) { return std::abs(mt + tmin); }, {"t", "tmin"})
              .Define("tprime",  // optional signed t' ≤ 0
                      [](double mtp) { return -mtp; }, {"mtprime"});
-  *df_ = define_DISCAT(*df_, "phi", &DISANAMath::GetPhi, beam_energy);
-  *df_ = define_DISCAT(*df_, "W", &DISANAMath::GetW, beam_energy);
-  *df_ = define_DISCAT(*df_, "nu", &DISANAMath::GetNu, beam_energy);
-  *df_ = define_DISCAT(*df_, "y", &DISANAMath::Gety, beam_energy);
-  *df_ = define_DISCAT(*df_, "cos_thetaKK", &DISANAMath::GetCosTheta_KK, beam_energy);
-  *df_ = define_DISCAT(*df_, "cos_phiKK", &DISANAMath::GetCosPhi_KK, beam_energy);
-
-  *df_ = define_DISCAT(*df_, "Mx2_ep", &DISANAMath::GetMx2_ep, beam_energy);
-  *df_ = define_DISCAT(*df_, "Emiss", &DISANAMath::GetEmiss, beam_energy);
-  *df_ = define_DISCAT(*df_, "PTmiss", &DISANAMath::GetPTmiss, beam_energy);
-  *df_ = define_DISCAT(*df_, "Mx2_epKpKm", &DISANAMath::GetMx2_epKpKm, beam_energy);
-  *df_ = define_DISCAT(*df_, "Mx2_eKpKm", &DISANAMath::GetMx2_eKpKm, beam_energy);
-  *df_ = define_DISCAT(*df_, "Mx2_epKm", &DISANAMath::GetMx2_epKm, beam_energy);
-  *df_ = define_DISCAT(*df_, "Mx2_epKp", &DISANAMath::GetMx2_epKp, beam_energy);
-  *df_ = define_DISCAT(*df_, "Mx2_eKp", &DISANAMath::GetMx2_eKp, beam_energy);
-  *df_ = define_DISCAT(*df_, "Mx_eKp", &DISANAMath::GetMx_eKp, beam_energy);
-  *df_ = define_DISCAT(*df_, "DeltaPhi", &DISANAMath::GetDeltaPhi, beam_energy);
-  *df_ = define_DISCAT(*df_, "Theta_g_phimeson", &DISANAMath::GetTheta_g_phimeson, beam_energy);
-  *df_ = define_DISCAT(*df_, "Theta_e_phimeson", &DISANAMath::GetTheta_e_phimeson, beam_energy);
-  *df_ = define_DISCAT(*df_, "DeltaE", &DISANAMath::GetDeltaE, beam_energy);
-  *df_ = define_DISCAT(*df_, "Cone_p", &DISANAMath::GetCone_p, beam_energy);
-  *df_ = define_DISCAT(*df_, "Cone_Kp", &DISANAMath::GetCone_Kp, beam_energy);
-  *df_ = define_DISCAT(*df_, "Cone_Km", &DISANAMath::GetCone_Km, beam_energy);
-  *df_ = define_DISCAT(*df_, "z_phi", &DISANAMath::GetZ_phi, beam_energy);
-  *df_ = define_DISCAT(*df_, "Coplanarity_had_normals_deg", &DISANAMath::GetCoplanarity_had_normals_deg, beam_energy);
+  *df_ = define_DISCAT(*df_, "phi", &disana_kin::PhiKin::phi, beam_energy);
+  *df_ = define_DISCAT(*df_, "W", &disana_kin::PhiKin::W, beam_energy);
+  *df_ = define_DISCAT(*df_, "nu", &disana_kin::PhiKin::nu, beam_energy);
+  *df_ = define_DISCAT(*df_, "y", &disana_kin::PhiKin::y, beam_energy);
+  *df_ = define_DISCAT(*df_, "cos_thetaKK", &disana_kin::PhiKin::cos_thetaKK, beam_energy);
+  *df_ = define_DISCAT(*df_, "cos_phiKK", &disana_kin::PhiKin::cos_phiKK, beam_energy);
+
+  *df_ = define_DISCAT(*df_, "Mx2_ep", &disana_kin::PhiKin::Mx2_ep, beam_energy);
+  *df_ = define_DISCAT(*df_, "Emiss", &disana_kin::PhiKin::Emiss, beam_energy);
+  *df_ = define_DISCAT(*df_, "PTmiss", &disana_kin::PhiKin::PTmiss, beam_energy);
+  *df_ = define_DISCAT(*df_, "Mx2_epKpKm", &disana_kin::PhiKin::Mx2_epKpKm, beam_energy);
+  *df_ = define_DISCAT(*df_, "Mx2_eKpKm", &disana_kin::PhiKin::Mx2_eKpKm, beam_energy);
+  *df_ = define_DISCAT(*df_, "Mx2_epKm", &disana_kin::PhiKin::Mx2_epKm, beam_energy);
+  *df_ = define_DISCAT(*df_, "Mx2_epKp", &disana_kin::PhiKin::Mx2_epKp, beam_energy);
+  *df_ = define_DISCAT(*df_, "Mx2_eKp", &disana_kin::PhiKin::Mx2_eKp, beam_energy);
+  *df_ = define_DISCAT(*df_, "Mx_eKp", &disana_kin::PhiKin::Mx_eKp, beam_energy);
+  *df_ = define_DISCAT(*df_, "DeltaPhi", &disana_kin::PhiKin::DeltaPhi, beam_energy);
+  *df_ = define_DISCAT(*df_, "Theta_g_phimeson", &disana_kin::PhiKin::Theta_g_phimeson, beam_energy);
+  *df_ = define_DISCAT(*df_, "Theta_e_phimeson", &disana_kin::PhiKin::Theta_e_phimeson, beam_energy);
+  *df_ = define_DISCAT(*df_, "DeltaE", &disana_kin::PhiKin::DeltaE, beam_energy);
+  *df_ = define_DISCAT(*df_, "Cone_p", &disana_kin::PhiKin::Cone_p, beam_energy);
+  *df_ = define_DISCAT(*df_, "Cone_Kp", &disana_kin::PhiKin::Cone_Kp, beam_energy);
+  *df_ = define_DISCAT(*df_, "Cone_Km", &disana_kin::PhiKin::Cone_Km, beam_energy);
+  *df_ = define_DISCAT(*df_, "z_phi", &disana_kin::PhiKin::z_phi, beam_energy);
+  *df_ = define_DISCAT(*df_, "Coplanarity_had_normals_deg", &disana_kin::PhiKin::Coplanarity_had_normals_deg, beam_energy);
   *df_ = df_->Define("Gamma_v", [beam_energy](double Q2, double W) {
                  return HandGammaV(beam_energy, Q2, W);
                }, {"Q2", "W"});
@@ -848,39 +875,39 @@ ROOT::RDF::RNode InitKinematics_MissingKp(const std::string& filename_, const st
                      {"pro_px", "pro_py", "pro_pz", "kPlus_miss_px", "kPlus_miss_py", "kPlus_miss_pz"});
   // φ mass built from missing K+ and measured K-
   // DISANAMath-driven observables
-  *df_ = define_DISCAT(*df_, "Q2", &DISANAMath::GetQ2, beam_energy);
-  *df_ = define_DISCAT(*df_, "xB", &DISANAMath::GetxB, beam_energy);
-  *df_ = define_DISCAT(*df_, "t", &DISANAMath::GetT, beam_energy);
-  *df_ = define_DISCAT(*df_, "tmin", &DISANAMath::GetTmin, beam_energy);
+  *df_ = define_DISCAT(*df_, "Q2", &disana_kin::PhiKin::Q2, beam_energy);
+  *df_ = define_DISCAT(*df_, "xB", &disana_kin::PhiKin::xB, beam_energy);
+  *df_ = define_DISCAT(*df_, "t", &disana_kin::PhiKin::t, beam_energy);
+  *df_ = define_DISCAT(*df_, "tmin", &disana_kin::PhiKin::tmin, beam_energy);
   *df_ = df_->Define("mtprime",  // non-negative: this is what you’ll plot
                      [](double mt, double tmin) { return std::abs(mt + tmin); }, {"t", "tmin"})
              .Define("tprime",  // optional signed t' ≤ 0
                      [](double mtp) { return -mtp; }, {"mtprime"});
-  *df_ = define_DISCAT(*df_, "phi", &DISANAMath::GetPhi, beam_energy);
-  *df_ = define_DISCAT(*df_, "W", &DISANAMath::GetW, beam_energy);
-  *df_ = define_DISCAT(*df_, "nu", &DISANAMath::GetNu, beam_energy);
-  *df_ = define_DISCAT(*df_, "y", &DISANAMath::Gety, beam_energy);
-  *df_ = define_DISCAT(*df_, "cos_thetaKK", &DISANAMath::GetCosTheta_KK, beam_energy);
-  *df_ = define_DISCAT(*df_, "cos_phiKK", &DISANAMath::GetCosPhi_KK, beam_energy);
-
-  *df_ = define_DISCAT(*df_, "Mx2_ep", &DISANAMath::GetMx2_ep, beam_energy);
-  *df_ = define_DISCAT(*df_, "Emiss", &DISANAMath::GetEmiss, beam_energy);
-  *df_ = define_DISCAT(*df_, "PTmiss", &DISANAMath::GetPTmiss, beam_energy);
-  *df_ = define_DISCAT(*df_, "Mx2_epKpKm", &DISANAMath::GetMx2_epKpKm, beam_energy);
-  *df_ = define_DISCAT(*df_, "Mx2_eKpKm", &DISANAMath::GetMx2_eKpKm, beam_energy);
-  *df_ = define_DISCAT(*df_, "Mx2_epKm", &DISANAMath::GetMx2_epKm, beam_energy);
-  *df_ = define_DISCAT(*df_, "Mx2_epKp", &DISANAMath::GetMx2_epKp, beam_energy);
-  *df_ = define_DISCAT(*df_, "Mx2_eKp", &DISANAMath::GetMx2_eKp, beam_energy);
-  *df_ = define_DISCAT(*df_, "Mx_eKp", &DISANAMath::GetMx_eKp, beam_energy);
-  *df_ = define_DISCAT(*df_, "DeltaPhi", &DISANAMath::GetDeltaPhi, beam_energy);
-  *df_ = define_DISCAT(*df_, "Theta_g_phimeson", &DISANAMath::GetTheta_g_phimeson, beam_energy);
-  *df_ = define_DISCAT(*df_, "Theta_e_phimeson", &DISANAMath::GetTheta_e_phimeson, beam_energy);
-  *df_ = define_DISCAT(*df_, "DeltaE", &DISANAMath::GetDeltaE, beam_energy);
-  *df_ = define_DISCAT(*df_, "Cone_p", &DISANAMath::GetCone_p, beam_energy);
-  *df_ = define_DISCAT(*df_, "Cone_Kp", &DISANAMath::GetCone_Kp, beam_energy);
-  *df_ = define_DISCAT(*df_, "Cone_Km", &DISANAMath::GetCone_Km, beam_energy);
-  *df_ = define_DISCAT(*df_, "z_phi", &DISANAMath::GetZ_phi, beam_energy);
-  *df_ = define_DISCAT(*df_, "Coplanarity_had_normals_deg", &DISANAMath::GetCoplanarity_had_normals_deg, beam_energy);
+  *df_ = define_DISCAT(*df_, "phi", &disana_kin::PhiKin::phi, beam_energy);
+  *df_ = define_DISCAT(*df_, "W", &disana_kin::PhiKin::W, beam_energy);
+  *df_ = define_DISCAT(*df_, "nu", &disana_kin::PhiKin::nu, beam_energy);
+  *df_ = define_DISCAT(*df_, "y", &disana_kin::PhiKin::y, beam_energy);
+  *df_ = define_DISCAT(*df_, "cos_thetaKK", &disana_kin::PhiKin::cos_thetaKK, beam_energy);
+  *df_ = define_DISCAT(*df_, "cos_phiKK", &disana_kin::PhiKin::cos_phiKK, beam_energy);
+
+  *df_ = define_DISCAT(*df_, "Mx2_ep", &disana_kin::PhiKin::Mx2_ep, beam_energy);
+  *df_ = define_DISCAT(*df_, "Emiss", &disana_kin::PhiKin::Emiss, beam_energy);
+  *df_ = define_DISCAT(*df_, "PTmiss", &disana_kin::PhiKin::PTmiss, beam_energy);
+  *df_ = define_DISCAT(*df_, "Mx2_epKpKm", &disana_kin::PhiKin::Mx2_epKpKm, beam_energy);
+  *df_ = define_DISCAT(*df_, "Mx2_eKpKm", &disana_kin::PhiKin::Mx2_eKpKm, beam_energy);
+  *df_ = define_DISCAT(*df_, "Mx2_epKm", &disana_kin::PhiKin::Mx2_epKm, beam_energy);
+  *df_ = define_DISCAT(*df_, "Mx2_epKp", &disana_kin::PhiKin::Mx2_epKp, beam_energy);
+  *df_ = define_DISCAT(*df_, "Mx2_eKp", &disana_kin::PhiKin::Mx2_eKp, beam_energy);
+  *df_ = define_DISCAT(*df_, "Mx_eKp", &disana_kin::PhiKin::Mx_eKp, beam_energy);
+  *df_ = define_DISCAT(*df_, "DeltaPhi", &disana_kin::PhiKin::DeltaPhi, beam_energy);
+  *df_ = define_DISCAT(*df_, "Theta_g_phimeson", &disana_kin::PhiKin::Theta_g_phimeson, beam_energy);
+  *df_ = define_DISCAT(*df_, "Theta_e_phimeson", &disana_kin::PhiKin::Theta_e_phimeson, beam_energy);
+  *df_ = define_DISCAT(*df_, "DeltaE", &disana_kin::PhiKin::DeltaE, beam_energy);
+  *df_ = define_DISCAT(*df_, "Cone_p", &disana_kin::PhiKin::Cone_p, beam_energy);
+  *df_ = define_DISCAT(*df_, "Cone_Kp", &disana_kin::PhiKin::Cone_Kp, beam_energy);
+  *df_ = define_DISCAT(*df_, "Cone_Km", &disana_kin::PhiKin::Cone_Km, beam_energy);
+  *df_ = define_DISCAT(*df_, "z_phi", &disana_kin::PhiKin::z_phi, beam_energy);
+  *df_ = define_DISCAT(*df_, "Coplanarity_had_normals_deg", &disana_kin::PhiKin::Coplanarity_had_normals_deg, beam_energy);
   *df_ = df_->Define("Gamma_v", [beam_energy](double Q2, double W) {
                  return HandGammaV(beam_energy, Q2, W);
                }, {"Q2", "W"});
@@ -899,6 +926,195 @@ ROOT::RDF::RNode InitKinematics_MissingKp(const std::string& filename_, const st
 }
 
 // =============================================================================
+// ---------------------------------------------------------------------------
+// BinnedStats — streaming per-bin statistics for chosen kinematic columns
+//
+// One ForeachSlot pass over the dataframe fills Welford accumulators per bin
+// of a binning column: event count, mean and variance of every tracked
+// column plus the covariance of every column pair.  Downstream consumers
+// (CSV export, bin-centering, radiative corrections) read the precomputed
+// moments instead of booking their own per-bin Mean() actions or re-scanning
+// the data per binning scheme.  Write/ReadBinnedStats persist the moments as
+// a text blob next to the cached histograms.
+// ---------------------------------------------------------------------------
+struct BinnedStats {
+  struct Bin {
+    long long n = 0;
+    std::vector<double> mean;   // per tracked column
+    std::vector<double> m2;     // sum of squared deviations (variance * (n-1))
+    std::vector<double> comom;  // pairwise co-moments, strict upper triangle
+  };
+  std::vector<std::string> vars;
+  std::vector<double> edges;  // bin edges on the binning column, [lo, hi)
+  std::vector<Bin> bins;
+
+  int VarIndex(const std::string& v) const {
+    for (size_t i = 0; i < vars.size(); ++i)
+      if (vars[i] == v) return static_cast<int>(i);
+    return -1;
+  }
+  static size_t PairIndex(size_t i, size_t j, size_t nv) {
+    if (i > j) std::swap(i, j);
+    return i * nv - i * (i + 1) / 2 + (j - i - 1);
+  }
+  double Mean(size_t bin, const std::string& v) const {
+    const int i = VarIndex(v);
+    return (i < 0 || bin >= bins.size()) ? std::numeric_limits<double>::quiet_NaN() : bins[bin].mean[i];
+  }
+  double Variance(size_t bin, const std::string& v) const {
+    const int i = VarIndex(v);
+    if (i < 0 || bin >= bins.size() || bins[bin].n < 2) return std::numeric_limits<double>::quiet_NaN();
+    return bins[bin].m2[i] / (bins[bin].n - 1);
+  }
+  double Covariance(size_t bin, const std::string& a, const std::string& b) const {
+    const int i = VarIndex(a), j = VarIndex(b);
+    if (i < 0 || j < 0 || bin >= bins.size() || bins[bin].n < 2) return std::numeric_limits<double>::quiet_NaN();
+    if (i == j) return Variance(bin, a);
+    return bins[bin].comom[PairIndex(i, j, vars.size())] / (bins[bin].n - 1);
+  }
+};
+
+// One-pass fill.  Tracks up to four double columns (enough for the kinematic
+// summaries here); the binning column and every tracked column must be
+// doubles, as the define_DISCAT outputs are.  Under IMT each slot owns its
+// accumulators and the slots are combined with the parallel Welford merge.
+inline BinnedStats ComputeBinnedStats(ROOT::RDF::RNode df, const std::string& binVar,
+                                      const std::vector<double>& edges,
+                                      const std::vector<std::string>& vars) {
+  BinnedStats out;
+  out.vars = vars;
+  out.edges = edges;
+  const int nBins = static_cast<int>(edges.size()) - 1;
+  const size_t nv = vars.size();
+  if (nBins <= 0 || nv == 0 || nv > 4) {
+    if (nv > 4) std::cerr << "[ComputeBinnedStats] at most 4 tracked columns supported\n";
+    return out;
+  }
+  const size_t nPairs = nv * (nv - 1) / 2;
+  BinnedStats::Bin empty;
+  empty.mean.assign(nv, 0.0);
+  empty.m2.assign(nv, 0.0);
+  empty.comom.assign(nPairs, 0.0);
+  out.bins.assign(nBins, empty);
+
+  const unsigned int nSlots = std::max(1u, df.GetNSlots());
+  std::vector<std::vector<BinnedStats::Bin>> acc(nSlots, out.bins);
+
+  auto update = [&edges, nv, nPairs](std::vector<BinnedStats::Bin>& slotBins, double bval, const double* x) {
+    // [lo, hi) binning, matching the per-bin Filter convention used here
+    if (bval < edges.front() || bval >= edges.back()) return;
+    const size_t ib = std::upper_bound(edges.begin(), edges.end(), bval) - edges.begin() - 1;
+    BinnedStats::Bin& bin = slotBins[ib];
+    ++bin.n;
+    double delta[4];
+    for (size_t i = 0; i < nv; ++i) {
+      delta[i] = x[i] - bin.mean[i];
+      bin.mean[i] += delta[i] / bin.n;
+      bin.m2[i] += delta[i] * (x[i] - bin.mean[i]);
+    }
+    for (size_t i = 0; i < nv; ++i)
+      for (size_t j = i + 1; j < nv; ++j)
+        bin.comom[BinnedStats::PairIndex(i, j, nv)] += delta[i] * (x[j] - bin.mean[j]);
+    (void)nPairs;
+  };
+
+  switch (nv) {
+    case 1:
+      df.ForeachSlot([&](unsigned int s, double b, double x0) { const double x[1] = {x0}; update(acc[s], b, x); },
+                     {binVar, vars[0]});
+      break;
+    case 2:
+      df.ForeachSlot([&](unsigned int s, double b, double x0, double x1) { const double x[2] = {x0, x1}; update(acc[s], b, x); },
+                     {binVar, vars[0], vars[1]});
+      break;
+    case 3:
+      df.ForeachSlot([&](unsigned int s, double b, double x0, double x1, double x2) { const double x[3] = {x0, x1, x2}; update(acc[s], b, x); },
+                     {binVar, vars[0], vars[1], vars[2]});
+      break;
+    default:
+      df.ForeachSlot([&](unsigned int s, double b, double x0, double x1, double x2, double x3) { const double x[4] = {x0, x1, x2, x3}; update(acc[s], b, x); },
+                     {binVar, vars[0], vars[1], vars[2], vars[3]});
+      break;
+  }
+
+  // Parallel Welford combine of the per-slot accumulators.
+  for (const auto& slotBins : acc) {
+    for (int ib = 0; ib < nBins; ++ib) {
+      const BinnedStats::Bin& src = slotBins[ib];
+      if (src.n == 0) continue;
+      BinnedStats::Bin& dst = out.bins[ib];
+      if (dst.n == 0) {
+        dst = src;
+        continue;
+      }
+      const double nA = static_cast<double>(dst.n), nB = static_cast<double>(src.n);
+      const double nAB = nA + nB;
+      double delta[4];
+      for (size_t i = 0; i < nv; ++i) delta[i] = src.mean[i] - dst.mean[i];
+      for (size_t i = 0; i < nv; ++i) {
+        dst.m2[i] += src.m2[i] + delta[i] * delta[i] * nA * nB / nAB;
+        for (size_t j = i + 1; j < nv; ++j) {
+          const size_t p = BinnedStats::PairIndex(i, j, nv);
+          dst.comom[p] += src.comom[p] + delta[i] * delta[j] * nA * nB / nAB;
+        }
+        dst.mean[i] += delta[i] * nB / nAB;
+      }
+      dst.n += src.n;
+    }
+  }
+  return out;
+}
+
+// Persist / restore the moments next to the cached histograms (TNamed text
+// blob, full double precision), so a cached plotting session serves the CSV
+// export and bin-centering without touching the data again.
+inline void WriteBinnedStats(TFile& f, const std::string& key, const BinnedStats& s) {
+  std::ostringstream os;
+  os.precision(17);
+  os << s.vars.size();
+  for (const auto& v : s.vars) os << ' ' << v;
+  os << '\n' << s.edges.size();
+  for (double e : s.edges) os << ' ' << e;
+  os << '\n';
+  for (const auto& b : s.bins) {
+    os << b.n;
+    for (double v : b.mean) os << ' ' << v;
+    for (double v : b.m2) os << ' ' << v;
+    for (double v : b.comom) os << ' ' << v;
+    os << '\n';
+  }
+  f.cd();
+  TNamed(key.c_str(), os.str().c_str()).Write(nullptr, TObject::kOverwrite);
+}
+
+inline BinnedStats ReadBinnedStats(TFile& f, const std::string& key) {
+  BinnedStats s;
+  auto* blob = dynamic_cast<TNamed*>(f.Get(key.c_str()));
+  if (!blob) return s;  // empty vars signals a cache miss
+  std::istringstream is(blob->GetTitle());
+  size_t nv = 0, ne = 0;
+  is >> nv;
+  s.vars.resize(nv);
+  for (auto& v : s.vars) is >> v;
+  is >> ne;
+  s.edges.resize(ne);
+  for (auto& e : s.edges) is >> e;
+  const size_t nPairs = nv * (nv - 1) / 2;
+  const size_t nBins = ne > 1 ? ne - 1 : 0;
+  s.bins.resize(nBins);
+  for (auto& b : s.bins) {
+    is >> b.n;
+    b.mean.resize(nv);
+    b.m2.resize(nv);
+    b.comom.resize(nPairs);
+    for (auto& v : b.mean) is >> v;
+    for (auto& v : b.m2) is >> v;
+    for (auto& v : b.comom) is >> v;
+  }
+  if (!is) s = BinnedStats{};  // truncated blob — treat as a miss
+  return s;
+}
+
 // ---------------------------------------------------------------------------
 // Q2BinMeans  — holds the per-Q^2-bin mean kinematics computed from data
 // ---------------------------------------------------------------------------
@@ -910,8 +1126,8 @@ struct Q2BinMeans {
 // ---------------------------------------------------------------------------
 // ComputeMeanKinPerQ2Bin
 //
-// Books Mean("xB") and Mean("Q2") for every Q^2 bin in a single pass over
-// the RDataFrame (all lazy actions are registered before any result is read).
+// One streaming pass over the RDataFrame fills a Welford accumulator per Q^2
+// bin (ComputeBinnedStats) instead of booking 2*nBins Filter+Mean actions.
 // Bins with no entries receive fallback values (xB=0.1, Q2=bin centre).
 // ---------------------------------------------------------------------------
 inline Q2BinMeans ComputeMeanKinPerQ2Bin(ROOT::RDF::RNode df,
@@ -921,26 +1137,13 @@ inline Q2BinMeans ComputeMeanKinPerQ2Bin(ROOT::RDF::RNode df,
   Q2BinMeans out;
   if (nBins <= 0) return out;
 
-  // Book all lazy actions first — single event loop
-  std::vector<ROOT::RDF::RResultPtr<double>> meanXb, meanQ2;
-  meanXb.reserve(nBins);
-  meanQ2.reserve(nBins);
-  for (int iq = 0; iq < nBins; ++iq) {
-    const double lo = q2Bins[iq];
-    const double hi = q2Bins[iq + 1];
-    auto df_bin = df.Filter(
-      [lo, hi](double Q2){ return Q2 >= lo && Q2 < hi; }, {"Q2"},
-      Form("vmkin_q2bin_%d", iq));
-    meanXb.push_back(df_bin.Mean("xB"));
-    meanQ2.push_back(df_bin.Mean("Q2"));
-  }
+  const BinnedStats stats = ComputeBinnedStats(df, "Q2", q2Bins, {"xB", "Q2"});
 
-  // Retrieve (triggers the event loop once for all bins and both quantities)
   out.xB.resize(nBins);
   out.Q2.resize(nBins);
   for (int iq = 0; iq < nBins; ++iq) {
-    const double vxb = *meanXb[iq];
-    const double vq2 = *meanQ2[iq];
+    const double vxb = stats.Mean(iq, "xB");
+    const double vq2 = stats.Mean(iq, "Q2");
     const double q2_centre = 0.5 * (q2Bins[iq] + q2Bins[iq + 1]);
     out.xB[iq] = (std::isfinite(vxb) && vxb > 0.0) ? vxb : 0.1;
     out.Q2[iq] = (std::isfinite(vq2) && vq2 > 0.0) ? vq2 : q2_centre;
@@ -1572,43 +1775,39 @@ inline void PlotInvMassVsMissingMassProjections(
   gStyle->SetOptStat(0); gStyle->SetOptTitle(0);
   gStyle->SetFrameLineWidth(1);
 
-  // ── Book all histograms lazily (single event loop) ────────────────────────
+  // ── Book one 2D map; every 1D view is an offline projection ───────────────
+  // A single M(K+K-) vs MM(ep) histogram replaces the per-window filter
+  // branches: the X projection, the signal-window Y projection and the
+  // sideband Y projection are all slices of it, so the graph carries one
+  // booked node and re-windowing needs no further event loop.  The x axis
+  // is fineFactor times finer than the plotted binning so the window edges
+  // snap to within a fraction of a bin.
   static std::atomic<unsigned long> uidP{0};
   const unsigned long uid = uidP.fetch_add(1);
 
-  // X projection: full y range
-  auto hXR = df.Histo1D(
-      {Form("hProjKK_%lu", uid), "", nBinsX, xLo, xHi},
-      "invMass_KpKm");
-
-  // Y projection — signal window in M(K+K-)
-  auto df_sig = df.Filter(
-      [sigLo, sigHi](float m){ return m >= sigLo && m <= sigHi; },
-      {"invMass_KpKm"});
-  auto hYsigR = df_sig.Histo1D(
-      {Form("hProjMM_sig_%lu", uid), "", nBinsY, yLo, yHi},
-      "MM_ep");
-
-  // Y projection — sidebands (background control)
-  auto df_bkg = df.Filter(
-      [bkgLo1, bkgHi1, bkgLo2, bkgHi2](float m){
-        return (m >= bkgLo1 && m <= bkgHi1) ||
-               (m >= bkgLo2 && m <= bkgHi2);
-      }, {"invMass_KpKm"});
-  auto hYbkgR = df_bkg.Histo1D(
-      {Form("hProjMM_bkg_%lu", uid), "", nBinsY, yLo, yHi},
-      "MM_ep");
-
-  // Force evaluation
-  hXR.GetValue();
-
-  // Clone and detach from ROOT directory
-  TH1D* hX    = (TH1D*)hXR.GetPtr()   ->Clone(Form("cKK_%lu",     uid));
-  TH1D* hYsig = (TH1D*)hYsigR.GetPtr()->Clone(Form("cMMsig_%lu",  uid));
-  TH1D* hYbkg = (TH1D*)hYbkgR.GetPtr()->Clone(Form("cMMbkg_%lu",  uid));
+  constexpr int fineFactor = 6;
+  auto h2R = df.Histo2D(
+      {Form("hProjMap_%lu", uid), "", nBinsX * fineFactor, xLo, xHi, nBinsY, yLo, yHi},
+      "invMass_KpKm", "MM_ep");
+  TH2D* h2 = h2R.GetPtr();
+
+  TH1D* hX = h2->ProjectionX(Form("cKK_%lu", uid));
+  hX->Rebin(fineFactor);
   hX->SetDirectory(nullptr);
-  hYsig->SetDirectory(nullptr);
-  hYbkg->SetDirectory(nullptr);
+
+  TAxis* xAxis = h2->GetXaxis();
+  auto projectY = [&](double lo, double hi, const char* name) {
+    TH1D* h = h2->ProjectionY(name, xAxis->FindFixBin(lo), xAxis->FindFixBin(hi));
+    h->SetDirectory(nullptr);
+    return h;
+  };
+
+  TH1D* hYsig = projectY(sigLo, sigHi, Form("cMMsig_%lu", uid));
+  TH1D* hYbkg = projectY(bkgLo1, bkgHi1, Form("cMMbkg_%lu", uid));
+  {
+    std::unique_ptr<TH1D> hYbkgHigh(projectY(bkgLo2, bkgHi2, Form("cMMbkg_hi_%lu", uid)));
+    hYbkg->Add(hYbkgHigh.get());
+  }
 
   // Normalise to unit area
   if (hX   ->Integral() > 0) hX   ->Scale(1.0 / hX   ->Integral());
@@ -2468,41 +2667,41 @@ ROOT::RDF::RNode InitKinematics(const std::string& filename_, const std::string&
                      {"pro_px", "pro_py", "pro_pz", "kPlus_px", "kPlus_py", "kPlus_pz"});
 
   // DISANAMath-driven observables
-  *df_ = define_DISCAT(*df_, "Q2", &DISANAMath::GetQ2, beam_energy);
-  *df_ = define_DISCAT(*df_, "xB", &DISANAMath::GetxB, beam_energy);
-  *df_ = define_DISCAT(*df_, "t", &DISANAMath::GetT, beam_energy);
-  *df_ = define_DISCAT(*df_, "tmin", &DISANAMath::GetTmin, beam_energy);
+  *df_ = define_DISCAT(*df_, "Q2", &disana_kin::PhiKin::Q2, beam_energy);
+  *df_ = define_DISCAT(*df_, "xB", &disana_kin::PhiKin::xB, beam_energy);
+  *df_ = define_DISCAT(*df_, "t", &disana_kin::PhiKin::t, beam_energy);
+  *df_ = define_DISCAT(*df_, "tmin", &disana_kin::PhiKin::tmin, beam_energy);
 
   *df_ = df_->Define("mtprime",  // non-negative: this is what you’ll plot
                      [](double mt, double tmin) { return std::abs(mt + tmin); }, {"t", "tmin"})
              .Define("tprime",  // optional signed t' ≤ 0
                      [](double mtp) { return -mtp; }, {"mtprime"});
 
-  *df_ = define_DISCAT(*df_, "phi", &DISANAMath::GetPhi, beam_energy);
-  *df_ = define_DISCAT(*df_, "W", &DISANAMath::GetW, beam_energy);
-  *df_ = define_DISCAT(*df_, "nu", &DISANAMath::GetNu, beam_energy);
-  *df_ = define_DISCAT(*df_, "y", &DISANAMath::Gety, beam_energy);
-  *df_ = define_DISCAT(*df_, "cos_thetaKK", &DISANAMath::GetCosTheta_KK, beam_energy);
-  *df_ = define_DISCAT(*df_, "cos_phiKK", &DISANAMath::GetCosPhi_KK, beam_energy);
-
-  *df_ = define_DISCAT(*df_, "Mx2_ep", &DISANAMath::GetMx2_ep, beam_energy);
-  *df_ = define_DISCAT(*df_, "Emiss", &DISANAMath::GetEmiss, beam_energy);
-  *df_ = define_DISCAT(*df_, "PTmiss", &DISANAMath::GetPTmiss, beam_energy);
-  *df_ = define_DISCAT(*df_, "Mx2_epKpKm", &DISANAMath::GetMx2_epKpKm, beam_energy);
-  *df_ = define_DISCAT(*df_, "Mx2_eKpKm", &DISANAMath::GetMx2_eKpKm, beam_energy);
-  *df_ = define_DISCAT(*df_, "Mx2_epKm", &DISANAMath::GetMx2_epKm, beam_energy);
-  *df_ = define_DISCAT(*df_, "Mx2_epKp", &DISANAMath::GetMx2_epKp, beam_energy);
-  *df_ = define_DISCAT(*df_, "Mx2_eKp", &DISANAMath::GetMx2_eKp, beam_energy);
-  *df_ = define_DISCAT(*df_, "Mx_eKp", &DISANAMath::GetMx_eKp, beam_energy);
-  *df_ = define_DISCAT(*df_, "DeltaPhi", &DISANAMath::GetDeltaPhi, beam_energy);
-  *df_ = define_DISCAT(*df_, "Theta_g_phimeson", &DISANAMath::GetTheta_g_phimeson, beam_energy);
-  *df_ = define_DISCAT(*df_, "Theta_e_phimeson", &DISANAMath::GetTheta_e_phimeson, beam_energy);
-  *df_ = define_DISCAT(*df_, "DeltaE", &DISANAMath::GetDeltaE, beam_energy);
-  *df_ = define_DISCAT(*df_, "Cone_p", &DISANAMath::GetCone_p, beam_energy);
-  *df_ = define_DISCAT(*df_, "Cone_Kp", &DISANAMath::GetCone_Kp, beam_energy);
-  *df_ = define_DISCAT(*df_, "Cone_Km", &DISANAMath::GetCone_Km, beam_energy);
-  *df_ = define_DISCAT(*df_, "z_phi", &DISANAMath::GetZ_phi, beam_energy);
-  *df_ = define_DISCAT(*df_, "Coplanarity_had_normals_deg", &DISANAMath::GetCoplanarity_had_normals_deg, beam_energy);
+  *df_ = define_DISCAT(*df_, "phi", &disana_kin::PhiKin::phi, beam_energy);
+  *df_ = define_DISCAT(*df_, "W", &disana_kin::PhiKin::W, beam_energy);
+  *df_ = define_DISCAT(*df_, "nu", &disana_kin::PhiKin::nu, beam_energy);
+  *df_ = define_DISCAT(*df_, "y", &disana_kin::PhiKin::y, beam_energy);
+  *df_ = define_DISCAT(*df_, "cos_thetaKK", &disana_kin::PhiKin::cos_thetaKK, beam_energy);
+  *df_ = define_DISCAT(*df_, "cos_phiKK", &disana_kin::PhiKin::cos_phiKK, beam_energy);
+
+  *df_ = define_DISCAT(*df_, "Mx2_ep", &disana_kin::PhiKin::Mx2_ep, beam_energy);
+  *df_ = define_DISCAT(*df_, "Emiss", &disana_kin::PhiKin::Emiss, beam_energy);
+  *df_ = define_DISCAT(*df_, "PTmiss", &disana_kin::PhiKin::PTmiss, beam_energy);
+  *df_ = define_DISCAT(*df_, "Mx2_epKpKm", &disana_kin::PhiKin::Mx2_epKpKm, beam_energy);
+  *df_ = define_DISCAT(*df_, "Mx2_eKpKm", &disana_kin::PhiKin::Mx2_eKpKm, beam_energy);
+  *df_ = define_DISCAT(*df_, "Mx2_epKm", &disana_kin::PhiKin::Mx2_epKm, beam_energy);
+  *df_ = define_DISCAT(*df_, "Mx2_epKp", &disana_kin::PhiKin::Mx2_epKp, beam_energy);
+  *df_ = define_DISCAT(*df_, "Mx2_eKp", &disana_kin::PhiKin::Mx2_eKp, beam_energy);
+  *df_ = define_DISCAT(*df_, "Mx_eKp", &disana_kin::PhiKin::Mx_eKp, beam_energy);
+  *df_ = define_DISCAT(*df_, "DeltaPhi", &disana_kin::PhiKin::DeltaPhi, beam_energy);
+  *df_ = define_DISCAT(*df_, "Theta_g_phimeson", &disana_kin::PhiKin::Theta_g_phimeson, beam_energy);
+  *df_ = define_DISCAT(*df_, "Theta_e_phimeson", &disana_kin::PhiKin::Theta_e_phimeson, beam_energy);
+  *df_ = define_DISCAT(*df_, "DeltaE", &disana_kin::PhiKin::DeltaE, beam_energy);
+  *df_ = define_DISCAT(*df_, "Cone_p", &disana_kin::PhiKin::Cone_p, beam_energy);
+  *df_ = define_DISCAT(*df_, "Cone_Kp", &disana_kin::PhiKin::Cone_Kp, beam_energy);
+  *df_ = define_DISCAT(*df_, "Cone_Km", &disana_kin::PhiKin::Cone_Km, beam_energy);
+  *df_ = define_DISCAT(*df_, "z_phi", &disana_kin::PhiKin::z_phi, beam_energy);
+  *df_ = define_DISCAT(*df_, "Coplanarity_had_normals_deg", &disana_kin::PhiKin::Coplanarity_had_normals_deg, beam_energy);
   *df_ = df_->Define("Gamma_v", [beam_energy](double Q2, double W) {
                  return HandGammaV(beam_energy, Q2, W);
                }, {"Q2", "W"});
@@ -2689,42 +2888,42 @@ df = df
             }, {"pro_px","pro_py","pro_pz","kPlus_px","kPlus_py","kPlus_pz"});
 
   // DISANAMath-driven observables
-  df = define_DISCAT(df, "Q2",  &DISANAMath::GetQ2,  beam_energy);
-  df = define_DISCAT(df, "xB",  &DISANAMath::GetxB,  beam_energy);
-  df = define_DISCAT(df, "t",   &DISANAMath::GetT,   beam_energy);
-  df = define_DISCAT(df, "tmin",&DISANAMath::GetTmin,beam_energy);
+  df = define_DISCAT(df, "Q2", &disana_kin::PhiKin::Q2, beam_energy);
+  df = define_DISCAT(df, "xB", &disana_kin::PhiKin::xB, beam_energy);
+  df = define_DISCAT(df, "t", &disana_kin::PhiKin::t, beam_energy);
+  df = define_DISCAT(df, "tmin", &disana_kin::PhiKin::tmin, beam_energy);
 
   df = df.Define("mtprime", [](double t, double tmin){ return std::abs(t + tmin); }, {"t","tmin"})
          .Define("tprime",  [](double mtp){ return -mtp; }, {"mtprime"});
 
-  df = define_DISCAT(df, "phi", &DISANAMath::GetPhi, beam_energy);
-  df = define_DISCAT(df, "W",   &DISANAMath::GetW,   beam_energy);
-  df = define_DISCAT(df, "nu",  &DISANAMath::GetNu,  beam_energy);
-  df = define_DISCAT(df, "y",   &DISANAMath::Gety,   beam_energy);
-
-  df = define_DISCAT(df, "cos_thetaKK", &DISANAMath::GetCosTheta_KK, beam_energy);
-  df = define_DISCAT(df, "cos_phiKK",   &DISANAMath::GetCosPhi_KK,   beam_energy);
-
-  df = define_DISCAT(df, "Mx2_ep",       &DISANAMath::GetMx2_ep,       beam_energy);
-  df = define_DISCAT(df, "Emiss",        &DISANAMath::GetEmiss,        beam_energy);
-  df = define_DISCAT(df, "PTmiss",       &DISANAMath::GetPTmiss,       beam_energy);
-  df = define_DISCAT(df, "Mx2_epKpKm",   &DISANAMath::GetMx2_epKpKm,   beam_energy);
-  df = define_DISCAT(df, "Mx2_eKpKm",    &DISANAMath::GetMx2_eKpKm,    beam_energy);
-  df = define_DISCAT(df, "Mx2_epKm",     &DISANAMath::GetMx2_epKm,     beam_energy);
-  df = define_DISCAT(df, "Mx2_epKp",     &DISANAMath::GetMx2_epKp,     beam_energy);
-  df = define_DISCAT(df, "Mx2_eKp",      &DISANAMath::GetMx2_eKp,      beam_energy);
-  df = define_DISCAT(df, "Mx_eKp",       &DISANAMath::GetMx_eKp,       beam_energy);
-
-  df = define_DISCAT(df, "DeltaPhi",                 &DISANAMath::GetDeltaPhi,                 beam_energy);
-  df = define_DISCAT(df, "Theta_g_phimeson",         &DISANAMath::GetTheta_g_phimeson,         beam_energy);
-  df = define_DISCAT(df, "Theta_e_phimeson",         &DISANAMath::GetTheta_e_phimeson,         beam_energy);
-  df = define_DISCAT(df, "DeltaE",                   &DISANAMath::GetDeltaE,                   beam_energy);
-  df = define_DISCAT(df, "Cone_p",                   &DISANAMath::GetCone_p,                   beam_energy);
-  df = define_DISCAT(df, "Cone_Kp",                  &DISANAMath::GetCone_Kp,                  beam_energy);
-  df = define_DISCAT(df, "Cone_Km",                  &DISANAMath::GetCone_Km,                  beam_energy);
-  df = define_DISCAT(df, "z_phi",                    &DISANAMath::GetZ_phi,                    beam_energy);
+  df = define_DISCAT(df, "phi", &disana_kin::PhiKin::phi, beam_energy);
+  df = define_DISCAT(df, "W", &disana_kin::PhiKin::W, beam_energy);
+  df = define_DISCAT(df, "nu", &disana_kin::PhiKin::nu, beam_energy);
+  df = define_DISCAT(df, "y", &disana_kin::PhiKin::y, beam_energy);
+
+  df = define_DISCAT(df, "cos_thetaKK", &disana_kin::PhiKin::cos_thetaKK, beam_energy);
+  df = define_DISCAT(df, "cos_phiKK", &disana_kin::PhiKin::cos_phiKK, beam_energy);
+
+  df = define_DISCAT(df, "Mx2_ep", &disana_kin::PhiKin::Mx2_ep, beam_energy);
+  df = define_DISCAT(df, "Emiss", &disana_kin::PhiKin::Emiss, beam_energy);
+  df = define_DISCAT(df, "PTmiss", &disana_kin::PhiKin::PTmiss, beam_energy);
+  df = define_DISCAT(df, "Mx2_epKpKm", &disana_kin::PhiKin::Mx2_epKpKm, beam_energy);
+  df = define_DISCAT(df, "Mx2_eKpKm", &disana_kin::PhiKin::Mx2_eKpKm, beam_energy);
+  df = define_DISCAT(df, "Mx2_epKm", &disana_kin::PhiKin::Mx2_epKm, beam_energy);
+  df = define_DISCAT(df, "Mx2_epKp", &disana_kin::PhiKin::Mx2_epKp, beam_energy);
+  df = define_DISCAT(df, "Mx2_eKp", &disana_kin::PhiKin::Mx2_eKp, beam_energy);
+  df = define_DISCAT(df, "Mx_eKp", &disana_kin::PhiKin::Mx_eKp, beam_energy);
+
+  df = define_DISCAT(df, "DeltaPhi", &disana_kin::PhiKin::DeltaPhi, beam_energy);
+  df = define_DISCAT(df, "Theta_g_phimeson", &disana_kin::PhiKin::Theta_g_phimeson, beam_energy);
+  df = define_DISCAT(df, "Theta_e_phimeson", &disana_kin::PhiKin::Theta_e_phimeson, beam_energy);
+  df = define_DISCAT(df, "DeltaE", &disana_kin::PhiKin::DeltaE, beam_energy);
+  df = define_DISCAT(df, "Cone_p", &disana_kin::PhiKin::Cone_p, beam_energy);
+  df = define_DISCAT(df, "Cone_Kp", &disana_kin::PhiKin::Cone_Kp, beam_energy);
+  df = define_DISCAT(df, "Cone_Km", &disana_kin::PhiKin::Cone_Km, beam_energy);
+  df = define_DISCAT(df, "z_phi", &disana_kin::PhiKin::z_phi, beam_energy);
   df = define_DISCAT(df, "Coplanarity_had_normals_deg",
-                     &DISANAMath::GetCoplanarity_had_normals_deg, beam_energy);
+                     &disana_kin::PhiKin::Coplanarity_had_normals_deg, beam_energy);
   df = df.Define("Gamma_v", [beam_energy](double Q2, double W) {
                  return HandGammaV(beam_energy, Q2, W);
                }, {"Q2", "W"});
@@ -2878,6 +3077,52 @@ ROOT::RDF::RNode GetSlim_exclusive(ROOT::RDF::RNode src, const std::string& f, c
     return WriteSlimAndReload_exclusive(src, f, t);
   }
 }
+
+// One named skim of the train: its physics selection (applied on top of the
+// shared dataframe; leave unset to keep every event), the exact columns to
+// persist and where to write them.
+struct SkimSpec {
+  std::string name;     // for logging
+  std::string outFile;
+  std::string outTree;
+  std::vector<std::string> keep;
+  std::function<ROOT::RDF::RNode(ROOT::RDF::RNode)> select;  // optional Filters/Defines
+};
+
+// One-pass skim train: every WriteSlimAndReload_* call above triggers its own
+// full event loop, so producing the exclusive, sideband and control skims
+// reads the selected file three times.  This writer books one lazy Snapshot
+// per declared skim against the same source node and drives them all with a
+// single RunGraphs pass — the shared upstream Defines are evaluated once per
+// event and each skim's writer only sees the events its selection keeps.
+// Returns one reloaded light dataframe per skim, in declaration order; skims
+// whose output file already exists are loaded instead of rewritten (same
+// convention as the GetSlim_* helpers).
+std::vector<ROOT::RDF::RNode> WriteSkimTrain(ROOT::RDF::RNode df, const std::vector<SkimSpec>& skims) {
+  std::vector<ROOT::RDF::RResultHandle> handles;
+  std::vector<bool> existed(skims.size(), false);
+  for (size_t i = 0; i < skims.size(); ++i) {
+    const SkimSpec& s = skims[i];
+    existed[i] = !gSystem->AccessPathName(s.outFile.c_str());
+    if (existed[i]) {
+      std::cout << "Skim \"" << s.name << "\": " << s.outFile << " exists, will load it." << std::endl;
+      continue;
+    }
+    ROOT::RDF::RNode node = s.select ? s.select(df) : df;
+    ROOT::RDF::RSnapshotOptions opts;
+    opts.fLazy = true;
+    handles.emplace_back(node.Snapshot(s.outTree, s.outFile, s.keep, opts));
+  }
+  if (!handles.empty()) {
+    std::cout << "Skim train: writing " << handles.size() << " skim(s) in one pass." << std::endl;
+    ROOT::RDF::RunGraphs(handles);
+  }
+
+  std::vector<ROOT::RDF::RNode> out;
+  out.reserve(skims.size());
+  for (const auto& s : skims) out.emplace_back(ROOT::RDataFrame(s.outTree, s.outFile));
+  return out;
+}
 //  Dump one line per event with 26 columns:
 //  1)  RunNumber
 //  2)  EventNumber
@@ -27,6 +27,8 @@
 #include <numeric>
 #include <stdexcept>
 
+#include "../Math/PDGTable.h"
+
 double NormalizeHCorrByMiddle(TH1* hCorr)
 {
     if (!hCorr) return 1.0;
@@ -61,13 +63,14 @@ double NormalizeHCorrByMiddle(TH1* hCorr)
 // Constants
 // -----------------------------------------------------------------------------
 constexpr double pi = 3.14159265358979323846;
-const double m_e = 0.000511;  // GeV
-// const double m_e = 0.0;       // GeV
-const double m_p = 0.938272;  // GeV
-// const double m_p = 0.938;       // GeV
-const double m_kMinus = 0.493677;  // GeV
-const double m_kPlus = 0.493677;   // GeV
-const double m_phi = 1.019461;     // GeV
+// Masses come from the shared constexpr table (Math/PDGTable.h), so the
+// kinematics here use exactly the numbers EventCut and the four-vector
+// builders select with.
+constexpr double m_e = PDG::Mass(11);       // GeV
+constexpr double m_p = PDG::Mass(2212);     // GeV
+constexpr double m_kMinus = PDG::Mass(-321);  // GeV
+constexpr double m_kPlus = PDG::Mass(321);    // GeV
+constexpr double m_phi = PDG::Mass(333);      // GeV
 
 struct EqualStatBinningResult {
   std::vector<double> q2Edges;      // x-axis (Q^2)
@@ -107,6 +110,216 @@ TLorentzVector Build4Vector(double p, double theta, double phi, double mass) {
 }
 }  // namespace
 
+// -----------------------------------------------------------------------------
+// Columnar batch kernel (plain-double kinematics)
+// -----------------------------------------------------------------------------
+// DISANAMath rebuilds every TLorentzVector and redoes the boosts for each
+// quantity when its getters are used one column at a time inside plotting
+// Defines.  The kernel below computes the full set of phi-channel observables
+// once per event with plain double px/py/pz/E arithmetic (no TLorentzVector,
+// no TMatrixD), so a single Define feeds all downstream columns and the
+// compiler is free to vectorize the straight-line math.
+namespace disana_kin {
+
+struct Vec3 {
+  double x{}, y{}, z{};
+};
+
+inline Vec3 operator+(const Vec3 &a, const Vec3 &b) { return {a.x + b.x, a.y + b.y, a.z + b.z}; }
+inline Vec3 operator-(const Vec3 &a) { return {-a.x, -a.y, -a.z}; }
+inline double Dot(const Vec3 &a, const Vec3 &b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+inline Vec3 Cross(const Vec3 &a, const Vec3 &b) {
+  return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+inline double Mag2(const Vec3 &a) { return Dot(a, a); }
+inline double Mag(const Vec3 &a) { return std::sqrt(Mag2(a)); }
+// Same convention as TVector3::Unit(): the null vector stays null.
+inline Vec3 Unit(const Vec3 &a) {
+  const double m2 = Mag2(a);
+  const double s = m2 > 0.0 ? 1.0 / std::sqrt(m2) : 1.0;
+  return {a.x * s, a.y * s, a.z * s};
+}
+// Same clamping as TVector3::Angle() (radians).
+inline double Angle(const Vec3 &a, const Vec3 &b) {
+  const double ptot2 = Mag2(a) * Mag2(b);
+  if (ptot2 <= 0.0) return 0.0;
+  double arg = Dot(a, b) / std::sqrt(ptot2);
+  arg = std::max(-1.0, std::min(1.0, arg));
+  return std::acos(arg);
+}
+
+struct Vec4 {
+  double px{}, py{}, pz{}, E{};
+  Vec3 Vect() const { return {px, py, pz}; }
+};
+
+inline Vec4 operator+(const Vec4 &a, const Vec4 &b) { return {a.px + b.px, a.py + b.py, a.pz + b.pz, a.E + b.E}; }
+inline Vec4 operator-(const Vec4 &a, const Vec4 &b) { return {a.px - b.px, a.py - b.py, a.pz - b.pz, a.E - b.E}; }
+inline double Mag2(const Vec4 &a) { return a.E * a.E - (a.px * a.px + a.py * a.py + a.pz * a.pz); }
+// Same sign convention as TLorentzVector::Mag() for spacelike vectors.
+inline double Mag(const Vec4 &a) {
+  const double m2 = Mag2(a);
+  return m2 < 0.0 ? -std::sqrt(-m2) : std::sqrt(m2);
+}
+inline double Dot(const Vec4 &a, const Vec4 &b) { return a.E * b.E - (a.px * b.px + a.py * b.py + a.pz * b.pz); }
+
+inline Vec4 FromPThetaPhi(double p, double theta, double phi, double mass) {
+  const double st = std::sin(theta);
+  return {p * st * std::cos(phi), p * st * std::sin(phi), p * std::cos(theta), std::sqrt(p * p + mass * mass)};
+}
+
+inline Vec3 BoostVector(const Vec4 &v) { return {v.px / v.E, v.py / v.E, v.pz / v.E}; }
+// Same algebra as TLorentzVector::Boost().
+inline Vec4 Boost(const Vec4 &v, const Vec3 &b) {
+  const double b2 = Mag2(b);
+  const double gamma = 1.0 / std::sqrt(1.0 - b2);
+  const double bp = b.x * v.px + b.y * v.py + b.z * v.pz;
+  const double gamma2 = b2 > 0.0 ? (gamma - 1.0) / b2 : 0.0;
+  return {v.px + gamma2 * bp * b.x + gamma * b.x * v.E,
+          v.py + gamma2 * bp * b.y + gamma * b.y * v.E,
+          v.pz + gamma2 * bp * b.z + gamma * b.z * v.E,
+          gamma * (v.E + bp)};
+}
+
+// Scalar twin of DISANAMath::ComputePhiH.
+inline double PhiH(const Vec3 &q1, const Vec3 &k1, const Vec3 &q2) {
+  const Vec3 t2 = Cross(q1, k1);
+  const Vec3 t3 = Cross(q1, q2);
+  const double t1 = Dot(t2, q2) / std::abs(Dot(t2, q2));
+  const double t4 = Dot(t2, t3) / (Mag(t2) * Mag(t3));
+  return t1 * std::acos(t4) * 180. / pi + 180.;
+}
+
+inline double Kallen(double x, double y, double z) { return std::max(0.0, x * x + y * y + z * z - 2.0 * (x * y + x * z + y * z)); }
+
+// Scalar twin of DISANAMath::tmin_phi_from_Q2_xB.
+inline double TminPhiFromQ2xB(double Q2, double xB) {
+  const double m_p2 = m_p * m_p;
+  const double m_phi2 = m_phi * m_phi;
+  const double s = m_p2 + Q2 * (1.0 / xB - 1.0);
+  const double m1sq = -Q2;
+  const double m2sq = m_p2;
+  const double m3sq = m_phi2;
+  const double m4sq = m_p2;
+  const double A = (s + m1sq - m2sq) * (s + m3sq - m4sq);
+  const double B = std::sqrt(Kallen(s, m1sq, m2sq)) * std::sqrt(Kallen(s, m3sq, m4sq));
+  return (m1sq + m3sq) - (A - B) / (2.0 * s);
+}
+
+// One field per downstream column; the names match the column names booked in
+// InitKinematics_* so define_DISCAT can read them by member pointer.
+struct PhiKin {
+  double Q2{}, xB{}, t{}, tmin{}, phi{}, W{}, nu{}, y{};
+  double cos_thetaKK{}, cos_phiKK{}, z_phi{};
+  double Mx2_ep{}, Emiss{}, PTmiss{}, Mx2_epKpKm{}, Mx2_eKpKm{}, Mx2_epKm{}, Mx2_epKp{}, Mx2_eKp{}, Mx_eKp{};
+  double DeltaPhi{}, Theta_g_phimeson{}, Theta_e_phimeson{}, DeltaE{};
+  double Cone_p{}, Cone_Kp{}, Cone_Km{};
+  double Coplanarity_had_normals_deg{};
+};
+
+// Scalar twin of the phi-channel DISANAMath::ComputeKinematics, evaluated once
+// per event.  Same argument order as the (e, p, K-, K+) DISANAMath ctor.
+inline PhiKin ComputePhiKinematics(double e_in_E, double e_out_p, double e_out_theta, double e_out_phi,
+                                   double p_out_p, double p_out_theta, double p_out_phi,
+                                   double kMinus_p, double kMinus_theta, double kMinus_phi,
+                                   double kPlus_p, double kPlus_theta, double kPlus_phi) {
+  const Vec4 e_in{0., 0., e_in_E, e_in_E};
+  const Vec4 e_out = FromPThetaPhi(e_out_p, e_out_theta, e_out_phi, m_e);
+  const Vec4 p_in{0., 0., 0., m_p};
+  const Vec4 p_out = FromPThetaPhi(p_out_p, p_out_theta, p_out_phi, m_p);
+  const Vec4 kMinus = FromPThetaPhi(kMinus_p, kMinus_theta, kMinus_phi, m_kMinus);
+  const Vec4 kPlus = FromPThetaPhi(kPlus_p, kPlus_theta, kPlus_phi, m_kPlus);
+
+  const Vec4 q = e_in - e_out;
+  const Vec4 phiM = kPlus + kMinus;
+
+  PhiKin k;
+  k.Q2 = -Mag2(q);
+  k.nu = q.E;
+  k.y = k.nu / e_in.E;
+  k.W = Mag(p_in + q);
+  k.xB = k.Q2 / (2.0 * Dot(p_in, q));
+  k.t = std::abs(Mag2(p_in - p_out));
+  k.tmin = TminPhiFromQ2xB(k.Q2, k.xB);
+  k.z_phi = 1.0 - k.t * k.xB / k.Q2;
+
+  const Vec3 nL = Unit(Cross(e_in.Vect(), e_out.Vect()));
+  const Vec3 nH = Unit(Cross(q.Vect(), p_out.Vect()));
+  const double cos_phi = Dot(nL, nH);
+  const double sin_phi = Dot(Cross(nL, nH), Unit(q.Vect()));
+  k.phi = (std::atan2(sin_phi, cos_phi) + pi) * 180. / pi;
+
+  const Vec4 totI = e_in + p_in;
+  const Vec4 totF = e_out + p_out + phiM;
+  const Vec4 miss = totI - totF;
+
+  k.Mx2_ep = Mag2(totI - e_out - p_out);
+  k.Emiss = miss.E;
+  k.PTmiss = std::sqrt(miss.px * miss.px + miss.py * miss.py);
+  k.Mx2_epKpKm = Mag2(miss);
+
+  const Vec3 qv = q.Vect();
+  const Vec3 ev = e_in.Vect();
+  const Vec3 phiv = phiM.Vect();
+  const Vec3 pv = p_out.Vect();
+
+  k.DeltaPhi = std::abs(PhiH(qv, ev, phiv) - PhiH(qv, ev, -pv));
+  k.Theta_g_phimeson = Angle(phiv, (totI - (e_out + p_out)).Vect()) * 180. / pi;
+  k.Cone_p = Angle((e_in + p_in - e_out - phiM).Vect(), pv) * 180. / pi;
+  k.Cone_Km = Angle((e_in + p_in - e_out - kPlus - p_out).Vect(), kMinus.Vect()) * 180. / pi;
+  k.Cone_Kp = Angle((e_in + p_in - e_out - kMinus - p_out).Vect(), kPlus.Vect()) * 180. / pi;
+
+  k.Mx2_eKpKm = Mag2(e_in + p_in - e_out - phiM);
+  k.Mx2_epKp = Mag2(e_in + p_in - e_out - kPlus - p_out);
+  k.Mx2_epKm = Mag2(e_in + p_in - e_out - kMinus - p_out);
+  k.Mx2_eKp = Mag2(e_in + p_in - e_out - kPlus);
+  k.Mx_eKp = std::sqrt(k.Mx2_eKp);
+
+  k.Theta_e_phimeson = Angle(e_out.Vect(), phiv) * 180. / pi;
+  k.DeltaE = (e_in.E + p_in.E) - (e_out.E + p_out.E + phiM.E);
+
+  // Note: the class version assigns a shadowing local, so its getter always
+  // returns 0; here the field is actually filled.
+  k.Coplanarity_had_normals_deg = std::numeric_limits<double>::quiet_NaN();
+  const Vec3 n_qphi = Cross(qv, phiv);
+  const Vec3 n_pphi = Cross(pv, phiv);
+  if (Mag(n_qphi) > 0 && Mag(n_pphi) > 0) {
+    double c = Dot(Unit(n_qphi), Unit(n_pphi));
+    c = std::max(-1.0, std::min(1.0, c));
+    const double ang = std::acos(c) * 180. / pi;
+    k.Coplanarity_had_normals_deg = std::min(ang, 180.0 - ang);
+  }
+
+  // K+ decay angles in the helicity frame: lab -> (gamma* p) c.m. -> phi rest
+  // frame, axes as in Diehl, arXiv:0704.1565 p.5 (same chain as the class).
+  k.cos_thetaKK = std::numeric_limits<double>::quiet_NaN();
+  k.cos_phiKK = std::numeric_limits<double>::quiet_NaN();
+
+  const Vec3 beta_gp = BoostVector(q + p_in);
+  const Vec4 phi_gp = Boost(phiM, -beta_gp);
+  const Vec4 p_out_gp = Boost(p_out, -beta_gp);
+  const Vec4 kPlus_gp = Boost(kPlus, -beta_gp);
+  const Vec4 q_gp = Boost(q, -beta_gp);
+
+  const Vec3 beta_phi_gp = BoostVector(phi_gp);
+  const Vec4 kPlus_rest = Boost(kPlus_gp, -beta_phi_gp);
+  const Vec4 p_out_rest = Boost(p_out_gp, -beta_phi_gp);
+  const Vec4 q_rest = Boost(q_gp, -beta_phi_gp);
+
+  const Vec3 z_axis = -Unit(p_out_rest.Vect());
+  const Vec3 y_axis = Unit(Cross(q_rest.Vect(), p_out_rest.Vect()));
+  const Vec3 x_axis = Unit(Cross(y_axis, z_axis));
+
+  const Vec3 k_vec = kPlus_rest.Vect();
+  if (Mag(k_vec) > 0) k.cos_thetaKK = Dot(z_axis, Unit(k_vec));
+  const double phi_rad = std::atan2(Dot(k_vec, y_axis), Dot(k_vec, x_axis));
+  k.cos_phiKK = std::cos(phi_rad);
+
+  return k;
+}
+
+}  // namespace disana_kin
+
 // -----------------------------------------------------------------------------
 // Bin manager
 // -----------------------------------------------------------------------------
@@ -1356,6 +1569,146 @@ class DISANAMath {
     return asym;
   }
 
+  // One-pass beam-spin asymmetry.  A single traversal fills flat per-slot
+  // helicity count sums N±(kinematic bin, φ bin) plus Σ λ·sinφ and Σ sin²φ
+  // per kinematic bin, and A_LU(φ) with its uncertainty comes out of the
+  // sums in closed form.  The luminosity and bin-volume factors of the
+  // per-helicity cross sections cancel in the ratio, so this reproduces
+  // ComputeBeamSpinAsymmetry(ComputeDVCS_CrossSection(df±), ...) without the
+  // two helicity-filtered event loops; the sinφ moments give the integrated
+  // A_LU^{sinφ} amplitude of each bin for free.
+  std::vector<std::vector<std::vector<TH1D *>>> ComputeBeamSpinAsymmetryOnePass(ROOT::RDF::RNode df, const BinManager &bins, double pol = 1.0) {
+    TStopwatch timer;
+    timer.Start();
+    constexpr double phi_min = 0.0, phi_max = 360.0;
+    constexpr int n_phi_bins = 18;
+
+    const bool custom = bins.HasCustomBins();
+    const auto &q2_bins = bins.GetQ2Bins();
+    const auto &t_bins = bins.GetTBins();
+    const size_t n_q2 = custom ? 1 : q2_bins.size() - 1;
+    const size_t n_t = custom ? 1 : t_bins.size() - 1;
+    const size_t n_xb = custom ? 1 : bins.GetMaxXBBinCount();
+    const size_t nBins = custom ? bins.GetCustomBins().size() : n_xb * n_q2 * n_t;
+
+    auto findBin = [](double v, const std::vector<double> &e) -> int {
+      auto it = std::upper_bound(e.begin(), e.end(), v);
+      if (it == e.begin() || it == e.end()) return -1;
+      return int(it - e.begin()) - 1;
+    };
+    // Flat kinematic-bin index: custom bins scan the list, the (xB, Q2, t)
+    // grid maps as (ix * n_q2 + iq) * n_t + it.
+    auto binIndex = [&](double Q2, double t, double xB) -> long {
+      if (custom) {
+        const auto &customBins = bins.GetCustomBins();
+        for (size_t ib = 0; ib < customBins.size(); ++ib) {
+          const auto &bin = customBins[ib];
+          if (xB >= bin.xBMin && xB < bin.xBMax && Q2 >= bin.Q2Min && Q2 < bin.Q2Max && t >= bin.tMin && t < bin.tMax) return long(ib);
+        }
+        return -1;
+      }
+      const int iq = findBin(Q2, q2_bins), it = findBin(t, t_bins);
+      if (iq < 0 || it < 0) return -1;
+      const int ix = findBin(xB, bins.GetXBBins(static_cast<size_t>(iq)));
+      if (ix < 0) return -1;
+      return (long(ix) * long(n_q2) + long(iq)) * long(n_t) + long(it);
+    };
+
+    struct HelicityMoments {
+      std::vector<double> nPos, nNeg;     // [bin * n_phi_bins + φ bin]
+      std::vector<double> helSin, sin2;   // [bin]
+    };
+    const unsigned int nSlots = std::max(1u, df.GetNSlots());
+    std::vector<HelicityMoments> slots(nSlots);
+    for (auto &s : slots) {
+      s.nPos.assign(nBins * n_phi_bins, 0.0);
+      s.nNeg.assign(nBins * n_phi_bins, 0.0);
+      s.helSin.assign(nBins, 0.0);
+      s.sin2.assign(nBins, 0.0);
+    }
+
+    df.ForeachSlot(
+        [&](unsigned int slot, double Q2, double t, double xB, double phi, short hel) {
+          if (hel != 1 && hel != -1) return;
+          const long idx = binIndex(Q2, t, xB);
+          if (idx < 0) return;
+          const int pb = int((phi - phi_min) / (phi_max - phi_min) * n_phi_bins);
+          if (pb < 0 || pb >= n_phi_bins) return;
+          HelicityMoments &s = slots[slot];
+          (hel == 1 ? s.nPos : s.nNeg)[size_t(idx) * n_phi_bins + pb] += 1.0;
+          const double sp = std::sin(phi * pi / 180.0);
+          s.helSin[idx] += static_cast<double>(hel) * sp;
+          s.sin2[idx] += sp * sp;
+        },
+        {"Q2", "t", "xB", "phi", "REC_Event_helicity"});
+
+    HelicityMoments acc = std::move(slots.front());
+    for (unsigned int s = 1; s < nSlots; ++s) {
+      for (size_t i = 0; i < acc.nPos.size(); ++i) {
+        acc.nPos[i] += slots[s].nPos[i];
+        acc.nNeg[i] += slots[s].nNeg[i];
+      }
+      for (size_t i = 0; i < nBins; ++i) {
+        acc.helSin[i] += slots[s].helSin[i];
+        acc.sin2[i] += slots[s].sin2[i];
+      }
+    }
+
+    // Same closed form as ComputeBeamSpinAsymmetry with Poisson bin errors:
+    // A = (N+ - N-)/(N+ + N-), E = 2 sqrt(N-² N+ + N+² N-)/(N+ + N-)².
+    auto makeAsym = [&](long idx, const char *name, const char *title) {
+      TH1D *ha = new TH1D(name, title, n_phi_bins, phi_min, phi_max);
+      ha->SetDirectory(nullptr);
+      for (int b = 1; b <= n_phi_bins; ++b) {
+        const double Np = acc.nPos[size_t(idx) * n_phi_bins + (b - 1)];
+        const double Nm = acc.nNeg[size_t(idx) * n_phi_bins + (b - 1)];
+        const double den = Np + Nm;
+        if (den == 0) continue;
+        const double A = (Np - Nm) / den;
+        const double E = 2.0 / (den * den) * std::sqrt(Nm * Nm * Np + Np * Np * Nm);
+        ha->SetBinContent(b, A / pol);
+        ha->SetBinError(b, E / pol);
+      }
+      // Moment-method sinφ amplitude of the whole bin, from the same sums.
+      if (acc.sin2[idx] > 0) {
+        const double Asin = acc.helSin[idx] / (pol * acc.sin2[idx]);
+        const double eAsin = 1.0 / (pol * std::sqrt(acc.sin2[idx]));
+        std::cout << "  " << name << ": A_LU^{sin#phi} = " << Asin << " +/- " << eAsin << "\n";
+      }
+      return ha;
+    };
+
+    std::vector<std::vector<std::vector<TH1D *>>> asym;
+    if (custom) {
+      const auto &customBins = bins.GetCustomBins();
+      asym.assign(1, std::vector<std::vector<TH1D *>>(nBins, std::vector<TH1D *>(1, nullptr)));
+      for (size_t ib = 0; ib < nBins; ++ib) {
+        const auto &bin = customBins[ib];
+        asym[0][ib][0] = makeAsym(long(ib), Form("hphi_custom_%zu_BSA", ib),
+                                  Form("Beam Spin Asymmetry (x_{B}=[%.3f,%.3f], Q^{2}=[%.3f,%.3f], t=[%.3f,%.3f])", bin.xBMin, bin.xBMax, bin.Q2Min, bin.Q2Max, bin.tMin, bin.tMax));
+      }
+    } else {
+      asym.assign(n_xb, std::vector<std::vector<TH1D *>>(n_q2, std::vector<TH1D *>(n_t, nullptr)));
+      for (size_t iq = 0; iq < n_q2; ++iq) {
+        const auto &xb_bins = bins.GetXBBins(iq);
+        for (size_t ix = 0; ix + 1 < xb_bins.size(); ++ix)
+          for (size_t it = 0; it < n_t; ++it) {
+            const double qmin = q2_bins[iq], qmax = q2_bins[iq + 1];
+            const double tmin = t_bins[it], tmax = t_bins[it + 1];
+            const double xbmin = xb_bins[ix], xbmax = xb_bins[ix + 1];
+            const long idx = (long(ix) * long(n_q2) + long(iq)) * long(n_t) + long(it);
+            asym[ix][iq][it] = makeAsym(idx, Form("hphi_q%.1f_t%.1f_xb%.2f_BSA", qmin, tmin, xbmin),
+                                        Form("Beam Spin Asymmetry of d#sigma/d#phi (Q^{2}=[%.1f,%.1f], t=[%.1f,%.1f], x_{B}=[%.2f,%.2f])", qmin, qmax, tmin, tmax, xbmin, xbmax));
+          }
+      }
+    }
+
+    timer.Stop();
+    std::cout << "Beam-Spin Asymmetries (3D) computed in a single pass.\n";
+    std::cout << "Time elapsed: " << timer.RealTime() << " s (real), " << timer.CpuTime() << " s (CPU)\n";
+    return asym;
+  }
+
   std::vector<std::vector<std::vector<TH1D *>>> CalcPi0Corr(ROOT::RDF::RNode df_dvcs_pi0mc, ROOT::RDF::RNode df_pi0_pi0mc, ROOT::RDF::RNode df_dvcs_data,
                                                             ROOT::RDF::RNode df_pi0_data, const BinManager &xBins) {
     const size_t n_t = xBins.GetTBins().size() - 1;
@@ -30,6 +30,8 @@
 
 // Your helper (for FitWindowFromGaussianCore)
 #include "DISANAMathFitUtils.h"
+// Compiled signal+background models (no TFormula in the fits)
+#include "DISANAFitModels.h"
 
 namespace DISANA {
 namespace PhiMass {
@@ -136,11 +138,12 @@ inline void Draw2DHistogram(TH2D* hist,
 inline TF1 *FitGausPlusPoly3(TH1 *h, double mu_guess, double sigma_guess,
                              double xmin, double xmax, const std::string &tag) {
   if (!h) throw std::runtime_error("FitGausPlusPoly3: histogram is null");
-  TF1 *f = new TF1(("fGMp3_"+tag).c_str(), "gaus(0)+pol3(3)", xmin, xmax);
+  TF1 *f = DISANA::FitModels::MakeGausPlusPoly3TF1("fGMp3_"+tag, xmin, xmax);
   f->SetParNames("A","mu","sigma","p0","p1","p2","p3");
   f->SetParameters(h->GetMaximum(), mu_guess, sigma_guess, 0, 0, 0, 0);
   f->SetParLimits(2, 0.0003, 0.20);
-  h->Fit(f, "RQ0");
+  DISANA::FitModels::GausPlusPoly3Model model;
+  DISANA::FitModels::FitHistogramCompiled(h, f, model);
   return f;
 }
 
@@ -344,18 +347,10 @@ inline PhiMassWindow FitAndDrawPhiMassHistogram(TH1D* hist,
     const double bw = hist->GetXaxis()->GetBinWidth(1);
     std::cout << "Bin width: " << bw << std::endl;
 
-    std::string name = "fitTotal_" + safe;
-    std::string formula = Form(
-        // Background: [0]*(x-0.9874)^[1] * exp(-[2]*(x-0.9874))
-        "[0]*TMath::Power(x-0.9874,[1])*TMath::Exp(-[2]*(x-0.9874))"
-        " + "
-        // Signal (counts/bin): [3] (=Nsig) * bw * Gaussian_pdf(x; [4]=mean, [5]=sigma)
-        "[3]*0.398942*%g*TMath::Exp(-0.5*TMath::Power((x-[4])/([5]),2))/TMath::Abs([5])",
-        bw);
+    // Compiled model: background [0]*(x-thr)^[1]*exp(-[2]*(x-thr)) plus
+    // signal (counts/bin) [3] (=Nsig) * bw * Gaussian_pdf(x; [4]=mean, [5]=sigma)
+    TF1* fitTotal = DISANA::FitModels::MakePhiMassTotalTF1("fitTotal_" + safe, bw, fit_range_min, fit_range_max);
 
-    TF1* fitTotal = new TF1(name.c_str(), formula.c_str(), fit_range_min, fit_range_max);
-
-    //[0]*0.398942*bw*TMath::Exp(-0.5*((x-[1])/([2]))*((x-[1])/([2])))/TMath::Abs([2])
     // params: [0]=Abkg(scale), [1]=alpha, [2]=lambda, [3]=Nsig(yield), [4]=mu, [5]=sigma
     fitTotal->SetParameters(100, 0.9, 2, 100, 1.02, 0.010);
     fitTotal->SetParLimits(4, .89, 1.05);
@@ -363,7 +358,8 @@ inline PhiMassWindow FitAndDrawPhiMassHistogram(TH1D* hist,
     fitTotal->SetParLimits(5, 0.00001, 0.06);
     fitTotal->SetLineColor(kRed + 1);
     fitTotal->SetLineWidth(3);
-    hist->Fit(fitTotal, "R0QL");
+    DISANA::FitModels::PhiMassTotalModel modelTotal(bw);
+    DISANA::FitModels::FitHistogramCompiled(hist, fitTotal, modelTotal, /*useLikelihood=*/true);
     fitTotal->Draw("SAME C");
 
     double A = fitTotal->GetParameter(0);
@@ -375,7 +371,7 @@ inline PhiMassWindow FitAndDrawPhiMassHistogram(TH1D* hist,
     double chi2 = fitTotal->GetChisquare();
     double ndf = fitTotal->GetNDF();
 
-    TF1* fitSignal = new TF1(("fitSignal_" + safe).c_str(), Form("[0]*0.398942*%g*TMath::Exp(-0.5*TMath::Power((x-[1])/([2]),2))/TMath::Abs([2])",bw), fit_range_min, fit_range_max);
+    TF1* fitSignal = DISANA::FitModels::MakePhiMassSignalTF1("fitSignal_" + safe, bw, fit_range_min, fit_range_max);
     fitSignal->SetParameters(N, win.mu, win.sigma);
     fitSignal->SetLineColor(kOrange + 1);
     fitSignal->SetLineStyle(2);
@@ -384,9 +380,7 @@ inline PhiMassWindow FitAndDrawPhiMassHistogram(TH1D* hist,
     fitSignal->SetFillStyle(1001);
     fitSignal->Draw("SAME FC");
    
-    TF1* fitBkg = new TF1(("fitBkg_" + safe).c_str(),
-                           "[0]*TMath::Power(x-0.9874,[1])*TMath::Exp(-[2]*(x-0.9874))",
-                           fit_range_min, fit_range_max);
+    TF1* fitBkg = DISANA::FitModels::MakePhiMassBkgTF1("fitBkg_" + safe, fit_range_min, fit_range_max);
     fitBkg->SetParameters(A, alpha, lambda);
     fitBkg->SetLineColor(kGreen + 2);
     fitBkg->SetLineStyle(3);
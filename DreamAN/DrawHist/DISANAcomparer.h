@@ -4,10 +4,13 @@
 // ROOT headers
 #include <TCanvas.h>
 #include <TF1.h>
+#include <TFile.h>
 #include <TGraphErrors.h>
+#include <TTree.h>
 #include <TLegend.h>
 #include <TH2D.h>
 #include <TLine.h>
+#include <TROOT.h>
 #include <TVector3.h>
 #include <TVirtualFitter.h>
 #include <ROOT/RDFHelpers.hxx>
@@ -26,12 +29,15 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
 // Project-specific headers
 #include <chrono>
 
+#include "CanvasRenderQueue.h"
+#include "DISANAExclusivitySparse.h"
 #include "DISANAplotter.h"
 #include "DrawStyle.h"
 
@@ -52,6 +58,14 @@ class DISANAcomparer {
   // Set the bin ranges used for cross-section calculations and plotting
   void SetXBinsRanges(BinManager bins) { fXbins = bins; }
 
+  // Write canvases from a background thread instead of blocking each Plot*
+  // method on ROOT's PDF/PNG writers (on by default).  FlushRenderQueue
+  // blocks until every queued canvas is on disk; the comparer's destructor
+  // flushes too, so an explicit call is only needed before reading the
+  // files back within the same session.
+  void SetDeferredRendering(bool on) { deferRendering_ = on; }
+  void FlushRenderQueue() { renderQueue_.Flush(); }
+
   void SetDVCSWeightFunction(DVCSWeightFunction weightFunc) {
     dvcs_weight_function_ = std::move(weightFunc);
     for (auto& plotter : plotters) {
@@ -59,6 +73,80 @@ class DISANAcomparer {
     }
   }
 
+  // Deferred histogram booking: when enabled before AddModel*, the per-model
+  // Generate*KinematicHistos calls only book their results and
+  // MaterializeKinematicHistograms() fills every model in a single
+  // ROOT::RDF::RunGraphs call, so each input dataset is read exactly once.
+  void SetDeferredHistogramBooking(bool on) {
+    deferredHistogramBooking_ = on;
+    for (auto& plotter : plotters) plotter->SetDeferredHistogramBooking(on);
+  }
+
+  void MaterializeKinematicHistograms() {
+    // Each model's handles belong to an independent RDataFrame over its own
+    // files.  With IMT enabled one RunGraphs call already interleaves the
+    // loops, but without it RunGraphs executes them strictly back to back —
+    // so in that case drive each model's graph from its own thread instead.
+    // A 4-model comparison then reads its four datasets concurrently.
+    std::vector<std::vector<ROOT::RDF::RResultHandle>> perModel(plotters.size());
+    size_t nPending = 0;
+    for (size_t i = 0; i < plotters.size(); ++i) {
+      plotters[i]->CollectHistogramHandles(perModel[i]);
+      if (!perModel[i].empty()) ++nPending;
+    }
+    if (nPending == 0) return;
+
+    unsigned int eventLoopCount = 0;
+    if (ROOT::IsImplicitMTEnabled() || nPending == 1) {
+      std::vector<ROOT::RDF::RResultHandle> resultHandles;
+      for (auto& handles : perModel) resultHandles.insert(resultHandles.end(), handles.begin(), handles.end());
+      eventLoopCount = ROOT::RDF::RunGraphs(resultHandles);
+    } else {
+      ROOT::EnableThreadSafety();
+      std::vector<std::thread> workers;
+      workers.reserve(nPending);
+      for (auto& handles : perModel) {
+        if (handles.empty()) continue;
+        workers.emplace_back([&handles]() { ROOT::RDF::RunGraphs(handles); });
+      }
+      for (auto& t : workers) t.join();
+      eventLoopCount = static_cast<unsigned int>(nPending);
+    }
+    std::cout << "[MaterializeKinematicHistograms] completed " << eventLoopCount << " independent RDataFrame event loop(s) for "
+              << plotters.size() << " model(s).\n";
+  }
+
+  // Persistent φ histogram cache: call AFTER all AddModel* calls and after
+  // SetXBinsRanges.  Each model gets a sidecar ROOT file in cacheDir keyed
+  // by a hash of the bin edges, the cut strings and the input file list; the
+  // PlotPhi*PerBin_AllModels drivers then skip their RDF pass and per-bin
+  // mass fits whenever a model's sidecar file matches the configuration, so
+  // restyling a canvas costs seconds instead of the full fill.
+  void EnablePhiHistogramCache(const std::string& cacheDir, const std::vector<std::string>& inputFiles,
+                               const std::vector<std::string>& cutTags = {}) {
+    gSystem->mkdir(cacheDir.c_str(), /*recursive=*/true);
+    const std::string hash = DISANAplotter::HashPhiPlotConfig(fXbins, cutTags, inputFiles);
+    for (size_t i = 0; i < plotters.size(); ++i) {
+      plotters[i]->EnablePhiHistogramCache(cacheDir + "/" + labels[i] + "_phiCache.root", hash);
+    }
+  }
+
+  // Correction response cache: same calling convention as the φ cache.
+  // Each model's pi0-contamination and radiative-correction ratio grids are
+  // derived from its MC RNodes once, stored in a per-model sidecar file
+  // keyed by the configuration hash, and re-applied as bin-by-bin
+  // multiplications — so restyling the corrected cross-section or pi0
+  // comparison plots no longer re-reads the MC.  Pass the MC file lists in
+  // inputFiles so a new MC production invalidates the cache.
+  void EnableCorrectionResponseCache(const std::string& cacheDir, const std::vector<std::string>& inputFiles,
+                                     const std::vector<std::string>& cutTags = {}) {
+    gSystem->mkdir(cacheDir.c_str(), /*recursive=*/true);
+    const std::string hash = DISANAplotter::HashPhiPlotConfig(fXbins, cutTags, inputFiles);
+    for (size_t i = 0; i < plotters.size(); ++i) {
+      plotters[i]->EnableCorrectionResponseCache(cacheDir + "/" + labels[i] + "_corrCache.root", hash);
+    }
+  }
+
   void NormalizeHistogram(TH1* hist) {
     if (!hist) return;
     double integral = hist->Integral();
@@ -81,6 +169,7 @@ class DISANAcomparer {
     plotter->SetPlotApplyRadiativeCorrection(fRadiativeCorrection);
     plotter->SetPlotApplyP1Cut(fP1cut);
     plotter->SetDVCSWeightFunction(dvcs_weight_function_);
+    plotter->SetDeferredHistogramBooking(deferredHistogramBooking_);
     plotter->GenerateKinematicHistos("el");
     plotter->GenerateKinematicHistos("pro");
     plotter->GenerateKinematicHistos("pho");
@@ -96,6 +185,7 @@ class DISANAcomparer {
     auto plotter = std::make_unique<DISANAplotter>(DVCSModeTag{}, df, beamEnergy, luminosity);
     std::cout << "Adding model: " << label << " with beam energy: " << beamEnergy << " GeV without Pi0 Correction" << std::endl;
     plotter->SetDVCSWeightFunction(dvcs_weight_function_);
+    plotter->SetDeferredHistogramBooking(deferredHistogramBooking_);
     plotter->GenerateKinematicHistos("el");
     plotter->GenerateKinematicHistos("pro");
     plotter->GenerateKinematicHistos("pho");
@@ -106,6 +196,7 @@ class DISANAcomparer {
   void AddModelPhi(ROOT::RDF::RNode df_data, const std::string& label, double beamEnergy, double luminosity) {
     auto plotter = std::make_unique<DISANAplotter>(PhiModeTag{}, df_data, beamEnergy, luminosity);
     labels.push_back(label);
+    plotter->SetDeferredHistogramBooking(deferredHistogramBooking_);
     plotter->GeneratePhiKinematicHistos("el");
     plotter->GeneratePhiKinematicHistos("pro");
     plotter->GeneratePhiKinematicHistos("kMinus");
@@ -116,6 +207,7 @@ class DISANAcomparer {
   void AddModelPhi(ROOT::RDF::RNode df_data, const std::string& label, double beamEnergy, double luminosity, ROOT::RDF::RNode df_gen, ROOT::RDF::RNode df_rec,
                    ROOT::RDF::RNode df_radRatio, bool fAcc = false, bool fEff = false, bool fRad = false) {
     auto plotter = std::make_unique<DISANAplotter>(PhiModeTag{}, df_data, beamEnergy, luminosity, df_gen, df_rec, std::nullopt, std::nullopt, df_radRatio);
+    plotter->SetDeferredHistogramBooking(deferredHistogramBooking_);
     plotter->GeneratePhiKinematicHistos("el");
     plotter->GeneratePhiKinematicHistos("pro");
     plotter->GeneratePhiKinematicHistos("kMinus");
@@ -131,6 +223,7 @@ class DISANAcomparer {
   void AddModelPhi(ROOT::RDF::RNode df_data, const std::string& label, double beamEnergy, double luminosity, ROOT::RDF::RNode df_gen, ROOT::RDF::RNode df_rec,
                    ROOT::RDF::RNode df_bkg, ROOT::RDF::RNode df_nobkg, ROOT::RDF::RNode df_radRatio, bool fAcc = false, bool fEff = false, bool fRad = false) {
     auto plotter = std::make_unique<DISANAplotter>(PhiModeTag{}, df_data, beamEnergy, luminosity, df_gen, df_rec, df_bkg, df_nobkg, df_radRatio);
+    plotter->SetDeferredHistogramBooking(deferredHistogramBooking_);
     plotter->GeneratePhiKinematicHistos("el");
     plotter->GeneratePhiKinematicHistos("pro");
     plotter->GeneratePhiKinematicHistos("kMinus");
@@ -487,7 +580,7 @@ class DISANAcomparer {
           diag.SetLineStyle(2);
           diag.SetLineWidth(2);
           diag.Draw("SAME");
-          c.SaveAs(Form("%s/%s_%s%s_momentumCorrection2D.png", outdir.c_str(), tag.c_str(), spec.tag.c_str(), detTag.c_str()));
+          SaveCanvas(c, Form("%s/%s_%s%s_momentumCorrection2D.png", outdir.c_str(), tag.c_str(), spec.tag.c_str(), detTag.c_str()));
         };
 
         if (spec.detectorColumn.empty()) {
@@ -554,7 +647,7 @@ class DISANAcomparer {
             unity.SetLineStyle(2);
             unity.SetLineWidth(2);
             unity.Draw("SAME");
-            c.SaveAs(Form("%s/%s_%s_%s%s_trueOverExp_vs_%s_momentumCorrection2D.png",
+            SaveCanvas(c, Form("%s/%s_%s_%s%s_trueOverExp_vs_%s_momentumCorrection2D.png",
                           ratioHistDir.c_str(), tag.c_str(), ratioSpec.tag.c_str(), detCase.second.c_str(), rangeName.c_str(), xTag.c_str()));
 
             auto hFit = dfGood.Histo2D({Form("hfit_momcorr_%s_%s_%s%s_vs_%s", tag.c_str(), ratioSpec.tag.c_str(), detCase.second.c_str(), rangeName.c_str(), xTag.c_str()),
@@ -655,7 +748,7 @@ class DISANAcomparer {
             unityPeak.SetLineStyle(2);
             unityPeak.SetLineWidth(2);
             unityPeak.Draw("SAME");
-            cFit.SaveAs(Form("%s/%s_%s_%s%s_peakTrueOverExp_vs_%s_momentumCorrection.png",
+            SaveCanvas(cFit, Form("%s/%s_%s_%s%s_peakTrueOverExp_vs_%s_momentumCorrection.png",
                              outdir.c_str(), tag.c_str(), ratioSpec.tag.c_str(), detCase.second.c_str(), rangeName.c_str(), xTag.c_str()));
 
           };
@@ -794,7 +887,7 @@ class DISANAcomparer {
         graph->SetLineColor(kBlack);
         graph->Draw("PE SAME");
 
-        cParam.SaveAs(Form("%s/%s_%s_%s_vs_momentum.png", outdir.c_str(), tag.c_str(), key.c_str(), paramName.c_str()));
+        SaveCanvas(cParam, Form("%s/%s_%s_%s_vs_momentum.png", outdir.c_str(), tag.c_str(), key.c_str(), paramName.c_str()));
         std::ofstream fitOut(Form("%s/%s_%s_%s_vs_momentum_fit.txt", outdir.c_str(), tag.c_str(), key.c_str(), paramName.c_str()));
         fitOut << "# Fit expression: [0]+[1]*p\n";
         fitOut << "# Graph: " << key << " " << paramName << "\n";
@@ -864,8 +957,11 @@ class DISANAcomparer {
           double q2_lo = q2_bins[iq], q2_hi = q2_bins[iq + 1];
           double t_lo = t_bins[it], t_hi = t_bins[it + 1];
 
-          // Apply filter
-          auto rdf_cut = rdf.Filter(Form("xB >= %f && xB < %f", xb_lo, xb_hi)).Filter(Form("Q2 >= %f && Q2 < %f", q2_lo, q2_hi)).Filter(Form("t >= %f && t < %f", t_lo, t_hi));
+          // Typed per-bin filter: a jitted string here would cost one cling
+          // compilation per (xB, Q2, t) cell at job startup.
+          auto rdf_cut = rdf.Filter(
+              [=](double xB, double Q2, double t) { return xB >= xb_lo && xB < xb_hi && Q2 >= q2_lo && Q2 < q2_hi && t >= t_lo && t < t_hi; },
+              {"xB", "Q2", "t"});
 
           // Compute means
           double mean_xB = rdf_cut.Mean("xB").GetValue();
@@ -1050,6 +1146,7 @@ class DISANAcomparer {
 
   // Plot all basic kinematic distributions (p, theta, phi) for all particle types
   void PlotKinematicComparison_phiAna() {
+    MaterializeKinematicHistograms();
     TCanvas* canvas = new TCanvas("KinematicComparison", "Kinematic Comparison", 1800, 1200);
     canvas->Divide(4, 4);
 
@@ -1064,7 +1161,7 @@ class DISANAcomparer {
     }
 
     canvas->Update();
-    canvas->SaveAs((outputDir + "KinematicComparison_phiAna.pdf").c_str());
+    SaveCanvas(*canvas, (outputDir + "KinematicComparison_phiAna.pdf").c_str());
 
     // Optionally save individual plots
     if (plotIndividual) {
@@ -1081,6 +1178,7 @@ class DISANAcomparer {
 
   // Plot all basic kinematic distributions (p, theta, phi) for all particle types
   void PlotKinematicComparison() {
+    MaterializeKinematicHistograms();
     TCanvas* canvas = new TCanvas("KinematicComparison", "Kinematic Comparison", 1800, 1200);
     canvas->Divide(3, 3);
 
@@ -1095,7 +1193,7 @@ class DISANAcomparer {
     }
 
     canvas->Update();
-    canvas->SaveAs((outputDir + "KinematicComparison.pdf").c_str());
+    SaveCanvas(*canvas, (outputDir + "KinematicComparison.pdf").c_str());
 
     // Optionally save individual plots
     if (plotIndividual) {
@@ -1169,6 +1267,7 @@ class DISANAcomparer {
   }
 
   void PlotPi0KinematicComparison() {
+    MaterializeKinematicHistograms();
     TCanvas* canvas = new TCanvas("KinematicComparison", "Kinematic Comparison", 1800, 1200);
     canvas->Divide(3, 4);
 
@@ -1183,7 +1282,7 @@ class DISANAcomparer {
     }
 
     canvas->Update();
-    canvas->SaveAs((outputDir + "Pi0KinematicComparison.pdf").c_str());
+    SaveCanvas(*canvas, (outputDir + "Pi0KinematicComparison.pdf").c_str());
 
     std::cout << "Saved pi0 kinematic comparison plots to: " << outputDir + "/Pi0KinematicComparison.pdf" << std::endl;
     delete canvas;
@@ -1283,7 +1382,7 @@ class DISANAcomparer {
 
     legend->Draw();
     canvas->Update();
-    canvas->SaveAs((outputDir + "/compare_" + type + "_" + var + ".pdf").c_str());
+    SaveCanvas(*canvas, (outputDir + "/compare_" + type + "_" + var + ".pdf").c_str());
     delete canvas;
   }
 
@@ -1458,7 +1557,7 @@ class DISANAcomparer {
     }
 
     // Final save and cleanup
-    canvas->SaveAs((outputDir + "/PhiAna_Kinematics_Comparison.pdf").c_str());
+    SaveCanvas(*canvas, (outputDir + "/PhiAna_Kinematics_Comparison.pdf").c_str());
     std::cout << "Saved phi electroproduction kinematics comparison to: " << (outputDir + "/PhiAna_Kinematics_Comparison.pdf") << std::endl;
 
     delete canvas;
@@ -1704,7 +1803,7 @@ class DISANAcomparer {
     TGaxis::SetMaxDigits(3);
     h2d->DrawCopy("COLZ");
     // Final save and cleanup
-    canvas->SaveAs((outputDir + "/DVCS_Kinematics_Comparison.pdf").c_str());
+    SaveCanvas(*canvas, (outputDir + "/DVCS_Kinematics_Comparison.pdf").c_str());
     std::cout << "Saved DVCS kinematics comparison to: " << outputDir + "/DVCS_Kinematics_Comparison.pdf" << std::endl;
     delete canvas;
     TGaxis::SetMaxDigits(oldMaxDigits);
@@ -1805,7 +1904,7 @@ class DISANAcomparer {
     TGaxis::SetMaxDigits(3);
     h2d->DrawCopy("COLZ");
     // Final save and cleanup
-    canvas->SaveAs((outputDir + "/DVPi0_Kinematics_Comparison.pdf").c_str());
+    SaveCanvas(*canvas, (outputDir + "/DVPi0_Kinematics_Comparison.pdf").c_str());
     std::cout << "Saved DVPi0 kinematics comparison to: " << outputDir + "/DVPi0_Kinematics_Comparison.pdf" << std::endl;
     delete canvas;
     TGaxis::SetMaxDigits(oldMaxDigits);
@@ -1911,7 +2010,7 @@ class DISANAcomparer {
     DrawVerticalBinLines(t_lines, tmin, tmax, xBmin, xBmax, 1, 1, kRed);
     gPad->RedrawAxis();
     // Final save and cleanup
-    canvas->SaveAs((outputDir + "/xBQ2tBin.pdf").c_str());
+    SaveCanvas(*canvas, (outputDir + "/xBQ2tBin.pdf").c_str());
     std::cout << "Saved xBQ2tBin kinematics to: " << outputDir + "/xBQ2tBin.pdf" << std::endl;
     delete canvas;
     TGaxis::SetMaxDigits(oldMaxDigits);
@@ -2017,7 +2116,7 @@ class DISANAcomparer {
     DrawVerticalBinLines(t_lines, tmin, tmax, xBmin, xBmax, 1, 1, kRed);
     gPad->RedrawAxis();
     // Final save and cleanup
-    canvas->SaveAs((outputDir + "/xBQ2tBinMC.pdf").c_str());
+    SaveCanvas(*canvas, (outputDir + "/xBQ2tBinMC.pdf").c_str());
     std::cout << "Saved xBQ2tBinMC kinematics to: " << outputDir + "/xBQ2tBinMC.pdf" << std::endl;
     delete canvas;
     TGaxis::SetMaxDigits(oldMaxDigits);
@@ -2123,7 +2222,7 @@ class DISANAcomparer {
     DrawVerticalBinLines(t_lines, tmin, tmax, xBmin, xBmax, 1, 1, kRed);
     gPad->RedrawAxis();
     // Final save and cleanup
-    canvas->SaveAs((outputDir + "/xBQ2tBinPi0.pdf").c_str());
+    SaveCanvas(*canvas, (outputDir + "/xBQ2tBinPi0.pdf").c_str());
     std::cout << "Saved xBQ2tBinPi0 kinematics to: " << outputDir + "/xBQ2tBinPi0.pdf" << std::endl;
     delete canvas;
     TGaxis::SetMaxDigits(oldMaxDigits);
@@ -2230,7 +2329,7 @@ class DISANAcomparer {
     DrawVerticalBinLines(t_lines, tmin, tmax, xBmin, xBmax, 1, 1, kRed);
     gPad->RedrawAxis();
     // Final save and cleanup
-    canvas->SaveAs((outputDir + "/xBQ2tBinPi0MC.pdf").c_str());
+    SaveCanvas(*canvas, (outputDir + "/xBQ2tBinPi0MC.pdf").c_str());
     std::cout << "Saved xBQ2tBinPi0MC kinematics to: " << outputDir + "/xBQ2tBinPi0MC.pdf" << std::endl;
     delete canvas;
     TGaxis::SetMaxDigits(oldMaxDigits);
@@ -2248,7 +2347,35 @@ class DISANAcomparer {
         {"Theta_e_gamma", "Angle: e-#gamma", "#theta(e, #gamma) [deg]", 0.0, 60.0}};
         //{"DeltaE", "Energy Balance", "#DeltaE [GeV]", -1.0, 2.0}};
 
-    for (const auto& [cutExpr, cutLabel] : detectorCuts) {
+    // One sparse accumulation pass per plotter covers every detector case
+    // and variable at once (axes: case, variable, value, t-bin) — the
+    // per-case filtered branches and histograms are projections of it.
+    std::vector<std::string> caseExpressions;
+    caseExpressions.reserve(detectorCuts.size());
+    for (const auto& [cutExpr, cutLabel] : detectorCuts) caseExpressions.push_back(cutExpr);
+
+    std::vector<std::vector<size_t>> availableVars(plotters.size());
+    std::vector<ROOT::RDF::RResultPtr<DISANAExclusivitySparse>> accumulators(plotters.size());
+    std::vector<ROOT::RDF::RResultHandle> resultHandles;
+    for (size_t m = 0; m < plotters.size(); ++m) {
+      auto rdf = plotters[m]->GetRDF();
+      std::vector<std::string> varColumns;
+      std::vector<std::pair<double, double>> varRanges;
+      for (size_t i = 0; i < vars.size(); ++i) {
+        const auto& [var, title, xlabel, xmin, xmax] = vars[i];
+        if (!rdf.HasColumn(var)) continue;
+        availableVars[m].push_back(i);
+        varColumns.push_back(var);
+        varRanges.emplace_back(xmin, xmax);
+      }
+      if (varColumns.empty()) continue;
+      accumulators[m] = BookExclusivitySparse(rdf, caseExpressions, varColumns, varRanges);
+      resultHandles.emplace_back(accumulators[m]);
+    }
+    if (!resultHandles.empty()) ROOT::RDF::RunGraphs(resultHandles);
+
+    for (size_t detectorIndex = 0; detectorIndex < detectorCuts.size(); ++detectorIndex) {
+      const std::string& cutLabel = detectorCuts[detectorIndex].second;
       std::string cleanName = cutLabel;
       std::replace(cleanName.begin(), cleanName.end(), ' ', '_');
       std::replace(cleanName.begin(), cleanName.end(), ',', '_');
@@ -2272,14 +2399,15 @@ class DISANAcomparer {
         bool first = true;
 
         for (size_t m = 0; m < plotters.size(); ++m) {
-          auto rdf_cut = plotters[m]->GetRDF().Filter(cutExpr, cutLabel);
-          if (!rdf_cut.HasColumn(var)) continue;
-
-          auto h = rdf_cut.Histo1D({Form("h_%s_%s_%zu", var.c_str(), cleanName.c_str(), m), (title + ";" + xlabel + ";Counts").c_str(), 100, xmin, xmax}, var);
-          h.GetValue();
-
-          TH1D* h_clone = (TH1D*)h.GetPtr()->Clone();
-          h_clone->SetDirectory(0);
+          if (!accumulators[m]) continue;
+          const auto slotIt = std::find(availableVars[m].begin(), availableVars[m].end(), i);
+          if (slotIt == availableVars[m].end()) continue;
+          const size_t varSlot = slotIt - availableVars[m].begin();
+
+          TH1D* h_clone = accumulators[m]->Projection(
+              detectorIndex, varSlot, -1,
+              Form("h_%s_%s_%zu", var.c_str(), cleanName.c_str(), m),
+              (title + ";" + xlabel + ";Counts").c_str());
           NormalizeHistogram(h_clone);
 
           styleKin_.StyleTH1(h_clone);
@@ -2317,7 +2445,7 @@ class DISANAcomparer {
       }
 
       std::string outpath = outputDir + "/Exclusivity_" + cleanName + ".pdf";
-      canvas->SaveAs(outpath.c_str());
+      SaveCanvas(*canvas, outpath.c_str());
       std::cout << "Saved detector-specific comparison to: " << outpath << "\n";
       delete canvas;
     }
@@ -2341,73 +2469,55 @@ class DISANAcomparer {
       return;
     }
 
-    struct BookedHistograms {
-      ROOT::RDF::RResultPtr<TH1D> dvcs;
-      ROOT::RDF::RResultPtr<TH1D> pi0Data;
-      ROOT::RDF::RResultPtr<TH1D> dvcsPi0MC;
-      ROOT::RDF::RResultPtr<TH1D> pi0Pi0MC;
+    struct BookedAccumulators {
+      ROOT::RDF::RResultPtr<DISANAExclusivitySparse> dvcs;
+      ROOT::RDF::RResultPtr<DISANAExclusivitySparse> pi0Data;
+      ROOT::RDF::RResultPtr<DISANAExclusivitySparse> dvcsPi0MC;
+      ROOT::RDF::RResultPtr<DISANAExclusivitySparse> pi0Pi0MC;
     };
-    using HistogramKey = std::tuple<size_t, size_t, size_t, size_t>;
-    std::map<HistogramKey, BookedHistograms> bookedHistograms;
-    std::vector<ROOT::RDF::RResultHandle> resultHandles;
 
-    // Book all detector/t-bin branches first so each underlying data source is
-    // scanned once when RunGraphs executes the complete graph.
-    for (size_t detectorIndex = 0; detectorIndex < detectorCuts.size(); ++detectorIndex) {
-      const auto& [cutExpr, cutLabel] = detectorCuts[detectorIndex];
-      std::string cleanName = cutLabel;
-      std::replace(cleanName.begin(), cleanName.end(), ' ', '_');
-      std::replace(cleanName.begin(), cleanName.end(), ',', '_');
-
-      for (size_t tbinIndex = 0; tbinIndex + 1 < tbin.size(); ++tbinIndex) {
-        const double tLow = tbin[tbinIndex];
-        const double tHigh = tbin[tbinIndex + 1];
-        if (tHigh <= tLow) continue;
-
-        const std::string tCut = Form("t >= %.12g && t < %.12g", tLow, tHigh);
-        const std::string tLabel = Form("%.3f <= t < %.3f GeV^{2}", tLow, tHigh);
-
-        for (size_t m = 0; m < plotters.size(); ++m) {
-          auto rdfDVCS = plotters[m]->GetRDF().Filter(cutExpr, cutLabel).Filter(tCut, tLabel);
-          auto rdfPi0 = plotters[m]->GetRDF_Pi0Data().Filter(cutExpr, cutLabel).Filter(tCut, tLabel);
-          auto rdfDVCSPi0MC = plotters[m]->GetRDF_DVCSSelectedPi0MC().Filter(cutExpr, cutLabel).Filter(tCut, tLabel);
-          auto rdfPi0Pi0MC = plotters[m]->GetRDF_Pi0SelectedPi0MC().Filter(cutExpr, cutLabel).Filter(tCut, tLabel);
-
-          for (size_t variableIndex = 0; variableIndex < vars.size(); ++variableIndex) {
-            const auto& [var, title, xlabel, xmin, xmax] = vars[variableIndex];
-            if (!rdfDVCS.HasColumn(var) || !rdfPi0.HasColumn(var) ||
-                !rdfDVCSPi0MC.HasColumn(var) || !rdfPi0Pi0MC.HasColumn(var)) {
-              continue;
-            }
-
-            BookedHistograms booked{
-                rdfDVCS.Histo1D(
-                    {Form("h_dvcs_%s_%s_tbin%zu_%zu", var.c_str(), cleanName.c_str(), tbinIndex, m),
-                     (title + ";" + xlabel + ";Counts / N_{DVCS}").c_str(), 100, xmin, xmax},
-                    var),
-                rdfPi0.Histo1D(
-                    {Form("h_pi0data_%s_%s_tbin%zu_%zu", var.c_str(), cleanName.c_str(), tbinIndex, m),
-                     (title + ";" + xlabel + ";Counts / N_{DVCS}").c_str(), 100, xmin, xmax},
-                    var),
-                rdfDVCSPi0MC.Histo1D(
-                    {Form("h_dvcs_pi0mc_%s_%s_tbin%zu_%zu", var.c_str(), cleanName.c_str(), tbinIndex, m),
-                     "", 100, xmin, xmax},
-                    var),
-                rdfPi0Pi0MC.Histo1D(
-                    {Form("h_pi0_pi0mc_%s_%s_tbin%zu_%zu", var.c_str(), cleanName.c_str(), tbinIndex, m),
-                     "", 100, xmin, xmax},
-                    var)};
-
-            resultHandles.emplace_back(booked.dvcs);
-            resultHandles.emplace_back(booked.pi0Data);
-            resultHandles.emplace_back(booked.dvcsPi0MC);
-            resultHandles.emplace_back(booked.pi0Pi0MC);
-            bookedHistograms.emplace(
-                HistogramKey{detectorIndex, tbinIndex, variableIndex, m},
-                std::move(booked));
-          }
+    // One sparse accumulation node per data source, with the detector cases,
+    // exclusivity variables and t-bins as THnSparse axes.  Each source is
+    // scanned once when RunGraphs executes the combined graph, and every
+    // detector-case x variable x t-bin histogram below is an offline
+    // projection — the graph no longer carries a filter branch per
+    // combination.
+    std::vector<std::string> caseExpressions;
+    caseExpressions.reserve(detectorCuts.size());
+    for (const auto& [cutExpr, cutLabel] : detectorCuts) caseExpressions.push_back(cutExpr);
+
+    std::vector<std::vector<size_t>> availableVars(plotters.size());
+    std::vector<BookedAccumulators> accumulators(plotters.size());
+    std::vector<ROOT::RDF::RResultHandle> resultHandles;
+    for (size_t m = 0; m < plotters.size(); ++m) {
+      auto rdfDVCS = plotters[m]->GetRDF();
+      auto rdfPi0 = plotters[m]->GetRDF_Pi0Data();
+      auto rdfDVCSPi0MC = plotters[m]->GetRDF_DVCSSelectedPi0MC();
+      auto rdfPi0Pi0MC = plotters[m]->GetRDF_Pi0SelectedPi0MC();
+
+      std::vector<std::string> varColumns;
+      std::vector<std::pair<double, double>> varRanges;
+      for (size_t i = 0; i < vars.size(); ++i) {
+        const auto& [var, title, xlabel, xmin, xmax] = vars[i];
+        if (!rdfDVCS.HasColumn(var) || !rdfPi0.HasColumn(var) ||
+            !rdfDVCSPi0MC.HasColumn(var) || !rdfPi0Pi0MC.HasColumn(var)) {
+          continue;
         }
+        availableVars[m].push_back(i);
+        varColumns.push_back(var);
+        varRanges.emplace_back(xmin, xmax);
       }
+      if (varColumns.empty()) continue;
+
+      accumulators[m] = BookedAccumulators{
+          BookExclusivitySparse(rdfDVCS, caseExpressions, varColumns, varRanges, tbin),
+          BookExclusivitySparse(rdfPi0, caseExpressions, varColumns, varRanges, tbin),
+          BookExclusivitySparse(rdfDVCSPi0MC, caseExpressions, varColumns, varRanges, tbin),
+          BookExclusivitySparse(rdfPi0Pi0MC, caseExpressions, varColumns, varRanges, tbin)};
+      resultHandles.emplace_back(accumulators[m].dvcs);
+      resultHandles.emplace_back(accumulators[m].pi0Data);
+      resultHandles.emplace_back(accumulators[m].dvcsPi0MC);
+      resultHandles.emplace_back(accumulators[m].pi0Pi0MC);
     }
 
     unsigned int eventLoopCount = 0;
@@ -2452,13 +2562,18 @@ class DISANAcomparer {
         bool first = true;
 
         for (size_t m = 0; m < plotters.size(); ++m) {
-          const auto bookedIt = bookedHistograms.find(
-              HistogramKey{detectorIndex, tbinIndex, i, m});
-          if (bookedIt == bookedHistograms.end()) continue;
-          auto& booked = bookedIt->second;
-
-          TH1D* hDVCS = (TH1D*)booked.dvcs.GetPtr()->Clone();
-          hDVCS->SetDirectory(0);
+          if (!accumulators[m].dvcs) continue;
+          const auto slotIt = std::find(availableVars[m].begin(), availableVars[m].end(), i);
+          if (slotIt == availableVars[m].end()) continue;
+          const size_t varSlot = slotIt - availableVars[m].begin();
+          auto& booked = accumulators[m];
+
+          const std::string& title = std::get<1>(vars[i]);
+          const std::string& xlabel = std::get<2>(vars[i]);
+          TH1D* hDVCS = booked.dvcs->Projection(
+              detectorIndex, varSlot, static_cast<int>(tbinIndex),
+              Form("h_dvcs_%s_%s_tbin%zu_%zu", var.c_str(), cleanName.c_str(), tbinIndex, m),
+              (title + ";" + xlabel + ";Counts / N_{DVCS}").c_str());
 
           const double dvcsIntegral = hDVCS->Integral();
           if (dvcsIntegral <= 0.0) {
@@ -2467,13 +2582,20 @@ class DISANAcomparer {
           }
 
           TH1D* hSubtracted = nullptr;
-          const double nDVCSPi0MC = booked.dvcsPi0MC.GetPtr()->Integral();
-          const double nPi0Pi0MC = booked.pi0Pi0MC.GetPtr()->Integral();
+          std::unique_ptr<TH1D> hDVCSPi0MC(booked.dvcsPi0MC->Projection(
+              detectorIndex, varSlot, static_cast<int>(tbinIndex),
+              Form("h_dvcs_pi0mc_%s_%s_tbin%zu_%zu", var.c_str(), cleanName.c_str(), tbinIndex, m)));
+          std::unique_ptr<TH1D> hPi0Pi0MC(booked.pi0Pi0MC->Projection(
+              detectorIndex, varSlot, static_cast<int>(tbinIndex),
+              Form("h_pi0_pi0mc_%s_%s_tbin%zu_%zu", var.c_str(), cleanName.c_str(), tbinIndex, m)));
+          const double nDVCSPi0MC = hDVCSPi0MC->Integral();
+          const double nPi0Pi0MC = hPi0Pi0MC->Integral();
           const double pi0TransferFactor =
               nPi0Pi0MC > 0.0 ? nDVCSPi0MC / nPi0Pi0MC : 0.0;
 
-          TH1D* hPi0Contamination = (TH1D*)booked.pi0Data.GetPtr()->Clone();
-          hPi0Contamination->SetDirectory(0);
+          TH1D* hPi0Contamination = booked.pi0Data->Projection(
+              detectorIndex, varSlot, static_cast<int>(tbinIndex),
+              Form("h_pi0data_%s_%s_tbin%zu_%zu", var.c_str(), cleanName.c_str(), tbinIndex, m));
           hPi0Contamination->Scale(pi0TransferFactor);
 
           hSubtracted = (TH1D*)hDVCS->Clone(
@@ -2525,7 +2647,7 @@ class DISANAcomparer {
 
         std::string outpath = outputDir + Form("/Exclusivity_DVCS_vs_Pi0Data_%s_tbin%zu_%.3f_%.3f.pdf",
                                                cleanName.c_str(), tbinIndex, tLow, tHigh);
-        canvas->SaveAs(outpath.c_str());
+        SaveCanvas(*canvas, outpath.c_str());
         std::cout << "Saved DVCS vs Pi0 data exclusivity comparison to: " << outpath << "\n";
         delete canvas;
       }
@@ -2666,7 +2788,7 @@ class DISANAcomparer {
       }
 
       std::string outpath = outputDir + "/Pi0Exclusivity_" + cleanName + ".pdf";
-      canvas->SaveAs(outpath.c_str());
+      SaveCanvas(*canvas, outpath.c_str());
       std::cout << "Saved detector-specific comparison to: " << outpath << "\n";
       delete canvas;
 
@@ -2776,7 +2898,7 @@ class DISANAcomparer {
         }
 
         std::string mpi0Outpath = outputDir + "/Pi0Exclusivity_Mass_pi0_wide_" + cleanName + ".pdf";
-        mpi0Canvas->SaveAs(mpi0Outpath.c_str());
+        SaveCanvas(*mpi0Canvas, mpi0Outpath.c_str());
         std::cout << "Saved wide-range Mpi0 comparison to: " << mpi0Outpath << "\n";
         delete mpi0Canvas;
       }
@@ -2865,7 +2987,7 @@ class DISANAcomparer {
       }
 
       std::string outpath = outputDir + "/Pi0Exclusivity_" + cleanName + ".pdf";
-      canvas->SaveAs(outpath.c_str());
+      SaveCanvas(*canvas, outpath.c_str());
       std::cout << "Saved detector-specific comparison to: " << outpath << "\n";
       delete canvas;
     }
@@ -2959,7 +3081,7 @@ class DISANAcomparer {
       }
 
       std::string outpath = outputDir + "/Exclusivity_Phi_Ana" + cleanName + ".pdf";
-      canvas->SaveAs(outpath.c_str());
+      SaveCanvas(*canvas, outpath.c_str());
       std::cout << "Saved detector-specific comparison to: " << outpath << "\n";
       delete canvas;
     }
@@ -3061,7 +3183,7 @@ class DISANAcomparer {
       }
 
       std::string outpath = outputDir + "/Exclusivity_Phi_Ana" + cleanName + ".pdf";
-      canvas->SaveAs(outpath.c_str());
+      SaveCanvas(*canvas, outpath.c_str());
       std::cout << "Saved detector-specific comparison to: " << outpath << "\n";
       delete canvas;
     }
@@ -3328,7 +3450,7 @@ class DISANAcomparer {
             Form("x_{B}:[%.3f,%.3f), Q^{2}:[%.3f,%.3f), t:[%.3f,%.3f)",
                  bin.xBMin, bin.xBMax, bin.Q2Min, bin.Q2Max, bin.tMin, bin.tMax));
         legend->Draw();
-        canvas->SaveAs(
+        SaveCanvas(*canvas, 
             Form("%s/%s_bin%03zu.%s",
                  customOutputDir.c_str(), observableName.c_str(), binIndex, suffix.c_str()));
         delete canvas;
@@ -3572,7 +3694,7 @@ class DISANAcomparer {
         }
       }
       TString outfile = Form("%s/%s_t_%.2f-%.2f.%s", outputDir.c_str(), observableName.c_str(), t_edges[t_bin], t_edges[t_bin + 1], suffix.c_str());
-      c->SaveAs(outfile);
+      SaveCanvas(*c, outfile);
 
       // std::cout << "Saved: " << outfile << '\n';
 
@@ -3599,6 +3721,11 @@ class DISANAcomparer {
       std::cout << "→ Fitting/drawing per-bin K^{+}K^{-} mass for model: " << labels[i] << " → " << subdir << "  (AccCorr=" << (doAcceptanceCorr ? "ON" : "OFF")
                 << ", RadCorr=" << (doRadCorr ? "ON" : "OFF") << ")\n";
 
+      if (p->LoadPhiHistogramCacheIfValid() && !p->GetPhiDSigmaDt3D().empty()) {
+        std::cout << "   cached dσ/dt grids restored for " << labels[i] << " — skipping fill and fits.\n";
+        continue;
+      }
+
       if (doAcceptanceCorr) {
         p->MakePhiAcceptanceCorrection3D(fXbins, subdir + "/acc/", "mtprime", "mtprime", /*minGenEntries=*/10, constrainSigma, sigmaRef, sigmaFrac);
       }
@@ -3614,6 +3741,7 @@ class DISANAcomparer {
       p->SetPlotApplyRadiativeCorrection(doRadCorr);
 
       (void)p->MakePhiMassFitCanvases3D(fXbins, subdir, nBins, mMin, mMax, constrainSigma, sigmaRef, sigmaFrac, branching);
+      p->SavePhiHistogramCache();
     }
   }
 
@@ -3655,10 +3783,16 @@ class DISANAcomparer {
       std::cout << "→ [xB-binned] Fitting K^{+}K^{-} mass for model: " << labels[i] << " → " << subdir << "  (AccCorr=" << (doAcceptanceCorr ? "ON" : "OFF")
                 << ", RadCorr=" << (doRadCorr ? "ON" : "OFF") << ")\n";
 
+      if (p->LoadPhiHistogramCacheIfValid() && !p->GetPhiDSigmaDt_XBT().empty()) {
+        std::cout << "   cached xB-binned dσ/dt' grids restored for " << labels[i] << " — skipping fill and fits.\n";
+        continue;
+      }
+
       p->SetPlotApplyAcceptanceCorrection(doAcceptanceCorr);
       p->SetPlotApplyRadiativeCorrection(doRadCorr);
 
       p->MakePhiMassFitCanvases_XBBins(fXbins, subdir, nBins, mMin, mMax, constrainSigma, sigmaRef, sigmaFrac, branching);
+      p->SavePhiHistogramCache();
     }
   }
 
@@ -3840,7 +3974,7 @@ class DISANAcomparer {
       leg->Draw();
 
       const TString out = Form("%s/phi_dsdt_xBBin_%zu.pdf", outputDir.c_str(), ixB);
-      c->SaveAs(out);
+      SaveCanvas(*c, out);
       delete leg;
       delete c;
     };
@@ -3854,7 +3988,8 @@ class DISANAcomparer {
     }
   }
 
-  void PlotPhiDSigmaDt_FromCache(bool plotData = true, bool plotAcc = false, bool plotRadCorr = false, bool plotEff = false, bool writeCSV = true) {
+  void PlotPhiDSigmaDt_FromCache(bool plotData = true, bool plotAcc = false, bool plotRadCorr = false, bool plotEff = false, bool writeCSV = true,
+                                 bool writeColumnar = true) {
     if (plotters.empty()) return;
 
     const auto& q2 = fXbins.GetQ2Bins();
@@ -4069,7 +4204,7 @@ class DISANAcomparer {
 
           TString out = hasW ? Form("%s/%s_Q%zu_W%zu.pdf", outputDir.c_str(), tag.Data(), iq, iw) : Form("%s/%s_Q%zu.pdf", outputDir.c_str(), tag.Data(), iq);
 
-          c->SaveAs(out);
+          SaveCanvas(*c, out);
 
           delete leg;
           delete c;
@@ -4115,6 +4250,146 @@ class DISANAcomparer {
         for (size_t iq = 0; iq < nQ; ++iq)
           for (size_t iw = 0; iw < nW; ++iw) writeCSVForBin(im, iq, iw);
     }
+
+    // ---- Columnar output: one dsdt.root per model with every (Q2,W,t') bin ----
+    // Same rows as the per-bin CSVs, but as a typed TTree the Python fitting
+    // stack reads as numpy arrays through uproot (no text parsing, no
+    // per-file globbing; iq/iw are branches).  The per-bin statistical
+    // errors are the full uncertainty record of the pipeline — the t' bins
+    // are statistically independent, so there is no off-diagonal covariance
+    // to store.
+    auto writeColumnarForModel = [&](size_t im) {
+      std::string safeLabel = labels[im];
+      for (char& ch : safeLabel)
+        if (ch == ' ' || ch == '/' || ch == '\\') ch = '_';
+
+      const std::string csvDir = outputDir + "/CSVs/" + safeLabel;
+      gSystem->Exec(Form("mkdir -p \"%s\"", csvDir.c_str()));
+      const std::string fname = csvDir + "/dsdt.root";
+
+      TFile fout(fname.c_str(), "RECREATE");
+      if (fout.IsZombie()) {
+        std::cerr << "[writeColumnar] Cannot open " << fname << "\n";
+        return;
+      }
+      TTree tree("dsdt", "phi dsigma/dt per (Q2,W,t') bin");
+
+      int b_iq = 0, b_iw = 0;
+      double b_tp_cen = 0, b_tp_lo = 0, b_tp_hi = 0, b_t_cen = 0, b_t_lo = 0, b_t_hi = 0;
+      double b_q2_cen = 0, b_q2_lo = 0, b_q2_hi = 0, b_w_lo = 0, b_w_hi = 0, b_w_cen = 0;
+      double b_xb_mean = 0, b_w_mean = 0, b_gv_mean = 0;
+      double b_xs = 0, b_xs_err = 0, b_acc = 0, b_eff = 0, b_rad = 0, b_nsig = 0, b_nsig_err = 0;
+
+      tree.Branch("iq", &b_iq, "iq/I");
+      tree.Branch("iw", &b_iw, "iw/I");
+      tree.Branch("tprime_center", &b_tp_cen, "tprime_center/D");
+      tree.Branch("tprime_lo", &b_tp_lo, "tprime_lo/D");
+      tree.Branch("tprime_hi", &b_tp_hi, "tprime_hi/D");
+      tree.Branch("t_center", &b_t_cen, "t_center/D");
+      tree.Branch("t_lo", &b_t_lo, "t_lo/D");
+      tree.Branch("t_hi", &b_t_hi, "t_hi/D");
+      tree.Branch("Q2_center", &b_q2_cen, "Q2_center/D");
+      tree.Branch("Q2_lo", &b_q2_lo, "Q2_lo/D");
+      tree.Branch("Q2_hi", &b_q2_hi, "Q2_hi/D");
+      tree.Branch("W_lo", &b_w_lo, "W_lo/D");
+      tree.Branch("W_hi", &b_w_hi, "W_hi/D");
+      tree.Branch("W_center", &b_w_cen, "W_center/D");
+      tree.Branch("xB_mean", &b_xb_mean, "xB_mean/D");
+      tree.Branch("W_mean", &b_w_mean, "W_mean/D");
+      tree.Branch("GammaV_mean", &b_gv_mean, "GammaV_mean/D");
+      tree.Branch("CrossSection", &b_xs, "CrossSection/D");
+      tree.Branch("CrossSection_Err", &b_xs_err, "CrossSection_Err/D");
+      tree.Branch("Acceptance", &b_acc, "Acceptance/D");
+      tree.Branch("Efficiency", &b_eff, "Efficiency/D");
+      tree.Branch("RadCorr", &b_rad, "RadCorr/D");
+      tree.Branch("RawCounts", &b_nsig, "RawCounts/D");
+      tree.Branch("RawCounts_Err", &b_nsig_err, "RawCounts_Err/D");
+
+      const double nan = std::numeric_limits<double>::quiet_NaN();
+
+      for (size_t iq = 0; iq < nQ; ++iq) {
+        for (size_t iw = 0; iw < nW; ++iw) {
+          TH1D* hXS = nullptr;
+          TH1D* hAcc = nullptr;
+          TH1D* hEff = nullptr;
+          TH1D* hRad = nullptr;
+          TH1D* hNsig = nullptr;
+          {
+            auto& H = plotters[im]->GetPhiDSigmaDt3D();
+            if (iq < H.size() && iw < H[iq].size()) hXS = H[iq][iw];
+          }
+          {
+            auto& A = plotters[im]->GetPhiAcceptance3D();
+            if (iq < A.size() && iw < A[iq].size()) hAcc = A[iq][iw];
+          }
+          {
+            auto& E = plotters[im]->GetPhiEfficiency3D();
+            if (iq < E.size() && iw < E[iq].size()) hEff = E[iq][iw];
+          }
+          {
+            auto& R = plotters[im]->GetPhiRadCorr3D();
+            if (iq < R.size() && iw < R[iq].size()) hRad = R[iq][iw];
+          }
+          {
+            auto& N = plotters[im]->GetPhiRawCounts3D();
+            if (iq < N.size() && iw < N[iq].size()) hNsig = N[iq][iw];
+          }
+          if (!hXS) continue;
+
+          b_iq = (int)iq;
+          b_iw = hasW ? (int)iw : -1;
+          b_q2_lo = q2[iq];
+          b_q2_hi = q2[iq + 1];
+          b_q2_cen = 0.5 * (b_q2_lo + b_q2_hi);
+          b_w_lo = hasW ? w[iw] : nan;
+          b_w_hi = hasW ? w[iw + 1] : nan;
+          const double w_mid = hasW ? 0.5 * (b_w_lo + b_w_hi) : nan;
+
+          const int nBins = hXS->GetNbinsX();
+          for (int ib = 1; ib <= nBins; ++ib) {
+            b_tp_cen = hXS->GetBinCenter(ib);
+            b_tp_lo = hXS->GetBinLowEdge(ib);
+            b_tp_hi = hXS->GetBinLowEdge(ib + 1);
+
+            if (hasT && (ib - 1) < (int)(t_edges.size() - 1)) {
+              b_t_lo = t_edges[ib - 1];
+              b_t_hi = t_edges[ib];
+              b_t_cen = 0.5 * (b_t_lo + b_t_hi);
+            } else {
+              b_t_cen = b_tp_cen;
+              b_t_lo = b_tp_lo;
+              b_t_hi = b_tp_hi;
+            }
+
+            b_xs = hXS->GetBinContent(ib);
+            b_xs_err = hXS->GetBinError(ib);
+            b_acc = hAcc ? hAcc->GetBinContent(ib) : nan;
+            b_eff = hEff ? hEff->GetBinContent(ib) : nan;
+            b_rad = hRad ? hRad->GetBinContent(ib) : nan;
+            b_nsig = hNsig ? hNsig->GetBinContent(ib) : nan;
+            b_nsig_err = hNsig ? hNsig->GetBinError(ib) : nan;
+
+            const int ib0 = ib - 1;
+            b_xb_mean = plotters[im]->GetPhiMeanXB(iq, iw, ib0);
+            b_w_mean = plotters[im]->GetPhiMeanW(iq, iw, ib0);
+            b_gv_mean = plotters[im]->GetPhiMeanGammaV(iq, iw, ib0);
+            // Same convention as the CSVs: data-weighted mean W when
+            // physical, bin midpoint as last resort.
+            b_w_cen = (std::isfinite(b_w_mean) && b_w_mean > 0.5) ? b_w_mean : w_mid;
+
+            tree.Fill();
+          }
+        }
+      }
+
+      tree.Write();
+      fout.Close();
+      std::cout << "[Columnar] Written → " << fname << " (" << tree.GetEntries() << " rows)\n";
+    };
+
+    if (writeColumnar) {
+      for (size_t im = 0; im < plotters.size(); ++im) writeColumnarForModel(im);
+    }
   }
 
   // Generic per-(Q2,W) grid plotter of TH1 vs t'
@@ -4187,7 +4462,7 @@ class DISANAcomparer {
 
         TString out = hasW ? Form("%s/%s_Q%zu_W%zu.pdf", outputDir.c_str(), tag.c_str(), iq, iw) : Form("%s/%s_Q%zu.pdf", outputDir.c_str(), tag.c_str(), iq);
 
-        c->SaveAs(out);
+        SaveCanvas(*c, out);
 
         delete leg;
         delete c;
@@ -4203,10 +4478,22 @@ class DISANAcomparer {
       return;
     }
     gSystem->Exec(Form("mkdir -p %s", baseOutDir.c_str()));
+    // Estimator + parameters that filled the grid; a cached grid is only
+    // reused when this tag matches (the config hash alone does not know
+    // which A_LU estimator ran, nor its mass window or polarization).
+    const std::string fillTag = Form("massfit nBins=%d m=[%.6g,%.6g] constrainSigma=%d sigmaRef=%.6g sigmaFrac=%.6g pol=%.6g",
+                                     nMassBins, mMin, mMax, constrainSigma ? 1 : 0, sigmaRef, sigmaFrac, beamPol);
     for (size_t i = 0; i < plotters.size(); ++i) {
       const std::string subdir = baseOutDir + "/" + labels[i];
       std::cout << "→ Fitting/drawing helicity-separated K^{+}K^{-} mass per cos(theta_KK) bin for model: " << labels[i] << " → " << subdir << std::endl;
+      if (plotters[i]->LoadPhiHistogramCacheIfValid() && !plotters[i]->GetPhiALUCosTheta3D().empty() &&
+          plotters[i]->GetPhiALUCosThetaFillTag() == fillTag) {
+        std::cout << "   cached A_LU(cosθ_KK) grids restored for " << labels[i] << " — skipping fill and fits.\n";
+        continue;
+      }
+      plotters[i]->SetPhiALUCosThetaFillTag(fillTag);
       plotters[i]->MakePhiBSAMassFitCanvases3D(fXbins, subdir, nMassBins, mMin, mMax, constrainSigma, sigmaRef, sigmaFrac, beamPol);
+      plotters[i]->SavePhiHistogramCache();
     }
   }
   void PlotPhiALUCosTheta_FromCache(const std::string& outDir = "PhiALUCosTheta") {
@@ -4296,7 +4583,7 @@ class DISANAcomparer {
         c->Update();
 
         TString out = hasW ? Form("%s/BSA_vs_CosKK_Q%zu_W%zu.pdf", outBase.c_str(), iq, iw) : Form("%s/BSA_vs_CosKK_Q%zu.pdf", outBase.c_str(), iq);
-        c->SaveAs(out);
+        SaveCanvas(*c, out);
 
         delete leg;
         delete c;
@@ -4316,7 +4603,12 @@ class DISANAcomparer {
       const std::string subdir = baseOutDir + "/" + labels[i];
       std::cout << "→ Fitting/drawing helicity-separated K^{+}K^{-} mass per Trento-phi bin for model: " << labels[i] << " → " << subdir << std::endl;
 
+      if (plotters[i]->LoadPhiHistogramCacheIfValid() && !plotters[i]->GetPhiBSATrentoPhi3D().empty()) {
+        std::cout << "   cached A_LU(φ_Trento) grids restored for " << labels[i] << " — skipping fill and fits.\n";
+        continue;
+      }
       plotters[i]->MakePhiBSATrentoPhiMassFitCanvases3D(fXbins, subdir, nMassBins, mMin, mMax, constrainSigma, sigmaRef, sigmaFrac, beamPol);
+      plotters[i]->SavePhiHistogramCache();
     }
   }
 
@@ -4408,7 +4700,7 @@ class DISANAcomparer {
         c->Update();
 
         TString out = hasW ? Form("%s/BSA_vs_trentoPhi_Q%zu_W%zu.pdf", outBase.c_str(), iq, iw) : Form("%s/BSA_vs_trentoPhi_Q%zu.pdf", outBase.c_str(), iq);
-        c->SaveAs(out);
+        SaveCanvas(*c, out);
 
         delete leg;
         delete c;
@@ -4430,7 +4722,12 @@ class DISANAcomparer {
       const std::string subdir = baseOutDir + "/" + labels[i];
       std::cout << "→ Fitting/drawing helicity-separated K^{+}K^{-} mass per z_phi bin for model: " << labels[i] << " → " << subdir << std::endl;
 
+      if (plotters[i]->LoadPhiHistogramCacheIfValid() && !plotters[i]->GetPhiALUZPhi3D().empty()) {
+        std::cout << "   cached A_LU(z_φ) grids restored for " << labels[i] << " — skipping fill and fits.\n";
+        continue;
+      }
       plotters[i]->MakePhiALUZPhiMassFitCanvases3D(fXbins, subdir, nMassBins, mMin, mMax, constrainSigma, sigmaRef, sigmaFrac, beamPol);
+      plotters[i]->SavePhiHistogramCache();
     }
   }
 
@@ -4523,7 +4820,7 @@ class DISANAcomparer {
         c->Update();
 
         TString out = hasW ? Form("%s/ALU_vs_zphi_Q%zu_W%zu.pdf", outBase.c_str(), iq, iw) : Form("%s/ALU_vs_zphi_Q%zu.pdf", outBase.c_str(), iq);
-        c->SaveAs(out);
+        SaveCanvas(*c, out);
 
         delete leg;
         delete c;
@@ -4547,7 +4844,12 @@ class DISANAcomparer {
     for (size_t i = 0; i < plotters.size(); ++i) {
       const std::string subdir = baseOutDir + "/" + labels[i];
       std::cout << "→ Extracting R=sigma_L/sigma_T from cos(theta_KK) angular fit for model: " << labels[i] << " → " << subdir << std::endl;
+      if (plotters[i]->LoadPhiHistogramCacheIfValid() && !plotters[i]->GetPhiRLT3D().empty()) {
+        std::cout << "   cached R/r04_00 grids restored for " << labels[i] << " — skipping fill and fits.\n";
+        continue;
+      }
       plotters[i]->MakePhiRLTFromCosTheta3D(fXbins, subdir, nMassBins, mMin, mMax, constrainSigma, sigmaRef, sigmaFrac, beamEnergyGeV);
+      plotters[i]->SavePhiHistogramCache();
     }
   }
 
@@ -4619,7 +4921,7 @@ class DISANAcomparer {
           }
           leg->Draw();
           TString out = hasW ? Form("%s/%s_Q%zu_W%zu.pdf", outBase.c_str(), tag.c_str(), iq, iw) : Form("%s/%s_Q%zu.pdf", outBase.c_str(), tag.c_str(), iq);
-          c->SaveAs(out);
+          SaveCanvas(*c, out);
           delete leg;
           delete c;
         }
@@ -4683,6 +4985,7 @@ class DISANAcomparer {
 
     gSystem->Exec(Form("mkdir -p %s", baseOutDir.c_str()));
 
+    const std::string fillTag = Form("sinphi-moment m=[%.6g,%.6g] pol=%.6g", mMin, mMax, beamPol);
     for (size_t i = 0; i < plotters.size(); ++i) {
       const std::string subdir = baseOutDir + "/" + labels[i];
 
@@ -4690,7 +4993,14 @@ class DISANAcomparer {
                 << "in m(K^{+}K^{-}) ∈ [" << mMin << ", " << mMax << "]"
                 << " for model: " << labels[i] << " → " << subdir << std::endl;
 
+      if (plotters[i]->LoadPhiHistogramCacheIfValid() && !plotters[i]->GetPhiALUCosTheta3D().empty() &&
+          plotters[i]->GetPhiALUCosThetaFillTag() == fillTag) {
+        std::cout << "   cached A_LU^{sinφ}(cosθ_KK) grids restored for " << labels[i] << " — skipping fill.\n";
+        continue;
+      }
+      plotters[i]->SetPhiALUCosThetaFillTag(fillTag);
       plotters[i]->MakePhiALUCosThetaSinPhiMoment3D(fXbins, subdir, mMin, mMax, beamPol);
+      plotters[i]->SavePhiHistogramCache();
     }
   }
 
@@ -4705,6 +5015,7 @@ class DISANAcomparer {
 
     gSystem->Exec(Form("mkdir -p %s", baseOutDir.c_str()));
 
+    const std::string fillTag = Form("sin-over-1plusbcos-fit m=[%.6g,%.6g] pol=%.6g", mMin, mMax, beamPol);
     for (size_t i = 0; i < plotters.size(); ++i) {
       const std::string subdir = baseOutDir + "/" + labels[i];
 
@@ -4713,12 +5024,36 @@ class DISANAcomparer {
                 << "in m(K^{+}K^{-}) ∈ [" << mMin << ", " << mMax << "]"
                 << " for model: " << labels[i] << " → " << subdir << std::endl;
 
+      if (plotters[i]->LoadPhiHistogramCacheIfValid() && !plotters[i]->GetPhiALUCosTheta3D().empty() &&
+          plotters[i]->GetPhiALUCosThetaFillTag() == fillTag) {
+        std::cout << "   cached A_LU(cosθ_KK) grids restored for " << labels[i] << " — skipping fill.\n";
+        continue;
+      }
+      plotters[i]->SetPhiALUCosThetaFillTag(fillTag);
       plotters[i]->MakePhiALUCosTheta_SinOver1PlusbCosFit3D(fXbins, subdir, mMin, mMax, beamPol);
+      plotters[i]->SavePhiHistogramCache();
     }
   }
 
  private:
+  /// Hand a finished canvas to the background renderer.  The clone keeps the
+  /// caller's delete/reuse untouched; with deferred rendering off this is a
+  /// plain inline SaveAs.
+  void SaveCanvas(TCanvas& canvas, const TString& outputPath) {
+    if (!deferRendering_) {
+      canvas.SaveAs(outputPath);
+      return;
+    }
+    canvas.Modified();
+    canvas.Update();
+    auto clone = std::unique_ptr<TCanvas>(static_cast<TCanvas*>(canvas.Clone()));
+    renderQueue_.Enqueue(std::move(clone), outputPath.Data());
+  }
+
   BinManager fXbins;
+  CanvasRenderQueue renderQueue_;
+  bool deferRendering_ = true;
+  bool deferredHistogramBooking_ = false;
   bool plotIndividual = false;
   bool useFittedYields_ = true;
   bool applyCorrection = false;
@@ -0,0 +1,115 @@
+#ifndef DISANA_DATASET_REGISTRY_H
+#define DISANA_DATASET_REGISTRY_H
+
+#include <ROOT/RDataFrame.hxx>
+
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+
+// Shared dataset registry for plotting sessions.
+//
+// The plotting macros build a fresh ROOT::RDataFrame per dfSelected*.root
+// input (data, pi0 MC, gen/accept MC, background variants — the twelve
+// optional RNode arguments of the DISANAplotter constructor) and re-apply the
+// same InitKinematics Defines every time a comparison is redrawn, so a full
+// session opens each file and JITs each Define chain many times over.  The
+// registry opens every (file, tree) pair once, applies the session's common
+// kinematic Defines once, and hands out cheap RNode copies that share the
+// cached computation graph.  Derived selections (e.g. the final DVCS or pi0
+// cuts) are cached per view name the same way.
+//
+// Typical session setup:
+//
+//   DISANAdatasetRegistry reg;
+//   reg.SetDefaultKinematics([&](ROOT::RDF::RNode df) { return InitKinematics(df, Ebeam); });
+//   auto data  = reg.Get("data",  file_data,  "dfSelected_afterFid_afterCorr");
+//   auto pi0mc = reg.Get("pi0mc", file_pi0mc, "dfSelected_afterFid_afterCorr");
+//   auto dataFinal = reg.View("data", "finalDVCS", ApplyFinalDVCSSelections);
+//
+// Registering two names for the same (file, tree) yields the same underlying
+// dataframe, so plots that slice one input several ways still read it once.
+class DISANAdatasetRegistry {
+ public:
+  using NodeTransform = std::function<ROOT::RDF::RNode(ROOT::RDF::RNode)>;
+
+  // Common kinematic Defines applied once to every dataset when it is first
+  // opened.  Set before the first Get(); datasets opened earlier keep the
+  // builder that was active at their registration.
+  void SetDefaultKinematics(NodeTransform builder) { fKinematics = std::move(builder); }
+
+  // Open-or-reuse: the first call for a (filename, treename) pair opens the
+  // file and applies the kinematic Defines; later calls — under this or any
+  // other name — return a copy of the cached node.
+  ROOT::RDF::RNode Get(const std::string& name, const std::string& filename,
+                       const std::string& treename) {
+    auto named = fByName.find(name);
+    if (named != fByName.end()) return named->second->node.value();
+
+    const std::string key = filename + "|" + treename;
+    auto opened = fByFileTree.find(key);
+    if (opened != fByFileTree.end()) {
+      fByName.emplace(name, opened->second);
+      return opened->second->node.value();
+    }
+
+    auto ds = std::make_shared<Dataset>();
+    ds->frame = std::make_shared<ROOT::RDataFrame>(treename, filename);
+    ROOT::RDF::RNode node(*ds->frame);
+    ds->node = fKinematics ? fKinematics(node) : node;
+    fByName.emplace(name, ds);
+    fByFileTree.emplace(key, ds);
+    std::cout << "[DISANAdatasetRegistry] Opened " << filename << " (" << treename << ") as \""
+              << name << "\"\n";
+    return ds->node.value();
+  }
+
+  // Previously registered dataset by name.
+  ROOT::RDF::RNode Get(const std::string& name) const {
+    auto named = fByName.find(name);
+    if (named == fByName.end())
+      throw std::runtime_error("DISANAdatasetRegistry: unknown dataset \"" + name + "\"");
+    return named->second->node.value();
+  }
+
+  bool Has(const std::string& name) const { return fByName.count(name) > 0; }
+
+  // Derived view of a dataset (a selection or extra Defines on top of the
+  // shared kinematics), built once per (dataset, viewName) and cached so the
+  // transform is not re-JITted on every plot call.
+  ROOT::RDF::RNode View(const std::string& name, const std::string& viewName,
+                        const NodeTransform& transform) {
+    auto named = fByName.find(name);
+    if (named == fByName.end())
+      throw std::runtime_error("DISANAdatasetRegistry: unknown dataset \"" + name + "\"");
+    Dataset& ds = *named->second;
+    auto view = ds.views.find(viewName);
+    if (view != ds.views.end()) return view->second;
+    auto built = transform(ds.node.value());
+    ds.views.emplace(viewName, built);
+    return built;
+  }
+
+  // Drop every cached frame/node (closes the files once the handed-out RNodes
+  // are gone too).
+  void Clear() {
+    fByName.clear();
+    fByFileTree.clear();
+  }
+
+ private:
+  struct Dataset {
+    std::shared_ptr<ROOT::RDataFrame> frame;  // keeps the file open
+    std::optional<ROOT::RDF::RNode> node;     // frame + common kinematic Defines
+    std::map<std::string, ROOT::RDF::RNode> views;
+  };
+
+  NodeTransform fKinematics;
+  std::map<std::string, std::shared_ptr<Dataset>> fByName;
+  std::map<std::string, std::shared_ptr<Dataset>> fByFileTree;  // "file|tree" -> dataset
+};
+
+#endif  // DISANA_DATASET_REGISTRY_H
@@ -3,18 +3,27 @@
 
 #include <TFile.h>
 #include <TH1.h>
+#include <TH3.h>
+#include <TNamed.h>
+#include <TROOT.h>
 #include <TTree.h>
+#include <TVectorD.h>
 
+#include <ROOT/RDFHelpers.hxx>
 #include <ROOT/RDataFrame.hxx>
 #include <algorithm>
 #include <atomic>
 #include <cmath>
+#include <cstdio>
 #include <functional>
 #include <limits>
 #include <memory>
+#include <random>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include "DISANAFitModels.h"
 #include "DISANAMath.h"
 
 class BinManager;
@@ -114,6 +123,10 @@ class DISANAplotter {
     phi_alu_zphi_QW_.clear();
   }
   void SetLuminosity(double L) { luminosity_nb_inv = L; }
+  // Number of Poisson-bootstrap replicas accumulated during the single-pass
+  // phi fills (0 disables; ~100 gives percent-level spread estimates for the
+  // cost of B extra weight draws per in-window event, not B extra passes).
+  void SetBootstrapReplicas(size_t n) { bootstrapReplicas_ = n; }
   double GetBeamEnergy() const { return beam_energy; }
   ROOT::RDF::RNode GetRDF() { return rdf; }
   ROOT::RDF::RNode GetRDF_Pi0Data() { return rdf_pi0_data.value(); }
@@ -223,6 +236,277 @@ class DISANAplotter {
     return phi_mean_GammaV_xBt_[ixB][it];
   }
 
+  // ── Persistent histogram cache ───────────────────────────────────────────
+  // The φ cache grids (phi_dsdt_QW_ and friends) only live for one process,
+  // so every plotting session repays the full RDF pass and all per-bin mass
+  // fits just to restyle a canvas.  EnablePhiHistogramCache() points the
+  // plotter at a sidecar ROOT file keyed by a hash of the bin edges, cut
+  // strings and input file list; LoadPhiHistogramCacheIfValid() restores
+  // every grid stored under a matching hash and SavePhiHistogramCache()
+  // writes the currently filled ones after an expensive fill.  The
+  // *_FromCache plots then work from the restored grids in seconds.
+
+  // FNV-1a over the bin edges, cut strings and input files — any change in
+  // binning, selection or dataset invalidates the cache.
+  static std::string HashPhiPlotConfig(const BinManager& bins,
+                                       const std::vector<std::string>& cuts,
+                                       const std::vector<std::string>& inputFiles) {
+    unsigned long long h = 1469598103934665603ULL;
+    auto mixBytes = [&h](const void* data, size_t n) {
+      const unsigned char* p = static_cast<const unsigned char*>(data);
+      for (size_t i = 0; i < n; ++i) {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+      }
+    };
+    auto mixEdges = [&](const std::vector<double>& e) { mixBytes(e.data(), e.size() * sizeof(double)); };
+    auto mixString = [&](const std::string& s) { mixBytes(s.c_str(), s.size() + 1); };
+
+    mixEdges(bins.GetQ2Bins());
+    mixEdges(bins.GetTBins());
+    mixEdges(bins.GetTprimeBins());
+    mixEdges(bins.GetWBins());
+    mixEdges(bins.GetXBBins());
+    for (const auto& xb : bins.GetXBBinsByQ2()) mixEdges(xb);
+    mixEdges(bins.GetCosThetaKKBins());
+    mixEdges(bins.GetTrentoPhiBins());
+    mixEdges(bins.GetZPhiBins());
+    for (const auto& c : cuts) mixString(c);
+    for (const auto& fn : inputFiles) mixString(fn);
+    return std::string(Form("%016llx", h));
+  }
+
+  void EnablePhiHistogramCache(const std::string& cacheFile, const std::string& configHash) {
+    phiCacheFile_ = cacheFile;
+    phiCacheHash_ = configHash;
+    phiCacheLoaded_ = false;
+  }
+  bool PhiHistogramCacheLoaded() const { return phiCacheLoaded_; }
+
+  // Three physically different estimators (helicity-split mass fit, sinφ
+  // moment, A·sinφ/(1+b·cosφ) fit) fill the same phi_alu_cos_QW_ grid, and
+  // HashPhiPlotConfig only covers binning, cuts and inputs.  The fill tag
+  // identifies the estimator and its numeric parameters, travels with the
+  // cached grid, and must match before a restored grid is reused — so one
+  // estimator's asymmetries are never served as another's, and changed mass
+  // windows or polarization refill instead of reusing stale values.
+  void SetPhiALUCosThetaFillTag(const std::string& tag) { phiAluCosFillTag_ = tag; }
+  const std::string& GetPhiALUCosThetaFillTag() const { return phiAluCosFillTag_; }
+
+  // Restore all φ grids from the sidecar file.  Returns false (leaving the
+  // in-memory grids untouched) when no cache is configured, the file is
+  // missing, or it was written for a different configuration hash.
+  bool LoadPhiHistogramCacheIfValid() {
+    phiCacheLoaded_ = false;
+    if (phiCacheFile_.empty()) return false;
+    if (gSystem->AccessPathName(phiCacheFile_.c_str())) return false;  // true == not readable
+
+    std::unique_ptr<TFile> f(TFile::Open(phiCacheFile_.c_str(), "READ"));
+    if (!f || f->IsZombie()) return false;
+
+    auto* tag = (TNamed*)f->Get("config_hash");
+    if (!tag || phiCacheHash_ != tag->GetTitle()) {
+      std::cout << "[LoadPhiHistogramCache] " << phiCacheFile_ << " is stale (configuration changed) — will refill.\n";
+      return false;
+    }
+
+    auto readGrid2D = [&](const char* name, std::vector<std::vector<TH1D*>>& g) {
+      auto* dims = (TNamed*)f->Get(Form("%s__dims", name));
+      size_t nQ = 0, nW = 0;
+      if (!dims || sscanf(dims->GetTitle(), "%zu %zu", &nQ, &nW) != 2 || !nQ) return;
+      for (auto& row : g)
+        for (auto* h : row) delete h;
+      g.assign(nQ, std::vector<TH1D*>(nW, nullptr));
+      for (size_t iq = 0; iq < nQ; ++iq)
+        for (size_t iw = 0; iw < nW; ++iw) {
+          auto* h = (TH1D*)f->Get(Form("%s__q%zu_w%zu", name, iq, iw));
+          if (h) {
+            h->SetDirectory(nullptr);
+            g[iq][iw] = h;
+          }
+        }
+    };
+    auto readGrid1D = [&](const char* name, std::vector<TH1D*>& g) {
+      auto* dims = (TNamed*)f->Get(Form("%s__dims", name));
+      size_t n = 0;
+      if (!dims || sscanf(dims->GetTitle(), "%zu", &n) != 1 || !n) return;
+      for (auto* h : g) delete h;
+      g.assign(n, nullptr);
+      for (size_t i = 0; i < n; ++i) {
+        auto* h = (TH1D*)f->Get(Form("%s__x%zu", name, i));
+        if (h) {
+          h->SetDirectory(nullptr);
+          g[i] = h;
+        }
+      }
+    };
+    auto readMeans3D = [&](const char* name, std::vector<std::vector<std::vector<double>>>& m) {
+      auto* dims = (TNamed*)f->Get(Form("%s__dims", name));
+      size_t nQ = 0, nW = 0;
+      if (!dims || sscanf(dims->GetTitle(), "%zu %zu", &nQ, &nW) != 2 || !nQ) return;
+      m.assign(nQ, std::vector<std::vector<double>>(nW));
+      for (size_t iq = 0; iq < nQ; ++iq)
+        for (size_t iw = 0; iw < nW; ++iw) {
+          auto* v = (TVectorD*)f->Get(Form("%s__q%zu_w%zu", name, iq, iw));
+          if (v) {
+            m[iq][iw].assign(v->GetMatrixArray(), v->GetMatrixArray() + v->GetNoElements());
+            delete v;
+          }
+        }
+    };
+    auto readMeans2D = [&](const char* name, std::vector<std::vector<double>>& m) {
+      auto* dims = (TNamed*)f->Get(Form("%s__dims", name));
+      size_t n = 0;
+      if (!dims || sscanf(dims->GetTitle(), "%zu", &n) != 1 || !n) return;
+      m.assign(n, std::vector<double>());
+      for (size_t i = 0; i < n; ++i) {
+        auto* v = (TVectorD*)f->Get(Form("%s__x%zu", name, i));
+        if (v) {
+          m[i].assign(v->GetMatrixArray(), v->GetMatrixArray() + v->GetNoElements());
+          delete v;
+        }
+      }
+    };
+
+    readGrid2D("phi_dsdt_QW", phi_dsdt_QW_);
+    readGrid2D("phi_nsig_QW", phi_nsig_QW_);
+    readGrid2D("phi_accept_QW", phi_accept_QW_);
+    readGrid2D("phi_eff_QW", phi_eff_QW_);
+    readGrid2D("phi_rad_QW", phi_rad_QW_);
+    readGrid2D("phi_alu_cos_QW", phi_alu_cos_QW_);
+    phiAluCosFillTag_.clear();
+    if (auto* fillTag = (TNamed*)f->Get("phi_alu_cos_QW__filltag")) phiAluCosFillTag_ = fillTag->GetTitle();
+    readGrid2D("phi_alu_zphi_QW", phi_alu_zphi_QW_);
+    readGrid2D("phi_bsa_trentophi_QW", phi_bsa_trentophi_QW_);
+    readGrid2D("phi_rlt_QW", phi_rlt_QW_);
+    readGrid2D("phi_r04_QW", phi_r04_QW_);
+    readMeans3D("phi_mean_xB_QW", phi_mean_xB_QW_);
+    readMeans3D("phi_mean_W_QW", phi_mean_W_QW_);
+    readMeans3D("phi_mean_GammaV_QW", phi_mean_GammaV_QW_);
+    readGrid1D("phi_dsdt_xBt", phi_dsdt_xBt_);
+    readGrid1D("phi_nsig_xBt", phi_nsig_xBt_);
+    readGrid1D("phi_accept_xBt", phi_accept_xBt_);
+    readGrid1D("phi_eff_xBt", phi_eff_xBt_);
+    readGrid1D("phi_rad_xBt", phi_rad_xBt_);
+    readMeans2D("phi_mean_xB_xBt", phi_mean_xB_xBt_);
+    readMeans2D("phi_mean_W_xBt", phi_mean_W_xBt_);
+    readMeans2D("phi_mean_Q2_xBt", phi_mean_Q2_xBt_);
+    readMeans2D("phi_mean_tmin_xBt", phi_mean_tmin_xBt_);
+    readMeans2D("phi_mean_GammaV_xBt", phi_mean_GammaV_xBt_);
+
+    phiCacheLoaded_ = true;
+    std::cout << "[LoadPhiHistogramCache] restored φ histogram grids from " << phiCacheFile_ << "\n";
+    return true;
+  }
+
+  // Write every non-empty φ grid (plus the configuration hash) to the
+  // sidecar file.  Grids restored by a previous load are written back too,
+  // so caches built by different workflows accumulate in one file.
+  void SavePhiHistogramCache() {
+    if (phiCacheFile_.empty()) return;
+
+    std::unique_ptr<TFile> f(TFile::Open(phiCacheFile_.c_str(), "RECREATE"));
+    if (!f || f->IsZombie()) {
+      std::cerr << "[SavePhiHistogramCache] cannot open " << phiCacheFile_ << " for writing.\n";
+      return;
+    }
+
+    TNamed tag("config_hash", phiCacheHash_.c_str());
+    tag.Write();
+
+    auto writeGrid2D = [&](const char* name, const std::vector<std::vector<TH1D*>>& g) {
+      if (g.empty()) return;
+      TNamed dims(Form("%s__dims", name), Form("%zu %zu", g.size(), g[0].size()));
+      dims.Write();
+      for (size_t iq = 0; iq < g.size(); ++iq)
+        for (size_t iw = 0; iw < g[iq].size(); ++iw)
+          if (g[iq][iw]) g[iq][iw]->Write(Form("%s__q%zu_w%zu", name, iq, iw));
+    };
+    auto writeGrid1D = [&](const char* name, const std::vector<TH1D*>& g) {
+      if (g.empty()) return;
+      TNamed dims(Form("%s__dims", name), Form("%zu", g.size()));
+      dims.Write();
+      for (size_t i = 0; i < g.size(); ++i)
+        if (g[i]) g[i]->Write(Form("%s__x%zu", name, i));
+    };
+    auto writeMeans3D = [&](const char* name, const std::vector<std::vector<std::vector<double>>>& m) {
+      if (m.empty()) return;
+      TNamed dims(Form("%s__dims", name), Form("%zu %zu", m.size(), m[0].size()));
+      dims.Write();
+      for (size_t iq = 0; iq < m.size(); ++iq)
+        for (size_t iw = 0; iw < m[iq].size(); ++iw) {
+          if (m[iq][iw].empty()) continue;
+          TVectorD v((int)m[iq][iw].size(), m[iq][iw].data());
+          v.Write(Form("%s__q%zu_w%zu", name, iq, iw));
+        }
+    };
+    auto writeMeans2D = [&](const char* name, const std::vector<std::vector<double>>& m) {
+      if (m.empty()) return;
+      TNamed dims(Form("%s__dims", name), Form("%zu", m.size()));
+      dims.Write();
+      for (size_t i = 0; i < m.size(); ++i) {
+        if (m[i].empty()) continue;
+        TVectorD v((int)m[i].size(), m[i].data());
+        v.Write(Form("%s__x%zu", name, i));
+      }
+    };
+
+    writeGrid2D("phi_dsdt_QW", phi_dsdt_QW_);
+    writeGrid2D("phi_nsig_QW", phi_nsig_QW_);
+    writeGrid2D("phi_accept_QW", phi_accept_QW_);
+    writeGrid2D("phi_eff_QW", phi_eff_QW_);
+    writeGrid2D("phi_rad_QW", phi_rad_QW_);
+    writeGrid2D("phi_alu_cos_QW", phi_alu_cos_QW_);
+    if (!phi_alu_cos_QW_.empty() && !phiAluCosFillTag_.empty()) {
+      TNamed fillTag("phi_alu_cos_QW__filltag", phiAluCosFillTag_.c_str());
+      fillTag.Write();
+    }
+    writeGrid2D("phi_alu_zphi_QW", phi_alu_zphi_QW_);
+    writeGrid2D("phi_bsa_trentophi_QW", phi_bsa_trentophi_QW_);
+    writeGrid2D("phi_rlt_QW", phi_rlt_QW_);
+    writeGrid2D("phi_r04_QW", phi_r04_QW_);
+    writeMeans3D("phi_mean_xB_QW", phi_mean_xB_QW_);
+    writeMeans3D("phi_mean_W_QW", phi_mean_W_QW_);
+    writeMeans3D("phi_mean_GammaV_QW", phi_mean_GammaV_QW_);
+    writeGrid1D("phi_dsdt_xBt", phi_dsdt_xBt_);
+    writeGrid1D("phi_nsig_xBt", phi_nsig_xBt_);
+    writeGrid1D("phi_accept_xBt", phi_accept_xBt_);
+    writeGrid1D("phi_eff_xBt", phi_eff_xBt_);
+    writeGrid1D("phi_rad_xBt", phi_rad_xBt_);
+    writeMeans2D("phi_mean_xB_xBt", phi_mean_xB_xBt_);
+    writeMeans2D("phi_mean_W_xBt", phi_mean_W_xBt_);
+    writeMeans2D("phi_mean_Q2_xBt", phi_mean_Q2_xBt_);
+    writeMeans2D("phi_mean_tmin_xBt", phi_mean_tmin_xBt_);
+    writeMeans2D("phi_mean_GammaV_xBt", phi_mean_GammaV_xBt_);
+
+    f->Close();
+    std::cout << "[SavePhiHistogramCache] wrote φ histogram grids to " << phiCacheFile_ << "\n";
+  }
+
+  // ── Correction response cache ────────────────────────────────────────────
+  // The pi0-contamination and radiative-correction ratios only depend on the
+  // MC samples and the binning, yet ComputePi0Corr/ComputeRadCorr re-derived
+  // them from the four MC RNodes on every call — once per cross-section
+  // variant per plotting session, i.e. on every styling iteration.  With a
+  // cache enabled the ratios are computed in one dedicated MC pass, kept for
+  // the session, and persisted to a sidecar file keyed by a configuration
+  // hash (HashPhiPlotConfig over the bin edges and the MC input file lists
+  // works here too); applying them stays the cheap bin-by-bin multiplication
+  // in UsePi0Correction/UseRadCorrection.  Only a hash change — new MC or
+  // new binning — triggers a re-read of the MC.
+  void EnableCorrectionResponseCache(const std::string& cacheFile, const std::string& configHash) {
+    corrCacheFile_ = cacheFile;
+    corrCacheHash_ = configHash;
+    pi0_corr_cache_.clear();
+    rad_corr_cache_.clear();
+  }
+
+  // Deferred booking: when enabled, Generate* methods never trigger an event
+  // loop themselves; axis-range scans and histograms are only booked, and
+  // CollectHistogramHandles() resolves everything so one RunGraphs call per
+  // dataset fills all of them (see DISANAcomparer::MaterializeKinematicHistograms).
+  void SetDeferredHistogramBooking(bool on) { deferredBooking_ = on; }
+
   void GenerateKinematicHistos(const std::string& type) {
     std::vector<std::string> vars = {"p", "theta", "phi"};  // for DVCS analysis
     for (const auto& v : vars) {
@@ -233,6 +517,18 @@ class DISANAplotter {
       if (it != kinematicAxisRanges.end()) {
         histMin = it->second.first;
         histMax = it->second.second;
+      } else if (deferredBooking_) {
+        auto minVal = rdf.Min(base);
+        auto maxVal = rdf.Max(base);
+        pendingRanges_.push_back({minVal, maxVal});
+        pendingBookings_.push_back([this, base, minVal, maxVal]() {
+          const double lo = *minVal;
+          const double hi = *maxVal;
+          const double margin = std::max(1e-3, 0.05 * (hi - lo));
+          kinematicAxisRanges[base] = {lo - margin, hi + margin};
+          kinematicHistos.push_back(rdf.Histo1D({base.c_str(), "", 100, lo - margin, hi + margin}, base));
+        });
+        continue;
       } else {
         auto minVal = rdf.Min(base);
         auto maxVal = rdf.Max(base);
@@ -276,6 +572,18 @@ class DISANAplotter {
       if (it != kinematicAxisRanges.end()) {
         histMin = it->second.first;
         histMax = it->second.second;
+      } else if (deferredBooking_) {
+        auto minVal = rdf.Min(base);
+        auto maxVal = rdf.Max(base);
+        pendingRanges_.push_back({minVal, maxVal});
+        pendingBookings_.push_back([this, base, minVal, maxVal]() {
+          const double lo = *minVal;
+          const double hi = *maxVal;
+          const double margin = std::max(1e-3, 0.05 * (hi - lo));
+          kinematicAxisRanges[base] = {lo - margin, hi + margin};
+          kinematicHistos.push_back(rdf.Histo1D({base.c_str(), "", 100, lo - margin, hi + margin}, base));
+        });
+        continue;
       } else {
         auto minVal = rdf.Min(base);
         auto maxVal = rdf.Max(base);
@@ -320,6 +628,19 @@ class DISANAplotter {
       if (it != kinematicAxisRanges.end()) {
         histMin = it->second.first;
         histMax = it->second.second;
+      } else if (deferredBooking_) {
+        auto df_tmp = (v == "p") ? rdf_pi0_data->Filter(base + " > -100") : *rdf_pi0_data;
+        auto minVal = df_tmp.Min(base);
+        auto maxVal = df_tmp.Max(base);
+        pendingRanges_.push_back({minVal, maxVal});
+        pendingBookings_.push_back([this, base, basename, minVal, maxVal]() {
+          const double lo = *minVal;
+          const double hi = *maxVal;
+          const double margin = std::max(1e-3, 0.05 * (hi - lo));
+          kinematicAxisRanges[base] = {lo - margin, hi + margin};
+          kinematicHistos.push_back(rdf_pi0_data->Histo1D({basename.c_str(), "", 100, lo - margin, hi + margin}, base));
+        });
+        continue;
       } else {
         auto df_tmp = (v == "p") ? rdf_pi0_data->Filter(base + " > -100") : *rdf_pi0_data;
         auto lo = *df_tmp.Min(base);
@@ -345,12 +666,36 @@ class DISANAplotter {
   void SetDVCSWeightFunction(DVCSWeightFunction weightFunc) { dvcs_weight_function_ = std::move(weightFunc); }
 
   std::vector<TH1*> GetAllHistograms() {
+    ResolveDeferredBookings();
     std::vector<TH1*> all;
     for (auto& h : kinematicHistos) all.push_back(h.GetPtr());
     for (auto& h : disHistos) all.push_back(h.GetPtr());
     return all;
   }
 
+  // Resolve any pending axis-range scans (one RunGraphs pass) and book the
+  // histograms that were waiting on them.
+  void ResolveDeferredBookings() {
+    if (pendingBookings_.empty()) return;
+    std::vector<ROOT::RDF::RResultHandle> rangeHandles;
+    for (auto& pr : pendingRanges_) {
+      rangeHandles.emplace_back(pr.first);
+      rangeHandles.emplace_back(pr.second);
+    }
+    if (!rangeHandles.empty()) ROOT::RDF::RunGraphs(rangeHandles);
+    for (auto& book : pendingBookings_) book();
+    pendingBookings_.clear();
+    pendingRanges_.clear();
+  }
+
+  // Append every booked histogram result to `handles` without triggering any
+  // event loop; the caller materializes them in one RunGraphs call.
+  void CollectHistogramHandles(std::vector<ROOT::RDF::RResultHandle>& handles) {
+    ResolveDeferredBookings();
+    for (auto& h : kinematicHistos) handles.emplace_back(h);
+    for (auto& h : disHistos) handles.emplace_back(h);
+  }
+
   std::vector<std::vector<std::vector<TH1D*>>> ComputeDVCS_CrossSection(const BinManager& bins) {
     auto result = kinCalc.ComputeDVCS_CrossSection_Weighted(rdf, bins, luminosity_nb_inv, dvcs_weight_function_);
     if (dopi0corr) {
@@ -377,7 +722,7 @@ class DISANAplotter {
   }
 
   std::vector<std::vector<std::vector<TH1D*>>> ComputePolDVCS_CrossSection(int pol, const BinManager& bins) {
-    auto rdf_pol = rdf.Filter(Form("REC_Event_helicity == %d", pol));
+    auto rdf_pol = rdf.Filter([pol](short hel) { return hel == pol; }, {"REC_Event_helicity"}, Form("helicity == %d", pol));
     const auto n_all = static_cast<double>(rdf.Count().GetValue());
     const auto n_pol = static_cast<double>(rdf_pol.Count().GetValue());
     auto lumi_pol = luminosity_nb_inv * n_pol / n_all;
@@ -407,28 +752,17 @@ class DISANAplotter {
     return result;
   }
 
-  /// BSA computations // we need to have refined version of this codes
+  /// BSA computations
   std::vector<std::vector<std::vector<TH1D*>>> ComputeBSA(const BinManager& bins, double pol = 1.0) {
-    // 1) Helicity selection
-    auto rdf_pos = rdf.Filter("REC_Event_helicity ==  1");
-    auto rdf_neg = rdf.Filter("REC_Event_helicity == -1");
-    // 2) One-pass cross-section per helicity
-
-    auto sigma_pos_3d = kinCalc.ComputeDVCS_CrossSection(rdf_pos, bins, luminosity_nb_inv);
-    auto sigma_neg_3d = kinCalc.ComputeDVCS_CrossSection(rdf_neg, bins, luminosity_nb_inv);
-
-    auto result = kinCalc.ComputeBeamSpinAsymmetry(sigma_pos_3d, sigma_neg_3d, pol);
+    // Single pass per sample: the helicity count and sinφ moment sums are
+    // accumulated together and the asymmetry comes out in closed form, so no
+    // helicity-filtered per-helicity cross-section passes are needed (the
+    // luminosity factors cancel in the ratio anyway).
+    auto result = kinCalc.ComputeBeamSpinAsymmetryOnePass(rdf, bins, pol);
 
     if (dopi0corr) {
-      auto rdf_pi0_data_pos = rdf_pi0_data->Filter("REC_Event_helicity ==  1");
-      auto rdf_pi0_data_neg = rdf_pi0_data->Filter("REC_Event_helicity == -1");
-      // 2) One-pass cross-section per helicity
-
-      auto sigma_pi0_pos_3d = kinCalc.ComputeDVCS_CrossSection(rdf_pi0_data_pos, bins, luminosity_nb_inv);
-      auto sigma_pi0_neg_3d = kinCalc.ComputeDVCS_CrossSection(rdf_pi0_data_neg, bins, luminosity_nb_inv);
-
       auto corr3D = ComputePi0Corr(bins);
-      auto Api0 = kinCalc.ComputeBeamSpinAsymmetry(sigma_pi0_pos_3d, sigma_pi0_neg_3d, pol);
+      auto Api0 = kinCalc.ComputeBeamSpinAsymmetryOnePass(*rdf_pi0_data, bins, pol);
       result = UsePi0CorrectionForBSA(result, Api0, corr3D);
     }
     return result;
@@ -436,11 +770,17 @@ class DISANAplotter {
 
   /// BSA computations // we need to have refined version of this codes
   std::vector<std::vector<std::vector<TH1D*>>> ComputePi0Corr(const BinManager& bins) {
+    // Session memo + sidecar cache: the ratio grid is derived from the MC
+    // exactly once per configuration (see EnableCorrectionResponseCache).
+    if (!pi0_corr_cache_.empty()) return pi0_corr_cache_;
+    if (LoadCorrectionGrid3D("pi0_corr", pi0_corr_cache_)) return pi0_corr_cache_;
     if (!rdf_dvcs_pi0mc || !rdf_pi0_pi0mc || !rdf_pi0_data) {
       std::cerr << "[ComputePi0Corr] Missing input RDFs.\n";
       return {};
     }
-    return kinCalc.CalcPi0Corr(*rdf_dvcs_pi0mc, *rdf_pi0_pi0mc, rdf, *rdf_pi0_data, bins);
+    pi0_corr_cache_ = kinCalc.CalcPi0Corr(*rdf_dvcs_pi0mc, *rdf_pi0_pi0mc, rdf, *rdf_pi0_data, bins);
+    SaveCorrectionGrid3D("pi0_corr", pi0_corr_cache_);
+    return pi0_corr_cache_;
   }
 
   std::vector<std::vector<std::vector<TH1D*>>> ComputePi0DVCSdiffmc(const BinManager& bins) {
@@ -584,11 +924,16 @@ class DISANAplotter {
   }
 
   std::vector<std::vector<std::vector<TH1D*>>> ComputeRadCorr(const BinManager& bins) {
+    // Session memo + sidecar cache, same scheme as ComputePi0Corr.
+    if (!rad_corr_cache_.empty()) return rad_corr_cache_;
+    if (LoadCorrectionGrid3D("rad_corr", rad_corr_cache_)) return rad_corr_cache_;
     if (!rdf_dvcsmc_rad || !rdf_dvcsmc_norad) {
       std::cerr << "[ComputeRadCorr] Missing input RDFs.\n";
       return {};
     }
-    return kinCalc.CalcRadiativeCorr(*rdf_dvcsmc_rad, *rdf_dvcsmc_norad, bins);
+    rad_corr_cache_ = kinCalc.CalcRadiativeCorr(*rdf_dvcsmc_rad, *rdf_dvcsmc_norad, bins);
+    SaveCorrectionGrid3D("rad_corr", rad_corr_cache_);
+    return rad_corr_cache_;
   }
   std::vector<std::vector<std::vector<TH1D*>>> UseRadCorrection(const std::vector<std::vector<std::vector<TH1D*>>>& xs3D,
                                                                 const std::vector<std::vector<std::vector<TH1D*>>>& corr3D) {
@@ -887,17 +1232,36 @@ class DISANAplotter {
     phi_mean_GammaV_QW_.assign(nQ, std::vector<std::vector<double>>(nW, std::vector<double>(nT, std::numeric_limits<double>::quiet_NaN())));
     static std::atomic<unsigned long> uid_dsdt{0};
 
+    // ── Single event loop: fill every (Q2,W,t') mass spectrum plus the
+    //    per-bin kinematic sums at once, instead of one Filter chain and
+    //    three Mean() triggers per bin (~4 passes x nQ*nW*nT before).
+    const auto spectra = FillPhiBinSpectraSinglePass(rdf, q2Edges, wEdges, tPrimeEdges, "mtprime",
+                                                     nMassBins, mMin, mMax);
+
+    // ── Per-bin fits on the worker pool (independent once the spectra are
+    //    filled); canvases are rendered afterwards inside the pool call.
+    std::vector<PhiMassFitJob> fitJobs(nQ * nW * nT);
+    for (size_t iq = 0; iq < nQ; ++iq)
+      for (size_t iw = 0; iw < nW; ++iw)
+        for (size_t it = 0; it < nT; ++it) {
+          const size_t idxBin = spectra.Index(iq, iw, it);
+          auto tagRawBin = hasW
+              ? Form("Q2_%.1f_%.1f__W_%.1f_%.2f__tprime_%.1f_%.1f",
+                     q2Edges[iq], q2Edges[iq + 1], wEdges[iw], wEdges[iw + 1],
+                     tPrimeEdges[it], tPrimeEdges[it + 1])
+              : Form("Q2_%.1f_%.1f__tprime_%.1f_%.1f",
+                     q2Edges[iq], q2Edges[iq + 1], tPrimeEdges[it], tPrimeEdges[it + 1]);
+          std::string tagBin = tagRawBin;
+          std::replace(tagBin.begin(), tagBin.end(), '.', '_');
+          fitJobs[idxBin].hist   = spectra.mass[idxBin].get();
+          fitJobs[idxBin].tagRaw = tagBin;
+        }
+    RunPhiMassFitPool(fitJobs, outDirPerModel, constrainSigma, sigmaRef, sigmaFrac);
+
     for (size_t iq = 0; iq < nQ; ++iq) {
       out[iq].resize(nW);
 
-      const double qLo = q2Edges[iq], qHi = q2Edges[iq + 1];
-      auto df_q = rdf.Filter([=](double Q2) { return Q2 > qLo && Q2 <= qHi; }, {"Q2"});
-
       for (size_t iw = 0; iw < nW; ++iw) {
-        const double wLo = hasW ? wEdges[iw] : 0.0;
-        const double wHi = hasW ? wEdges[iw + 1] : 1e9;
-        auto df_qw = df_q.Filter([=](double W) { return (!hasW) || (W > wLo && W <= wHi); }, {"W"});
-
         out[iq][iw].resize(nT);
 
         // --- NEW: create the dσ/dt histogram for this (Q2,W) slice (if we will compute) ---
@@ -916,26 +1280,15 @@ class DISANAplotter {
         }
 
         for (size_t it = 0; it < nT; ++it) {
-          const double tLo = tPrimeEdges[it], tHi = tPrimeEdges[it + 1];
-          const double dT     = tHi - tLo;
+          const double dT     = tPrimeEdges[it + 1] - tPrimeEdges[it];
           const double binVol = dT;   // dσ/dt — divide only by Δt'
 
-          auto df_bin = df_qw.Filter(
-              [=](double mtp) { return mtp > tLo && mtp <= tHi; }, {"mtprime"});
-
-          // ── Bin label for output files ──────────────────────────────────
-          auto tagRawBin = hasW
-              ? Form("Q2_%.1f_%.1f__W_%.1f_%.2f__tprime_%.1f_%.1f",
-                     qLo, qHi, wLo, wHi, tLo, tHi)
-              : Form("Q2_%.1f_%.1f__tprime_%.1f_%.1f",
-                     qLo, qHi, tLo, tHi);
-          std::string tagBin = tagRawBin;
-          std::replace(tagBin.begin(), tagBin.end(), '.', '_');
+          const size_t idxBin = spectra.Index(iq, iw, it);
 
-          // ── Shared mass-fit kernel (same function as acceptance & eff) ──
-          const auto yData = FitPhiMassYieldAndSave(
-              df_bin, outDirPerModel, tagBin, "",
-              nMassBins, mMin, mMax, constrainSigma, sigmaRef, sigmaFrac);
+          // ── Shared mass-fit kernel (same function as acceptance & eff);
+          //    already run on the worker pool above.
+          const std::string& tagBin = fitJobs[idxBin].tagRaw;
+          const auto& yData = fitJobs[idxBin].result;
 
           if (!yData.valid) {
             if (luminosity_nb_inv > 0.0 && phi_dsdt_QW_[iq][iw]) {
@@ -949,9 +1302,10 @@ class DISANAplotter {
           const double Nsig_err = yData.dN;
 
           // ── Mean kinematics (needed for CSV / Gamma_v export) ───────────
-          const double mean_xB = *df_bin.Mean("xB");
-          const double mean_W  = *df_bin.Mean("W");
-          const double mean_Gv = *df_bin.Mean("Gamma_v");
+          const long long nEv = spectra.count[idxBin];
+          const double mean_xB = nEv > 0 ? spectra.sum_xB[idxBin] / nEv : 0.0;
+          const double mean_W  = nEv > 0 ? spectra.sum_W [idxBin] / nEv : 0.0;
+          const double mean_Gv = nEv > 0 ? spectra.sum_Gv[idxBin] / nEv : 0.0;
 
           // ── Cross-section computation ───────────────────────────────────
           if (luminosity_nb_inv > 0.0 && phi_dsdt_QW_[iq][iw]) {
@@ -1052,22 +1406,52 @@ class DISANAplotter {
 
     static std::atomic<unsigned long> uid_acc{0};
 
-    // ── Loop over (Q2, W) slices ─────────────────────────────────────────────
+    // ── One event loop per MC sample over the full (Q2, W, t') grid ──────────
+    // The generated side is pure signal (no background), so raw counts are
+    // correct and a counts-only map suffices; the reconstructed side also
+    // fills the per-cell K+K- spectra the fitted-yield extraction needs.
+    // The per-(Q2, W) t' histograms below are projections of these maps, so
+    // each MC sample is read once instead of once per grid cell.
+    const auto genMap = FillPhiCountMap3D(*rdf_gen_phimc, q2Edges, wEdges, tPrimeEdges, genTPrimeVar);
+    const auto recMap = FillPhiCountMap3D(*rdf_accept_phimc, q2Edges, wEdges, tPrimeEdges, recTPrimeVar,
+                                          /*nMassBins=*/200, /*mMin=*/0.8, /*mMax=*/1.8);
+
+    // ── N_rec: phi signal yield from K+K- mass fit on reconstructed MC ──────
+    // We MUST fit (not just count) because the reconstructed MC sample
+    // contains combinatorial background exactly like the data.  Using raw
+    // event counts would overestimate N_rec and therefore overestimate A,
+    // which would make the cross-section systematically too low.
+    // The fit model is identical to MakePhiMassFitCanvases3D so that the
+    // acceptance and the data yield are extracted in exactly the same way.
+    // All grid cells are fitted in one batch on the worker pool.
+    std::vector<PhiMassFitJob> fitJobs(nQ * nW * nT);
     for (size_t iq = 0; iq < nQ; ++iq) {
       const double qLo = q2Edges[iq], qHi = q2Edges[iq + 1];
+      for (size_t iw = 0; iw < nW; ++iw) {
+        const double wLo = hasW ? wEdges[iw] : 0.0;
+        const double wHi = hasW ? wEdges[iw + 1] : 1e9;
+        for (size_t it = 0; it < nT; ++it) {
+          const double tLo = tPrimeEdges[it], tHi = tPrimeEdges[it + 1];
+          auto& job = fitJobs[recMap.Index(iq, iw, it)];
+          job.hist = recMap.mass[recMap.Index(iq, iw, it)].get();
+          job.tagRaw = hasW
+              ? Form("MCrecMassFit_Q2_%.2f_%.2f__W_%.2f_%.2f__T_%.3f_%.3f",
+                     qLo, qHi, wLo, wHi, tLo, tHi)
+              : Form("MCrecMassFit_Q2_%.2f_%.2f__T_%.3f_%.3f",
+                     qLo, qHi, tLo, tHi);
+        }
+      }
+    }
+    RunPhiMassFitPool(fitJobs, outDirPerModel, constrainSigma, sigmaRef, sigmaFrac);
 
-      // Filter the MC RDFs to this Q2 slice
-      auto df_gen_q = rdf_gen_phimc->Filter([=](double Q2) { return Q2 > qLo && Q2 <= qHi; }, {"Q2"});
-      auto df_rec_q = rdf_accept_phimc->Filter([=](double Q2) { return Q2 > qLo && Q2 <= qHi; }, {"Q2"});
+    // ── Loop over (Q2, W) slices ─────────────────────────────────────────────
+    for (size_t iq = 0; iq < nQ; ++iq) {
+      const double qLo = q2Edges[iq], qHi = q2Edges[iq + 1];
 
       for (size_t iw = 0; iw < nW; ++iw) {
         const double wLo = hasW ? wEdges[iw] : 0.0;
         const double wHi = hasW ? wEdges[iw + 1] : 1e9;
 
-        // Filter the MC RDFs to this W slice
-        auto df_gen_qw = df_gen_q.Filter([=](double W) { return (!hasW) || (W > wLo && W <= wHi); }, {"W"});
-        auto df_rec_qw = df_rec_q.Filter([=](double W) { return (!hasW) || (W > wLo && W <= wHi); }, {"W"});
-
         // ── Build the acceptance histogram for this (Q2, W) cell ─────────────
         const auto hname_acc = Form("phi_accept_Q%zu_W%zu_%lu", iq, iw, uid_acc.fetch_add(1));
         const auto htitle_acc = hasW ? Form("Acceptance; -t' [GeV^{2}]; A(t')") : Form("Acceptance; -t' [GeV^{2}]; A(t')");
@@ -1076,53 +1460,20 @@ class DISANAplotter {
         hAcc->SetDirectory(nullptr);
         hAcc->Sumw2();
 
-        // ── N_gen: raw count histogram of generated MC events vs t' ────────────
-        // Gen events are pure signal (no background), so raw counts are correct.
+        // ── N_gen / raw N_rec vs t': projections of the count maps ───────────
+        // (hRec is raw counts — used only for the diagnostic canvas)
         const auto hname_gen = Form("hGen_Q%zu_W%zu_%lu", iq, iw, uid_acc.load());
-        auto hGenR = df_gen_qw.Histo1D(
-            ROOT::RDF::TH1DModel(hname_gen, ";-t' [GeV^{2}];N_{gen}",
-                                 static_cast<int>(tPrimeEdges.size() - 1), tPrimeEdges.data()),
-            genTPrimeVar);
-        TH1D* hGen = (TH1D*)hGenR.GetPtr();
-
-        // ── N_rec: phi signal yield from K+K- mass fit on reconstructed MC ────
-        // We MUST fit (not just count) because the reconstructed MC sample
-        // contains combinatorial background exactly like the data.  Using raw
-        // event counts would overestimate N_rec and therefore overestimate A,
-        // which would make the cross-section systematically too low.
-        // The fit model is identical to MakePhiMassFitCanvases3D so that the
-        // acceptance and the data yield are extracted in exactly the same way.
-
-        // Build a per-t'-bin array of fitted yields (same loop structure as data fit)
-        std::vector<double> nRecFit(nT, 0.0);
-        std::vector<double> nRecFitErr(nT, 0.0);
-
-        // Also keep a raw-count hRec for the diagnostic canvas (display only)
         const auto hname_rec = Form("hRec_Q%zu_W%zu_%lu", iq, iw, uid_acc.load() + 1);
-        auto hRecR = df_rec_qw.Histo1D(
-            ROOT::RDF::TH1DModel(hname_rec, ";-t' [GeV^{2}];N_{rec} (raw)",
-                                 static_cast<int>(tPrimeEdges.size() - 1), tPrimeEdges.data()),
-            recTPrimeVar);
-        TH1D* hRec = (TH1D*)hRecR.GetPtr();  // raw counts — used only for display
+        TH1D* hGen = genMap.ProjectT(iq, iw, hname_gen);
+        hGen->GetYaxis()->SetTitle("N_{gen}");
+        TH1D* hRec = recMap.ProjectT(iq, iw, hname_rec);
+        hRec->GetYaxis()->SetTitle("N_{rec} (raw)");
 
+        // Per-t'-bin fitted yields for this cell, from the batched fit pool
+        std::vector<double> nRecFit(nT, 0.0);
+        std::vector<double> nRecFitErr(nT, 0.0);
         for (size_t it = 0; it < nT; ++it) {
-          const double tLo = tPrimeEdges[it], tHi = tPrimeEdges[it + 1];
-
-          auto df_rec_bin = df_rec_qw.Filter(
-              [=](double mtp) { return mtp > tLo && mtp <= tHi; }, {"mtprime"});
-
-          // ── Bin label ────────────────────────────────────────────────────
-          auto tagRaw = hasW
-              ? Form("MCrecMassFit_Q2_%.2f_%.2f__W_%.2f_%.2f__T_%.3f_%.3f",
-                     qLo, qHi, wLo, wHi, tLo, tHi)
-              : Form("MCrecMassFit_Q2_%.2f_%.2f__T_%.3f_%.3f",
-                     qLo, qHi, tLo, tHi);
-
-          // ── Shared mass-fit kernel (same as XS and efficiency) ───────────
-          const auto yRec = FitPhiMassYieldAndSave(
-              df_rec_bin, outDirPerModel, tagRaw, "",
-              200, 0.8, 1.8, constrainSigma, sigmaRef, sigmaFrac);
-
+          const auto& yRec = fitJobs[recMap.Index(iq, iw, it)].result;
           if (yRec.valid && yRec.N > 0.0) {
             nRecFit[it]    = yRec.N;
             nRecFitErr[it] = yRec.dN;
@@ -1262,6 +1613,9 @@ class DISANAplotter {
           delete hAccDraw;
         }  // end diagnostic canvas scope
 
+        delete hGen;  // owned projections of the count maps
+        delete hRec;
+
         // ── Store in both output vector and the persistent cache ─────────────
         out[iq][iw] = hAcc;
         phi_accept_QW_[iq][iw] = hAcc;
@@ -1307,42 +1661,58 @@ class DISANAplotter {
 
     phi_eff_QW_.assign(nQ, std::vector<TH1D*>(nW, nullptr));
 
+    // ── One event loop per MC sample over the full (Q2, W, t') grid ──────────
+    const auto bkgMap = FillPhiCountMap3D(rdf_phimc_bkg.value(), q2Edges, wEdges, tPrimeEdges, bkgTPrimeVar,
+                                          nMassBins, mMin, mMax);
+    const auto nobkgMap = FillPhiCountMap3D(rdf_phimc_nobkg.value(), q2Edges, wEdges, tPrimeEdges, nobkgTPrimeVar,
+                                            nMassBins, mMin, mMax);
+
+    // ── Batch the per-cell fits on the worker pool ───────────────────────────
+    // Cells below minEntries on either side keep C_eff = 1 and are never
+    // fitted (same policy as the old per-bin loop); jobOf maps each grid cell
+    // to its (bkg, nobkg) job pair, -1 when skipped.
+    std::vector<PhiMassFitJob> fitJobs;
+    fitJobs.reserve(2 * nQ * nW * nT);
+    std::vector<std::pair<int, int>> jobOf(nQ * nW * nT, {-1, -1});
     for (size_t iq = 0; iq < nQ; ++iq) {
       const double qLo = q2Edges[iq], qHi = q2Edges[iq + 1];
-      auto df_q_bkg = rdf_phimc_bkg.value().Filter([=](double Q2) { return Q2 > qLo && Q2 <= qHi; }, {"Q2"});
-      auto df_q_nobkg = rdf_phimc_nobkg.value().Filter([=](double Q2) { return Q2 > qLo && Q2 <= qHi; }, {"Q2"});
-
       for (size_t iw = 0; iw < nW; ++iw) {
         const double wLo = hasW ? wEdges[iw] : 0.0;
         const double wHi = hasW ? wEdges[iw + 1] : 1e9;
-        auto df_qw_bkg = df_q_bkg.Filter([=](double W) { return (!hasW) || (W > wLo && W <= wHi); }, {"W"});
-        auto df_qw_nobkg = df_q_nobkg.Filter([=](double W) { return (!hasW) || (W > wLo && W <= wHi); }, {"W"});
+        for (size_t it = 0; it < nT; ++it) {
+          const size_t idx = bkgMap.Index(iq, iw, it);
+          if (bkgMap.Count(iq, iw, it) < minEntries || nobkgMap.Count(iq, iw, it) < minEntries) continue;
 
+          const double tLo = tPrimeEdges[it], tHi = tPrimeEdges[it + 1];
+          const std::string tagBase = hasW
+              ? Form("eff_Q%.2f_%.2f_W%.2f_%.2f_t%.3f_%.3f", qLo, qHi, wLo, wHi, tLo, tHi)
+              : Form("eff_Q%.2f_%.2f_t%.3f_%.3f", qLo, qHi, tLo, tHi);
+
+          jobOf[idx].first = static_cast<int>(fitJobs.size());
+          fitJobs.push_back({bkgMap.mass[idx].get(), tagBase + "_bkg", "B", {}});
+          jobOf[idx].second = static_cast<int>(fitJobs.size());
+          fitJobs.push_back({nobkgMap.mass[idx].get(), tagBase + "_nobkg", "N", {}});
+        }
+      }
+    }
+    RunPhiMassFitPool(fitJobs, outDirPerModel, constrainSigma, sigmaRef, sigmaFrac);
+
+    for (size_t iq = 0; iq < nQ; ++iq) {
+      for (size_t iw = 0; iw < nW; ++iw) {
         auto* hEff = new TH1D(Form("hPhiEff_Q%zu_W%zu", iq, iw), ";-t' [GeV^{2}];C_{eff}", (int)nT, tPrimeEdges.data());
         hEff->SetDirectory(nullptr);
         hEff->Sumw2();
 
         for (size_t it = 0; it < nT; ++it) {
-          const double tLo = tPrimeEdges[it], tHi = tPrimeEdges[it + 1];
-          auto df_bkg_bin = df_qw_bkg.Filter([=](double mtprime) { return mtprime > tLo && mtprime <= tHi; }, {bkgTPrimeVar});
-          auto df_nobkg_bin = df_qw_nobkg.Filter([=](double mtprime) { return mtprime > tLo && mtprime <= tHi; }, {nobkgTPrimeVar});
-
-          const double nRecoBkg = static_cast<double>(*df_bkg_bin.Count());
-          const double nRecoNoBkg = static_cast<double>(*df_nobkg_bin.Count());
-          if (nRecoBkg < minEntries || nRecoNoBkg < minEntries) {
+          const auto& jobs = jobOf[bkgMap.Index(iq, iw, it)];
+          if (jobs.first < 0) {  // below minEntries on either side
             hEff->SetBinContent((int)it + 1, 1.0);
             hEff->SetBinError((int)it + 1, 0.0);
             continue;
           }
 
-          const std::string tagBase = hasW
-              ? Form("eff_Q%.2f_%.2f_W%.2f_%.2f_t%.3f_%.3f", qLo, qHi, wLo, wHi, tLo, tHi)
-              : Form("eff_Q%.2f_%.2f_t%.3f_%.3f", qLo, qHi, tLo, tHi);
-
-          const auto yBkg = FitPhiMassYieldAndSave(df_bkg_bin, outDirPerModel, tagBase + "_bkg", "B",
-                                                   nMassBins, mMin, mMax, constrainSigma, sigmaRef, sigmaFrac);
-          const auto yNoBkg = FitPhiMassYieldAndSave(df_nobkg_bin, outDirPerModel, tagBase + "_nobkg", "N",
-                                                     nMassBins, mMin, mMax, constrainSigma, sigmaRef, sigmaFrac);
+          const auto& yBkg = fitJobs[jobs.first].result;
+          const auto& yNoBkg = fitJobs[jobs.second].result;
 
           double ceff = 1.0;
           double dceff = 0.0;
@@ -1474,6 +1844,398 @@ class DISANAplotter {
 }
 
 
+  // Per-bin accumulators filled in ONE event loop by FillPhiBinSpectraSinglePass.
+  // Flat index layout matches the nested (iq, iw, ib) loops of the Make*3D
+  // methods: idx = (iq*nW + iw)*nB + ib — use Index() instead of spelling it out.
+  struct PhiBinSpectra {
+    size_t nQ{0}, nW{0}, nB{0};
+    // K+K- invariant-mass spectra (all helicities / helicity ±1)
+    std::vector<std::unique_ptr<TH1D>> mass;
+    std::vector<std::unique_ptr<TH1D>> massPos, massNeg;
+    // helicity-split Trento-phi spectra inside the mass window (optional)
+    std::vector<std::unique_ptr<TH1D>> phiPos, phiNeg;
+    // per-bin kinematic sums, for the mean xB/W/Gamma_v exports
+    std::vector<double> sum_xB, sum_W, sum_Gv;
+    std::vector<long long> count;
+    // sin(phi_Trento) moment sums inside the mass window (optional)
+    std::vector<double> sum_hel_sinphi, sum_sin2phi;
+    // Poisson-bootstrap replica sums (optional): helicity-split in-mass-window
+    // counts of every flat bin, all replicas filled during the same single
+    // pass.  Each event carries an independent Poisson(1) weight per replica,
+    // so the replica-to-replica spread of any per-bin observable is its
+    // bootstrap uncertainty without re-reading the data.
+    size_t nBootstrap{0};
+    std::vector<double> bootPos, bootNeg;  // [replica * nBins + bin]
+
+    size_t Index(size_t iq, size_t iw, size_t ib) const { return (iq * nW + iw) * nB + ib; }
+    double BootPos(size_t r, size_t idx) const { return bootPos[r * count.size() + idx]; }
+    double BootNeg(size_t r, size_t idx) const { return bootNeg[r * count.size() + idx]; }
+  };
+
+  // ── Single-pass binned accumulation ──────────────────────────────────────
+  // Replaces the per-bin Filter chains of the φ(1020) bin loops: one Foreach
+  // over the dataframe maps each event to its flat (Q2, W, binVar) bin via a
+  // numeric edge lookup and fills every per-bin spectrum/sum at once.  With a
+  // 5x4x6 binning this is one event loop instead of ~120 jitted Filter passes.
+  // Per-slot accumulators merged after the loop — same idiom as
+  // DISANAMath::ComputeDVCS_CrossSection and DISANAcomparer::getMeanQ2xBt.
+  //
+  // Parameters
+  //   df             — dataframe with Q2, W, binVar, invMass_KpKm, xB,
+  //                    Gamma_v, phi, REC_Event_helicity columns
+  //   binVar         — third binning axis ("mtprime", "cos_thetaKK", ...)
+  //   nMassBins..    — K+K- mass-spectrum binning (fit input)
+  //   splitHelicity  — also fill massPos/massNeg for the BSA fits
+  //   sinPhiMoments  — also accumulate Σ λ·sinφ and Σ sin²φ in the mass window
+  //   phiHistEdges   — when non-null, also fill helicity-split φ_Trento
+  //                    spectra in the mass window (BSA-vs-φ fits)
+  //   massWinLo/Hi   — mass window for the two optional accumulators
+  //   bootstrapReplicas — when > 0, also fill that many Poisson-bootstrap
+  //                    replicas of the helicity-split in-window counts
+  inline PhiBinSpectra FillPhiBinSpectraSinglePass(ROOT::RDF::RNode df,
+                                                   const std::vector<double>& q2Edges,
+                                                   const std::vector<double>& wEdges,
+                                                   const std::vector<double>& binEdges,
+                                                   const std::string& binVar,
+                                                   int nMassBins, double mMin, double mMax,
+                                                   bool splitHelicity = false,
+                                                   bool sinPhiMoments = false,
+                                                   const std::vector<double>* phiHistEdges = nullptr,
+                                                   double massWinLo = 0.0, double massWinHi = 0.0,
+                                                   size_t bootstrapReplicas = 0) {
+    PhiBinSpectra acc;
+    const bool hasW = !wEdges.empty();
+    acc.nQ = (q2Edges.size() > 1) ? (q2Edges.size() - 1) : 0;
+    acc.nW = hasW ? (wEdges.size() - 1) : 1;
+    acc.nB = (binEdges.size() > 1) ? (binEdges.size() - 1) : 0;
+    const size_t nBins = acc.nQ * acc.nW * acc.nB;
+    if (!nBins) return acc;
+
+    static std::atomic<unsigned long> uidSP{0};
+    const unsigned long uid = uidSP.fetch_add(1);
+
+    auto makeHists = [&](std::vector<std::unique_ptr<TH1D>>& v, const char* tag, int nb, double lo, double hi,
+                         const double* edges) {
+      v.resize(nBins);
+      for (size_t i = 0; i < nBins; ++i) {
+        TH1D* h = edges ? new TH1D(Form("h_sp%lu_%s_b%zu", uid, tag, i), "", nb, edges)
+                        : new TH1D(Form("h_sp%lu_%s_b%zu", uid, tag, i), ";M_{K^{+}K^{-}} [GeV];Counts", nb, lo, hi);
+        h->SetDirectory(nullptr);
+        v[i].reset(h);
+      }
+    };
+
+    makeHists(acc.mass, "m", nMassBins, mMin, mMax, nullptr);
+    if (splitHelicity) {
+      makeHists(acc.massPos, "mP", nMassBins, mMin, mMax, nullptr);
+      makeHists(acc.massNeg, "mM", nMassBins, mMin, mMax, nullptr);
+    }
+    if (phiHistEdges && phiHistEdges->size() > 1) {
+      makeHists(acc.phiPos, "phiP", (int)(phiHistEdges->size() - 1), 0, 0, phiHistEdges->data());
+      makeHists(acc.phiNeg, "phiM", (int)(phiHistEdges->size() - 1), 0, 0, phiHistEdges->data());
+    }
+    acc.sum_xB.assign(nBins, 0.0);
+    acc.sum_W.assign(nBins, 0.0);
+    acc.sum_Gv.assign(nBins, 0.0);
+    acc.count.assign(nBins, 0);
+    if (sinPhiMoments) {
+      acc.sum_hel_sinphi.assign(nBins, 0.0);
+      acc.sum_sin2phi.assign(nBins, 0.0);
+    }
+    acc.nBootstrap = bootstrapReplicas;
+    if (bootstrapReplicas) {
+      acc.bootPos.assign(bootstrapReplicas * nBins, 0.0);
+      acc.bootNeg.assign(bootstrapReplicas * nBins, 0.0);
+    }
+
+    // lower_bound reproduces the (lo, hi] convention of the old per-bin
+    // Filters: an event sitting exactly on an edge goes to the lower bin.
+    auto findBin = [](double v, const std::vector<double>& edges) -> int {
+      const auto itb = std::lower_bound(edges.begin(), edges.end(), v);
+      const int idx = static_cast<int>(itb - edges.begin()) - 1;
+      return (idx < 0 || idx >= static_cast<int>(edges.size()) - 1) ? -1 : idx;
+    };
+
+    const unsigned int nSlots = std::max(1u, df.GetNSlots());
+    const size_t nW = acc.nW, nB = acc.nB;
+
+    // per-slot clones of every accumulator, merged after the loop
+    struct SlotAcc {
+      std::vector<std::unique_ptr<TH1D>> mass, massPos, massNeg, phiPos, phiNeg;
+      std::vector<double> sum_xB, sum_W, sum_Gv, sum_hel_sinphi, sum_sin2phi;
+      std::vector<long long> count;
+      std::vector<double> bootPos, bootNeg;
+      // per-slot generator: replica weights are independent across slots and
+      // deterministic for a given slot count
+      std::mt19937_64 rng;
+      std::poisson_distribution<int> poisson{1.0};
+    };
+    std::vector<SlotAcc> slots(nSlots);
+    auto cloneHists = [&](const std::vector<std::unique_ptr<TH1D>>& src, std::vector<std::unique_ptr<TH1D>>& dst,
+                          unsigned int s) {
+      dst.resize(src.size());
+      for (size_t i = 0; i < src.size(); ++i) {
+        TH1D* h = (TH1D*)src[i]->Clone(Form("%s_s%u", src[i]->GetName(), s));
+        h->SetDirectory(nullptr);
+        dst[i].reset(h);
+      }
+    };
+    for (unsigned int s = 0; s < nSlots; ++s) {
+      cloneHists(acc.mass, slots[s].mass, s);
+      if (splitHelicity) {
+        cloneHists(acc.massPos, slots[s].massPos, s);
+        cloneHists(acc.massNeg, slots[s].massNeg, s);
+      }
+      if (!acc.phiPos.empty()) {
+        cloneHists(acc.phiPos, slots[s].phiPos, s);
+        cloneHists(acc.phiNeg, slots[s].phiNeg, s);
+      }
+      slots[s].sum_xB.assign(nBins, 0.0);
+      slots[s].sum_W.assign(nBins, 0.0);
+      slots[s].sum_Gv.assign(nBins, 0.0);
+      slots[s].count.assign(nBins, 0);
+      if (sinPhiMoments) {
+        slots[s].sum_hel_sinphi.assign(nBins, 0.0);
+        slots[s].sum_sin2phi.assign(nBins, 0.0);
+      }
+      if (bootstrapReplicas) {
+        slots[s].bootPos.assign(bootstrapReplicas * nBins, 0.0);
+        slots[s].bootNeg.assign(bootstrapReplicas * nBins, 0.0);
+        slots[s].rng.seed(0x9E3779B97F4A7C15ull ^ (s + 1));
+      }
+    }
+
+    const double deg2rad = 3.14159265358979323846 / 180.0;
+    const bool fillPhiHists = !acc.phiPos.empty();
+
+    df.ForeachSlot(
+        [&, hasW, splitHelicity, sinPhiMoments, fillPhiHists, massWinLo, massWinHi, deg2rad](
+            unsigned int slot, double Q2, double Wv, double bv, float m, double xB, double Gv, double phiDeg,
+            short hel) {
+          const int iq = findBin(Q2, q2Edges);
+          if (iq < 0) return;
+          int iw = 0;
+          if (hasW) {
+            iw = findBin(Wv, wEdges);
+            if (iw < 0) return;
+          }
+          const int ib = findBin(bv, binEdges);
+          if (ib < 0) return;
+          const size_t idx = (size_t(iq) * nW + size_t(iw)) * nB + size_t(ib);
+
+          auto& sa = slots[slot];
+          sa.mass[idx]->Fill(m);
+          if (splitHelicity) {
+            if (hel == 1)
+              sa.massPos[idx]->Fill(m);
+            else if (hel == -1)
+              sa.massNeg[idx]->Fill(m);
+          }
+          sa.sum_xB[idx] += xB;
+          sa.sum_W[idx] += Wv;
+          sa.sum_Gv[idx] += Gv;
+          ++sa.count[idx];
+
+          // same strict (lo, hi) mass window as the old float Filters
+          const bool inWin = (m > massWinLo && m < massWinHi);
+          if (sinPhiMoments && inWin) {
+            const double s = std::sin(phiDeg * deg2rad);
+            sa.sum_hel_sinphi[idx] += static_cast<double>(hel) * s;
+            sa.sum_sin2phi[idx] += s * s;
+          }
+          if (fillPhiHists && inWin) {
+            if (hel == 1)
+              sa.phiPos[idx]->Fill(phiDeg);
+            else if (hel == -1)
+              sa.phiNeg[idx]->Fill(phiDeg);
+          }
+          if (bootstrapReplicas && inWin && (hel == 1 || hel == -1)) {
+            std::vector<double>& boot = (hel == 1) ? sa.bootPos : sa.bootNeg;
+            for (size_t r = 0; r < bootstrapReplicas; ++r) {
+              const int w = sa.poisson(sa.rng);
+              if (w) boot[r * nBins + idx] += w;
+            }
+          }
+        },
+        {"Q2", "W", binVar, "invMass_KpKm", "xB", "Gamma_v", "phi", "REC_Event_helicity"});
+
+    // merge the slots
+    for (unsigned int s = 0; s < nSlots; ++s) {
+      for (size_t i = 0; i < nBins; ++i) {
+        acc.mass[i]->Add(slots[s].mass[i].get());
+        if (splitHelicity) {
+          acc.massPos[i]->Add(slots[s].massPos[i].get());
+          acc.massNeg[i]->Add(slots[s].massNeg[i].get());
+        }
+        if (fillPhiHists) {
+          acc.phiPos[i]->Add(slots[s].phiPos[i].get());
+          acc.phiNeg[i]->Add(slots[s].phiNeg[i].get());
+        }
+        acc.sum_xB[i] += slots[s].sum_xB[i];
+        acc.sum_W[i] += slots[s].sum_W[i];
+        acc.sum_Gv[i] += slots[s].sum_Gv[i];
+        acc.count[i] += slots[s].count[i];
+        if (sinPhiMoments) {
+          acc.sum_hel_sinphi[i] += slots[s].sum_hel_sinphi[i];
+          acc.sum_sin2phi[i] += slots[s].sum_sin2phi[i];
+        }
+      }
+      if (bootstrapReplicas) {
+        for (size_t i = 0; i < acc.bootPos.size(); ++i) {
+          acc.bootPos[i] += slots[s].bootPos[i];
+          acc.bootNeg[i] += slots[s].bootNeg[i];
+        }
+      }
+    }
+    return acc;
+  }
+
+  // Raw count / mass-spectrum maps on the full (Q2, W, t') grid, filled in
+  // ONE event loop by FillPhiCountMap3D.  counts is a variable-edge TH3D, so
+  // the per-(Q2, W) t' histograms the correction builders need fall out as
+  // ProjectionZ calls instead of per-cell Filter chains; mass holds the
+  // per-cell K+K- spectra for the fitted-yield path and stays empty when the
+  // builder was asked for counts only (the generated MC has no invMass_KpKm
+  // column).  Same flat (iq*nW + iw)*nT + it layout as PhiBinSpectra.
+  struct PhiCountMap3D {
+    size_t nQ{0}, nW{0}, nT{0};
+    std::unique_ptr<TH3D> counts;
+    std::vector<std::unique_ptr<TH1D>> mass;
+
+    size_t Index(size_t iq, size_t iw, size_t it) const { return (iq * nW + iw) * nT + it; }
+    double Count(size_t iq, size_t iw, size_t it) const {
+      return counts ? counts->GetBinContent((int)iq + 1, (int)iw + 1, (int)it + 1) : 0.0;
+    }
+    /// t' spectrum of one (Q2, W) cell; the caller owns the projection.
+    TH1D* ProjectT(size_t iq, size_t iw, const char* name) const {
+      TH1D* h = counts->ProjectionZ(name, (int)iq + 1, (int)iq + 1, (int)iw + 1, (int)iw + 1);
+      h->SetDirectory(nullptr);
+      return h;
+    }
+  };
+
+  // ── Single-pass (Q2, W, t') count map ────────────────────────────────────
+  // Acceptance/efficiency companion of FillPhiBinSpectraSinglePass: one
+  // Foreach over the dataframe bins each event on the full grid with the
+  // same (lo, hi] lower_bound convention as the old per-cell Filters, and
+  // accumulates per-slot flat count arrays (plus per-cell K+K- mass spectra
+  // when nMassBins > 0) that are merged into the TH3D after the loop.  The
+  // MC correction passes therefore read each sample once instead of once
+  // per grid cell.
+  inline PhiCountMap3D FillPhiCountMap3D(ROOT::RDF::RNode df,
+                                         const std::vector<double>& q2Edges,
+                                         const std::vector<double>& wEdges,
+                                         const std::vector<double>& tEdges,
+                                         const std::string& tVar,
+                                         int nMassBins = 0, double mMin = 0.0, double mMax = 0.0) {
+    PhiCountMap3D map;
+    const bool hasW = !wEdges.empty();
+    map.nQ = (q2Edges.size() > 1) ? (q2Edges.size() - 1) : 0;
+    map.nW = hasW ? (wEdges.size() - 1) : 1;
+    map.nT = (tEdges.size() > 1) ? (tEdges.size() - 1) : 0;
+    const size_t nCells = map.nQ * map.nW * map.nT;
+    if (!nCells) return map;
+
+    static std::atomic<unsigned long> uidMap{0};
+    const unsigned long uid = uidMap.fetch_add(1);
+
+    // without a W binning the grid keeps a single catch-all W bin, matching
+    // the (wLo = 0, wHi = 1e9) fallback of the old per-cell Filters
+    const std::vector<double> wAll{0.0, 1e9};
+    const auto& yEdges = hasW ? wEdges : wAll;
+    map.counts.reset(new TH3D(Form("hCountMap3D_%lu", uid), ";Q^{2} [GeV^{2}];W [GeV];-t' [GeV^{2}]",
+                              (int)map.nQ, q2Edges.data(), (int)map.nW, yEdges.data(), (int)map.nT, tEdges.data()));
+    map.counts->SetDirectory(nullptr);
+    map.counts->Sumw2();
+
+    const bool wantMass = nMassBins > 0;
+    if (wantMass) {
+      map.mass.resize(nCells);
+      for (size_t i = 0; i < nCells; ++i) {
+        auto* h = new TH1D(Form("hCountMap3D_%lu_m%zu", uid, i), ";M_{K^{+}K^{-}} [GeV];Counts", nMassBins, mMin, mMax);
+        h->SetDirectory(nullptr);
+        map.mass[i].reset(h);
+      }
+    }
+
+    // lower_bound reproduces the (lo, hi] convention of the old per-cell
+    // Filters: an event sitting exactly on an edge goes to the lower bin.
+    auto findBin = [](double v, const std::vector<double>& edges) -> int {
+      const auto itb = std::lower_bound(edges.begin(), edges.end(), v);
+      const int idx = static_cast<int>(itb - edges.begin()) - 1;
+      return (idx < 0 || idx >= static_cast<int>(edges.size()) - 1) ? -1 : idx;
+    };
+
+    const unsigned int nSlots = std::max(1u, df.GetNSlots());
+    const size_t nW = map.nW, nT = map.nT;
+
+    // per-slot clones of the accumulators, merged after the loop
+    struct SlotAcc {
+      std::vector<double> counts;
+      std::vector<std::unique_ptr<TH1D>> mass;
+    };
+    std::vector<SlotAcc> slots(nSlots);
+    for (unsigned int s = 0; s < nSlots; ++s) {
+      slots[s].counts.assign(nCells, 0.0);
+      if (wantMass) {
+        slots[s].mass.resize(nCells);
+        for (size_t i = 0; i < nCells; ++i) {
+          TH1D* h = (TH1D*)map.mass[i]->Clone(Form("%s_s%u", map.mass[i]->GetName(), s));
+          h->SetDirectory(nullptr);
+          slots[s].mass[i].reset(h);
+        }
+      }
+    }
+
+    auto cellOf = [&, hasW](double Q2, double Wv, double tv) -> long {
+      const int iq = findBin(Q2, q2Edges);
+      if (iq < 0) return -1;
+      int iw = 0;
+      if (hasW) {
+        iw = findBin(Wv, wEdges);
+        if (iw < 0) return -1;
+      }
+      const int it = findBin(tv, tEdges);
+      if (it < 0) return -1;
+      return static_cast<long>((size_t(iq) * nW + size_t(iw)) * nT + size_t(it));
+    };
+
+    if (wantMass) {
+      df.ForeachSlot(
+          [&](unsigned int slot, double Q2, double Wv, double tv, float m) {
+            const long idx = cellOf(Q2, Wv, tv);
+            if (idx < 0) return;
+            slots[slot].counts[idx] += 1.0;
+            slots[slot].mass[idx]->Fill(m);
+          },
+          {"Q2", "W", tVar, "invMass_KpKm"});
+    } else {
+      df.ForeachSlot(
+          [&](unsigned int slot, double Q2, double Wv, double tv) {
+            const long idx = cellOf(Q2, Wv, tv);
+            if (idx < 0) return;
+            slots[slot].counts[idx] += 1.0;
+          },
+          {"Q2", "W", tVar});
+    }
+
+    // merge the slots; the TH3D gets plain Poisson errors so its projections
+    // carry sqrt(N) per bin like the Histo1D bookings they replace
+    for (size_t iq = 0; iq < map.nQ; ++iq)
+      for (size_t iw = 0; iw < nW; ++iw)
+        for (size_t it = 0; it < nT; ++it) {
+          const size_t idx = (iq * nW + iw) * nT + it;
+          double n = 0.0;
+          for (unsigned int s = 0; s < nSlots; ++s) n += slots[s].counts[idx];
+          map.counts->SetBinContent((int)iq + 1, (int)iw + 1, (int)it + 1, n);
+          map.counts->SetBinError((int)iq + 1, (int)iw + 1, (int)it + 1, std::sqrt(n));
+          if (wantMass)
+            for (unsigned int s = 0; s < nSlots; ++s) map.mass[idx]->Add(slots[s].mass[idx].get());
+        }
+
+    return map;
+  }
+
   // Result of a single K+K- mass peak fit.
   // Shared by MakePhiMassFitCanvases3D, MakePhiAcceptanceCorrection3D,
   // MakePhiEfficiencyCorrection3D, and the BSA helpers.
@@ -1496,58 +2258,42 @@ class DISANAplotter {
   // This is the ONE fitting kernel used by the cross-section computation,
   // the acceptance correction, and the efficiency correction.
   //
-  // Parameters
-  //   df_in          — RDataFrame already filtered to the kinematic bin
-  //   outDir         — directory for the saved canvas PDF
-  //   tagRaw         — human-readable bin label (dots are replaced internally)
-  //   label          — optional suffix appended to the filename, e.g. "bkg" or
-  //                    "nobkg" for efficiency pairs; leave empty for data/acceptance
-  //   nMassBins..    — fit window and sigma-constraint options
+  // It is split in two so the per-bin fits can run on a worker pool:
+  //   FitPhiMassYield       — numerical fit only, thread-safe
+  //   SavePhiMassFitCanvas  — canvas/PDF rendering, main thread only
+  // FitPhiMassYieldAndSave composes the two for the single-threaded callers
+  // (acceptance, efficiency, RLT sidebands) and returns a fully-populated
+  // YieldRes.  Check .valid before using .N.
   //
-  // Returns a fully-populated YieldRes.  Check .valid before using .N.
-  inline YieldRes FitPhiMassYieldAndSave(ROOT::RDF::RNode df_in,
-                                         const std::string& outDir,
-                                         const std::string& tagRaw,
-                                         const std::string& label = "",
-                                         int    nMassBins     = 120,
-                                         double mMin          = 0.98,
-                                         double mMax          = 1.08,
-                                         bool   constrainSigma= true,
-                                         double sigmaRef      = 0.004,
-                                         double sigmaFrac     = 0.25) {
-    static std::atomic<unsigned long> uid{0};
-    const auto hname = Form("hM_phi_%s_%s_%lu",
-                            tagRaw.c_str(), label.c_str(), uid.fetch_add(1));
+  // Fit-only kernel: fits a pre-filled spectrum and returns the yield and
+  // all fit parameters without touching any canvas or global graphics state.
+  // Safe to run concurrently from worker threads once
+  // ROOT::EnableThreadSafety() has been called — the fit copies the bin
+  // contents into a private ROOT::Fit::BinData and never mutates the
+  // histogram or any global state.  The canvas is rendered
+  // afterwards (sequentially) by SavePhiMassFitCanvas from the parameters
+  // stored in the YieldRes; sigma > 0 marks a fit that actually ran.
+  inline YieldRes FitPhiMassYield(TH1D* h0,
+                                  bool   constrainSigma = true,
+                                  double sigmaRef       = 0.004,
+                                  double sigmaFrac      = 0.25) {
+    // No Form() here: its shared circular buffer is not safe off the main
+    // thread, and this function runs inside RunPhiMassFitPool workers.
+    static std::atomic<unsigned long> uidFit{0};
+    const std::string fname = "phiFit_" + std::to_string(uidFit.fetch_add(1));
 
-    auto hR = df_in.Histo1D(ROOT::RDF::TH1DModel(hname, ";M_{K^{+}K^{-}} [GeV];Counts", nMassBins, mMin, mMax), "invMass_KpKm");
-    hR.GetValue();
-    TH1D* h0 = (TH1D*)hR.GetPtr();
     if (!h0 || h0->GetEntries() < 20) return {};
+    const double mMin = h0->GetXaxis()->GetXmin();
+    const double mMax = h0->GetXaxis()->GetXmax();
 
-    std::unique_ptr<TH1D> hDraw((TH1D*)h0->Clone(Form("%s_draw", hname)));
-    hDraw->SetDirectory(nullptr);
-    hDraw->SetTitle("");
-    hDraw->SetLineColor(kBlue + 1);
-    hDraw->SetLineWidth(2);
-    hDraw->SetMarkerStyle(20);
-    hDraw->SetMarkerSize(1.1);
-    hDraw->GetXaxis()->SetTitle("M(K^{+}K^{-}) [GeV]");
-    hDraw->GetYaxis()->SetTitle("Counts");
-
-    const double bw = hDraw->GetXaxis()->GetBinWidth(1);
+    const double bw = h0->GetXaxis()->GetBinWidth(1);
 
-    // bkg + (Nsig * bw * Gaussian_pdf)
-    std::string formula = Form(
-        "[0]*TMath::Power(x-0.9874,[1])*TMath::Exp(-[2]*(x-0.9874))"
-        " + "
-        "[3]*0.398942*%g*TMath::Exp(-0.5*TMath::Power((x-[4])/([5]),2))/TMath::Abs([5])",
-        bw);
-
-    std::unique_ptr<TF1> fTot(new TF1(Form("fTot_%s", hname), formula.c_str(), mMin, mMax));
+    // compiled bkg + (Nsig * bw * Gaussian_pdf) model, analytic gradients
+    std::unique_ptr<TF1> fTot(DISANA::FitModels::MakePhiMassTotalTF1("fTot_" + fname, bw, mMin, mMax));
     fTot->SetParNames("A", "alpha", "lambda", "Nsig", "mu", "sigma");
 
     const double peakX = 1.019;
-    const double peakY = hDraw->GetMaximum();
+    const double peakY = h0->GetMaximum();
     fTot->SetParameters(std::max(1.0, peakY), 0.9, 2.0, std::max(1.0, peakY * bw * 10.0), peakX, sigmaRef);
 
     fTot->SetParLimits(4, 1.005, 1.022);
@@ -1557,30 +2303,61 @@ class DISANAplotter {
       fTot->SetParLimits(5, 0.0025, 0.025);
     fTot->SetParLimits(3, 0.0, 1e9);
 
-    // Fit (no draw)
-    hDraw->Fit(fTot.get(), "R0Q");
+    // Fit (no draw); reads the histogram without mutating it
+    DISANA::FitModels::PhiMassTotalModel model(bw);
+    DISANA::FitModels::FitHistogramCompiled(h0, fTot.get(), model);
 
-    const double A = fTot->GetParameter(0);
-    const double alpha = fTot->GetParameter(1);
-    const double lambda = fTot->GetParameter(2);
-    const double Nsig = fTot->GetParameter(3);
-    const double dNsig = fTot->GetParError(3);
-    const double mu = fTot->GetParameter(4);
+    const double Nsig  = fTot->GetParameter(3);
+    const double mu    = fTot->GetParameter(4);
     const double sigma = fTot->GetParameter(5);
 
-    const double mLo = mu - 3.0 * sigma;
-    const double mHi = mu + 3.0 * sigma;
+    return {Nsig, fTot->GetParError(3), mu, sigma,
+            mu - 3.0 * sigma, mu + 3.0 * sigma,
+            fTot->GetParameter(0), fTot->GetParameter(1), fTot->GetParameter(2),
+            fTot->GetChisquare(), fTot->GetNDF(),
+            /*valid=*/(Nsig > 0.0)};
+  }
 
-    std::unique_ptr<TF1> fSig(new TF1(Form("fSig_%s", hname), Form("[0]*0.398942*%g*TMath::Exp(-0.5*TMath::Power((x-[1])/([2]),2))/TMath::Abs([2])", bw), mMin, mMax));
-    fSig->SetParameters(Nsig, mu, sigma);
+  // Canvas half of the kernel: rebuilds the total/signal/background curves
+  // from a YieldRes produced by FitPhiMassYield and saves the usual per-bin
+  // PDF.  Must run on the main thread — TCanvas is not thread-safe.
+  inline void SavePhiMassFitCanvas(TH1D* h0, const YieldRes& y,
+                                   const std::string& outDir,
+                                   const std::string& tagRaw,
+                                   const std::string& label = "") {
+    static std::atomic<unsigned long> uid{0};
+    const auto hname = Form("hM_phi_%s_%s_%lu",
+                            tagRaw.c_str(), label.c_str(), uid.fetch_add(1));
+
+    if (!h0 || y.sigma <= 0.0) return;
+    const double mMin = h0->GetXaxis()->GetXmin();
+    const double mMax = h0->GetXaxis()->GetXmax();
+
+    std::unique_ptr<TH1D> hDraw((TH1D*)h0->Clone(Form("%s_draw", hname)));
+    hDraw->SetDirectory(nullptr);
+    hDraw->SetTitle("");
+    hDraw->SetLineColor(kBlue + 1);
+    hDraw->SetLineWidth(2);
+    hDraw->SetMarkerStyle(20);
+    hDraw->SetMarkerSize(1.1);
+    hDraw->GetXaxis()->SetTitle("M(K^{+}K^{-}) [GeV]");
+    hDraw->GetYaxis()->SetTitle("Counts");
+
+    const double bw = hDraw->GetXaxis()->GetBinWidth(1);
+
+    std::unique_ptr<TF1> fTot(DISANA::FitModels::MakePhiMassTotalTF1(Form("fTot_%s", hname), bw, mMin, mMax));
+    fTot->SetParameters(y.A, y.alpha, y.lambda, y.N, y.mu, y.sigma);
+
+    std::unique_ptr<TF1> fSig(DISANA::FitModels::MakePhiMassSignalTF1(Form("fSig_%s", hname), bw, mMin, mMax));
+    fSig->SetParameters(y.N, y.mu, y.sigma);
     fSig->SetLineColor(kOrange + 1);
     fSig->SetLineStyle(2);
     fSig->SetLineWidth(2);
     fSig->SetFillColorAlpha(kOrange - 3, 0.30);
     fSig->SetFillStyle(1001);
 
-    std::unique_ptr<TF1> fBkg(new TF1(Form("fBkg_%s", hname), "[0]*TMath::Power(x-0.9874,[1])*TMath::Exp(-[2]*(x-0.9874))", mMin, mMax));
-    fBkg->SetParameters(A, alpha, lambda);
+    std::unique_ptr<TF1> fBkg(DISANA::FitModels::MakePhiMassBkgTF1(Form("fBkg_%s", hname), mMin, mMax));
+    fBkg->SetParameters(y.A, y.alpha, y.lambda);
     fBkg->SetLineColor(kGreen + 2);
     fBkg->SetLineStyle(3);
     fBkg->SetLineWidth(2);
@@ -1606,8 +2383,8 @@ class DISANAplotter {
     fTot->Draw("SAME C");
 
     const double yMax = hDraw->GetMaximum();
-    TLine L1(mLo, 0.0, mLo, yMax * 0.75);
-    TLine L2(mHi, 0.0, mHi, yMax * 0.75);
+    TLine L1(y.mLo, 0.0, y.mLo, yMax * 0.75);
+    TLine L2(y.mHi, 0.0, y.mHi, yMax * 0.75);
     L1.SetLineColor(kMagenta + 2);
     L2.SetLineColor(kMagenta + 2);
     L1.SetLineStyle(2);
@@ -1630,18 +2407,95 @@ class DISANAplotter {
     TLatex latex;
     latex.SetNDC();
     latex.SetTextSize(0.035);
-    latex.DrawLatex(0.55, 0.85, Form("#mu = %.3f GeV, #sigma = %.3f GeV", mu, sigma));
-    latex.DrawLatex(0.55, 0.81, Form("N_{#phi} = %.1f #pm %.1f", Nsig, dNsig));
+    latex.DrawLatex(0.55, 0.85, Form("#mu = %.3f GeV, #sigma = %.3f GeV", y.mu, y.sigma));
+    latex.DrawLatex(0.55, 0.81, Form("N_{#phi} = %.1f #pm %.1f", y.N, y.dN));
 
     std::string tag = tagRaw;
     std::replace(tag.begin(), tag.end(), '.', '_');
     const std::string suffix = label.empty() ? "" : ("_" + label);
     c->SaveAs(Form("%s/KKmass_%s%s.pdf", outDir.c_str(), tag.c_str(), suffix.c_str()));
+  }
 
-    return {Nsig, dNsig, mu, sigma, mLo, mHi,
-            A, alpha, lambda,
-            fTot->GetChisquare(), fTot->GetNDF(),
-            /*valid=*/(Nsig > 0.0)};
+  // TH1D overload: fits a spectrum that was already filled, e.g. by
+  // FillPhiBinSpectraSinglePass, and saves the canvas.  The fit range is
+  // taken from the histogram axis.  The RNode overload below books the
+  // spectrum itself and delegates here, so both paths share the one
+  // fitting kernel.
+  inline YieldRes FitPhiMassYieldAndSave(TH1D* h0,
+                                         const std::string& outDir,
+                                         const std::string& tagRaw,
+                                         const std::string& label = "",
+                                         bool   constrainSigma= true,
+                                         double sigmaRef      = 0.004,
+                                         double sigmaFrac     = 0.25) {
+    const YieldRes y = FitPhiMassYield(h0, constrainSigma, sigmaRef, sigmaFrac);
+    SavePhiMassFitCanvas(h0, y, outDir, tagRaw, label);
+    return y;
+  }
+
+  // RNode overload: books the mass spectrum from an already-filtered
+  // dataframe (one event loop per call) and hands it to the TH1D kernel.
+  inline YieldRes FitPhiMassYieldAndSave(ROOT::RDF::RNode df_in,
+                                         const std::string& outDir,
+                                         const std::string& tagRaw,
+                                         const std::string& label = "",
+                                         int    nMassBins     = 120,
+                                         double mMin          = 0.98,
+                                         double mMax          = 1.08,
+                                         bool   constrainSigma= true,
+                                         double sigmaRef      = 0.004,
+                                         double sigmaFrac     = 0.25) {
+    static std::atomic<unsigned long> uidDf{0};
+    const auto hname = Form("hM_phi_df_%s_%s_%lu",
+                            tagRaw.c_str(), label.c_str(), uidDf.fetch_add(1));
+
+    auto hR = df_in.Histo1D(ROOT::RDF::TH1DModel(hname, ";M_{K^{+}K^{-}} [GeV];Counts", nMassBins, mMin, mMax), "invMass_KpKm");
+    hR.GetValue();
+    return FitPhiMassYieldAndSave((TH1D*)hR.GetPtr(), outDir, tagRaw, label,
+                                  constrainSigma, sigmaRef, sigmaFrac);
+  }
+
+  // One per-bin fit request for RunPhiMassFitPool.  hist stays owned by the
+  // caller (usually a PhiBinSpectra grid); result is filled by the pool.
+  struct PhiMassFitJob {
+    TH1D*       hist = nullptr;
+    std::string tagRaw;
+    std::string label;
+    YieldRes    result;
+  };
+
+  // Runs FitPhiMassYield over all jobs on a worker thread pool, then renders
+  // the per-bin canvases sequentially on the calling thread.  The per-bin
+  // fits are independent once the spectra are pre-filled, so they scale with
+  // the core count; only the canvas/PDF step stays serial (TCanvas is not
+  // thread-safe).  ROOT::EnableThreadSafety() makes Minuit and the TF1
+  // formula evaluation safe to run from plain std::threads.
+  inline void RunPhiMassFitPool(std::vector<PhiMassFitJob>& jobs,
+                                const std::string& outDir,
+                                bool   constrainSigma = true,
+                                double sigmaRef       = 0.004,
+                                double sigmaFrac      = 0.25) {
+    if (jobs.empty()) return;
+
+    ROOT::EnableThreadSafety();
+    const std::size_t nWorkers =
+        std::max<std::size_t>(1, std::min<std::size_t>(std::thread::hardware_concurrency(), jobs.size()));
+
+    std::atomic<std::size_t> next{0};
+    auto worker = [&]() {
+      for (std::size_t i = next.fetch_add(1); i < jobs.size(); i = next.fetch_add(1))
+        jobs[i].result = FitPhiMassYield(jobs[i].hist, constrainSigma, sigmaRef, sigmaFrac);
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(nWorkers);
+    for (std::size_t w = 0; w < nWorkers; ++w) threads.emplace_back(worker);
+    for (auto& t : threads)
+      if (t.joinable()) t.join();
+
+    // Canvases after the fits complete, on this thread only.
+    for (const auto& job : jobs)
+      SavePhiMassFitCanvas(job.hist, job.result, outDir, job.tagRaw, job.label);
   }
 
   // ---------------- NEW: build A_LU(cos#theta_{KK}) cache and save helicity-separated mass-fit canvases ---------------
@@ -1681,15 +2535,25 @@ class DISANAplotter {
     phi_alu_cos_QW_.assign(nQ, std::vector<TH1D*>(nW, nullptr));
     static std::atomic<unsigned long> uidH{0};
 
-    for (size_t iq = 0; iq < nQ; ++iq) {
-      const double qLo = q2Edges[iq], qHi = q2Edges[iq + 1];
-      auto df_q = rdf.Filter([=](double Q2) { return Q2 > qLo && Q2 <= qHi; }, {"Q2"});
+    // one event loop for all (Q2,W,cosθ_KK) bins, helicity-split mass spectra
+    const auto spectra = FillPhiBinSpectraSinglePass(rdf, q2Edges, wEdges, cEdges, "cos_thetaKK",
+                                                     nMassBins, mMin, mMax, /*splitHelicity=*/true);
 
-      for (size_t iw = 0; iw < nW; ++iw) {
-        const double wLo = hasW ? wEdges[iw] : 0.0;
-        const double wHi = hasW ? wEdges[iw + 1] : 1e9;
-        auto df_qw = df_q.Filter([=](double W) { return (!hasW) || (W > wLo && W <= wHi); }, {"W"});
+    // two jobs per bin (h+ / h-), fitted on the worker pool
+    std::vector<PhiMassFitJob> fitJobs(2 * nQ * nW * nC);
+    for (size_t iq = 0; iq < nQ; ++iq)
+      for (size_t iw = 0; iw < nW; ++iw)
+        for (size_t ic = 0; ic < nC; ++ic) {
+          const size_t idxBin = spectra.Index(iq, iw, ic);
+          auto tagRawC = hasW ? Form("Q2_%.2f_%.2f__W_%.2f_%.2f__tprime_%.3f_%.3f", q2Edges[iq], q2Edges[iq + 1], wEdges[iw], wEdges[iw + 1], cEdges[ic], cEdges[ic + 1])
+                              : Form("Q2_%.2f_%.2f__tprime_%.3f_%.3f", q2Edges[iq], q2Edges[iq + 1], cEdges[ic], cEdges[ic + 1]);
+          fitJobs[2 * idxBin]     = {spectra.massPos[idxBin].get(), tagRawC, "P", {}};
+          fitJobs[2 * idxBin + 1] = {spectra.massNeg[idxBin].get(), tagRawC, "M", {}};
+        }
+    RunPhiMassFitPool(fitJobs, outDirPerModel, constrainSigma, sigmaRef, sigmaFrac);
 
+    for (size_t iq = 0; iq < nQ; ++iq) {
+      for (size_t iw = 0; iw < nW; ++iw) {
         // cache hist for this (Q,W)
         {
           auto hname = Form("phi_alu_t_Q%zu_W%zu_%lu", iq, iw, uidH.fetch_add(1));
@@ -1700,20 +2564,10 @@ class DISANAplotter {
         }
 
         for (size_t ic = 0; ic < nC; ++ic) {
-          const double cLo = cEdges[ic], cHi = cEdges[ic + 1];
+          const size_t idxBin = spectra.Index(iq, iw, ic);
 
-          auto df_bin = df_qw.Filter([=](double mcp) { return mcp > cLo && mcp <= cHi; }, {"cos_thetaKK"});
-
-          // helicity-separated
-          auto df_pos = df_bin.Filter("REC_Event_helicity ==  1");
-          auto df_neg = df_bin.Filter("REC_Event_helicity == -1");
-
-          // tag for filenames
-          auto tagRawC = hasW ? Form("Q2_%.2f_%.2f__W_%.2f_%.2f__tprime_%.3f_%.3f", qLo, qHi, wLo, wHi, cLo, cHi) : Form("Q2_%.2f_%.2f__tprime_%.3f_%.3f", qLo, qHi, cLo, cHi);
-          std::string tagRaw = tagRawC;
-
-          const auto yp = FitPhiMassYieldAndSave(df_pos, outDirPerModel, tagRaw, "P", nMassBins, mMin, mMax, constrainSigma, sigmaRef, sigmaFrac);
-          const auto ym = FitPhiMassYieldAndSave(df_neg, outDirPerModel, tagRaw, "M", nMassBins, mMin, mMax, constrainSigma, sigmaRef, sigmaFrac);
+          const auto& yp = fitJobs[2 * idxBin].result;
+          const auto& ym = fitJobs[2 * idxBin + 1].result;
 
           const double Np = yp.N, dNp = yp.dN;
           const double Nm = ym.N, dNm = ym.dN;
@@ -1776,15 +2630,30 @@ class DISANAplotter {
 
     static std::atomic<unsigned long> uidH{0};
 
-    for (size_t iq = 0; iq < nQ; ++iq) {
-      const double qLo = q2Edges[iq], qHi = q2Edges[iq + 1];
-      auto df_q = rdf.Filter([=](double Q2) { return Q2 > qLo && Q2 <= qHi; }, {"Q2"});
+    // one event loop for all (Q2,W,φ_Trento) bins, helicity-split mass spectra;
+    // when bootstrap replicas are enabled the same pass also fills the
+    // replica-weighted in-window counts (window = fit range)
+    const auto spectra = FillPhiBinSpectraSinglePass(rdf, q2Edges, wEdges, phiEdges, "phi",
+                                                     nMassBins, mMin, mMax, /*splitHelicity=*/true,
+                                                     /*sinPhiMoments=*/false, /*phiHistEdges=*/nullptr,
+                                                     mMin, mMax, bootstrapReplicas_);
+
+    // two jobs per bin (h+ / h-), fitted on the worker pool; the inv-mass
+    // fit PDFs land in outDirPerModel exactly as before
+    std::vector<PhiMassFitJob> fitJobs(2 * nQ * nW * nPhi);
+    for (size_t iq = 0; iq < nQ; ++iq)
+      for (size_t iw = 0; iw < nW; ++iw)
+        for (size_t ip = 0; ip < nPhi; ++ip) {
+          const size_t idxBin = spectra.Index(iq, iw, ip);
+          auto tagRawC = hasW ? Form("Q2_%.2f_%.2f__W_%.2f_%.2f__phiTrento_%.1f_%.1f", q2Edges[iq], q2Edges[iq + 1], wEdges[iw], wEdges[iw + 1], phiEdges[ip], phiEdges[ip + 1])
+                              : Form("Q2_%.2f_%.2f__phiTrento_%.1f_%.1f", q2Edges[iq], q2Edges[iq + 1], phiEdges[ip], phiEdges[ip + 1]);
+          fitJobs[2 * idxBin]     = {spectra.massPos[idxBin].get(), tagRawC, "P", {}};
+          fitJobs[2 * idxBin + 1] = {spectra.massNeg[idxBin].get(), tagRawC, "M", {}};
+        }
+    RunPhiMassFitPool(fitJobs, outDirPerModel, constrainSigma, sigmaRef, sigmaFrac);
 
+    for (size_t iq = 0; iq < nQ; ++iq) {
       for (size_t iw = 0; iw < nW; ++iw) {
-        const double wLo = hasW ? wEdges[iw] : 0.0;
-        const double wHi = hasW ? wEdges[iw + 1] : 1e9;
-        auto df_qw = df_q.Filter([=](double W) { return (!hasW) || (W > wLo && W <= wHi); }, {"W"});
-
         // cache hist for this (Q,W)
         {
           auto hname = Form("phi_bsa_phiTrento_Q%zu_W%zu_%lu", iq, iw, uidH.fetch_add(1));
@@ -1795,21 +2664,10 @@ class DISANAplotter {
         }
 
         for (size_t ip = 0; ip < nPhi; ++ip) {
-          const double pLo = phiEdges[ip], pHi = phiEdges[ip + 1];
-
-          // NOTE: using column name "phi" (Trento φ in your codebase)
-          auto df_bin = df_qw.Filter([=](double ph) { return ph > pLo && ph <= pHi; }, {"phi"});
-
-          auto df_pos = df_bin.Filter("REC_Event_helicity ==  1");
-          auto df_neg = df_bin.Filter("REC_Event_helicity == -1");
+          const size_t idxBin = spectra.Index(iq, iw, ip);
 
-          // tag for filenames (so you get inv-mass fit PDFs inside this workflow)
-          auto tagRawC =
-              hasW ? Form("Q2_%.2f_%.2f__W_%.2f_%.2f__phiTrento_%.1f_%.1f", qLo, qHi, wLo, wHi, pLo, pHi) : Form("Q2_%.2f_%.2f__phiTrento_%.1f_%.1f", qLo, qHi, pLo, pHi);
-          std::string tagRaw = tagRawC;
-
-          const auto yp = FitPhiMassYieldAndSave(df_pos, outDirPerModel, tagRaw, "P", nMassBins, mMin, mMax, constrainSigma, sigmaRef, sigmaFrac);
-          const auto ym = FitPhiMassYieldAndSave(df_neg, outDirPerModel, tagRaw, "M", nMassBins, mMin, mMax, constrainSigma, sigmaRef, sigmaFrac);
+          const auto& yp = fitJobs[2 * idxBin].result;
+          const auto& ym = fitJobs[2 * idxBin + 1].result;
 
           const double Np = yp.N, dNp = yp.dN;
           const double Nm = ym.N, dNm = ym.dN;
@@ -1830,6 +2688,30 @@ class DISANAplotter {
           const int b = (int)(ip + 1);
           phi_bsa_trentophi_QW_[iq][iw]->SetBinContent(b, A);
           phi_bsa_trentophi_QW_[iq][iw]->SetBinError(b, dA);
+
+          // Bootstrap spread of the in-window counting asymmetry: all
+          // replicas came from the single fill pass above, so this replaces
+          // the rerun-the-chain-on-subsamples stability checks.
+          if (spectra.nBootstrap) {
+            double sumA = 0.0, sumA2 = 0.0;
+            size_t nGood = 0;
+            for (size_t r = 0; r < spectra.nBootstrap; ++r) {
+              const double bp = spectra.BootPos(r, idxBin);
+              const double bm = spectra.BootNeg(r, idxBin);
+              if (bp + bm <= 0.0 || beamPol == 0.0) continue;
+              const double Ar = (bp - bm) / (bp + bm) / beamPol;
+              sumA += Ar;
+              sumA2 += Ar * Ar;
+              ++nGood;
+            }
+            if (nGood > 1) {
+              const double meanA = sumA / nGood;
+              const double rmsA = std::sqrt(std::max(0.0, sumA2 / nGood - meanA * meanA));
+              std::cout << Form("[MakePhiBSATrentoPhiMassFitCanvases3D] Q[%zu] W[%zu] phi[%zu]"
+                                " bootstrap(%zu): A_LU = %.4f +/- %.4f (fit dA = %.4f)\n",
+                                iq, iw, ip, nGood, meanA, rmsA, dA);
+            }
+          }
         }
       }
     }
@@ -1871,16 +2753,25 @@ class DISANAplotter {
     phi_alu_zphi_QW_.assign(nQ, std::vector<TH1D*>(nW, nullptr));
     static std::atomic<unsigned long> uidH{0};
 
-    for (size_t iq = 0; iq < nQ; ++iq) {
-      const double qLo = q2Edges[iq];
-      const double qHi = q2Edges[iq + 1];
-      auto df_q = rdf.Filter([=](double Q2) { return Q2 > qLo && Q2 <= qHi; }, {"Q2"});
+    // one event loop for all (Q2,W,z_phi) bins, helicity-split mass spectra
+    const auto spectra = FillPhiBinSpectraSinglePass(rdf, q2Edges, wEdges, zEdges, "z_phi",
+                                                     nMassBins, mMin, mMax, /*splitHelicity=*/true);
 
-      for (size_t iw = 0; iw < nW; ++iw) {
-        const double wLo = hasW ? wEdges[iw] : 0.0;
-        const double wHi = hasW ? wEdges[iw + 1] : 1e9;
-        auto df_qw = df_q.Filter([=](double W) { return (!hasW) || (W > wLo && W <= wHi); }, {"W"});
+    // two jobs per bin (h+ / h-), fitted on the worker pool
+    std::vector<PhiMassFitJob> fitJobs(2 * nQ * nW * nZ);
+    for (size_t iq = 0; iq < nQ; ++iq)
+      for (size_t iw = 0; iw < nW; ++iw)
+        for (size_t iz = 0; iz < nZ; ++iz) {
+          const size_t idxBin = spectra.Index(iq, iw, iz);
+          auto tagRawC = hasW ? Form("Q2_%.2f_%.2f__W_%.2f_%.2f__zphi_%.3f_%.3f", q2Edges[iq], q2Edges[iq + 1], wEdges[iw], wEdges[iw + 1], zEdges[iz], zEdges[iz + 1])
+                              : Form("Q2_%.2f_%.2f__zphi_%.3f_%.3f", q2Edges[iq], q2Edges[iq + 1], zEdges[iz], zEdges[iz + 1]);
+          fitJobs[2 * idxBin]     = {spectra.massPos[idxBin].get(), tagRawC, "P", {}};
+          fitJobs[2 * idxBin + 1] = {spectra.massNeg[idxBin].get(), tagRawC, "M", {}};
+        }
+    RunPhiMassFitPool(fitJobs, outDirPerModel, constrainSigma, sigmaRef, sigmaFrac);
 
+    for (size_t iq = 0; iq < nQ; ++iq) {
+      for (size_t iw = 0; iw < nW; ++iw) {
         // Cache A_LU(z_phi) hist for this (Q2,W)
         {
           auto hname = Form("phi_alu_zphi_Q%zu_W%zu_%lu", iq, iw, uidH.fetch_add(1));
@@ -1895,16 +2786,10 @@ class DISANAplotter {
           const double zLo = zEdges[iz];
           const double zHi = zEdges[iz + 1];
 
-          auto df_bin = df_qw.Filter([=](double z) { return z > zLo && z <= zHi; }, {"z_phi"});
-
-          auto df_pos = df_bin.Filter("REC_Event_helicity ==  1");
-          auto df_neg = df_bin.Filter("REC_Event_helicity == -1");
+          const size_t idxBin = spectra.Index(iq, iw, iz);
 
-          auto tagRawC = hasW ? Form("Q2_%.2f_%.2f__W_%.2f_%.2f__zphi_%.3f_%.3f", qLo, qHi, wLo, wHi, zLo, zHi) : Form("Q2_%.2f_%.2f__zphi_%.3f_%.3f", qLo, qHi, zLo, zHi);
-          std::string tagRaw = tagRawC;
-
-          const auto yp = FitPhiMassYieldAndSave(df_pos, outDirPerModel, tagRaw, "P", nMassBins, mMin, mMax, constrainSigma, sigmaRef, sigmaFrac);
-          const auto ym = FitPhiMassYieldAndSave(df_neg, outDirPerModel, tagRaw, "M", nMassBins, mMin, mMax, constrainSigma, sigmaRef, sigmaFrac);
+          const auto& yp = fitJobs[2 * idxBin].result;
+          const auto& ym = fitJobs[2 * idxBin + 1].result;
 
           const double Np = yp.N;
           const double dNp = yp.dN;
@@ -1978,22 +2863,15 @@ class DISANAplotter {
     phi_alu_cos_QW_.assign(nQ, std::vector<TH1D*>(nW, nullptr));
     static std::atomic<unsigned long> uidH{0};
 
-    auto df_all = rdf;  // base dataframe in this plotter
-
-    const double deg2rad = 3.14159265358979323846 / 180.0;
+    // one event loop accumulating Σ λ·sinφ and Σ sin²φ (inside the mass
+    // window) for every (Q2,W,cosθ_KK) bin; the mass spectra go unused here
+    const auto spectra = FillPhiBinSpectraSinglePass(rdf, q2Edges, wEdges, cEdges, "cos_thetaKK",
+                                                     /*nMassBins=*/120, mMin, mMax,
+                                                     /*splitHelicity=*/false, /*sinPhiMoments=*/true,
+                                                     /*phiHistEdges=*/nullptr, mMin, mMax);
 
     for (size_t iq = 0; iq < nQ; ++iq) {
-      const double qLo = q2Edges[iq];
-      const double qHi = q2Edges[iq + 1];
-
-      auto df_q = df_all.Filter([=](double Q2) { return Q2 > qLo && Q2 <= qHi; }, {"Q2"});
-
       for (size_t iw = 0; iw < nW; ++iw) {
-        const double wLo = hasW ? wEdges[iw] : 0.0;
-        const double wHi = hasW ? wEdges[iw + 1] : 1e9;
-
-        auto df_qw = df_q.Filter([=](double W) { return (!hasW) || (W > wLo && W <= wHi); }, {"W"});
-
         // Histogram A_LU(cosθ_KK) for this (Q2, W) slice
         {
           auto hname = Form("phi_alu_costh_sinphi_Q%zu_W%zu_%lu", iq, iw, uidH.fetch_add(1));
@@ -2008,27 +2886,10 @@ class DISANAplotter {
           const double cLo = cEdges[ic];
           const double cHi = cEdges[ic + 1];
 
-          // Select cos(theta_KK) bin
-          auto df_costh = df_qw.Filter([=](double c) { return c > cLo && c <= cHi; }, {"cos_thetaKK"});
-
-          // Restrict to invariant-mass window
-          auto df_mass = df_costh.Filter([=](float m) { return m > mMin && m < mMax; }, {"invMass_KpKm"});
-
-          // Define sin(phi_Trento) (phi is in degrees in the tree)
-          auto df_sin = df_mass
-                            .Define("sinphi", [=](double phi_deg) { return std::sin(phi_deg * deg2rad); }, {"phi"})
-                            // helicity-weighted sinφ: +1 * sinφ for +hel, -1 * sinφ for -hel
-                            .Define("w_sinphi", [](short hel, double s) { return static_cast<double>(hel) * s; }, {"REC_Event_helicity", "sinphi"})
-                            // sin²φ for the denominator
-                            .Define("sin2", [](double s) { return s * s; }, {"sinphi"});
-
-          // Numerator: Σ hel * sinφ  over all events in this bin
-          auto sum_num = df_sin.Sum("w_sinphi");
-          // Denominator piece: Σ sin²φ over all events in this bin
-          auto sum_s2 = df_sin.Sum("sin2");
+          const size_t idxBin = spectra.Index(iq, iw, ic);
 
-          const double Nnum = static_cast<double>(*sum_num);  // Σ λ_i sinφ_i
-          const double S2 = static_cast<double>(*sum_s2);     // Σ sin²φ_i
+          const double Nnum = spectra.sum_hel_sinphi[idxBin];  // Σ λ_i sinφ_i
+          const double S2 = spectra.sum_sin2phi[idxBin];       // Σ sin²φ_i
 
           double A = 0.0;
           double dA = 0.0;
@@ -2102,20 +2963,21 @@ class DISANAplotter {
     static std::atomic<unsigned long> uidH{0};  // for hist names
     static std::atomic<unsigned long> uidC{0};  // for canvas names
 
-    auto df_all = rdf;
+    // one event loop filling the helicity-split N^±(φ_Trento) spectra
+    // (inside the mass window) for every (Q2,W,cosθ_KK) bin
+    const auto spectra = FillPhiBinSpectraSinglePass(rdf, q2Edges, wEdges, cEdges, "cos_thetaKK",
+                                                     /*nMassBins=*/120, mMin, mMax,
+                                                     /*splitHelicity=*/false, /*sinPhiMoments=*/false,
+                                                     &phiEdges, mMin, mMax);
 
     for (size_t iq = 0; iq < nQ; ++iq) {
       const double qLo = q2Edges[iq];
       const double qHi = q2Edges[iq + 1];
 
-      auto df_q = df_all.Filter([=](double Q2) { return Q2 > qLo && Q2 <= qHi; }, {"Q2"});
-
       for (size_t iw = 0; iw < nW; ++iw) {
         const double wLo = hasW ? wEdges[iw] : 0.0;
         const double wHi = hasW ? wEdges[iw + 1] : 1e9;
 
-        auto df_qw = df_q.Filter([=](double W) { return (!hasW) || (W > wLo && W <= wHi); }, {"W"});
-
         // A_LU(cosθ_KK) hist for this (Q2, W)
         {
           auto hname = Form("phi_alu_costh_sinOver1plusbcos_Q%zu_W%zu_%lu", iq, iw, uidH.fetch_add(1));
@@ -2129,24 +2991,10 @@ class DISANAplotter {
           const double cLo = cEdges[ic];
           const double cHi = cEdges[ic + 1];
 
-          // cos(theta_KK) slice
-          auto df_costh = df_qw.Filter([=](double c) { return c > cLo && c <= cHi; }, {"cos_thetaKK"});
-
-          // inv-mass window (branch is float!)
-          auto df_mass = df_costh.Filter([=](float m) { return m > mMin && m < mMax; }, {"invMass_KpKm"});
-
-          // helicity separation
-          auto df_pos = df_mass.Filter("REC_Event_helicity ==  1");
-          auto df_neg = df_mass.Filter("REC_Event_helicity == -1");
-
-          // N^+(phi), N^-(phi)
-          auto hPlus_ptr = df_pos.Histo1D({"hPlus_tmp", "hPlus_tmp", (int)nPhi, phiEdges.data()}, "phi");
-          auto hMinus_ptr = df_neg.Histo1D({"hMinus_tmp", "hMinus_tmp", (int)nPhi, phiEdges.data()}, "phi");
-
-          std::unique_ptr<TH1D> hPlus(dynamic_cast<TH1D*>(hPlus_ptr->Clone("hPlus_local")));
-          std::unique_ptr<TH1D> hMinus(dynamic_cast<TH1D*>(hMinus_ptr->Clone("hMinus_local")));
-          if (hPlus) hPlus->SetDirectory(nullptr);
-          if (hMinus) hMinus->SetDirectory(nullptr);
+          // N^+(phi), N^-(phi) — pre-filled by the single pass above
+          const size_t idxBin = spectra.Index(iq, iw, ic);
+          TH1D* hPlus = spectra.phiPos[idxBin].get();
+          TH1D* hMinus = spectra.phiNeg[idxBin].get();
 
           // BSA(phi)
           std::unique_ptr<TH1D> hBSA(new TH1D("hBSA_local", "BSA vs #phi_{Trento};#phi_{Trento} [deg];A_{LU}", (int)nPhi, phiEdges.data()));
@@ -2885,6 +3733,7 @@ class DISANAplotter {
   std::string predFileName = ".";
   double beam_energy;
   bool dopi0corr = false;
+  size_t bootstrapReplicas_ = 0;
   bool doacceptcorr = false;
   bool doefficiencycorr = false;
   bool doradiativecorr = false;
@@ -2915,6 +3764,99 @@ class DISANAplotter {
   std::vector<std::vector<double>> phi_mean_GammaV_xBt_;
   
   std::vector<ROOT::RDF::RResultPtr<TH1>> kinematicHistos, disHistos;
+  // Deferred-booking state (see SetDeferredHistogramBooking)
+  bool deferredBooking_ = false;
+  std::vector<std::pair<ROOT::RDF::RResultPtr<double>, ROOT::RDF::RResultPtr<double>>> pendingRanges_;
+  std::vector<std::function<void()>> pendingBookings_;
+  // persistent histogram cache (see EnablePhiHistogramCache)
+  std::string phiCacheFile_;
+  std::string phiCacheHash_;
+  bool phiCacheLoaded_ = false;
+  std::string phiAluCosFillTag_;  // which estimator filled phi_alu_cos_QW_ (see SetPhiALUCosThetaFillTag)
+
+  // correction response cache (see EnableCorrectionResponseCache)
+  std::string corrCacheFile_;
+  std::string corrCacheHash_;
+  std::vector<std::vector<std::vector<TH1D*>>> pi0_corr_cache_;
+  std::vector<std::vector<std::vector<TH1D*>>> rad_corr_cache_;
+
+  // Sidecar layout mirrors the φ cache: a config_hash TNamed guards
+  // validity, per-level dims TNameds record the (possibly ragged, e.g.
+  // xB-by-Q2) grid shape, and each ratio histogram sits under its
+  // (iq, it, ix) key.
+  bool LoadCorrectionGrid3D(const char* name, std::vector<std::vector<std::vector<TH1D*>>>& g) {
+    if (corrCacheFile_.empty()) return false;
+    if (gSystem->AccessPathName(corrCacheFile_.c_str())) return false;  // true == not readable
+
+    std::unique_ptr<TFile> f(TFile::Open(corrCacheFile_.c_str(), "READ"));
+    if (!f || f->IsZombie()) return false;
+
+    auto* tag = (TNamed*)f->Get("config_hash");
+    if (!tag || corrCacheHash_ != tag->GetTitle()) {
+      std::cout << "[CorrectionResponseCache] " << corrCacheFile_ << " is stale (configuration changed) — will refill.\n";
+      return false;
+    }
+
+    auto* dims = (TNamed*)f->Get(Form("%s__dims", name));
+    size_t n0 = 0;
+    if (!dims || sscanf(dims->GetTitle(), "%zu", &n0) != 1 || !n0) return false;
+
+    std::vector<std::vector<std::vector<TH1D*>>> loaded(n0);
+    for (size_t iq = 0; iq < n0; ++iq) {
+      auto* d1 = (TNamed*)f->Get(Form("%s__dims_q%zu", name, iq));
+      size_t n1 = 0;
+      if (!d1 || sscanf(d1->GetTitle(), "%zu", &n1) != 1) return false;
+      loaded[iq].resize(n1);
+      for (size_t it = 0; it < n1; ++it) {
+        auto* d2 = (TNamed*)f->Get(Form("%s__dims_q%zu_t%zu", name, iq, it));
+        size_t n2 = 0;
+        if (!d2 || sscanf(d2->GetTitle(), "%zu", &n2) != 1) return false;
+        loaded[iq][it].assign(n2, nullptr);
+        for (size_t ix = 0; ix < n2; ++ix) {
+          auto* h = (TH1D*)f->Get(Form("%s__q%zu_t%zu_x%zu", name, iq, it, ix));
+          if (h) {
+            h->SetDirectory(nullptr);
+            loaded[iq][it][ix] = h;
+          }
+        }
+      }
+    }
+    g = std::move(loaded);
+    std::cout << "[CorrectionResponseCache] restored " << name << " from " << corrCacheFile_ << "\n";
+    return true;
+  }
+
+  void SaveCorrectionGrid3D(const char* name, const std::vector<std::vector<std::vector<TH1D*>>>& g) {
+    if (corrCacheFile_.empty() || g.empty()) return;
+
+    // UPDATE so the pi0 and radiative grids accumulate in one file; a hash
+    // mismatch means the configuration changed and the file starts over.
+    std::unique_ptr<TFile> f(TFile::Open(corrCacheFile_.c_str(), "UPDATE"));
+    if (!f || f->IsZombie()) {
+      std::cerr << "[CorrectionResponseCache] cannot open " << corrCacheFile_ << " for writing.\n";
+      return;
+    }
+    auto* tag = (TNamed*)f->Get("config_hash");
+    if (tag && corrCacheHash_ != tag->GetTitle()) {
+      f.reset(TFile::Open(corrCacheFile_.c_str(), "RECREATE"));
+      if (!f || f->IsZombie()) return;
+      tag = nullptr;
+    }
+    if (!tag) TNamed("config_hash", corrCacheHash_.c_str()).Write();
+
+    TNamed(Form("%s__dims", name), Form("%zu", g.size())).Write(nullptr, TObject::kOverwrite);
+    for (size_t iq = 0; iq < g.size(); ++iq) {
+      TNamed(Form("%s__dims_q%zu", name, iq), Form("%zu", g[iq].size())).Write(nullptr, TObject::kOverwrite);
+      for (size_t it = 0; it < g[iq].size(); ++it) {
+        TNamed(Form("%s__dims_q%zu_t%zu", name, iq, it), Form("%zu", g[iq][it].size())).Write(nullptr, TObject::kOverwrite);
+        for (size_t ix = 0; ix < g[iq][it].size(); ++ix)
+          if (g[iq][it][ix]) g[iq][it][ix]->Write(Form("%s__q%zu_t%zu_x%zu", name, iq, it, ix), TObject::kOverwrite);
+      }
+    }
+    f->Close();
+    std::cout << "[CorrectionResponseCache] wrote " << name << " to " << corrCacheFile_ << "\n";
+  }
+
   std::vector<std::vector<TH1D*>> phi_dsdt_QW_;
   std::vector<std::vector<TH1D*>> phi_nsig_QW_;   // raw fit yields Nsig per (Q2,W,t) bin
   std::vector<std::vector<TH1D*>> phi_alu_costh_QW_;
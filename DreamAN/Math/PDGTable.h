@@ -0,0 +1,106 @@
+#ifndef PDGTABLE_H
+#define PDGTABLE_H
+
+// One constexpr PDG property table for every subsystem that needs particle
+// masses or charges.  Before this header the same numbers lived in three
+// places — the switch in Cuts/EventCut.h, the unordered_map behind
+// getParticleMass() in its own translation unit, and hardcoded constants in
+// DrawHist/DISANAMath.h — with slightly different precision in each.  All
+// lookups here are constexpr, so in the per-particle loops they compile to
+// constant loads (or a jump table when the pid is only known at runtime),
+// and the dense compact index can key flattened per-species arrays directly.
+namespace PDG {
+
+struct Properties {
+  int pid;       // signed PDG code
+  float mass;    // GeV
+  float charge;  // units of e
+};
+
+// Species known to the analysis, one row per signed pid.  Row order defines
+// the compact index; CompactIndex() below must mirror it (checked by the
+// static_assert at the end of this header).
+inline constexpr Properties kTable[] = {
+    {11, 0.000510999f, -1.f},   // e-
+    {-11, 0.000510999f, +1.f},  // e+
+    {13, 0.105658375f, -1.f},   // mu-
+    {-13, 0.105658375f, +1.f},  // mu+
+    {22, 0.0f, 0.f},            // photon
+    {111, 0.1349768f, 0.f},     // pi0
+    {211, 0.13957039f, +1.f},   // pi+
+    {-211, 0.13957039f, -1.f},  // pi-
+    {321, 0.493677f, +1.f},     // K+
+    {-321, 0.493677f, -1.f},    // K-
+    {130, 0.497611f, 0.f},      // K0L
+    {310, 0.497611f, 0.f},      // K0S
+    {2112, 0.939565413f, 0.f},  // neutron
+    {-2112, 0.939565413f, 0.f}, // anti-neutron
+    {2212, 0.938272081f, +1.f}, // proton
+    {-2212, 0.938272081f, -1.f},// anti-proton
+    {113, 0.77526f, 0.f},       // rho0
+    {213, 0.77526f, +1.f},      // rho+
+    {-213, 0.77526f, -1.f},     // rho-
+    {323, 0.89166f, +1.f},      // K*+
+    {-323, 0.89166f, -1.f},     // K*-
+    {333, 1.019461f, 0.f},      // phi
+};
+
+inline constexpr int kNSpecies = static_cast<int>(sizeof(kTable) / sizeof(kTable[0]));
+
+// Dense row index for a signed pid, -1 when unknown.
+constexpr int CompactIndex(int pid) {
+  switch (pid) {
+    case 11:    return 0;
+    case -11:   return 1;
+    case 13:    return 2;
+    case -13:   return 3;
+    case 22:    return 4;
+    case 111:   return 5;
+    case 211:   return 6;
+    case -211:  return 7;
+    case 321:   return 8;
+    case -321:  return 9;
+    case 130:   return 10;
+    case 310:   return 11;
+    case 2112:  return 12;
+    case -2112: return 13;
+    case 2212:  return 14;
+    case -2212: return 15;
+    case 113:   return 16;
+    case 213:   return 17;
+    case -213:  return 18;
+    case 323:   return 19;
+    case -323:  return 20;
+    case 333:   return 21;
+    default:    return -1;
+  }
+}
+
+// Mass in GeV; 0 for species outside the table (matching the historical
+// behaviour of the EventCut switch).  Unsigned lookups fall through to the
+// particle row, so Mass(-pid) == Mass(pid) for every listed species.
+constexpr float Mass(int pid) {
+  const int idx = CompactIndex(pid) >= 0 ? CompactIndex(pid) : CompactIndex(-pid);
+  return idx < 0 ? 0.0f : kTable[idx].mass;
+}
+
+// Charge in units of e; 0 for species outside the table.
+constexpr float Charge(int pid) {
+  const int idx = CompactIndex(pid);
+  return idx < 0 ? 0.0f : kTable[idx].charge;
+}
+
+namespace detail {
+constexpr bool TableConsistent() {
+  for (int i = 0; i < kNSpecies; ++i) {
+    if (CompactIndex(kTable[i].pid) != i) return false;
+  }
+  return true;
+}
+}  // namespace detail
+static_assert(detail::TableConsistent(),
+              "PDG::CompactIndex must mirror the kTable row order");
+
+}  // namespace PDG
+
+#endif  // PDGTABLE_H
@@ -1,8 +1,22 @@
 #ifndef PARTICLEMASSTABLE_H
 #define PARTICLEMASSTABLE_H
 
-#include <unordered_map>
+#include <stdexcept>
+#include <string>
 
-double getParticleMass(int pid);
+#include "PDGTable.h"
 
-#endif // PARTICLEMASSTABLE_H
\ No newline at end of file
+// Header-inline over the shared constexpr table so the lookup inlines into
+// the kinematic per-particle loops (it used to live in its own translation
+// unit behind an unordered_map).  Unknown pids still throw, as the old
+// implementation did — the kinematic Defines rely on that to flag a
+// misconfigured particle list rather than silently building massless
+// four-vectors.
+inline double getParticleMass(int pid) {
+  if (PDG::CompactIndex(pid) < 0) {
+    throw std::invalid_argument("Unknown pid: " + std::to_string(pid));
+  }
+  return PDG::Mass(pid);
+}
+
+#endif // PARTICLEMASSTABLE_H
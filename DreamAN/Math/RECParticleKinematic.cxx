@@ -75,6 +75,45 @@ RECStoreType RECParticleP(){
     };
 }
 
+RECKinStoreType RECParticleKinematics() {
+    return [](const std::vector<int>& pid,
+              const std::vector<float>& px,
+              const std::vector<float>& py,
+              const std::vector<float>& pz,
+              const std::vector<float>& vx,
+              const std::vector<float>& vy,
+              const std::vector<float>& vz,
+              const std::vector<float>& vt,
+              const std::vector<short>& charge,
+              const std::vector<float>& beta,
+              const std::vector<float>& chi2pid,
+              const std::vector<short>& status) -> RECParticleKin {
+
+        RECParticleKin kin;
+        const size_t n = pid.size();
+        kin.theta.resize(n);
+        kin.phi.resize(n);
+        kin.p.resize(n);
+        // Single pass over the contiguous momentum arrays: the pt^2 term is
+        // shared between p and theta, and indexing (instead of push_back)
+        // keeps the loop body straight-line for the vectorizer.
+        const float* X = px.data();
+        const float* Y = py.data();
+        const float* Z = pz.data();
+        for (size_t i = 0; i < n; ++i) {
+            const float pt2 = X[i] * X[i] + Y[i] * Y[i];
+            kin.p[i] = std::sqrt(pt2 + Z[i] * Z[i]);
+            kin.theta[i] = std::atan2(std::sqrt(pt2), Z[i]);
+            float phi = std::atan2(Y[i], X[i]);
+            if (phi < 0) {
+                phi += 2 * M_PI;
+            }
+            kin.phi[i] = phi;
+        }
+        return kin;
+    };
+}
+
 RECStoreType EventQ2(float E, int target_pid, int target_charge) {
     return [E,target_pid,target_charge](const std::vector<int>& pid,
               const std::vector<float>& px,
@@ -21,9 +21,35 @@ using RECStoreType = std::function<std::vector<float>(
 )>;
 
 
+// Fused theta/phi/p kinematics, filled by one traversal of the momenta.
+// The three per-column Defines each re-read px/py/pz and redo the shared
+// pt^2 term; RECParticleKinematics() computes all three arrays at once and
+// the columns are peeled off the struct with cheap accessor Defines.
+struct RECParticleKin {
+  std::vector<float> theta;
+  std::vector<float> phi;
+  std::vector<float> p;
+};
+
+using RECKinStoreType = std::function<RECParticleKin(
+    const std::vector<int>&,
+    const std::vector<float>&,
+    const std::vector<float>&,
+    const std::vector<float>&,
+    const std::vector<float>&,
+    const std::vector<float>&,
+    const std::vector<float>&,
+    const std::vector<float>&,
+    const std::vector<short>&,
+    const std::vector<float>&,
+    const std::vector<float>&,
+    const std::vector<short>&
+)>;
+
 RECStoreType RECParticletheta();
 RECStoreType RECParticlephi();
 RECStoreType RECParticleP();
+RECKinStoreType RECParticleKinematics();
 
 RECStoreType EventQ2(float E, int target_pid, int target_charge);
 RECStoreType EventxB(float E, int target_pid, int target_charge, float target_mass);
@@ -0,0 +1,56 @@
+#ifndef PINDEXHITINDEX_H
+#define PINDEXHITINDEX_H
+
+#include <cstddef>
+#include <vector>
+
+// Per-event index of detector-bank rows grouped by REC::Particle index.
+//
+// The REC::Traj / REC::Calorimeter / REC::ForwardTagger / REC::Track banks all
+// reference particles through a pindex column.  Instead of re-scanning the full
+// hit list once per pass function (and once per particle in sector lookups),
+// this structure is built once per event from the pindex column with a stable
+// counting sort and then gives O(1) access to the contiguous row range of each
+// particle.  Rows with an invalid pindex (unmatched hits, pindex = -1) are
+// dropped during the build, so consumers no longer need per-hit validity checks.
+struct PindexHitIndex {
+  std::vector<int> rowStart;  // size nParticles+1; CSR offsets into rows
+  std::vector<int> rows;      // bank row numbers grouped by particle, row order preserved
+  std::vector<int> cursor;    // Build scratch; member so a reused index keeps its capacity
+
+  template <typename T>
+  void Build(const std::vector<T>& pindex, int nParticles) {
+    rowStart.assign(nParticles + 1, 0);
+    if (nParticles <= 0) {
+      rows.clear();
+      return;
+    }
+    for (size_t i = 0; i < pindex.size(); ++i) {
+      const int p = static_cast<int>(pindex[i]);
+      if (p >= 0 && p < nParticles) ++rowStart[p + 1];
+    }
+    for (int p = 0; p < nParticles; ++p) rowStart[p + 1] += rowStart[p];
+    rows.resize(rowStart[nParticles]);
+    cursor.assign(rowStart.begin(), rowStart.end() - 1);
+    for (size_t i = 0; i < pindex.size(); ++i) {
+      const int p = static_cast<int>(pindex[i]);
+      if (p >= 0 && p < nParticles) rows[cursor[p]++] = static_cast<int>(i);
+    }
+  }
+
+  // Iterable view over the bank rows of one particle.
+  struct RowRange {
+    const int* first;
+    const int* last;
+    const int* begin() const { return first; }
+    const int* end() const { return last; }
+    bool empty() const { return first == last; }
+  };
+
+  RowRange RowsOf(int particle) const {
+    if (particle < 0 || particle + 1 >= static_cast<int>(rowStart.size())) return {nullptr, nullptr};
+    return {rows.data() + rowStart[particle], rows.data() + rowStart[particle + 1]};
+  }
+};
+
+#endif  // PINDEXHITINDEX_H
@@ -3,6 +3,8 @@
 #include <cmath>
 #include <functional>
 
+#include "../Math/PDGTable.h"
+
 const std::vector<std::string>& RECParticle::All() {
     static const std::vector<std::string> names = {
         "REC_Particle_pid",
@@ -37,6 +39,7 @@ std::function<std::vector<float>(const std::vector<float>&, const std::vector<in
 get_RECParticle_float_var(int target_pid, int target_charge) {
     return [target_pid, target_charge](const std::vector<float>& var, const std::vector<int>& pid, const std::vector<short>& charge, const std::vector<float>& p, const std::vector<int>& trackpass) {
         std::vector<float> out;
+        out.reserve(pid.size());  // one right-sized allocation, no push_back regrowth
         for (size_t i = 0; i < pid.size(); ++i) {
             if (pid[i] == target_pid && charge[i]==target_charge && p[i] > 0.02 && trackpass[i] == 1) {
                 out.push_back(var[i]);
@@ -46,10 +49,11 @@ get_RECParticle_float_var(int target_pid, int target_charge) {
     };
 }
 
-std::function<std::vector<int>(const std::vector<int>&, const std::vector<int>&, const std::vector<short>&, const std::vector<float>&, const std::vector<int>&)> 
+std::function<std::vector<int>(const std::vector<int>&, const std::vector<int>&, const std::vector<short>&, const std::vector<float>&, const std::vector<int>&)>
 get_RECParticle_int_var(int target_pid, int target_charge) {
     return [target_pid, target_charge](const std::vector<int>& var, const std::vector<int>& pid, const std::vector<short>& charge, const std::vector<float>& p, const std::vector<int>& trackpass) {
         std::vector<int> out;
+        out.reserve(pid.size());  // one right-sized allocation, no push_back regrowth
         for (size_t i = 0; i < pid.size(); ++i) {
             if (pid[i] == target_pid && charge[i]==target_charge && p[i] > 0.02 && trackpass[i] == 1) {
                 out.push_back(var[i]);
@@ -59,3 +63,43 @@ get_RECParticle_int_var(int target_pid, int target_charge) {
     };
 }
 
+std::function<std::vector<short>(const std::vector<int>&, const std::vector<short>&, const std::vector<float>&, const std::vector<int>&)>
+RECParticleCategoryTable() {
+    return [](const std::vector<int>& pid, const std::vector<short>& charge, const std::vector<float>& p, const std::vector<int>& trackpass) {
+        std::vector<short> category(pid.size(), -1);
+        for (size_t i = 0; i < pid.size(); ++i) {
+            if (!(p[i] > 0.02) || trackpass[i] != 1) continue;
+            const int idx = PDG::CompactIndex(pid[i]);
+            // The same charge-consistency test the per-species extractors
+            // apply: callers always pass the species' PDG charge.
+            if (idx < 0 || charge[i] != static_cast<short>(PDG::kTable[idx].charge)) continue;
+            category[i] = static_cast<short>(idx);
+        }
+        return category;
+    };
+}
+
+std::function<std::vector<float>(const std::vector<float>&, const std::vector<short>&)>
+get_RECParticle_float_var_bycat(int target_pid) {
+    return [target = static_cast<short>(PDG::CompactIndex(target_pid))](const std::vector<float>& var, const std::vector<short>& category) {
+        std::vector<float> out;
+        out.reserve(category.size());  // one right-sized allocation, no push_back regrowth
+        for (size_t i = 0; i < category.size(); ++i) {
+            if (category[i] == target) out.push_back(var[i]);
+        }
+        return out;
+    };
+}
+
+std::function<std::vector<int>(const std::vector<int>&, const std::vector<short>&)>
+get_RECParticle_int_var_bycat(int target_pid) {
+    return [target = static_cast<short>(PDG::CompactIndex(target_pid))](const std::vector<int>& var, const std::vector<short>& category) {
+        std::vector<int> out;
+        out.reserve(category.size());  // one right-sized allocation, no push_back regrowth
+        for (size_t i = 0; i < category.size(); ++i) {
+            if (category[i] == target) out.push_back(var[i]);
+        }
+        return out;
+    };
+}
+
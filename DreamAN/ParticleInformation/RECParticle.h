@@ -28,11 +28,34 @@ struct RECParticle {
 
 
 
-std::function<std::vector<float>(const std::vector<float>&, const std::vector<int>&, const std::vector<short>&, const std::vector<float>&, const std::vector<int>&)> 
+std::function<std::vector<float>(const std::vector<float>&, const std::vector<int>&, const std::vector<short>&, const std::vector<float>&, const std::vector<int>&)>
 get_RECParticle_float_var(int target_pid, int target_charge);
 
 
-std::function<std::vector<int>(const std::vector<int>&, const std::vector<int>&, const std::vector<short>&, const std::vector<float>&, const std::vector<int>&)> 
+std::function<std::vector<int>(const std::vector<int>&, const std::vector<int>&, const std::vector<short>&, const std::vector<float>&, const std::vector<int>&)>
 get_RECParticle_int_var(int target_pid, int target_charge);
 
+// Classification-once extractors.  Stacking the per-species functors above
+// re-tests every particle of every event against pid/charge/p/trackpass once
+// per extracted variable — the phi chain books ~10 such Defines over the same
+// columns.  RECParticleCategoryTable() classifies the event once instead:
+// category[i] is the compact PDG index (PDG::CompactIndex) of particle i when
+// it passes the shared preconditions (charge consistent with the pid's PDG
+// charge, p > 0.02, trackpass == 1), -1 otherwise.  Book it as one Define
+// ("REC_Particle_category") and every per-species extractor becomes a gather
+// comparing a single short per particle:
+//
+//   df.Define("REC_Particle_category", RECParticleCategoryTable(),
+//             {"REC_Particle_pid", "REC_Particle_charge", "REC_Particle_p", "REC_Track_pass_fid"})
+//     .Define("kPlus_px", get_RECParticle_float_var_bycat(321),
+//             {"REC_Particle_px", "REC_Particle_category"});
+std::function<std::vector<short>(const std::vector<int>&, const std::vector<short>&, const std::vector<float>&, const std::vector<int>&)>
+RECParticleCategoryTable();
+
+std::function<std::vector<float>(const std::vector<float>&, const std::vector<short>&)>
+get_RECParticle_float_var_bycat(int target_pid);
+
+std::function<std::vector<int>(const std::vector<int>&, const std::vector<short>&)>
+get_RECParticle_int_var_bycat(int target_pid);
+
 #endif
\ No newline at end of file
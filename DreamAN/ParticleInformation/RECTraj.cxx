@@ -154,6 +154,7 @@ get_RECTraj_float_var(int target_detector, int target_layer, int target_pid, int
                const std::vector<float>& p,
                const std::vector<int>& trackpass) -> std::vector<float> {
         std::vector<float> out;
+        out.reserve(pid.size());  // one right-sized allocation, no push_back regrowth
         for (size_t i = 0; i < pid.size(); ++i) {
             for (size_t j = 0; j < detector.size(); ++j) {
                 if (detector[j] == target_detector && layer[j] == target_layer &&
@@ -5,12 +5,24 @@
 #include <TH1F.h>
 #include <TTree.h>
 
+#include <Compression.h>
 #include <ROOT/RDF/RInterface.hxx>
+#include <ROOT/RDFHelpers.hxx>
+#include <ROOT/RSnapshotOptions.hxx>
+#include <RVersion.h>
+
+#include <iostream>
 #include <map>
 #include <string>
 
+#include "PipelineTimer.h"
 #include "RHipoDS.hxx"
 
+// RNTuple output from Snapshot needs the ESnapshotOutputFormat option.
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 34, 0)
+#define DISANA_HAS_RNTUPLE_SNAPSHOT 1
+#endif
+
 class AnalysisTaskManager;  // forward declare
 
 class AnalysisTask {
@@ -23,11 +35,86 @@ class AnalysisTask {
   virtual void SaveOutput() = 0;
   virtual void Terminate(Option_t* = nullptr) {}
 
+  // Shared-loop protocol (see AnalysisTaskManager::SetSharedEventLoop): a
+  // task that can book all of its RDF results lazily appends their handles
+  // here and returns true.  The manager concatenates the handles of every
+  // booked task and drives them with one RunGraphs call, so N tasks on the
+  // same graph cost a single read of the input.  SaveOutput() still runs
+  // afterwards for the post-loop work (prints, CSVs, ledgers) — by then
+  // every handle is materialized.  The default keeps the task on its own
+  // eager SaveOutput() loop.
+  virtual bool BookLazyOutputs(std::vector<ROOT::RDF::RResultHandle>& /*handles*/) { return false; }
+
   void SetTaskManager(AnalysisTaskManager* mgr) { fTaskManager = mgr; }
 
   // New virtual method to receive output file pointer
   virtual void SetOutputFile(TFile* file) {}
   virtual void SetOutputDir(const std::string& dir) {}
+
+  // Datasource column pruning: the input columns this task reads, as exact
+  // names or bank prefixes ("REC_Particle" covers every REC_Particle_*
+  // column).  An empty vector means the task needs the full schema and
+  // disables pruning.  See AnalysisTaskManager::RequestedColumns().
+  virtual std::vector<std::string> RequestedColumns() const { return {}; }
+
+  // Upper bound on the events this task wants to process, 0 = everything.
+  // Bounded runs used to go through df.Range(), which forces single-threaded
+  // execution; instead Events trims the input file list to roughly this many
+  // events (header-only census, rounded up to whole files), so quick
+  // validation passes keep full IMT parallelism.  See
+  // AnalysisTaskManager::MaxEventsHint().
+  virtual size_t MaxEventsHint() const { return 0; }
+
+  // Write snapshots as RNTuples instead of TTrees.  The std::vector branches
+  // deserialize much faster from the columnar format, which pays off every
+  // time the plotters re-read the intermediate files.  Falls back to TTree
+  // (with a warning) on ROOT versions without RNTuple Snapshot support.
+  void SetUseRNTuple(bool use) { fUseRNTupleOutput = use; }
+
+  // Compression profiles for snapshot outputs.  Intermediates (dfSelected*)
+  // are rewritten and re-read constantly, so the default is LZ4: cheap to
+  // compress in the event loop and to decompress in every plotting pass.
+  // Archival outputs kept long-term (e.g. dfSelectedMC.root) default to
+  // high-level zstd for size.
+  enum class SnapshotProfile { kIntermediate, kArchival };
+
+  void SetIntermediateCompression(ROOT::RCompressionSetting::EAlgorithm::EValues algo, int level) {
+    fIntermediateAlgo = algo;
+    fIntermediateLevel = level;
+  }
+  void SetArchivalCompression(ROOT::RCompressionSetting::EAlgorithm::EValues algo, int level) {
+    fArchivalAlgo = algo;
+    fArchivalLevel = level;
+  }
+
+  // Snapshot options honouring the RNTuple switch and the compression
+  // profile; every Snapshot in SaveOutput and the helpers below should
+  // start from these.
+  ROOT::RDF::RSnapshotOptions MakeSnapshotOptions(bool lazy = false,
+                                                  SnapshotProfile profile = SnapshotProfile::kIntermediate) const {
+    ROOT::RDF::RSnapshotOptions opts;
+    opts.fLazy = lazy;
+    if (profile == SnapshotProfile::kArchival) {
+      opts.fCompressionAlgorithm = fArchivalAlgo;
+      opts.fCompressionLevel = fArchivalLevel;
+    } else {
+      opts.fCompressionAlgorithm = fIntermediateAlgo;
+      opts.fCompressionLevel = fIntermediateLevel;
+    }
+    if (fUseRNTupleOutput) {
+#ifdef DISANA_HAS_RNTUPLE_SNAPSHOT
+      opts.fOutputFormat = ROOT::RDF::ESnapshotOutputFormat::kRNTuple;
+#else
+      static bool warned = false;
+      if (!warned) {
+        std::cerr << "[AnalysisTask] RNTuple output requested but this ROOT version "
+                     "cannot write RNTuple snapshots; falling back to TTree.\n";
+        warned = true;
+      }
+#endif
+    }
+    return opts;
+  }
   template <typename Lambda>
   ROOT::RDF::RNode DefineOrRedefine(ROOT::RDF::RNode df, const std::string& name, Lambda&& lambda, const std::vector<std::string>& columns) {
     auto existingCols = df.GetColumnNames();
@@ -37,6 +124,17 @@ class AnalysisTask {
     return df.Define(name, std::forward<Lambda>(lambda), columns);
   }
 
+  // Slot-aware sibling of DefineOrRedefine for callables that keep per-slot
+  // scratch buffers (their first argument is the slot number).
+  template <typename Lambda>
+  ROOT::RDF::RNode DefineSlotOrRedefine(ROOT::RDF::RNode df, const std::string& name, Lambda&& lambda, const std::vector<std::string>& columns) {
+    auto existingCols = df.GetColumnNames();
+    if (std::find(existingCols.begin(), existingCols.end(), name) != existingCols.end()) {
+      return df.RedefineSlot(name, std::forward<Lambda>(lambda), columns);
+    }
+    return df.DefineSlot(name, std::forward<Lambda>(lambda), columns);
+  }
+
   void SafeSnapshot(ROOT::RDF::RNode df, const std::string& treename, const std::string& filename, const std::vector<std::string>& excludeCols = {"EventCutResult"}) {
     auto allCols = df.GetColumnNames();
     std::vector<std::string> outputCols;
@@ -47,7 +145,7 @@ class AnalysisTask {
       }
     }
 
-    df.Snapshot(treename, filename, outputCols);
+    df.Snapshot(treename, filename, outputCols, MakeSnapshotOptions());
   }
 
   // SelectiveSnapshot: snapshot only the columns in wantedCols that actually
@@ -65,7 +163,7 @@ class AnalysisTask {
         outputCols.push_back(col);
       }
     }
-    df.Snapshot(treename, filename, outputCols);
+    df.Snapshot(treename, filename, outputCols, MakeSnapshotOptions());
   }
 
   // ResolveSnapshotColumns: returns the subset of wantedCols that exist in df.
@@ -81,6 +179,7 @@ class AnalysisTask {
       if (std::find(allCols.begin(), allCols.end(), col) != allCols.end())
         result.push_back(col);
     }
+    RecordSnapshotMemoryEstimates(df, "resolved", result);
     return result;
   }
 
@@ -96,11 +195,69 @@ class AnalysisTask {
       if (std::find(excludeCols.begin(), excludeCols.end(), col) == excludeCols.end())
         result.push_back(col);
     }
+    RecordSnapshotMemoryEstimates(df, "full", result);
     return result;
   }
 
  protected:
+  // Memory telemetry for a snapshot column set (no-op unless the timing
+  // report is enabled).  Per-column element sizes come from the declared
+  // column type — vector columns are flagged so the reader knows to scale by
+  // multiplicity — and the basket estimate is nColumns x ROOT's default
+  // 32 kB basket x one write buffer per slot, which is what a TTree snapshot
+  // holds resident during the event loop.  Labels are <kind>_<n> in snapshot
+  // booking order.
+  void RecordSnapshotMemoryEstimates(ROOT::RDF::RNode df, const std::string& kind,
+                                     const std::vector<std::string>& cols) {
+    auto& timer = PipelineTimer::Instance();
+    if (!timer.Enabled()) return;
+
+    const std::string label = kind + "_" + std::to_string(fColumnSetCounter++);
+    for (const auto& col : cols) {
+      const std::string type = df.GetColumnType(col);
+      std::string elemType = type;
+      bool variable = false;
+      const auto lt = type.find('<');
+      if (lt != std::string::npos &&
+          (type.find("vector<") != std::string::npos || type.find("RVec<") != std::string::npos)) {
+        variable = true;
+        elemType = type.substr(lt + 1, type.rfind('>') - lt - 1);
+      }
+      timer.RecordColumnEstimate(label, col, type, EstimateElementBytes(elemType), variable);
+    }
+
+    const unsigned int nSlots = df.GetNSlots() > 0 ? df.GetNSlots() : 1;
+    constexpr unsigned long long kDefaultBasketBytes = 32000;  // TTree default basket
+    timer.RecordSnapshotBuffers(label, cols.size(), nSlots,
+                                cols.size() * kDefaultBasketBytes * nSlots);
+  }
+
+  // Rough per-element size from the declared type name; unknown types fall
+  // back to 8 bytes.
+  static std::size_t EstimateElementBytes(const std::string& type) {
+    if (type.find("double") != std::string::npos || type.find("Double") != std::string::npos ||
+        type.find("long") != std::string::npos || type.find("Long") != std::string::npos)
+      return 8;
+    if (type.find("short") != std::string::npos || type.find("Short") != std::string::npos ||
+        type.find("int16") != std::string::npos)
+      return 2;
+    if (type.find("char") != std::string::npos || type.find("Char") != std::string::npos ||
+        type.find("bool") != std::string::npos || type.find("Bool") != std::string::npos ||
+        type.find("int8") != std::string::npos)
+      return 1;
+    if (type.find("float") != std::string::npos || type.find("Float") != std::string::npos ||
+        type.find("int") != std::string::npos || type.find("Int") != std::string::npos ||
+        type.find("UInt") != std::string::npos)
+      return 4;
+    return 8;
+  }
   AnalysisTaskManager* fTaskManager = nullptr;
+  unsigned int fColumnSetCounter = 0;  // numbers the memory-telemetry labels
+  bool fUseRNTupleOutput = false;  // snapshot format: false → TTree, true → RNTuple
+  ROOT::RCompressionSetting::EAlgorithm::EValues fIntermediateAlgo = ROOT::RCompressionSetting::EAlgorithm::kLZ4;
+  int fIntermediateLevel = 4;
+  ROOT::RCompressionSetting::EAlgorithm::EValues fArchivalAlgo = ROOT::RCompressionSetting::EAlgorithm::kZSTD;
+  int fArchivalLevel = 9;
 };
 
 #endif
@@ -1,6 +1,10 @@
 #include "AnalysisTaskManager.h"
 #include "AnalysisTask.h"
+#include "PipelineTimer.h"
 #include <TFile.h>
+#include <ROOT/RDFHelpers.hxx>
+#include <algorithm>
+#include <chrono>
 
 AnalysisTaskManager::AnalysisTaskManager() {}
 AnalysisTaskManager::~AnalysisTaskManager() {
@@ -8,26 +12,112 @@ AnalysisTaskManager::~AnalysisTaskManager() {
 
 void AnalysisTaskManager::AddTask(std::shared_ptr<AnalysisTask> task) {
     task->SetTaskManager(this);
+    task->SetUseRNTuple(useRNTuple);
     tasks.push_back(std::move(task));
 }
 
+void AnalysisTaskManager::SetUseRNTuple(bool use) {
+    useRNTuple = use;
+    for (auto& task : tasks) task->SetUseRNTuple(use);
+}
+
 void AnalysisTaskManager::UserCreateOutputObjects() {
     for (auto& task : tasks) task->UserCreateOutputObjects();
 }
 
+void AnalysisTaskManager::SetTimingReport(bool enable) {
+    timingReport = enable;
+    PipelineTimer::Instance().SetEnabled(enable);
+}
+
+void AnalysisTaskManager::SetSharedEventLoop(bool enable) {
+    sharedEventLoop = enable;
+}
+
 void AnalysisTaskManager::Execute(ROOT::RDF::RNode& df) {
-    for (auto& task : tasks) task->UserExec(df);
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        const auto t0 = std::chrono::steady_clock::now();
+        tasks[i]->UserExec(df);
+        if (timingReport) {
+            const std::chrono::duration<double> dt = std::chrono::steady_clock::now() - t0;
+            PipelineTimer::Instance().RecordStage("UserExec/task" + std::to_string(i), dt.count());
+        }
+    }
 }
 
 void AnalysisTaskManager::SetOututDir(const std::string& Outputdir) {
     outputDir = Outputdir;
 }
 
+// Union of the input columns requested by the booked tasks, used by Events to
+// prune the datasource schema.  If any task does not restrict its inputs
+// (returns an empty set), the union is the full schema and {} is returned.
+std::vector<std::string> AnalysisTaskManager::RequestedColumns() const {
+    std::vector<std::string> requested;
+    for (const auto& task : tasks) {
+        auto cols = task->RequestedColumns();
+        if (cols.empty()) return {};
+        for (auto& col : cols) {
+            if (std::find(requested.begin(), requested.end(), col) == requested.end())
+                requested.push_back(std::move(col));
+        }
+    }
+    return requested;
+}
+
+// Combined event budget of the booked tasks, used by Events to trim the input
+// file list for bounded runs.  If any task wants the full dataset (hint 0)
+// the inputs must not be trimmed, so 0 is returned; otherwise the largest
+// hint wins so every task sees at least the events it asked for.
+size_t AnalysisTaskManager::MaxEventsHint() const {
+    size_t hint = 0;
+    for (const auto& task : tasks) {
+        const size_t h = task->MaxEventsHint();
+        if (h == 0) return 0;
+        hint = std::max(hint, h);
+    }
+    return hint;
+}
+
 void AnalysisTaskManager::SaveOutput() {
     if (outputDir =="./") std::cerr << "[SaveOutput] the default output dir is ./!" << std::endl;
-    for (auto& task : tasks) {
-        task->SetOutputDir(outputDir);
-        task->SaveOutput();
+
+    // Shared loop: collect the lazily booked results of every task that
+    // supports it and run them together — one read of the input for all
+    // channels.  Each task's SaveOutput below then only does its post-loop
+    // work on the already-materialized handles.
+    if (sharedEventLoop) {
+        std::vector<ROOT::RDF::RResultHandle> handles;
+        size_t booked = 0;
+        for (auto& task : tasks) {
+            task->SetOutputDir(outputDir);  // snapshots book with their final paths
+            if (task->BookLazyOutputs(handles)) ++booked;
+        }
+        if (!handles.empty()) {
+            std::cout << "[SaveOutput] Shared event loop — driving " << handles.size()
+                      << " booked result(s) from " << booked << " task(s) in one pass.\n";
+            const auto t0 = std::chrono::steady_clock::now();
+            ROOT::RDF::RunGraphs(handles);
+            if (timingReport) {
+                const std::chrono::duration<double> dt = std::chrono::steady_clock::now() - t0;
+                PipelineTimer::Instance().RecordStage("SharedEventLoop", dt.count());
+            }
+        }
+    }
+
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        tasks[i]->SetOutputDir(outputDir);
+        // SaveOutput is where the event loops actually run, so this stage
+        // time is the per-task wall clock of the pass.
+        const auto t0 = std::chrono::steady_clock::now();
+        tasks[i]->SaveOutput();
+        if (timingReport) {
+            const std::chrono::duration<double> dt = std::chrono::steady_clock::now() - t0;
+            PipelineTimer::Instance().RecordStage("SaveOutput/task" + std::to_string(i), dt.count());
+        }
+    }
+    if (timingReport) {
+        PipelineTimer::Instance().WriteReport(outputDir + "/timing_report.csv");
     }
 }
 
@@ -22,9 +22,27 @@ public:
     void Execute(ROOT::RDF::RNode& df);
     void SaveOutput();
     void SetOututDir(const std::string& Outputdir="./");
+    // Snapshot format switch for every booked task (and tasks added later):
+    // true writes RNTuple outputs instead of TTrees.
+    void SetUseRNTuple(bool use);
+    // Per-node/per-stage timing instrumentation (see PipelineTimer): records
+    // sampled functor times, stage wall clocks and input byte counts, and
+    // writes <outputDir>/timing_report.csv after SaveOutput.
+    void SetTimingReport(bool enable);
+    // Shared event loop across tasks: every task that supports lazy booking
+    // (AnalysisTask::BookLazyOutputs) contributes its result handles and one
+    // RunGraphs call drives them all in a single read of the input, instead
+    // of one full pass per task.  Tasks without lazy booking still run their
+    // own loop in SaveOutput as before.
+    void SetSharedEventLoop(bool enable);
+    std::vector<std::string> RequestedColumns() const;
+    size_t MaxEventsHint() const;
 private:
     std::vector<std::shared_ptr<AnalysisTask>> tasks;
     std::string outputDir;
+    bool useRNTuple = false;
+    bool timingReport = false;
+    bool sharedEventLoop = false;
 
 };
 
@@ -0,0 +1,56 @@
+#ifndef COLUMNPRUNEDHIPODS_H
+#define COLUMNPRUNEDHIPODS_H
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "hipo4/RHipoDS.hxx"
+
+// RHipoDS with its advertised schema restricted to the columns the booked
+// analysis tasks actually read.  RDataFrame only asks a datasource for the
+// columns that appear in the computation graph, but wildcard consumers
+// (full-column Snapshots, Display, ...) enumerate GetColumnNames() and would
+// otherwise pull every bank — REC::Cherenkov, REC::Scintillator, etc. — into
+// the event loop.  Hiding the unrequested columns here keeps those banks from
+// ever being decoded.
+//
+// Entries in `requested` are either exact column names ("RUN_run") or bank
+// prefixes ("REC_Particle", matching every REC_Particle_* column).
+class ColumnPrunedHipoDS final : public RHipoDS {
+ public:
+  ColumnPrunedHipoDS(const std::vector<std::string>& files, long maxRecords,
+                     const std::vector<std::string>& requested)
+      : RHipoDS(files, maxRecords) {
+    const auto& all = RHipoDS::GetColumnNames();
+    fFullColumnCount = all.size();
+    fPrunedColumnNames.reserve(all.size());
+    for (const auto& col : all) {
+      for (const auto& req : requested) {
+        const bool prefixMatch = col.size() > req.size() &&
+                                 col.compare(0, req.size(), req) == 0 &&
+                                 col[req.size()] == '_';
+        if (col == req || prefixMatch) {
+          fPrunedColumnNames.push_back(col);
+          break;
+        }
+      }
+    }
+  }
+
+  const std::vector<std::string>& GetColumnNames() const override { return fPrunedColumnNames; }
+
+  bool HasColumn(std::string_view colName) const override {
+    return std::find(fPrunedColumnNames.begin(), fPrunedColumnNames.end(), colName) != fPrunedColumnNames.end();
+  }
+
+  // How many columns the unpruned schema had (for logging).
+  std::size_t FullColumnCount() const { return fFullColumnCount; }
+
+ private:
+  std::vector<std::string> fPrunedColumnNames;
+  std::size_t fFullColumnCount = 0;
+};
+
+#endif  // COLUMNPRUNEDHIPODS_H
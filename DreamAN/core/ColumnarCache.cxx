@@ -0,0 +1,507 @@
+#include "ColumnarCache.h"
+
+#include <TBranch.h>
+#include <TFile.h>
+#include <TLeaf.h>
+#include <TTree.h>
+#include <TTreeReader.h>
+#include <TTreeReaderValue.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr const char* kManifestName = "manifest.txt";
+constexpr const char* kMagicLine = "DISANA colcache v1";
+
+// Element types the cache can store, keyed by their C++ spelling in the
+// manifest.  Everything a MinimalColumns snapshot produces is covered;
+// anything else (strings, nested objects) makes Build() bail out.
+enum class ElemType { kFloat, kDouble, kInt, kUInt, kShort, kUShort, kLong64, kULong64, kChar, kUChar, kBool, kUnsupported };
+
+ElemType ElemFromCpp(const std::string& name) {
+  if (name == "float") return ElemType::kFloat;
+  if (name == "double") return ElemType::kDouble;
+  if (name == "int") return ElemType::kInt;
+  if (name == "unsigned int") return ElemType::kUInt;
+  if (name == "short") return ElemType::kShort;
+  if (name == "unsigned short") return ElemType::kUShort;
+  if (name == "long long" || name == "Long64_t") return ElemType::kLong64;
+  if (name == "unsigned long long" || name == "ULong64_t") return ElemType::kULong64;
+  if (name == "char") return ElemType::kChar;
+  if (name == "unsigned char") return ElemType::kUChar;
+  if (name == "bool") return ElemType::kBool;
+  return ElemType::kUnsupported;
+}
+
+const char* CppFromElem(ElemType t) {
+  switch (t) {
+    case ElemType::kFloat: return "float";
+    case ElemType::kDouble: return "double";
+    case ElemType::kInt: return "int";
+    case ElemType::kUInt: return "unsigned int";
+    case ElemType::kShort: return "short";
+    case ElemType::kUShort: return "unsigned short";
+    case ElemType::kLong64: return "long long";
+    case ElemType::kULong64: return "unsigned long long";
+    case ElemType::kChar: return "char";
+    case ElemType::kUChar: return "unsigned char";
+    case ElemType::kBool: return "bool";
+    default: return "unsupported";
+  }
+}
+
+// Scalar branches carry their type on the leaf ("Float_t", "Int_t", ...).
+ElemType ElemFromLeaf(const std::string& leafType) {
+  if (leafType == "Float_t") return ElemType::kFloat;
+  if (leafType == "Double_t") return ElemType::kDouble;
+  if (leafType == "Int_t") return ElemType::kInt;
+  if (leafType == "UInt_t") return ElemType::kUInt;
+  if (leafType == "Short_t") return ElemType::kShort;
+  if (leafType == "UShort_t") return ElemType::kUShort;
+  if (leafType == "Long64_t") return ElemType::kLong64;
+  if (leafType == "ULong64_t") return ElemType::kULong64;
+  if (leafType == "Char_t") return ElemType::kChar;
+  if (leafType == "UChar_t") return ElemType::kUChar;
+  if (leafType == "Bool_t") return ElemType::kBool;
+  return ElemType::kUnsupported;
+}
+
+// Invokes f with a default-constructed value of the static type matching t,
+// so callers can instantiate the right column/dumper template from a runtime
+// type code.  Returns false for unsupported types.
+template <typename F>
+bool DispatchElem(ElemType t, F&& f) {
+  switch (t) {
+    case ElemType::kFloat: f(float{}); return true;
+    case ElemType::kDouble: f(double{}); return true;
+    case ElemType::kInt: f(int{}); return true;
+    case ElemType::kUInt: f(static_cast<unsigned int>(0)); return true;
+    case ElemType::kShort: f(short{}); return true;
+    case ElemType::kUShort: f(static_cast<unsigned short>(0)); return true;
+    case ElemType::kLong64: f(static_cast<long long>(0)); return true;
+    case ElemType::kULong64: f(static_cast<unsigned long long>(0)); return true;
+    case ElemType::kChar: f(char{}); return true;
+    case ElemType::kUChar: f(static_cast<unsigned char>(0)); return true;
+    case ElemType::kBool: f(bool{}); return true;
+    default: return false;
+  }
+}
+
+// Read-only mapping of one cache file.  A zero-byte file (a column whose
+// vectors were all empty) maps to a null pointer and is still valid.
+struct MappedFile {
+  const unsigned char* data = nullptr;
+  std::size_t size = 0;
+
+  bool Map(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+      ::close(fd);
+      return false;
+    }
+    size = static_cast<std::size_t>(st.st_size);
+    if (size > 0) {
+      void* p = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+      if (p == MAP_FAILED) {
+        ::close(fd);
+        size = 0;
+        return false;
+      }
+      data = static_cast<const unsigned char*>(p);
+    }
+    ::close(fd);  // the mapping keeps the file alive
+    return true;
+  }
+
+  void Unmap() {
+    if (data) ::munmap(const_cast<unsigned char*>(data), size);
+    data = nullptr;
+    size = 0;
+  }
+
+  MappedFile() = default;
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  ~MappedFile() { Unmap(); }
+};
+
+std::string SourceStamp(const std::string& rootFile) {
+  std::error_code ec;
+  const auto size = fs::file_size(rootFile, ec);
+  if (ec) return {};
+  const auto mtime = fs::last_write_time(rootFile, ec);
+  if (ec) return {};
+  const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(mtime.time_since_epoch()).count();
+  std::ostringstream out;
+  out << size << " " << seconds << " " << fs::path(rootFile).filename().string();
+  return out.str();
+}
+
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// Column views over the mapped arrays
+// ---------------------------------------------------------------------------
+
+struct MMapCacheColumn {
+  std::string name;
+  std::string typeName;  // as reported by GetTypeName()
+  bool active = false;   // a reader was requested for this column
+
+  virtual ~MMapCacheColumn() = default;
+  virtual bool Open(const std::string& cacheDir, ULong64_t nEvents) = 0;
+  virtual void SetNSlots(unsigned int n) = 0;
+  virtual void* ReaderAddr(unsigned int slot) = 0;
+  virtual void SetEntry(unsigned int slot, ULong64_t entry) = 0;
+  virtual const std::type_info& Type() const = 0;
+};
+
+namespace {
+
+// Fixed-width column: the per-slot value pointer points straight into the
+// mapping, so reading it is a page-cache hit with no copy at all.
+template <typename T>
+struct ScalarColumn final : MMapCacheColumn {
+  MappedFile values;
+  std::vector<T*> slotPtr;
+
+  bool Open(const std::string& cacheDir, ULong64_t nEvents) override {
+    if (!values.Map(cacheDir + "/" + name + ".bin")) return false;
+    return values.size == nEvents * sizeof(T);
+  }
+  void SetNSlots(unsigned int n) override { slotPtr.assign(n, nullptr); }
+  void* ReaderAddr(unsigned int slot) override { return &slotPtr[slot]; }
+  void SetEntry(unsigned int slot, ULong64_t entry) override {
+    // readers never write through this pointer
+    slotPtr[slot] = const_cast<T*>(reinterpret_cast<const T*>(values.data)) + entry;
+  }
+  const std::type_info& Type() const override { return typeid(T); }
+};
+
+// Jagged column: a flat value array plus an offset table with nEvents + 1
+// entries.  SetEntry assigns the entry's range into the slot's vector —
+// a memcpy, not a deserialization.
+template <typename T>
+struct VectorColumn final : MMapCacheColumn {
+  MappedFile values;
+  MappedFile offsets;
+  std::vector<std::vector<T>> slotBuf;
+  std::vector<std::vector<T>*> slotPtr;
+
+  bool Open(const std::string& cacheDir, ULong64_t nEvents) override {
+    if (!offsets.Map(cacheDir + "/" + name + ".off")) return false;
+    if (offsets.size != (nEvents + 1) * sizeof(std::uint64_t)) return false;
+    if (!values.Map(cacheDir + "/" + name + ".bin")) return false;
+    const auto* off = reinterpret_cast<const std::uint64_t*>(offsets.data);
+    return values.size == off[nEvents] * sizeof(T);
+  }
+  void SetNSlots(unsigned int n) override {
+    slotBuf.assign(n, {});
+    slotPtr.resize(n);
+    for (unsigned int s = 0; s < n; ++s) slotPtr[s] = &slotBuf[s];
+  }
+  void* ReaderAddr(unsigned int slot) override { return &slotPtr[slot]; }
+  void SetEntry(unsigned int slot, ULong64_t entry) override {
+    const auto* off = reinterpret_cast<const std::uint64_t*>(offsets.data);
+    const auto* v = reinterpret_cast<const T*>(values.data);
+    slotBuf[slot].assign(v + off[entry], v + off[entry + 1]);
+  }
+  const std::type_info& Type() const override { return typeid(std::vector<T>); }
+};
+
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// Datasource
+// ---------------------------------------------------------------------------
+
+MMapColumnCacheDS::MMapColumnCacheDS(const std::string& cacheDir) {
+  std::ifstream in(fs::path(cacheDir) / kManifestName);
+  if (!in) throw std::runtime_error("Columnar cache: no manifest in " + cacheDir);
+
+  std::string line;
+  if (!std::getline(in, line) || line != kMagicLine)
+    throw std::runtime_error("Columnar cache: unrecognized manifest in " + cacheDir);
+
+  while (std::getline(in, line)) {
+    std::istringstream ls(line);
+    std::string key;
+    ls >> key;
+    if (key == "source") {
+      continue;  // validity against the source file is IsValid()'s job
+    } else if (key == "events") {
+      ls >> fNEvents;
+    } else if (key == "column") {
+      std::string name, kind;
+      ls >> name >> kind;
+      std::string ctype;
+      std::getline(ls, ctype);
+      const auto first = ctype.find_first_not_of(' ');
+      ctype = (first == std::string::npos) ? std::string{} : ctype.substr(first);
+
+      const ElemType t = ElemFromCpp(ctype);
+      const bool isVector = (kind == "vector");
+      std::unique_ptr<MMapCacheColumn> col;
+      const bool known = DispatchElem(t, [&](auto tag) {
+        using T = decltype(tag);
+        if (isVector) {
+          if constexpr (std::is_same_v<T, bool>) return;  // vector<bool> is never written
+          else col = std::make_unique<VectorColumn<T>>();
+        } else {
+          col = std::make_unique<ScalarColumn<T>>();
+        }
+      });
+      if (!known || !col)
+        throw std::runtime_error("Columnar cache: unsupported column type '" + ctype + "' for " + name);
+      col->name = name;
+      col->typeName = isVector ? "vector<" + ctype + ">" : ctype;
+      if (!col->Open(cacheDir, fNEvents))
+        throw std::runtime_error("Columnar cache: corrupt or truncated column " + name + " in " + cacheDir);
+      fColumnNames.push_back(name);
+      fColumns.push_back(std::move(col));
+    }
+  }
+  if (fColumns.empty()) throw std::runtime_error("Columnar cache: manifest lists no columns in " + cacheDir);
+}
+
+MMapColumnCacheDS::~MMapColumnCacheDS() = default;
+
+void MMapColumnCacheDS::SetNSlots(unsigned int nSlots) {
+  fNSlots = nSlots;
+  for (auto& col : fColumns) col->SetNSlots(nSlots);
+}
+
+const std::vector<std::string>& MMapColumnCacheDS::GetColumnNames() const { return fColumnNames; }
+
+MMapCacheColumn* MMapColumnCacheDS::FindColumn(std::string_view name) const {
+  for (const auto& col : fColumns)
+    if (col->name == name) return col.get();
+  return nullptr;
+}
+
+bool MMapColumnCacheDS::HasColumn(std::string_view colName) const { return FindColumn(colName) != nullptr; }
+
+std::string MMapColumnCacheDS::GetTypeName(std::string_view colName) const {
+  const auto* col = FindColumn(colName);
+  if (!col) throw std::runtime_error("Columnar cache: unknown column " + std::string(colName));
+  return col->typeName;
+}
+
+void MMapColumnCacheDS::Initialize() { fRangesServed = false; }
+
+std::vector<std::pair<ULong64_t, ULong64_t>> MMapColumnCacheDS::GetEntryRanges() {
+  std::vector<std::pair<ULong64_t, ULong64_t>> ranges;
+  if (fRangesServed || fNEvents == 0) return ranges;
+  fRangesServed = true;
+
+  // A few chunks per slot so stragglers rebalance; the arrays are already
+  // resident or page in sequentially either way.
+  const ULong64_t nChunks = std::max<ULong64_t>(1, static_cast<ULong64_t>(fNSlots) * 4);
+  const ULong64_t chunk = std::max<ULong64_t>(1, (fNEvents + nChunks - 1) / nChunks);
+  for (ULong64_t start = 0; start < fNEvents; start += chunk)
+    ranges.emplace_back(start, std::min(start + chunk, fNEvents));
+  return ranges;
+}
+
+bool MMapColumnCacheDS::SetEntry(unsigned int slot, ULong64_t entry) {
+  for (auto* col : fActiveColumns) col->SetEntry(slot, entry);
+  return true;
+}
+
+MMapColumnCacheDS::Record_t MMapColumnCacheDS::GetColumnReadersImpl(std::string_view name, const std::type_info& ti) {
+  auto* col = FindColumn(name);
+  if (!col) throw std::runtime_error("Columnar cache: unknown column " + std::string(name));
+  if (col->Type() != ti)
+    throw std::runtime_error("Columnar cache: type mismatch for column " + std::string(name) +
+                             " (cache holds " + col->typeName + ")");
+  if (!col->active) {
+    col->active = true;
+    fActiveColumns.push_back(col);
+  }
+  Record_t readers(fNSlots);
+  for (unsigned int s = 0; s < fNSlots; ++s) readers[s] = col->ReaderAddr(s);
+  return readers;
+}
+
+// ---------------------------------------------------------------------------
+// Cache builder
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct DumperBase {
+  std::string manifestLine;
+  virtual ~DumperBase() = default;
+  virtual void Fill() = 0;
+  virtual bool Good() const = 0;
+};
+
+template <typename T>
+struct ScalarDumper final : DumperBase {
+  TTreeReaderValue<T> val;
+  std::ofstream out;
+
+  ScalarDumper(TTreeReader& reader, const std::string& name, const std::string& cacheDir)
+      : val(reader, name.c_str()), out(cacheDir + "/" + name + ".bin", std::ios::binary) {}
+  void Fill() override {
+    const T v = *val;
+    out.write(reinterpret_cast<const char*>(&v), sizeof(T));
+  }
+  bool Good() const override { return static_cast<bool>(out); }
+};
+
+template <typename T>
+struct VectorDumper final : DumperBase {
+  TTreeReaderValue<std::vector<T>> val;
+  std::ofstream bin;
+  std::ofstream off;
+  std::uint64_t cum = 0;
+
+  VectorDumper(TTreeReader& reader, const std::string& name, const std::string& cacheDir)
+      : val(reader, name.c_str()),
+        bin(cacheDir + "/" + name + ".bin", std::ios::binary),
+        off(cacheDir + "/" + name + ".off", std::ios::binary) {
+    off.write(reinterpret_cast<const char*>(&cum), sizeof(cum));  // offset table starts at 0
+  }
+  void Fill() override {
+    const std::vector<T>& v = *val;
+    if (!v.empty()) bin.write(reinterpret_cast<const char*>(v.data()), v.size() * sizeof(T));
+    cum += v.size();
+    off.write(reinterpret_cast<const char*>(&cum), sizeof(cum));
+  }
+  bool Good() const override { return bin && off; }
+};
+
+}  // namespace
+
+bool MMapColumnCacheDS::Build(const std::string& rootFile, const std::string& treeName, const std::string& cacheDir) {
+  TFile f(rootFile.c_str(), "READ");
+  if (f.IsZombie()) {
+    std::cerr << "[ColumnarCache] Cannot open " << rootFile << "\n";
+    return false;
+  }
+  auto* tree = f.Get<TTree>(treeName.c_str());
+  if (!tree) {
+    // RNTuple snapshots land here too: the cache only understands TTrees.
+    std::cerr << "[ColumnarCache] No TTree '" << treeName << "' in " << rootFile << "\n";
+    return false;
+  }
+
+  std::error_code ec;
+  fs::create_directories(cacheDir, ec);
+  if (ec) {
+    std::cerr << "[ColumnarCache] Cannot create " << cacheDir << ": " << ec.message() << "\n";
+    return false;
+  }
+  fs::remove(fs::path(cacheDir) / kManifestName, ec);  // invalidate any previous cache first
+
+  TTreeReader reader(tree);
+  std::vector<std::unique_ptr<DumperBase>> dumpers;
+
+  for (auto* obj : *tree->GetListOfBranches()) {
+    auto* br = static_cast<TBranch*>(obj);
+    const std::string name = br->GetName();
+    const std::string cls = br->GetClassName() ? br->GetClassName() : "";
+
+    std::unique_ptr<DumperBase> dumper;
+    if (cls.rfind("vector<", 0) == 0 && cls.back() == '>') {
+      const std::string elem = cls.substr(7, cls.size() - 8);
+      const ElemType t = ElemFromCpp(elem);
+      const bool made = t != ElemType::kBool && DispatchElem(t, [&](auto tag) {
+        using T = decltype(tag);
+        if constexpr (!std::is_same_v<T, bool>) dumper = std::make_unique<VectorDumper<T>>(reader, name, cacheDir);
+      });
+      if (!made || !dumper) {
+        std::cerr << "[ColumnarCache] Unsupported branch type " << cls << " (" << name << ") — not caching\n";
+        return false;
+      }
+      dumper->manifestLine = "column " + name + " vector " + CppFromElem(t);
+    } else if (cls.empty()) {
+      auto* leaf = br->GetLeaf(name.c_str());
+      const ElemType t = leaf ? ElemFromLeaf(leaf->GetTypeName()) : ElemType::kUnsupported;
+      const bool made = DispatchElem(t, [&](auto tag) {
+        using T = decltype(tag);
+        dumper = std::make_unique<ScalarDumper<T>>(reader, name, cacheDir);
+      });
+      if (!made || !dumper) {
+        std::cerr << "[ColumnarCache] Unsupported leaf type for branch " << name << " — not caching\n";
+        return false;
+      }
+      dumper->manifestLine = "column " + name + " scalar " + CppFromElem(t);
+    } else {
+      std::cerr << "[ColumnarCache] Unsupported branch class " << cls << " (" << name << ") — not caching\n";
+      return false;
+    }
+    dumpers.push_back(std::move(dumper));
+  }
+  if (dumpers.empty()) {
+    std::cerr << "[ColumnarCache] Tree has no branches — not caching\n";
+    return false;
+  }
+
+  ULong64_t nEvents = 0;
+  while (reader.Next()) {
+    for (auto& d : dumpers) d->Fill();
+    ++nEvents;
+  }
+
+  for (auto& d : dumpers) {
+    if (!d->Good()) {
+      std::cerr << "[ColumnarCache] Write error while materializing " << cacheDir << "\n";
+      return false;
+    }
+  }
+
+  // Manifest last, through a rename: its presence is what declares the cache
+  // complete.
+  const auto manifestTmp = fs::path(cacheDir) / (std::string(kManifestName) + ".tmp");
+  {
+    std::ofstream man(manifestTmp);
+    man << kMagicLine << "\n";
+    man << "source " << SourceStamp(rootFile) << "\n";
+    man << "events " << nEvents << "\n";
+    for (const auto& d : dumpers) man << d->manifestLine << "\n";
+    if (!man) {
+      std::cerr << "[ColumnarCache] Cannot write manifest in " << cacheDir << "\n";
+      return false;
+    }
+  }
+  fs::rename(manifestTmp, fs::path(cacheDir) / kManifestName, ec);
+  if (ec) {
+    std::cerr << "[ColumnarCache] Cannot finalize manifest: " << ec.message() << "\n";
+    return false;
+  }
+
+  std::cout << "[ColumnarCache] Materialized " << dumpers.size() << " column(s), " << nEvents
+            << " events into " << cacheDir << "\n";
+  return true;
+}
+
+bool MMapColumnCacheDS::IsValid(const std::string& cacheDir, const std::string& rootFile) {
+  std::ifstream in(fs::path(cacheDir) / kManifestName);
+  if (!in) return false;
+  std::string line;
+  if (!std::getline(in, line) || line != kMagicLine) return false;
+  if (!std::getline(in, line) || line.rfind("source ", 0) != 0) return false;
+  const std::string stamp = SourceStamp(rootFile);
+  return !stamp.empty() && line.substr(7) == stamp;
+}
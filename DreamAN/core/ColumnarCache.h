@@ -0,0 +1,69 @@
+#ifndef COLUMNARCACHE_H
+#define COLUMNARCACHE_H
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ROOT/RDataSource.hxx>
+
+struct MMapCacheColumn;
+
+// Memory-mapped columnar cache for reprocess inputs.  The first run over a
+// dfSelected-style ROOT file materializes every branch into flat binary
+// arrays — one file per column, plus a 64-bit offset table per vector
+// column — under <inputDir>/colcache/, stamped with the source file's size
+// and mtime.  Subsequent runs map those arrays read-only and serve them to
+// RDataFrame through this datasource: no TTree decompression or
+// deserialization on the hot path, and the OS page cache shares one physical
+// copy of the arrays across all concurrent jobs on the node.
+//
+// Scalar columns are handed to RDataFrame as pointers straight into the
+// mapping; vector columns are filled per entry into a per-slot buffer (a
+// plain memcpy), so downstream code sees the same std::vector<T> types the
+// TTree would have produced.  A branch with an unsupported type makes
+// Build() fail, and Events falls back to the TTree path.
+class MMapColumnCacheDS final : public ROOT::RDF::RDataSource {
+ public:
+  // Opens an existing cache; throws std::runtime_error when the manifest or
+  // a column file is missing or inconsistent.  Validate with IsValid() (and
+  // rebuild with Build()) before constructing.
+  explicit MMapColumnCacheDS(const std::string& cacheDir);
+  ~MMapColumnCacheDS() override;
+
+  // Materializes rootFile's tree into cacheDir.  The manifest is written
+  // last, via a rename, so a crashed build is never mistaken for a valid
+  // cache.  Returns false (leaving no manifest) when the tree cannot be read
+  // or contains a branch type the cache does not support.
+  static bool Build(const std::string& rootFile, const std::string& treeName,
+                    const std::string& cacheDir);
+
+  // True when cacheDir holds a cache built from this exact rootFile
+  // (matched by file size and modification time recorded in the manifest).
+  static bool IsValid(const std::string& cacheDir, const std::string& rootFile);
+
+  void SetNSlots(unsigned int nSlots) override;
+  const std::vector<std::string>& GetColumnNames() const override;
+  bool HasColumn(std::string_view colName) const override;
+  std::string GetTypeName(std::string_view colName) const override;
+  std::vector<std::pair<ULong64_t, ULong64_t>> GetEntryRanges() override;
+  bool SetEntry(unsigned int slot, ULong64_t entry) override;
+  void Initialize() override;
+  std::string GetLabel() override { return "MMapColumnCacheDS"; }
+
+ protected:
+  Record_t GetColumnReadersImpl(std::string_view name, const std::type_info& ti) override;
+
+ private:
+  MMapCacheColumn* FindColumn(std::string_view name) const;
+
+  std::vector<std::unique_ptr<MMapCacheColumn>> fColumns;
+  std::vector<MMapCacheColumn*> fActiveColumns;  // columns with readers requested
+  std::vector<std::string> fColumnNames;
+  ULong64_t fNEvents = 0;
+  unsigned int fNSlots = 0;
+  bool fRangesServed = false;
+};
+
+#endif  // COLUMNARCACHE_H
@@ -1,5 +1,57 @@
 #include "Columns.h"
 
+#include <atomic>
+#include <cmath>
+#include <iostream>
+
+std::function<std::vector<unsigned char>(const std::vector<short>&, const std::vector<float>&)>
+Columns::RegionSectorPack() {
+  return [](const std::vector<short>& status, const std::vector<float>& phi) {
+    const size_t n = status.size();
+    std::vector<unsigned char> regsec(n);
+    for (size_t i = 0; i < n; ++i) {
+      const unsigned char region = RegionFromStatus(status[i]);
+      unsigned char sector = 0;
+      if (region == kRegionFD) {
+        // FD sectors are 60 degrees wide with sector 1 centred on phi = 0;
+        // phi arrives in [0, 2pi).
+        float deg = phi[i] * 180.0f / static_cast<float>(M_PI) + 30.0f;
+        if (deg >= 360.0f) deg -= 360.0f;
+        sector = static_cast<unsigned char>(deg / 60.0f) + 1;
+      }
+      regsec[i] = static_cast<unsigned char>(region | (sector << 2));
+    }
+    return regsec;
+  };
+}
+
+std::function<std::uint64_t(const std::vector<int>&)>
+Columns::PackMask() {
+  return [](const std::vector<int>& mask) {
+    std::uint64_t bits = 0;
+    const size_t n = std::min<size_t>(mask.size(), 64);
+    for (size_t i = 0; i < n; ++i)
+      if (mask[i]) bits |= (std::uint64_t{1} << i);
+    if (mask.size() > 64) {
+      static std::atomic<bool> warned{false};
+      if (!warned.exchange(true))
+        std::cerr << "[Columns::PackMask] event with " << mask.size()
+                  << " particles — entries beyond 64 stored as failing.\n";
+    }
+    return bits;
+  };
+}
+
+std::function<std::vector<int>(const std::uint64_t&, const int&)>
+Columns::UnpackMask() {
+  return [](const std::uint64_t& bits, const int& nParticles) {
+    std::vector<int> mask(nParticles > 0 ? nParticles : 0, 0);
+    const size_t n = std::min<size_t>(mask.size(), 64);
+    for (size_t i = 0; i < n; ++i) mask[i] = static_cast<int>((bits >> i) & 1u);
+    return mask;
+  };
+}
+
 std::function<std::vector<int>(const std::vector<int>&, const std::vector<int>&)>
 Columns::LogicalAND2() {
   return [](const std::vector<int>& a, const std::vector<int>& b) {
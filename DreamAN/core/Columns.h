@@ -4,6 +4,7 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <type_traits>
 #include <functional>
@@ -12,6 +13,43 @@ class Columns {
  public:
   // For two-column logical AND
   static std::function<std::vector<int>(const std::vector<int>&, const std::vector<int>&)> LogicalAND2();
+
+  // Packed per-particle pass masks: bit i set = particle i passes.  One
+  // 64-bit word per event replaces a 32-bit flag per particle in the
+  // snapshots (CLAS12 REC::Particle multiplicity stays far below 64; an
+  // overflow particle is stored as failing and flagged once on stderr).
+  // PackMask feeds the *_bits sidecar columns, UnpackMask is the read-back
+  // shim that rebuilds the vector view the selection chain consumes.
+  static std::function<std::uint64_t(const std::vector<int>&)> PackMask();
+  static std::function<std::vector<int>(const std::uint64_t&, const int&)> UnpackMask();
+
+  // Packed per-particle detector classification: region code in bits 0-1 and
+  // the FD sector (1-6, 0 when not in the FD) in bits 2-4.  Decoded from the
+  // status word once per event in DVCSAnalysis::UserExec so the selection, the
+  // momentum corrections and the plot macros all read one byte instead of
+  // re-branching on |status| thresholds, and the snapshot stores a uint8
+  // instead of the full int16 status.  The region codes match the integer
+  // convention the plot macros already use (0 = FT, 1 = FD, 2 = CD).
+  static constexpr unsigned char kRegionFT = 0;
+  static constexpr unsigned char kRegionFD = 1;
+  static constexpr unsigned char kRegionCD = 2;
+  static constexpr unsigned char kRegionUnknown = 3;
+
+  static unsigned char RegionFromStatus(short status) {
+    const int statusAbs = status < 0 ? -status : status;
+    if (statusAbs >= 1000 && statusAbs < 2000) return kRegionFT;
+    if (statusAbs >= 2000 && statusAbs < 3000) return kRegionFD;
+    if (statusAbs >= 4000 && statusAbs < 5000) return kRegionCD;
+    return kRegionUnknown;
+  }
+
+  static unsigned char RegionOf(unsigned char regsec) { return regsec & 0x3; }
+  static unsigned char SectorOf(unsigned char regsec) { return regsec >> 2; }
+
+  // Functor for the "REC_Particle_regsec" Define: packs (status, phi) into
+  // one byte per particle.  phi is in [0, 2pi) as RECParticleKinematics
+  // produces it.
+  static std::function<std::vector<unsigned char>(const std::vector<short>&, const std::vector<float>&)> RegionSectorPack();
 };
 
 // CombineColumns: Merges multiple std::vector<std::string> into one
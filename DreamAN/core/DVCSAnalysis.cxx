@@ -1,15 +1,23 @@
 #include "DVCSAnalysis.h"
 
+#include <TROOT.h>
+
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <fstream>
 #include <iomanip>
-#include <mutex>
+#include <memory>
+#include <sstream>
 #include <stdexcept>
 
+#include "../ParticleInformation/PindexHitIndex.h"
 #include "AnalysisTaskManager.h"
 #include "PerRunCounter.h"
+#include "PipelineTimer.h"
+#include "RunEventColumns.h"
+#include "ROOT/RCutFlowReport.hxx"
+#include "ROOT/RDFHelpers.hxx"
 #include "ROOT/RVec.hxx"
 
 namespace {
@@ -32,9 +40,12 @@ static inline int TrackSectorForParticle(int particleIndex,
                                          const std::vector<int16_t>& trackPindex,
                                          const std::vector<int16_t>& trackSector) {
   if (particleIndex < 0) return -1;
-  for (size_t i = 0; i < trackPindex.size(); ++i) {
-    if (i >= trackSector.size()) continue;
-    if (trackPindex[i] != particleIndex) continue;
+  // Group the REC::Track rows by particle once, then read off this particle's
+  // contiguous row range instead of re-scanning the whole pindex column.
+  thread_local PindexHitIndex trackIndex;
+  trackIndex.Build(trackPindex, particleIndex + 1);
+  for (int i : trackIndex.RowsOf(particleIndex)) {
+    if (static_cast<size_t>(i) >= trackSector.size()) continue;
     const int sector = static_cast<int>(trackSector[i]);
     if (sector >= 1 && sector <= 6) return sector;
   }
@@ -59,87 +70,6 @@ static inline float PhiRadToWrappedDeg(float phiRad) {
 }
 }  // namespace
 
-static inline std::pair<std::string, std::string> PickRunEventCols(ROOT::RDF::RNode df) {
-  auto cols = df.GetColumnNames();
-  auto has = [&](const std::string& n) { return std::find(cols.begin(), cols.end(), n) != cols.end(); };
-
-  if (has("RUN_config_run") && has("RUN_config_event")) return {"RUN_config_run", "RUN_config_event"};
-
-  if (has("RUN::config.run") && has("RUN::config.event")) return {"RUN::config.run", "RUN::config.event"};
-
-  throw std::runtime_error("QADB: cannot find run/event columns");
-}
-#include "ROOT/RVec.hxx"
-
-// helper: detect substring
-static inline bool has_substr(const std::string& s, const std::string& sub) {
-  return s.find(sub) != std::string::npos;
-}
-
-static inline ROOT::RDF::RNode
-DefineRunEventScalars(ROOT::RDF::RNode df, const std::string& runCol, const std::string& evCol) {
-  const auto runType = df.GetColumnType(runCol);
-  const auto evType  = df.GetColumnType(evCol);
-
-  // ----- scalar cases -----
-  auto is_scalar_int = [&](const std::string& t){
-    return t=="int" || t=="Int_t" || t=="unsigned int" || t=="UInt_t";
-  };
-  auto is_scalar_long = [&](const std::string& t){
-    return t=="Long64_t" || t=="long" || t=="long long" || t=="ULong64_t" || t=="unsigned long long";
-  };
-  auto is_scalar_short = [&](const std::string& t){
-    return t=="short" || t=="Short_t" || t=="unsigned short" || t=="UShort_t";
-  };
-
-  if (is_scalar_int(runType) && is_scalar_int(evType)) {
-    return df.Define("RUN_run",  [](int r){ return r; }, {runCol})
-             .Define("RUN_event",[](int e){ return e; }, {evCol});
-  }
-  if (is_scalar_long(runType) && is_scalar_long(evType)) {
-    return df.Define("RUN_run",  [](Long64_t r){ return (int)r; }, {runCol})
-             .Define("RUN_event",[](Long64_t e){ return (int)e; }, {evCol});
-  }
-  if (is_scalar_short(runType) && is_scalar_short(evType)) {
-    return df.Define("RUN_run",  [](Short_t r){ return (int)r; }, {runCol})
-             .Define("RUN_event",[](Short_t e){ return (int)e; }, {evCol});
-  }
-
-  // ----- RVec cases -----
-  auto is_rvec = [&](const std::string& t){ return has_substr(t, "ROOT::VecOps::RVec"); };
-
-  // RVec<int> / RVec<Int_t> / etc (match by substring)
-  if (is_rvec(runType) && is_rvec(evType) && (has_substr(runType,"<int") || has_substr(runType,"<Int_t"))) {
-    return df.Define("RUN_run",  [](const ROOT::VecOps::RVec<int>& v){ return v.empty() ? -1 : (int)v[0]; }, {runCol})
-             .Define("RUN_event",[](const ROOT::VecOps::RVec<int>& v){ return v.empty() ? -1 : (int)v[0]; }, {evCol});
-  }
-  if (is_rvec(runType) && is_rvec(evType) && (has_substr(runType,"<Long64_t") || has_substr(runType,"<long long") || has_substr(runType,"<long"))) {
-    return df.Define("RUN_run",  [](const ROOT::VecOps::RVec<Long64_t>& v){ return v.empty() ? -1 : (int)v[0]; }, {runCol})
-             .Define("RUN_event",[](const ROOT::VecOps::RVec<Long64_t>& v){ return v.empty() ? -1 : (int)v[0]; }, {evCol});
-  }
-  if (is_rvec(runType) && is_rvec(evType) && (has_substr(runType,"<Short_t") || has_substr(runType,"<short"))) {
-    return df.Define("RUN_run",  [](const ROOT::VecOps::RVec<Short_t>& v){ return v.empty() ? -1 : (int)v[0]; }, {runCol})
-             .Define("RUN_event",[](const ROOT::VecOps::RVec<Short_t>& v){ return v.empty() ? -1 : (int)v[0]; }, {evCol});
-  }
-
-  // ----- std::vector cases -----
-  auto is_stdvec = [&](const std::string& t){ return has_substr(t, "std::vector") || has_substr(t, "vector<"); };
-
-  if (is_stdvec(runType) && is_stdvec(evType) && (has_substr(runType,"<int") || has_substr(runType,"<Int_t"))) {
-    return df.Define("RUN_run",  [](const std::vector<int>& v){ return v.empty() ? -1 : (int)v[0]; }, {runCol})
-             .Define("RUN_event",[](const std::vector<int>& v){ return v.empty() ? -1 : (int)v[0]; }, {evCol});
-  }
-  if (is_stdvec(runType) && is_stdvec(evType) && (has_substr(runType,"<Long64_t") || has_substr(runType,"<long long") || has_substr(runType,"<long"))) {
-    return df.Define("RUN_run",  [](const std::vector<Long64_t>& v){ return v.empty() ? -1 : (int)v[0]; }, {runCol})
-             .Define("RUN_event",[](const std::vector<Long64_t>& v){ return v.empty() ? -1 : (int)v[0]; }, {evCol});
-  }
-  if (is_stdvec(runType) && is_stdvec(evType) && (has_substr(runType,"<Short_t") || has_substr(runType,"<short"))) {
-    return df.Define("RUN_run",  [](const std::vector<Short_t>& v){ return v.empty() ? -1 : (int)v[0]; }, {runCol})
-             .Define("RUN_event",[](const std::vector<Short_t>& v){ return v.empty() ? -1 : (int)v[0]; }, {evCol});
-  }
-
-  throw std::runtime_error("QADB: unsupported run/event types: run=" + runType + " ev=" + evType);
-}
 
 DVCSAnalysis::DVCSAnalysis(bool IsMC, bool IsReproc, bool IsMinBook) : IsMC(IsMC), IsReproc(IsReproc), IsMinBooking(IsMinBook), fHistPhotonP(nullptr) {}
 DVCSAnalysis::~DVCSAnalysis() {}
@@ -149,9 +79,22 @@ void DVCSAnalysis::UserCreateOutputObjects() {}
 void DVCSAnalysis::UserExec(ROOT::RDF::RNode& df) {
   using namespace std;
 
-  if (fMaxEvents > 0) {
+  if (fMaxEvents > 0 && !ROOT::IsImplicitMTEnabled()) {
+    // Range() forces single-threaded execution, so it is only used when IMT
+    // is off anyway.  Under IMT the bound is applied upstream instead:
+    // Events trims the input file list to ~fMaxEvents events (via
+    // MaxEventsHint and the header-only census), which keeps every thread
+    // busy at the cost of rounding the cap up to whole files.
     df = df.Range(0, fMaxEvents);  // only process the first fMaxEvents
   }
+  if (fSampleStride > 1) {
+    // MT-safe thinning: entry numbers are unique under IMT even though they
+    // are not processed in order, so keeping every Nth entry samples the
+    // whole run range without serialising the loop.
+    const auto stride = fSampleStride;
+    df = df.Filter([stride](ULong64_t entry) { return entry % stride == 0; }, {"rdfentry_"},
+                   "stride sample");
+  }
   if (!fTrackCuts || !fEventCuts) throw std::runtime_error("DVCSAnalysis: One or more cut not set.");
 
   fTrackCutsNoFid = std::make_shared<TrackCut>(*fTrackCuts);
@@ -163,20 +106,70 @@ void DVCSAnalysis::UserExec(ROOT::RDF::RNode& df) {
   // auto colnames = df.GetColumnNames();
   auto dfDefs = df;
   dfDefs = DefineOrRedefine(dfDefs, "REC_Particle_num", [](const std::vector<int>& pid) { return static_cast<int>(pid.size()); }, {"REC_Particle_pid"});
-  dfDefs = DefineOrRedefine(dfDefs, "REC_Particle_theta", RECParticletheta(), RECParticle::All());
-  dfDefs = DefineOrRedefine(dfDefs, "REC_Particle_phi", RECParticlephi(), RECParticle::All());
-  dfDefs = DefineOrRedefine(dfDefs, "REC_Particle_p", RECParticleP(), RECParticle::All());
+  dfDefs = DefineOrRedefine(dfDefs, "REC_Particle_kin", RECParticleKinematics(), RECParticle::All());
+  dfDefs = DefineOrRedefine(dfDefs, "REC_Particle_theta", [](const RECParticleKin& kin) { return kin.theta; }, {"REC_Particle_kin"});
+  dfDefs = DefineOrRedefine(dfDefs, "REC_Particle_phi", [](const RECParticleKin& kin) { return kin.phi; }, {"REC_Particle_kin"});
+  dfDefs = DefineOrRedefine(dfDefs, "REC_Particle_p", [](const RECParticleKin& kin) { return kin.p; }, {"REC_Particle_kin"});
+  // Packed detector region + FD sector, decoded from the status word once per
+  // event; the selection and the plot macros read this byte instead of
+  // re-branching on |status| thresholds (codes: 0 FT, 1 FD, 2 CD).
+  dfDefs = DefineOrRedefine(dfDefs, "REC_Particle_regsec", Columns::RegionSectorPack(), {"REC_Particle_status", "REC_Particle_phi"});
   dforginal = dfDefs;
   // Fiducial cuts
   auto dfDefsWithTraj = dfDefs;
-  auto [runCol, evCol] = PickRunEventCols(dfDefsWithTraj);
-  dfDefsWithTraj = DefineRunEventScalars(dfDefsWithTraj, runCol, evCol);
+  // Events already normalized RUN_run/RUN_event on the dataframes it hands
+  // out; this is a no-op there and only does work for externally-built nodes.
+  dfDefsWithTraj = NormalizeRunEventColumns(dfDefsWithTraj);
+  // Per-run conditions: resolve the beam energy from the table per event so
+  // a mixed-period file list is processed in one pass (binary search over
+  // the registered run ranges; fbeam_energy covers unlisted runs).
+  if (fRunConditions && !fRunConditions->Empty()) {
+    dfDefsWithTraj = DefineOrRedefine(dfDefsWithTraj, "RUN_beam_energy",
+                                      [rc = fRunConditions, fallback = fbeam_energy](int run) { return rc->BeamEnergy(run, fallback); }, {"RUN_run"});
+  }
   // QADB cuts should be place in the first to reduce the computation load
   if (fIsQADBCut && fQADBCuts) {
     std::cout << "Applying QADB cut..." << std::endl;
+    // Warm start from the shared binary cache if one matching this defect
+    // configuration exists; otherwise decisions are cached as we go.
+    QADBCuts::LoadDecisionCache();
     auto qadb = *fQADBCuts;
     dfDefsWithTraj =
-        dfDefsWithTraj.Define("REC_QADB_pass", [qadb](int run, int ev) mutable { return qadb(run, ev); }, {"RUN_run", "RUN_event"}).Filter("REC_QADB_pass", "QADB pass");
+        dfDefsWithTraj.Define("REC_QADB_pass", [qadb](int run, int ev) mutable { return qadb(run, ev); }, {"RUN_run", "RUN_event"}).Filter([](bool pass) { return pass; }, {"REC_QADB_pass"}, "QADB pass");
+  }
+
+  // Topology prefilter: an event whose pid column does not even contain the
+  // required species counts can never satisfy the minCount constraints — the
+  // kinematic and fiducial cuts only shrink the candidate counts — so reject
+  // it with one scan of REC_Particle_pid before the bank walks and kinematic
+  // Defines are ever evaluated.  With variations registered, only the
+  // constraints every selection chain imposes are applied, at the weakest
+  // required count, so no variation can lose events to the nominal topology.
+  if (!fAcceptAll && fEventCuts) {
+    auto required = fEventCuts->RequiredPidCounts();
+    for (const auto& v : fVariations) {
+      if (!v.eventCuts) continue;
+      const auto vreq = v.eventCuts->RequiredPidCounts();
+      std::vector<std::pair<int, int>> merged;
+      for (const auto& [pidWanted, n] : required)
+        for (const auto& [vpid, vn] : vreq)
+          if (vpid == pidWanted) merged.emplace_back(pidWanted, std::min(n, vn));
+      required = merged;
+    }
+    if (!required.empty()) {
+      auto topoSampler = PipelineTimer::Instance().MakeSampler("DVCSAnalysis/TopologyPrefilter");
+      std::function<bool(const std::vector<int>&)> topoCheck = [required](const std::vector<int>& pid) {
+        for (const auto& [pidWanted, minCount] : required) {
+          int n = 0;
+          for (int p : pid)
+            if (p == pidWanted && ++n >= minCount) break;
+          if (n < minCount) return false;
+        }
+        return true;
+      };
+      dfDefsWithTraj = dfDefsWithTraj.Filter(PipelineTimer::Wrap(topoSampler, std::move(topoCheck)),
+                                             {"REC_Particle_pid"}, "Topology prefilter");
+    }
   }
 
   auto trajCols = CombineColumns(RECTraj::ForFiducialCut(), std::vector<std::string>{"REC_Particle_pid"}, std::vector<std::string>{"REC_Particle_num"});
@@ -184,70 +177,277 @@ void DVCSAnalysis::UserExec(ROOT::RDF::RNode& df) {
       CombineColumns(RECCalorimeter::ForFiducialCut(), std::vector<std::string>{"REC_Particle_pid"}, std::vector<std::string>{"REC_Particle_p"}, std::vector<std::string>{"REC_Particle_num"});
   auto fwdtagCols = CombineColumns(RECForwardTagger::ForFiducialCut(), std::vector<std::string>{"REC_Particle_pid"}, std::vector<std::string>{"REC_Particle_num"});
 
-  dfDefsWithTraj = DefineOrRedefine(dfDefsWithTraj, "REC_Track_pass_nofid", fTrackCutsNoFid->RECTrajPass(), trajCols);
-  dfDefsWithTraj = DefineOrRedefine(dfDefsWithTraj, "REC_Traj_pass_fid", fTrackCutsWithFid->RECTrajPass(), trajCols);
-  dfDefsWithTraj = DefineOrRedefine(dfDefsWithTraj, "REC_Calorimeter_pass_fid", fTrackCutsWithFid->RECCalorimeterPass(), caloCols);
-
-  if (fFTonConfig) {
-    dfDefsWithTraj = DefineOrRedefine(dfDefsWithTraj, "REC_ForwardTagger_pass_fid", fTrackCutsWithFid->RECForwardTaggerPass(), fwdtagCols);
+  // Derived-column reuse: the fiducial masks are the most expensive stable
+  // Defines, so with the sidecar enabled the snapshots persist them and
+  // SaveOutput records the producing TrackCut fingerprint.  A reprocess run
+  // whose fingerprint matches reads the masks back from the input columns
+  // and skips the bank walks entirely; any changed fiducial knob changes the
+  // fingerprint and falls back to a full recompute.
+  fFiducialFingerprint = fTrackCutsWithFid->ConfigFingerprint() + (fFTonConfig ? "+ft" : "-ft");
+  bool reuseFidMasks = false;
+  if (IsReproc && fDerivedSidecar && !fOutputDir.empty()) {
+    std::ifstream fpIn(fOutputDir + "/derived_columns.txt");
+    std::string recorded;
+    if (fpIn && std::getline(fpIn, recorded) && recorded == fFiducialFingerprint) {
+      reuseFidMasks = dfDefsWithTraj.HasColumn("REC_Track_pass_nofid") &&
+                      dfDefsWithTraj.HasColumn("REC_Track_pass_fid");
+      // Newer sidecar files persist the masks packed — one 64-bit word per
+      // mask per event (Columns::PackMask) instead of a 32-bit flag per
+      // particle.  Rebuild the per-particle vector view the selection chain
+      // consumes; older files with the vector columns are used directly.
+      if (!reuseFidMasks && dfDefsWithTraj.HasColumn("REC_Track_pass_nofid_bits") &&
+          dfDefsWithTraj.HasColumn("REC_Track_pass_fid_bits")) {
+        for (const char* c : {"REC_Track_pass_nofid", "REC_Traj_pass_fid", "REC_Calorimeter_pass_fid",
+                              "REC_ForwardTagger_pass_fid", "REC_Track_pass_fid"}) {
+          const std::string bits = std::string(c) + "_bits";
+          if (dfDefsWithTraj.HasColumn(bits))
+            dfDefsWithTraj = DefineOrRedefine(dfDefsWithTraj, c, Columns::UnpackMask(), {bits, "REC_Particle_num"});
+        }
+        reuseFidMasks = true;
+      }
+    }
+    if (reuseFidMasks)
+      std::cout << "[DVCSAnalysis] Fiducial fingerprint unchanged (" << fFiducialFingerprint
+                << ") — reusing persisted pass masks, skipping the bank walks.\n";
   }
-  dfDefsWithTraj = DefineOrRedefine(dfDefsWithTraj, "REC_Track_pass_fid", Columns::LogicalAND2(),
-                                    CombineColumns(std::vector<std::string>{"REC_Traj_pass_fid"}, std::vector<std::string>{"REC_Calorimeter_pass_fid"}));
-  if (fFTonConfig) {
+
+  if (reuseFidMasks) {
+    // masks already present as input columns; nothing to define
+  } else if (fFTonConfig) {
+    // Fused kernel: one traversal of the traj/calo/FT banks per event produces
+    // every pass mask at once, instead of four independent Defines that each
+    // re-scan the hit lists, plus the LogicalAND2 combinations.
+    auto maskCols = CombineColumns(RECTraj::ForFiducialCut(), RECCalorimeter::ForFiducialCut(), RECForwardTagger::ForFiducialCut(),
+                                   std::vector<std::string>{"REC_Particle_pid", "REC_Particle_p", "REC_Particle_num"});
+    // Hot functor: sampled by PipelineTimer when the timing report is on
+    // (inactive sampler otherwise, one relaxed increment per call).
+    auto fidSampler = PipelineTimer::Instance().MakeSampler("DVCSAnalysis/REC_FiducialMasks");
+    dfDefsWithTraj = DefineOrRedefine(dfDefsWithTraj, "REC_FiducialMasks",
+                                      PipelineTimer::Wrap(fidSampler, fTrackCutsWithFid->RECAllFiducialMasks(true)), maskCols);
+    dfDefsWithTraj = DefineOrRedefine(dfDefsWithTraj, "REC_Track_pass_nofid", [](const FiducialPassMasks& m) { return m.nofidPass; }, {"REC_FiducialMasks"});
+    dfDefsWithTraj = DefineOrRedefine(dfDefsWithTraj, "REC_Traj_pass_fid", [](const FiducialPassMasks& m) { return m.trajPass; }, {"REC_FiducialMasks"});
+    dfDefsWithTraj = DefineOrRedefine(dfDefsWithTraj, "REC_Calorimeter_pass_fid", [](const FiducialPassMasks& m) { return m.caloPass; }, {"REC_FiducialMasks"});
+    dfDefsWithTraj = DefineOrRedefine(dfDefsWithTraj, "REC_ForwardTagger_pass_fid", [](const FiducialPassMasks& m) { return m.ftPass; }, {"REC_FiducialMasks"});
+    dfDefsWithTraj = DefineOrRedefine(dfDefsWithTraj, "REC_Track_pass_fid", [](const FiducialPassMasks& m) { return m.trackFidPass; }, {"REC_FiducialMasks"});
+  } else {
+    // FT bank may be absent from the input in FT-off configurations, so keep
+    // the split per-detector path there.
+    dfDefsWithTraj = DefineOrRedefine(dfDefsWithTraj, "REC_Track_pass_nofid", fTrackCutsNoFid->RECTrajPass(), trajCols);
+    dfDefsWithTraj = DefineOrRedefine(dfDefsWithTraj, "REC_Traj_pass_fid", fTrackCutsWithFid->RECTrajPass(), trajCols);
+    dfDefsWithTraj = DefineOrRedefine(dfDefsWithTraj, "REC_Calorimeter_pass_fid", fTrackCutsWithFid->RECCalorimeterPass(), caloCols);
     dfDefsWithTraj = DefineOrRedefine(dfDefsWithTraj, "REC_Track_pass_fid", Columns::LogicalAND2(),
-                                      CombineColumns(std::vector<std::string>{"REC_Track_pass_fid"}, std::vector<std::string>{"REC_ForwardTagger_pass_fid"}));
+                                      CombineColumns(std::vector<std::string>{"REC_Traj_pass_fid"}, std::vector<std::string>{"REC_Calorimeter_pass_fid"}));
   }
-  auto AllCols = CombineColumns(trajCols, caloCols);
 
-  auto cols_track_fid = CombineColumns(RECParticle::All(), std::vector<std::string>{"REC_Track_pass_fid"});
-  auto cols_track_nofid = CombineColumns(RECParticle::All(), std::vector<std::string>{"REC_Track_pass_nofid"});
+  // Packed sidecar columns: the snapshots store each mask as one 64-bit
+  // word per event (bit i = particle i passes) instead of a vector of
+  // 32-bit flags — ~30x less pass-mask payload per event.  The unpack shim
+  // in the reuse block above turns them back into the vector view.
+  if (fDerivedSidecar) {
+    std::vector<std::string> sidecarMasks = {"REC_Track_pass_nofid", "REC_Traj_pass_fid",
+                                             "REC_Calorimeter_pass_fid", "REC_Track_pass_fid"};
+    if (fFTonConfig) sidecarMasks.push_back("REC_ForwardTagger_pass_fid");
+    for (const auto& c : sidecarMasks)
+      if (dfDefsWithTraj.HasColumn(c) && !dfDefsWithTraj.HasColumn(c + "_bits"))
+        dfDefsWithTraj = dfDefsWithTraj.Define(c + "_bits", Columns::PackMask(), {c});
+  }
+  auto AllCols = CombineColumns(trajCols, caloCols);
 
   if (fAcceptAll) {
     fEventCuts->AcceptEverything(true);
   }
+  // must be set before the cuts are captured into the Defines below
+  if (fDoInvMassCut) {
+    fEventCuts->SetDoCutMotherInvMass(true);
+  }
+
+  // The nofid and fid chains apply identical pid/charge/momentum/vertex/chi2
+  // selections — only the fiducial mask differs.  Classify every particle
+  // once into a shared column and derive each EventCutResult by combining
+  // the classification with the corresponding mask, instead of running the
+  // full EventCut::operator() twice per event.
+  //
+  // The classification and the two results live in per-slot arenas owned by
+  // the Define functors; the columns carry pointers into the current slot's
+  // buffer, which is only read downstream within the same event.  That keeps
+  // the selection free of per-event heap allocation in steady state.  These
+  // pointer columns are excluded from every Snapshot below.
+  // Compile the selectivity-ordered cut plan before the copy below: the plan
+  // is shared across copies, so the per-slot functors calibrate on the first
+  // events and then evaluate the tightest count constraints first with early
+  // rejection of events that cannot satisfy them.
+  fEventCuts->Compile();
+  const EventCut evCuts = *fEventCuts;
+  const unsigned int nSlots = std::max(1u, dfDefsWithTraj.GetNSlots());
+  auto clsArena = std::make_shared<std::vector<EventCutClassification>>(nSlots);
+  auto clsSampler = PipelineTimer::Instance().MakeSampler("DVCSAnalysis/EventCutClassification");
+  dfDefsWithTraj = DefineSlotOrRedefine(
+      dfDefsWithTraj, "EventCutClassification",
+      [evCuts, clsArena, clsSampler](unsigned int slot, const std::vector<int>& pid, const std::vector<float>& px, const std::vector<float>& py, const std::vector<float>& pz,
+                         const std::vector<float>& vx, const std::vector<float>& vy, const std::vector<float>& vz, const std::vector<float>& vt,
+                         const std::vector<short>& charge, const std::vector<float>& beta, const std::vector<float>& chi2pid, const std::vector<short>& /*status*/,
+                         const std::vector<unsigned char>& regsec) {
+        auto timed = clsSampler.Sample();
+        EventCutClassification& cls = (*clsArena)[slot];
+        evCuts.Classify(pid, px, py, pz, vx, vy, vz, vt, charge, beta, chi2pid, regsec, cls);
+        return static_cast<const EventCutClassification*>(&cls);
+      },
+      CombineColumns(RECParticle::All(), std::vector<std::string>{"REC_Particle_regsec"}));
+  // Each chain gets its own result arena: both EventCutResult Defines can be
+  // evaluated for the same slot and event when the graphs run concurrently.
+  // When cut-flow accounting is on, each chain also gets per-slot tallies of
+  // the event decision and the per-particle masks, filled here for free and
+  // summed into the cut-flow table at SaveOutput.
+  fCutFlowNoFid = fCutFlowReport ? std::make_shared<std::vector<CutFlowTally>>(nSlots) : nullptr;
+  fCutFlowFid = fCutFlowReport ? std::make_shared<std::vector<CutFlowTally>>(nSlots) : nullptr;
+  auto makeApplyMask = [evCuts, nSlots](std::shared_ptr<std::vector<CutFlowTally>> tally) {
+    auto resArena = std::make_shared<std::vector<EventCutResult>>(nSlots);
+    return [evCuts, resArena, tally](unsigned int slot, const EventCutClassification* cls, const std::vector<int>& mask) {
+      EventCutResult& result = (*resArena)[slot];
+      evCuts.ApplyFiducialMask(*cls, mask, result);
+      if (tally) {
+        CutFlowTally& t = (*tally)[slot];
+        ++t.events;
+        if (result.eventPass) ++t.eventPass;
+        t.particles += result.particlePass.size();
+        for (int v : result.particlePass) if (v) ++t.particlePass;
+        for (int v : result.MaxPhotonEnergyPass) if (v) ++t.photonMaxEPass;
+        for (int v : result.particleDaughterPass) if (v) ++t.daughterPass;
+      }
+      return static_cast<const EventCutResult*>(&result);
+    };
+  };
 
   dfSelected = dfDefsWithTraj;
-  dfSelected = DefineOrRedefine(*dfSelected, "EventCutResult", *fEventCuts, cols_track_nofid);
-  dfSelected = DefineOrRedefine(*dfSelected, "REC_Event_pass", [](const EventCutResult& result) { return result.eventPass; }, {"EventCutResult"});
-  dfSelected = DefineOrRedefine(*dfSelected, "REC_Particle_pass", [](const EventCutResult& result) { return result.particlePass; }, {"EventCutResult"});
-  dfSelected = DefineOrRedefine(*dfSelected, "REC_Photon_MaxE", [](const EventCutResult& result) { return result.MaxPhotonEnergyPass; }, {"EventCutResult"});
+  dfSelected = DefineSlotOrRedefine(*dfSelected, "EventCutResult", makeApplyMask(fCutFlowNoFid), {"EventCutClassification", "REC_Track_pass_nofid"});
+  dfSelected = DefineOrRedefine(*dfSelected, "REC_Event_pass", [](const EventCutResult* result) { return result->eventPass; }, {"EventCutResult"});
+  dfSelected = DefineOrRedefine(*dfSelected, "REC_Particle_pass", [](const EventCutResult* result) { return result->particlePass; }, {"EventCutResult"});
+  dfSelected = DefineOrRedefine(*dfSelected, "REC_Photon_MaxE", [](const EventCutResult* result) { return result->MaxPhotonEnergyPass; }, {"EventCutResult"});
 
   if (fDoInvMassCut) {
-    fEventCuts->SetDoCutMotherInvMass(true);
-    dfSelected = DefineOrRedefine(*dfSelected, "REC_DaughterParticle_pass", [](const EventCutResult& result) { return result.particleDaughterPass; }, {"EventCutResult"});
-    dfSelected = DefineOrRedefine(*dfSelected, "REC_MotherMass", [](const EventCutResult& result) { return result.MotherMass; }, {"EventCutResult"});
+    dfSelected = DefineOrRedefine(*dfSelected, "REC_DaughterParticle_pass", [](const EventCutResult* result) { return result->particleDaughterPass; }, {"EventCutResult"});
+    dfSelected = DefineOrRedefine(*dfSelected, "REC_MotherMass", [](const EventCutResult* result) { return result->MotherMass; }, {"EventCutResult"});
   }
-  dfSelected = dfSelected->Filter("REC_Event_pass");
+  dfSelected = dfSelected->Filter([](bool pass) { return pass; }, {"REC_Event_pass"}, "event pass");
 
   // After fiducial cut
   if (fFiducialCut) {
     dfSelected_afterFid = dfDefsWithTraj;
-    dfSelected_afterFid = DefineOrRedefine(*dfSelected_afterFid, "EventCutResult", *fEventCuts, cols_track_fid);
-    dfSelected_afterFid = DefineOrRedefine(*dfSelected_afterFid, "REC_Event_pass", [](const EventCutResult& result) { return result.eventPass; }, {"EventCutResult"});
-    dfSelected_afterFid = DefineOrRedefine(*dfSelected_afterFid, "REC_Particle_pass", [](const EventCutResult& result) { return result.particlePass; }, {"EventCutResult"});
-    dfSelected_afterFid = DefineOrRedefine(*dfSelected_afterFid, "REC_Photon_MaxE", [](const EventCutResult& result) { return result.MaxPhotonEnergyPass; }, {"EventCutResult"});
+    dfSelected_afterFid = DefineSlotOrRedefine(*dfSelected_afterFid, "EventCutResult", makeApplyMask(fCutFlowFid), {"EventCutClassification", "REC_Track_pass_fid"});
+    dfSelected_afterFid = DefineOrRedefine(*dfSelected_afterFid, "REC_Event_pass", [](const EventCutResult* result) { return result->eventPass; }, {"EventCutResult"});
+    dfSelected_afterFid = DefineOrRedefine(*dfSelected_afterFid, "REC_Particle_pass", [](const EventCutResult* result) { return result->particlePass; }, {"EventCutResult"});
+    dfSelected_afterFid = DefineOrRedefine(*dfSelected_afterFid, "REC_Photon_MaxE", [](const EventCutResult* result) { return result->MaxPhotonEnergyPass; }, {"EventCutResult"});
     if (fDoInvMassCut) {
-      fEventCuts->SetDoCutMotherInvMass(true);
       dfSelected_afterFid =
-          DefineOrRedefine(*dfSelected_afterFid, "REC_DaughterParticle_pass", [](const EventCutResult& result) { return result.particleDaughterPass; }, {"EventCutResult"});
-      dfSelected_afterFid = DefineOrRedefine(*dfSelected_afterFid, "REC_MotherMass", [](const EventCutResult& result) { return result.MotherMass; }, {"EventCutResult"});
+          DefineOrRedefine(*dfSelected_afterFid, "REC_DaughterParticle_pass", [](const EventCutResult* result) { return result->particleDaughterPass; }, {"EventCutResult"});
+      dfSelected_afterFid = DefineOrRedefine(*dfSelected_afterFid, "REC_MotherMass", [](const EventCutResult* result) { return result->MotherMass; }, {"EventCutResult"});
     }
-    dfSelected_afterFid = dfSelected_afterFid->Filter("REC_Event_pass");
+    dfSelected_afterFid = dfSelected_afterFid->Filter([](bool pass) { return pass; }, {"REC_Event_pass"}, "event pass (fid)");
   }
 
   dfSelected_afterFid_afterCorr = dfSelected_afterFid;
 
   if (fMomCorr && fDoMomentumCorrection) {
     std::cout << "Applying momentum correction..." << std::endl;
-    dfSelected_afterFid_afterCorr = DefineOrRedefine(*dfSelected_afterFid_afterCorr, "REC_Particle_px", fMomCorr->RECParticlePxCorrected(), RECParticle::Extend());
-    dfSelected_afterFid_afterCorr = DefineOrRedefine(*dfSelected_afterFid_afterCorr, "REC_Particle_py", fMomCorr->RECParticlePyCorrected(), RECParticle::Extend());
-    dfSelected_afterFid_afterCorr = DefineOrRedefine(*dfSelected_afterFid_afterCorr, "REC_Particle_pz", fMomCorr->RECParticlePzCorrected(), RECParticle::Extend());
-    dfSelected_afterFid_afterCorr = DefineOrRedefine(*dfSelected_afterFid_afterCorr, "REC_Particle_theta", RECParticletheta(), RECParticle::All());
-    dfSelected_afterFid_afterCorr = DefineOrRedefine(*dfSelected_afterFid_afterCorr, "REC_Particle_phi", RECParticlephi(), RECParticle::All());
-    dfSelected_afterFid_afterCorr = DefineOrRedefine(*dfSelected_afterFid_afterCorr, "REC_Particle_p", RECParticleP(), RECParticle::All());
+    // Fused correction kernel: one traversal resolves the region and
+    // evaluates the correction per particle, then the six columns are peeled
+    // off the struct — the per-component functors re-did that work three
+    // times and forced a kinematics re-Define afterwards.
+    using CorrKin = MomentumCorrection::CorrectedKinematics;
+    auto corrSampler = PipelineTimer::Instance().MakeSampler("DVCSAnalysis/REC_Particle_corr");
+    dfSelected_afterFid_afterCorr = DefineOrRedefine(*dfSelected_afterFid_afterCorr, "REC_Particle_corr",
+                                                     PipelineTimer::Wrap(corrSampler, fMomCorr->RECParticleCorrected()), RECParticle::Extend());
+    dfSelected_afterFid_afterCorr = DefineOrRedefine(*dfSelected_afterFid_afterCorr, "REC_Particle_px", [](const CorrKin& c) { return c.px; }, {"REC_Particle_corr"});
+    dfSelected_afterFid_afterCorr = DefineOrRedefine(*dfSelected_afterFid_afterCorr, "REC_Particle_py", [](const CorrKin& c) { return c.py; }, {"REC_Particle_corr"});
+    dfSelected_afterFid_afterCorr = DefineOrRedefine(*dfSelected_afterFid_afterCorr, "REC_Particle_pz", [](const CorrKin& c) { return c.pz; }, {"REC_Particle_corr"});
+    dfSelected_afterFid_afterCorr = DefineOrRedefine(*dfSelected_afterFid_afterCorr, "REC_Particle_theta", [](const CorrKin& c) { return c.theta; }, {"REC_Particle_corr"});
+    dfSelected_afterFid_afterCorr = DefineOrRedefine(*dfSelected_afterFid_afterCorr, "REC_Particle_phi", [](const CorrKin& c) { return c.phi; }, {"REC_Particle_corr"});
+    dfSelected_afterFid_afterCorr = DefineOrRedefine(*dfSelected_afterFid_afterCorr, "REC_Particle_p", [](const CorrKin& c) { return c.p; }, {"REC_Particle_corr"});
+  }
+
+  // ---- Systematics fan-out ----
+  // Each registered variation branches off the shared Defines and redefines
+  // only what its cuts change: its own fiducial masks, its own classification
+  // and result (in separate slot arenas, since all branches run in the same
+  // loop), and optionally its own momentum correction.  The branches are
+  // booked next to the nominal snapshots in SaveOutput, so an N-variation
+  // campaign is one pass over the data instead of N full jobs.
+  dfVariationNodes.clear();
+  for (const auto& var : fVariations) {
+    auto varTrackBase = var.trackCuts ? var.trackCuts : fTrackCuts;
+    auto varTrackFid = std::make_shared<TrackCut>(*varTrackBase);
+    varTrackFid->SetDoFiducialCut(true);
+    varTrackFid->SetFiducialCutOptions(true, true);
+
+    EventCut varEv = var.eventCuts ? *var.eventCuts : *fEventCuts;
+    if (fAcceptAll) varEv.AcceptEverything(true);
+    if (fDoInvMassCut) varEv.SetDoCutMotherInvMass(true);
+
+    ROOT::RDF::RNode varNode = dfDefsWithTraj;
+    if (fFTonConfig) {
+      auto varMaskCols = CombineColumns(RECTraj::ForFiducialCut(), RECCalorimeter::ForFiducialCut(), RECForwardTagger::ForFiducialCut(),
+                                        std::vector<std::string>{"REC_Particle_pid", "REC_Particle_p", "REC_Particle_num"});
+      varNode = DefineOrRedefine(varNode, "REC_FiducialMasks", varTrackFid->RECAllFiducialMasks(true), varMaskCols);
+      varNode = DefineOrRedefine(varNode, "REC_Track_pass_fid", [](const FiducialPassMasks& m) { return m.trackFidPass; }, {"REC_FiducialMasks"});
+    } else {
+      varNode = DefineOrRedefine(varNode, "REC_Traj_pass_fid", varTrackFid->RECTrajPass(), trajCols);
+      varNode = DefineOrRedefine(varNode, "REC_Calorimeter_pass_fid", varTrackFid->RECCalorimeterPass(), caloCols);
+      varNode = DefineOrRedefine(varNode, "REC_Track_pass_fid", Columns::LogicalAND2(),
+                                 CombineColumns(std::vector<std::string>{"REC_Traj_pass_fid"}, std::vector<std::string>{"REC_Calorimeter_pass_fid"}));
+    }
+
+    auto varClsArena = std::make_shared<std::vector<EventCutClassification>>(nSlots);
+    varNode = DefineSlotOrRedefine(
+        varNode, "EventCutClassification",
+        [varEv, varClsArena](unsigned int slot, const std::vector<int>& pid, const std::vector<float>& px, const std::vector<float>& py, const std::vector<float>& pz,
+                             const std::vector<float>& vx, const std::vector<float>& vy, const std::vector<float>& vz, const std::vector<float>& vt,
+                             const std::vector<short>& charge, const std::vector<float>& beta, const std::vector<float>& chi2pid, const std::vector<short>& status) {
+          EventCutClassification& cls = (*varClsArena)[slot];
+          varEv.Classify(pid, px, py, pz, vx, vy, vz, vt, charge, beta, chi2pid, status, cls);
+          return static_cast<const EventCutClassification*>(&cls);
+        },
+        RECParticle::All());
+    auto varResArena = std::make_shared<std::vector<EventCutResult>>(nSlots);
+    varNode = DefineSlotOrRedefine(
+        varNode, "EventCutResult",
+        [varEv, varResArena](unsigned int slot, const EventCutClassification* cls, const std::vector<int>& mask) {
+          EventCutResult& result = (*varResArena)[slot];
+          varEv.ApplyFiducialMask(*cls, mask, result);
+          return static_cast<const EventCutResult*>(&result);
+        },
+        {"EventCutClassification", "REC_Track_pass_fid"});
+    varNode = DefineOrRedefine(varNode, "REC_Event_pass", [](const EventCutResult* result) { return result->eventPass; }, {"EventCutResult"});
+    varNode = DefineOrRedefine(varNode, "REC_Particle_pass", [](const EventCutResult* result) { return result->particlePass; }, {"EventCutResult"});
+    varNode = DefineOrRedefine(varNode, "REC_Photon_MaxE", [](const EventCutResult* result) { return result->MaxPhotonEnergyPass; }, {"EventCutResult"});
+    if (fDoInvMassCut) {
+      varNode = DefineOrRedefine(varNode, "REC_DaughterParticle_pass", [](const EventCutResult* result) { return result->particleDaughterPass; }, {"EventCutResult"});
+      varNode = DefineOrRedefine(varNode, "REC_MotherMass", [](const EventCutResult* result) { return result->MotherMass; }, {"EventCutResult"});
+    }
+    varNode = varNode.Filter([](bool pass) { return pass; }, {"REC_Event_pass"}, "event pass (" + var.name + ")");
+
+    auto varCorr = var.momCorr ? var.momCorr : fMomCorr;
+    if (varCorr && fDoMomentumCorrection) {
+      using CorrKin = MomentumCorrection::CorrectedKinematics;
+      varNode = DefineOrRedefine(varNode, "REC_Particle_corr", varCorr->RECParticleCorrected(), RECParticle::Extend());
+      varNode = DefineOrRedefine(varNode, "REC_Particle_px", [](const CorrKin& c) { return c.px; }, {"REC_Particle_corr"});
+      varNode = DefineOrRedefine(varNode, "REC_Particle_py", [](const CorrKin& c) { return c.py; }, {"REC_Particle_corr"});
+      varNode = DefineOrRedefine(varNode, "REC_Particle_pz", [](const CorrKin& c) { return c.pz; }, {"REC_Particle_corr"});
+      varNode = DefineOrRedefine(varNode, "REC_Particle_theta", [](const CorrKin& c) { return c.theta; }, {"REC_Particle_corr"});
+      varNode = DefineOrRedefine(varNode, "REC_Particle_phi", [](const CorrKin& c) { return c.phi; }, {"REC_Particle_corr"});
+      varNode = DefineOrRedefine(varNode, "REC_Particle_p", [](const CorrKin& c) { return c.p; }, {"REC_Particle_corr"});
+    }
+
+    dfVariationNodes.emplace_back(var.name, varNode);
   }
 }
 
+void DVCSAnalysis::AddSystematicVariation(const std::string& name,
+                                          std::shared_ptr<TrackCut> trackCuts,
+                                          std::shared_ptr<EventCut> eventCuts,
+                                          std::shared_ptr<MomentumCorrection> momCorr) {
+  fVariations.push_back({name, std::move(trackCuts), std::move(eventCuts), std::move(momCorr)});
+}
+
 std::vector<std::string> DVCSAnalysis::MinimalColumns() const {
   using V = std::vector<std::string>;
 
@@ -259,6 +459,21 @@ std::vector<std::string> DVCSAnalysis::MinimalColumns() const {
     cols = CombineColumns(cols, RECForwardTagger::ForFiducialCut());
     cols.push_back("REC_Event_helicity");
 
+  // Mixed-period runs carry the resolved per-event beam energy into the slim
+  // outputs so downstream kinematics can consume it without the table.
+  if (fRunConditions && !fRunConditions->Empty()) cols.push_back("RUN_beam_energy");
+
+  // With the derived-column sidecar the snapshots also carry the fiducial
+  // pass masks, so a fingerprint-matched reprocess run can read them back
+  // instead of re-deriving them from the bank columns.  They persist in
+  // the packed one-word-per-event form (Columns::PackMask).
+  if (fDerivedSidecar) {
+    for (const auto& c : V{"REC_Traj_pass_fid_bits", "REC_Calorimeter_pass_fid_bits",
+                           "REC_Track_pass_nofid_bits", "REC_Track_pass_fid_bits"})
+      cols.push_back(c);
+    if (fFTonConfig) cols.push_back("REC_ForwardTagger_pass_fid_bits");
+  }
+
   for (const auto& c : V{"RUN_config_run", "RUN_config_event",
                             "RUN::config.run", "RUN::config.event",
                             "RUN_run", "RUN_event",
@@ -272,6 +487,7 @@ std::vector<std::string> DVCSAnalysis::MinimalColumns() const {
       "REC_Particle_theta",
       "REC_Particle_phi",
       "REC_Particle_p",
+      "REC_Particle_regsec",
       "REC_Particle_pass",
       "REC_Event_pass",
       "REC_MotherMass",
@@ -288,6 +504,23 @@ std::vector<std::string> DVCSAnalysis::MinimalColumns() const {
   return cols;
 }
 
+// The HIPO banks this task reads, as prefixes for the datasource pruning in
+// Events (see ColumnPrunedHipoDS).  Only active when column optimisation is
+// on: the full-snapshot path writes every input column and therefore still
+// needs the complete schema.
+std::vector<std::string> DVCSAnalysis::RequestedColumns() const {
+  if (!fOptimizeColumns) return {};
+
+  std::vector<std::string> banks = {"REC_Particle", "REC_Track", "REC_Traj", "REC_Calorimeter", "REC_Event",
+                                    "RUN_config", "RUN::config.run", "RUN::config.event"};
+  if (fFTonConfig) banks.push_back("REC_ForwardTagger");
+  if (IsMC) {
+    banks.push_back("MC_Particle");
+    banks.push_back("MC_Event");
+  }
+  return banks;
+}
+
 void DVCSAnalysis::WriteFinalElectronWCSV(ROOT::RDF::RNode df, const std::string& csvPath) {
   auto out = df;
   out = DefineOrRedefine(out, "WCSV_e_idx", SelectedElectronIndex, {"REC_Particle_pid", "REC_Particle_pass"});
@@ -295,26 +528,41 @@ void DVCSAnalysis::WriteFinalElectronWCSV(ROOT::RDF::RNode df, const std::string
   out = DefineOrRedefine(out, "WCSV_e_theta_rad", FloatAtIndex, {"REC_Particle_theta", "WCSV_e_idx"});
   out = DefineOrRedefine(out, "WCSV_e_phi_rad", FloatAtIndex, {"REC_Particle_phi", "WCSV_e_idx"});
   out = DefineOrRedefine(out, "WCSV_e_sector", TrackSectorForParticle, {"WCSV_e_idx", "REC_Track_pindex", "REC_Track_sector"});
-  out = DefineOrRedefine(out, "WCSV_W", [beam = fbeam_energy](float p, float theta) { return InclusiveWFromElectron(beam, p, theta); }, {"WCSV_e_p", "WCSV_e_theta_rad"});
+  if (fRunConditions && !fRunConditions->Empty()) {
+    out = DefineOrRedefine(out, "WCSV_W", [](float beam, float p, float theta) { return InclusiveWFromElectron(beam, p, theta); },
+                           {"RUN_beam_energy", "WCSV_e_p", "WCSV_e_theta_rad"});
+  } else {
+    out = DefineOrRedefine(out, "WCSV_W", [beam = fbeam_energy](float p, float theta) { return InclusiveWFromElectron(beam, p, theta); }, {"WCSV_e_p", "WCSV_e_theta_rad"});
+  }
   out = DefineOrRedefine(out, "WCSV_e_phi", PhiRadToWrappedDeg, {"WCSV_e_phi_rad"});
   out = DefineOrRedefine(out, "WCSV_e_theta", [](float theta) { return theta * 180.0f / static_cast<float>(M_PI); }, {"WCSV_e_theta_rad"});
-  out = out.Filter("WCSV_e_idx >= 0 && WCSV_W >= 0.8 && WCSV_W <= 1.1 && WCSV_e_sector >= 1 && WCSV_e_sector <= 6",
-                   "final electron W CSV rows");
+  out = out.Filter([](int idx, float W, int sector) { return idx >= 0 && W >= 0.8f && W <= 1.1f && sector >= 1 && sector <= 6; },
+                   {"WCSV_e_idx", "WCSV_W", "WCSV_e_sector"}, "final electron W CSV rows");
+
+  // One buffer per RDF processing slot: each worker appends to its own stream
+  // with no synchronisation, and the buffers are concatenated once after the
+  // event loop.  Row order between slots is arbitrary, which it already was
+  // under MT with the old mutex-guarded Foreach.
+  const unsigned int nSlots = std::max(1u, out.GetNSlots());
+  std::vector<std::ostringstream> slotBuf(nSlots);
+  std::vector<size_t> slotRows(nSlots, 0);
+  for (auto& buf : slotBuf) buf << std::fixed << std::setprecision(8);
+
+  out.ForeachSlot([&](unsigned int slot, float w, float p, float phi, float theta, int sector) {
+    slotBuf[slot] << w << "," << p << "," << phi << "," << theta << "," << sector << "\n";
+    ++slotRows[slot];
+  }, {"WCSV_W", "WCSV_e_p", "WCSV_e_phi", "WCSV_e_theta", "WCSV_e_sector"});
 
   std::ofstream csv(csvPath);
   if (!csv.is_open()) {
     throw std::runtime_error("DVCSAnalysis: cannot open W CSV output: " + csvPath);
   }
   csv << "W,e_p,e_phi,e_theta,e_sector\n";
-  csv << std::fixed << std::setprecision(8);
-
-  std::mutex csvMutex;
   size_t rows = 0;
-  out.Foreach([&](float w, float p, float phi, float theta, int sector) {
-    std::lock_guard<std::mutex> lock(csvMutex);
-    csv << w << "," << p << "," << phi << "," << theta << "," << sector << "\n";
-    ++rows;
-  }, {"WCSV_W", "WCSV_e_p", "WCSV_e_phi", "WCSV_e_theta", "WCSV_e_sector"});
+  for (unsigned int slot = 0; slot < nSlots; ++slot) {
+    csv << slotBuf[slot].str();
+    rows += slotRows[slot];
+  }
 
   std::cout << "[SaveOutput] Wrote final corrected electron W CSV: " << csvPath
             << " (rows = " << rows << ")\n";
@@ -333,23 +581,129 @@ void DVCSAnalysis::SaveOutput() {
     std::cout << "[SaveOutput] Output-W mode ON — writing CSV only, no ROOT snapshots.\n";
     WriteFinalElectronWCSV(finalDf, csvPath);
     if (fIsQADBCut) {
-      std::cout << "\n[QADB] total accumulated charge analyzed: " << fQADBCuts->GetAccumulatedCharge() / 1e6 << " mC (Do NOT use this number if you enable MT)\n";
+      std::cout << "\n[QADB] total accumulated charge analyzed: " << fQADBCuts->GetAccumulatedCharge() / 1e6 << " mC (per-bin accounting, safe with MT)\n";
+      QADBCuts::SaveDecisionCache();
     }
     return;
   }
 
+  // In shared-loop mode the manager already booked every result through
+  // BookLazyOutputs and drove the handles with its own RunGraphs pass;
+  // everything below the booking call is post-loop bookkeeping.
+  const bool externallyRun = fOutputsBooked;
+  if (!fOutputsBooked && !BookOutputs()) return;
+
+  if (fConcurrentSnapshots && !fSnapHandles.empty()) {
+    if (!externallyRun) {
+      std::cout << "[SaveOutput] Concurrent-snapshot mode ON — running " << fSnapHandles.size()
+                << " booked results in a single pass over the input.\n";
+      ROOT::RDF::RunGraphs(fSnapHandles);
+    }
+    if (fCnt.has_value()) std::cout << "Events selected: " << *(*fCnt) << std::endl;
+    if (fCntAfterFid.has_value()) std::cout << "Events after fiducial selected: " << *(*fCntAfterFid) << std::endl;
+    if (fCntAfterCorr.has_value())
+      std::cout << "Events after fiducial and momentum correction selected: " << *(*fCntAfterCorr) << std::endl;
+    for (std::size_t i = 0; i < dfVariationNodes.size(); ++i)
+      std::cout << "Events selected (variation " << dfVariationNodes[i].first << "): " << *fCntVariations[i] << std::endl;
+  }
+
+  if (fCutFlowReport) {
+    const std::string csvPath = fOutputDir + "/cutflow_report.csv";
+    std::ofstream csv(csvPath);
+    if (!csv.is_open()) {
+      std::cerr << "DVCSAnalysis: cannot open cut-flow report: " << csvPath << std::endl;
+    } else {
+      csv << "kind,name,pass,all,efficiency\n";
+      auto writeFilters = [&csv](const char* chain, ROOT::RDF::RCutFlowReport& rep) {
+        for (auto&& ci : rep) {
+          const double eff = ci.GetAll() > 0 ? static_cast<double>(ci.GetPass()) / ci.GetAll() : 0.0;
+          csv << "filter," << chain << "/" << ci.GetName() << "," << ci.GetPass() << "," << ci.GetAll() << "," << eff << "\n";
+        }
+      };
+      auto writeTallies = [&csv](const char* chain, const std::vector<CutFlowTally>& tallies) {
+        CutFlowTally sum;
+        for (const auto& t : tallies) {
+          sum.events += t.events;
+          sum.eventPass += t.eventPass;
+          sum.particles += t.particles;
+          sum.particlePass += t.particlePass;
+          sum.photonMaxEPass += t.photonMaxEPass;
+          sum.daughterPass += t.daughterPass;
+        }
+        auto row = [&csv, chain](const char* name, unsigned long long pass, unsigned long long all) {
+          const double eff = all > 0 ? static_cast<double>(pass) / all : 0.0;
+          csv << "mask," << chain << "/" << name << "," << pass << "," << all << "," << eff << "\n";
+        };
+        row("event_pass", sum.eventPass, sum.events);
+        row("particle_pass", sum.particlePass, sum.particles);
+        row("photon_maxE_pass", sum.photonMaxEPass, sum.particles);
+        row("daughter_pass", sum.daughterPass, sum.particles);
+      };
+      if (fCutReport.has_value()) writeFilters("nofid", **fCutReport);
+      if (fCutReportFid.has_value()) writeFilters("fid", **fCutReportFid);
+      if (fCutFlowNoFid) writeTallies("nofid", *fCutFlowNoFid);
+      if (fCutFlowFid) writeTallies("fid", *fCutFlowFid);
+      std::cout << "[SaveOutput] Cut-flow report written to " << csvPath << std::endl;
+    }
+  }
+
+  if (fPerRunCounts.has_value()) {
+    const std::string csvpath = fOutputDir + "/events_per_run_afterFid.csv";
+    try {
+      const auto& items = *(*fPerRunCounts);  // already filled by the snapshot loop
+      WritePerRunCSV(items, csvpath);
+
+      std::cout << "[INFO] Wrote per-run counts to " << csvpath << " (unique runs = " << items.size() << ")\n";
+    } catch (const std::exception& e) {
+      std::cerr << "[WARN] Failed to write per-run CSV after fiducial snapshot: " << e.what() << std::endl;
+    }
+  }
+  if (fIsQADBCut) {
+    std::cout << "\n[QADB] total accumulated charge analyzed: " << fQADBCuts->GetAccumulatedCharge() / 1e6 << " mC (per-bin accounting, safe with MT)\n";
+    QADBCuts::SaveDecisionCache();
+  }
+
+  if (fDerivedSidecar && !fFiducialFingerprint.empty()) {
+    const std::string fpPath = fOutputDir + "/derived_columns.txt";
+    std::ofstream fpOut(fpPath);
+    if (!fpOut.is_open()) {
+      std::cerr << "DVCSAnalysis: cannot write derived-column fingerprint: " << fpPath << std::endl;
+    } else {
+      fpOut << fFiducialFingerprint << "\n";
+      std::cout << "[SaveOutput] Derived-column fingerprint recorded in " << fpPath << std::endl;
+    }
+  }
+}
+
+// Books the snapshots, counts, per-run counter, variations and cut-flow
+// reports into the fBooked* members — lazily in concurrent-snapshot mode so
+// one RunGraphs call (ours or the manager's) drives them together, eagerly
+// otherwise, matching the historical behaviour.
+bool DVCSAnalysis::BookOutputs() {
+  fSnapHandles.clear();
+  fCnt.reset();
+  fCntAfterFid.reset();
+  fCntAfterCorr.reset();
+  fCntVariations.clear();
+  fPerRunCounts.reset();
+  fCutReport.reset();
+  fCutReportFid.reset();
+
   if (IsMC) {
-    // snapshot of the MC bank for efficiency and other studies
-    dforginal->Snapshot(
+    // snapshot of the MC bank for efficiency and other studies (lazy in
+    // concurrent mode so it joins the single pass)
+    auto snapMC = dforginal->Snapshot(
         "dfSelectedMC", Form("%s/%s", fOutputDir.c_str(), "dfSelectedMC.root"),
         {"MC_Particle_pid", "MC_Particle_px", "MC_Particle_py", "MC_Particle_pz", "MC_Particle_vx", "MC_Particle_vy", "MC_Particle_vz", "MC_Particle_vt", "MC_Event_weight",
          "MC_Event_pbeam",  // include if this exists
-         "MC_Event_ptarget", "MC_Event_ebeam"});
+         "MC_Event_ptarget", "MC_Event_ebeam"},
+        MakeSnapshotOptions(/*lazy=*/fConcurrentSnapshots, SnapshotProfile::kArchival));
+    if (fConcurrentSnapshots) fSnapHandles.emplace_back(snapMC);
   }
 
   if (!dfSelected.has_value()) {
     std::cerr << "DVCSAnalysis::SaveOutput: dfSelected not set!" << std::endl;
-    return;
+    return false;
   }
 
   if (fOptimizeColumns) {
@@ -362,50 +716,100 @@ void DVCSAnalysis::SaveOutput() {
     if (fOptimizeColumns) {
       return ResolveSnapshotColumns(node, MinimalColumns());
     } else {
-      return SafeSnapshotColumns(node, {"EventCutResult"});
+      return SafeSnapshotColumns(node, {"EventCutResult", "EventCutClassification", "REC_Particle_kin", "REC_Particle_corr", "REC_FiducialMasks"});
     }
   };
 
+  // Concurrent-snapshot mode: every Snapshot is booked lazily together with its
+  // Count and the whole set is driven by one RunGraphs call, so the input banks
+  // are decoded exactly once instead of once per output tree.
+  auto snapOpts = MakeSnapshotOptions(/*lazy=*/fConcurrentSnapshots);
+
   if (!IsReproc) {
     auto cols = resolveColumns(*dfSelected);
-    auto cnt = dfSelected->Count();
-    dfSelected->Snapshot("dfSelected",
-                    Form("%s/%s", fOutputDir.c_str(), "dfSelected.root"), cols);  // triggers loop
-    std::cout << "Events selected: " << *cnt << std::endl;
+    fCnt = dfSelected->Count();
+    auto snap = dfSelected->Snapshot("dfSelected",
+                    Form("%s/%s", fOutputDir.c_str(), "dfSelected.root"), cols, snapOpts);  // triggers loop unless lazy
+    if (fConcurrentSnapshots) {
+      fSnapHandles.emplace_back(*fCnt);
+      fSnapHandles.emplace_back(snap);
+    } else {
+      std::cout << "Events selected: " << *(*fCnt) << std::endl;
+    }
   }
-  if (IsReproc) SafeSnapshot(*dfSelected, "dfSelected_reproc", Form("%s/%s", fOutputDir.c_str(), "dfSelected_reproc.root"));
+  if (IsReproc) SafeSnapshot(*dfSelected, "dfSelected_reproc", Form("%s/%s", fOutputDir.c_str(), "dfSelected_reproc.root"), {"EventCutResult", "EventCutClassification", "REC_Particle_kin", "REC_Particle_corr", "REC_FiducialMasks"});
   if (fFiducialCut && dfSelected_afterFid.has_value()) {
     std::cout << "output directory is : " << fOutputDir.c_str() << std::endl;
 
     if (IsReproc) {SafeSnapshot(*dfSelected_afterFid,"dfSelected_afterFid_reprocessed",
-                                Form("%s/%s", fOutputDir.c_str(),"dfSelected_afterFid_reprocessed.root"));
+                                Form("%s/%s", fOutputDir.c_str(),"dfSelected_afterFid_reprocessed.root"), {"EventCutResult", "EventCutClassification", "REC_Particle_kin", "REC_Particle_corr", "REC_FiducialMasks"});
     } else {
       if (!IsMinBooking) {
         const std::string root_afterFid = Form("%s/%s", fOutputDir.c_str(), "dfSelected_afterFid.root");
-        auto cnt_afterFid = dfSelected_afterFid->Count();
-        dfSelected_afterFid->Snapshot("dfSelected_afterFid", root_afterFid, resolveColumns(*dfSelected_afterFid));
-        std::cout << "Events after fiducial selected: " << *cnt_afterFid << std::endl;
+        fCntAfterFid = dfSelected_afterFid->Count();
+        auto snap_afterFid = dfSelected_afterFid->Snapshot("dfSelected_afterFid", root_afterFid, resolveColumns(*dfSelected_afterFid), snapOpts);
+        if (fConcurrentSnapshots) {
+          fSnapHandles.emplace_back(*fCntAfterFid);
+          fSnapHandles.emplace_back(snap_afterFid);
+        } else {
+          std::cout << "Events after fiducial selected: " << *(*fCntAfterFid) << std::endl;
+        }
       }
     }
   }
   if (fDoMomentumCorrection && dfSelected_afterFid_afterCorr.has_value()) {
-    auto cnt_afterFid_afterCorr = dfSelected_afterFid_afterCorr->Count();
-    dfSelected_afterFid_afterCorr->Snapshot("dfSelected_afterFid_afterCorr", Form("%s/%s", fOutputDir.c_str(), "dfSelected_afterFid_afterCorr.root"), resolveColumns(*dfSelected_afterFid_afterCorr));
-    std::cout << "Events after fiducial and momentum correction selected: " << *cnt_afterFid_afterCorr << std::endl;
-    const std::string root_afterFid_afterCorr = Form("%s/%s", fOutputDir.c_str(), "dfSelected_afterFid_afterCorr.root");
-    const std::string csvpath = fOutputDir + "/events_per_run_afterFid.csv";
-    try {
-      ROOT::RDataFrame rdf_afterFid_afterCorr("dfSelected_afterFid_afterCorr", root_afterFid_afterCorr);
-      auto items = CountPerRunAndWriteCSV<int>(rdf_afterFid_afterCorr, "RUN_run", csvpath);
+    fCntAfterCorr = dfSelected_afterFid_afterCorr->Count();
+    // Streaming per-run counter booked on the same node as the snapshot: it
+    // rides the same event loop instead of re-reading the output file later.
+    fPerRunCounts = BookPerRunCount<int>(*dfSelected_afterFid_afterCorr, "RUN_run");
+    auto snap_afterCorr = dfSelected_afterFid_afterCorr->Snapshot("dfSelected_afterFid_afterCorr",
+                    Form("%s/%s", fOutputDir.c_str(), "dfSelected_afterFid_afterCorr.root"), resolveColumns(*dfSelected_afterFid_afterCorr), snapOpts);
+    if (fConcurrentSnapshots) {
+      fSnapHandles.emplace_back(*fCntAfterCorr);
+      fSnapHandles.emplace_back(*fPerRunCounts);
+      fSnapHandles.emplace_back(snap_afterCorr);
+    } else {
+      std::cout << "Events after fiducial and momentum correction selected: " << *(*fCntAfterCorr) << std::endl;
+    }
+  }
 
-      std::cout << "[INFO] Wrote per-run counts to " << csvpath << " (unique runs = " << items.size() << ")\n";
-    } catch (const std::exception& e) {
-      std::cerr << "[WARN] Failed to write per-run CSV after fiducial snapshot: " << e.what() << std::endl;
+  // Systematic variations ride the same booking: with concurrent snapshots on
+  // they join fSnapHandles and the single RunGraphs pass produces every
+  // variation output in one read of the input.
+  for (auto& [varName, varNode] : dfVariationNodes) {
+    const std::string treeName = "dfSelected_afterFid_afterCorr_" + varName;
+    const std::string filePath = fOutputDir + "/" + treeName + ".root";
+    fCntVariations.push_back(varNode.Count());
+    auto snapVar = varNode.Snapshot(treeName, filePath, resolveColumns(varNode), snapOpts);
+    if (fConcurrentSnapshots) {
+      fSnapHandles.emplace_back(fCntVariations.back());
+      fSnapHandles.emplace_back(snapVar);
+    } else {
+      std::cout << "Events selected (variation " << varName << "): " << *fCntVariations.back() << std::endl;
     }
   }
-  if (fIsQADBCut) {
-    std::cout << "\n[QADB] total accumulated charge analyzed: " << fQADBCuts->GetAccumulatedCharge() / 1e6 << " mC (Do NOT use this number if you enable MT)\n";
+
+  // Cut-flow accounting rides the same loop(s): the named-filter reports are
+  // booked lazily next to the snapshots and the per-slot mask tallies were
+  // filled inside the EventCutResult Defines.
+  if (fCutFlowReport) {
+    fCutReport = dfSelected->Report();
+    if (fConcurrentSnapshots) fSnapHandles.emplace_back(*fCutReport);
+    if (dfSelected_afterFid.has_value()) {
+      fCutReportFid = dfSelected_afterFid->Report();
+      if (fConcurrentSnapshots) fSnapHandles.emplace_back(*fCutReportFid);
+    }
   }
+  return true;
+}
+
+bool DVCSAnalysis::BookLazyOutputs(std::vector<ROOT::RDF::RResultHandle>& handles) {
+  if (fOutputWCSV) return false;  // the CSV path drives its own Foreach loop
+  fConcurrentSnapshots = true;    // the shared loop needs every action booked lazily
+  if (!BookOutputs()) return false;
+  handles.insert(handles.end(), fSnapHandles.begin(), fSnapHandles.end());
+  fOutputsBooked = true;
+  return true;
 }
 
 void DVCSAnalysis::SetOutputDir(const std::string& dir) { fOutputDir = dir; }
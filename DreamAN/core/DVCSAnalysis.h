@@ -21,6 +21,10 @@
 #include "../ParticleInformation/RECForwardTagger.h"
 #include "../core/Columns.h"
 #include "AnalysisTask.h"
+#include "PerRunCounter.h"
+#include "RunConditions.h"
+
+#include <ROOT/RCutFlowReport.hxx>
 
 class DVCSAnalysis : public AnalysisTask {
  public:
@@ -30,7 +34,17 @@ class DVCSAnalysis : public AnalysisTask {
   void UserCreateOutputObjects() override;
   void UserExec(ROOT::RDF::RNode &df) override;
   void SaveOutput() override;
+  // Shared-loop support: books every snapshot/count/report lazily (implies
+  // concurrent-snapshot mode) and hands the result handles to the manager's
+  // single RunGraphs pass; SaveOutput then only does the post-loop writes.
+  bool BookLazyOutputs(std::vector<ROOT::RDF::RResultHandle>& handles) override;
+  std::vector<std::string> RequestedColumns() const override;
   void SetMaxEvents(size_t n) { fMaxEvents = n; }
+  size_t MaxEventsHint() const override { return fMaxEvents; }
+  // Keep every Nth event instead of the first fMaxEvents: an MT-safe
+  // thinning Filter on the entry number, for quick looks that should still
+  // span the whole run range.  1 (default) keeps everything.
+  void SetSampleStride(size_t n) { fSampleStride = n; }
   // Bad for raw pointer setup
   void SetTrackCuts(std::shared_ptr<TrackCut> cuts) { fTrackCuts = std::move(cuts); };
 
@@ -45,19 +59,66 @@ class DVCSAnalysis : public AnalysisTask {
 
   void SetFTonConfig(bool config) { fFTonConfig = config; }
 
+  // Per-run conditions table: the beam energy is looked up per event from
+  // RUN_run (exposed as the RUN_beam_energy column and used by the W CSV
+  // output), so one pass can consume a file list spanning several beam
+  // periods.  FT on/off decides which banks are read at graph construction,
+  // so it becomes the superset over the table's periods; fbeam_energy stays
+  // the fallback for runs outside the table.
+  void SetRunConditions(std::shared_ptr<const RunConditions> conditions) {
+    fRunConditions = std::move(conditions);
+    if (fRunConditions && !fRunConditions->Empty()) fFTonConfig = fRunConditions->AnyFTon();
+  }
+
   void SetDoMomentumCorrection(bool do_correction) { fDoMomentumCorrection = do_correction; }
   void SetMomentumCorrection(std::shared_ptr<MomentumCorrection> corr) { fMomCorr = std::move(corr); }
 
+  // One named systematic variation.  Any member left null falls back to the
+  // nominal object, so a fiducial variation only carries its own TrackCut.
+  struct SystematicVariation {
+    std::string name;
+    std::shared_ptr<TrackCut> trackCuts;
+    std::shared_ptr<EventCut> eventCuts;
+    std::shared_ptr<MomentumCorrection> momCorr;
+  };
+
+  // Register a variation to be evaluated alongside the nominal selection.
+  // Each variation branches off the shared Defines with its own pass masks
+  // and writes dfSelected_afterFid_afterCorr_<name>.root; combined with
+  // SetConcurrentSnapshots(true) the whole fan-out is a single read of the
+  // input instead of one full job per toggled parameter.
+  void AddSystematicVariation(const std::string& name,
+                              std::shared_ptr<TrackCut> trackCuts = nullptr,
+                              std::shared_ptr<EventCut> eventCuts = nullptr,
+                              std::shared_ptr<MomentumCorrection> momCorr = nullptr);
+
   void SetQADBCuts(std::shared_ptr<QADBCuts> qadbcuts){ fQADBCuts = std::move(qadbcuts); };
   void SetDoQADBCuts(bool charge_output) { fIsQADBCut = charge_output; }
 
   void SetOptimizeColumns(bool optimize) { fOptimizeColumns = optimize; }
+  void SetConcurrentSnapshots(bool concurrent) { fConcurrentSnapshots = concurrent; }
+  // Cut-flow accounting gathered during the physics event loop: pass/all for
+  // every named Filter plus per-particle tallies of the EventCutResult masks,
+  // written to <outputDir>/cutflow_report.csv at SaveOutput.  Replaces the
+  // dedicated counting jobs used to build N-1 tables.
+  void SetCutFlowReport(bool enable) { fCutFlowReport = enable; }
+  // Derived-column reuse for reprocess iterations: snapshots additionally
+  // persist the fiducial pass-mask columns together with the fingerprint of
+  // the TrackCut that produced them (<outputDir>/derived_columns.txt).  When
+  // reprocessing with an unchanged fingerprint the masks are read back from
+  // the input instead of re-walking the trajectory/calorimeter/FT banks, so
+  // an iteration that only changes an event cut pays only for that cut.
+  void SetDerivedColumnSidecar(bool enable) { fDerivedSidecar = enable; }
   void SetOutputWCSV(bool output) { fOutputWCSV = output; }
   void SetOutputWCSVName(const std::string& name) { fOutputWCSVName = name; }
 
  private:
   std::vector<std::string> MinimalColumns() const;
   void WriteFinalElectronWCSV(ROOT::RDF::RNode df, const std::string& csvPath);
+  // Books the snapshots, counts, per-run counter, variations and cut-flow
+  // reports (lazily in concurrent-snapshot mode, eagerly otherwise) into the
+  // fBooked* members below.  Returns false when there is nothing to book.
+  bool BookOutputs();
   bool IsMC = false;
   bool fDoInvMassCut = false;  // Flag to indicate if invMass cut is applied
   bool fAcceptAll = false;  // Flag to indicate if all events are accepted without cuts
@@ -67,22 +128,54 @@ class DVCSAnalysis : public AnalysisTask {
   bool fFTonConfig = true;
   bool fDoMomentumCorrection = false;  // Flag to indicate if momentum correction is applied
   bool fOptimizeColumns = false;  // Flag to indicate if column optimization is enabled
+  bool fConcurrentSnapshots = false;  // Book all snapshots lazily and drive them with RunGraphs (single read of the input)
   bool fOutputWCSV = false;  // Output final corrected electron W CSV and skip ROOT snapshots
   std::string fOutputWCSVName = "electron_w_afterCorr.csv";
+  bool fDerivedSidecar = false;  // persist/reuse fiducial masks across reprocess iterations
+  std::string fFiducialFingerprint;  // TrackCut fingerprint recorded at SaveOutput
 
   bool fIsQADBCut = false;  // Flag to indicate if QADB cut is applied
   bool fChargeOutput = false; // Flag to indicate if output the accumulated charge from QADB
 
   size_t fMaxEvents{0}; // Maximum number of events to process, 0 means no limit
+  size_t fSampleStride{1}; // Keep every Nth event, 1 means keep all
 
   std::optional<ROOT::RDF::RNode> dforginal;
 
   std::optional<ROOT::RDF::RNode> dfSelected;
   std::optional<ROOT::RDF::RNode> dfSelected_afterFid;  // DataFrame after fiducial cuts
   std::optional<ROOT::RDF::RNode> dfSelected_afterFid_afterCorr;  // DataFrame after fiducial cuts and momentum correction
+
+  std::vector<SystematicVariation> fVariations;  // registered systematic variations
+  std::vector<std::pair<std::string, ROOT::RDF::RNode>> dfVariationNodes;  // per-variation final nodes, built in UserExec
+
+  // Per-slot tallies of the per-particle masks in EventCutResult (one entry
+  // per RDF slot, written without synchronisation, summed at SaveOutput).
+  struct CutFlowTally {
+    unsigned long long events = 0;
+    unsigned long long eventPass = 0;
+    unsigned long long particles = 0;
+    unsigned long long particlePass = 0;
+    unsigned long long photonMaxEPass = 0;
+    unsigned long long daughterPass = 0;
+  };
+  bool fCutFlowReport = false;
+  std::shared_ptr<std::vector<CutFlowTally>> fCutFlowNoFid;
+  std::shared_ptr<std::vector<CutFlowTally>> fCutFlowFid;
   std::string fOutputDir;
+
+  // Results booked by BookOutputs() and consumed by the post-loop section of
+  // SaveOutput().  In shared-loop mode the manager's RunGraphs materializes
+  // fSnapHandles before SaveOutput runs (fOutputsBooked marks that case).
+  std::vector<ROOT::RDF::RResultHandle> fSnapHandles;
+  std::optional<ROOT::RDF::RResultPtr<ULong64_t>> fCnt, fCntAfterFid, fCntAfterCorr;
+  std::vector<ROOT::RDF::RResultPtr<ULong64_t>> fCntVariations;
+  std::optional<ROOT::RDF::RResultPtr<PerRunCountAction<int>::Result_t>> fPerRunCounts;
+  std::optional<ROOT::RDF::RResultPtr<ROOT::RDF::RCutFlowReport>> fCutReport, fCutReportFid;
+  bool fOutputsBooked = false;
   
   float fbeam_energy = 10.6;
+  std::shared_ptr<const RunConditions> fRunConditions;
   
   TH1F *fHistPhotonP = nullptr;
 
@@ -1,8 +1,21 @@
 #include "EventProcessor.h"
+#include "ProgressMonitor.h"
+#include "RemoteInput.h"
 
+#include <TFileMerger.h>
+#include <TROOT.h>
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <thread>
 
-EventProcessor::EventProcessor(AnalysisTaskManager& taskMgr, const std::string& inputDirectory,const std::string& OuptpuDirectory, bool fIsReprocessRootFile, const std::string& fInputROOTtreeName, const std::string& fInputROOTfileName, int nfiles, const int nthreads ) : evt(inputDirectory, OuptpuDirectory,fIsReprocessRootFile, fInputROOTtreeName, fInputROOTfileName, nfiles, nthreads), tasks(taskMgr) {}
+EventProcessor::EventProcessor(AnalysisTaskManager& taskMgr, const std::string& inputDirectory,const std::string& OuptpuDirectory, bool fIsReprocessRootFile, const std::string& fInputROOTtreeName, const std::string& fInputROOTfileName, int nfiles, const int nthreads, int shardIndex, int nShards, bool useColumnarCache ) : evt(inputDirectory, OuptpuDirectory,fIsReprocessRootFile, fInputROOTtreeName, fInputROOTfileName, nfiles, nthreads, taskMgr.RequestedColumns(), shardIndex, nShards, true, static_cast<long>(taskMgr.MaxEventsHint()), useColumnarCache), tasks(taskMgr) {}
 
 void EventProcessor::ProcessEvents() {
   auto dfOpt = evt.getNode();
@@ -15,9 +28,237 @@ void EventProcessor::ProcessEvents() {
 
   ROOT::RDF::RNode df = dfOpt.value();
 
+  // Progress reporting: a pass-through Filter bumps a shared relaxed atomic
+  // per event and a reporter thread prints a periodic line with rate and ETA.
+  // The denominator comes from the header-only event census (unknown in
+  // reprocess mode, where the line falls back to counts only).
+  std::unique_ptr<ProgressMonitor> progress;
+  if (fProgressInterval > 0) {
+    progress = std::make_unique<ProgressMonitor>(evt.CountTotalEventsFast(),
+                                                 evt.getFileCount(), fProgressInterval);
+    auto counter = progress->Counter();
+    df = df.Filter([counter] {
+      counter->fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }, {}, "progress counter");
+    progress->Start();
+  }
+
   tasks.UserCreateOutputObjects();
   tasks.Execute(df);
   tasks.SaveOutput();
 
+  if (progress) progress->Stop();
+
   std::cout << "[EventProcessor] Finished processing all events." << std::endl;
-}
\ No newline at end of file
+}
+
+bool EventProcessor::ProcessEventsWithCheckpoints(AnalysisTaskManager& taskMgr,
+                                                  const std::string& inputDirectory,
+                                                  const std::string& outputDirectory,
+                                                  int nfiles, int nthreads,
+                                                  int filesPerGroup,
+                                                  const std::vector<std::string>& outputFileNames) {
+  namespace fs = std::filesystem;
+
+  // Remote datasets (a URL or a .list/.txt of URLs) are processed group by
+  // group through the stager: the current group is staged into the local
+  // cache and the next one prefetches in the background while the event loop
+  // runs, so the transfer latency hides behind the computation.  The ledger
+  // records the URLs, not the cache paths, so restarts stay stable.
+  std::vector<std::string> files;
+  std::unique_ptr<RemoteInputStager> stager;
+  {
+    const fs::path ip(inputDirectory);
+    if (IsRemoteInputUrl(inputDirectory)) {
+      files.push_back(inputDirectory);
+    } else if (ip.extension() == ".list" || ip.extension() == ".txt") {
+      files = ReadInputUrlList(inputDirectory, nfiles);
+    }
+    if (!files.empty()) {
+      stager = std::make_unique<RemoteInputStager>(
+          (fs::path(outputDirectory) / "remote_cache").string());
+    } else {
+      files = Events::getHipoFilesInPath(inputDirectory, nfiles);
+    }
+  }
+  if (files.empty()) {
+    std::cerr << "[Checkpoint] No .hipo files found in " << inputDirectory << "\n";
+    return false;
+  }
+  // Group membership must be identical across restarts, so order by path —
+  // not by size, which could change if a file is re-copied.
+  std::sort(files.begin(), files.end());
+
+  if (filesPerGroup < 1) filesPerGroup = 1;
+  const int nGroups = static_cast<int>((files.size() + filesPerGroup - 1) / filesPerGroup);
+
+  std::error_code ec;
+  fs::create_directories(outputDirectory, ec);
+  const std::string ledgerPath = (fs::path(outputDirectory) / "checkpoint_ledger.txt").string();
+
+  // A ledger line records the group index and its exact file list; a group is
+  // only skipped when the line matches, so a changed dataset reprocesses.
+  std::set<std::string> completed;
+  {
+    std::ifstream in(ledgerPath);
+    for (std::string line; std::getline(in, line);) {
+      if (!line.empty()) completed.insert(line);
+    }
+  }
+  if (!completed.empty()) {
+    std::cout << "[Checkpoint] Ledger " << ledgerPath << " lists " << completed.size()
+              << " completed group(s)\n";
+  }
+
+  auto groupSlice = [&](int g) {
+    const size_t begin = static_cast<size_t>(g) * filesPerGroup;
+    const size_t end = std::min(files.size(), begin + filesPerGroup);
+    return std::vector<std::string>(files.begin() + begin, files.begin() + end);
+  };
+  auto ledgerLineFor = [](int g, const std::vector<std::string>& groupFiles) {
+    std::ostringstream entry;
+    entry << "group_" << g;
+    for (const auto& f : groupFiles) entry << ' ' << f;
+    return entry.str();
+  };
+
+  std::vector<std::string> groupDirs;
+  groupDirs.reserve(nGroups);
+
+  for (int g = 0; g < nGroups; ++g) {
+    const std::vector<std::string> groupFiles = groupSlice(g);
+    const std::string ledgerLine = ledgerLineFor(g, groupFiles);
+
+    const std::string groupDir = (fs::path(outputDirectory) / ("group_" + std::to_string(g))).string();
+    groupDirs.push_back(groupDir);
+
+    if (completed.count(ledgerLine)) {
+      std::cout << "[Checkpoint] group_" << g << " already done, skipping "
+                << groupFiles.size() << " file(s)\n";
+      continue;
+    }
+
+    std::cout << "[Checkpoint] Processing group_" << g << " (" << groupFiles.size()
+              << " file(s))\n";
+    fs::create_directories(groupDir, ec);
+    if (ec) {
+      std::cerr << "[Checkpoint] Cannot create " << groupDir << ": " << ec.message() << "\n";
+      return false;
+    }
+
+    // Stage this group (a cache hit when the previous iteration prefetched
+    // it) and immediately start pulling the next unprocessed group, so the
+    // transfer of group g+1 overlaps the event loop of group g.
+    std::vector<std::string> groupLocal = groupFiles;
+    if (stager) {
+      stager->Wait();
+      groupLocal = stager->Stage(groupFiles);
+      for (int h = g + 1; h < nGroups; ++h) {
+        auto nextFiles = groupSlice(h);
+        if (completed.count(ledgerLineFor(h, nextFiles))) continue;
+        stager->PrefetchAsync(std::move(nextFiles));
+        break;
+      }
+      if (groupLocal.empty()) {
+        std::cerr << "[Checkpoint] group_" << g << ": no inputs could be staged\n";
+        return false;
+      }
+    }
+
+    try {
+      Events groupEvt(groupLocal, groupDir, nthreads, taskMgr.RequestedColumns());
+      auto dfOpt = groupEvt.getNode();
+      if (!dfOpt.has_value()) {
+        std::cerr << "[Checkpoint] group_" << g << ": no dataframe\n";
+        return false;
+      }
+      ROOT::RDF::RNode df = dfOpt.value();
+
+      taskMgr.SetOututDir(groupDir);
+      taskMgr.UserCreateOutputObjects();
+      taskMgr.Execute(df);
+      taskMgr.SaveOutput();
+    } catch (const std::exception& e) {
+      std::cerr << "[Checkpoint] group_" << g << " failed: " << e.what() << "\n";
+      return false;
+    }
+
+    // The group's outputs are on disk — commit it to the ledger before
+    // touching the next one.
+    std::ofstream ledger(ledgerPath, std::ios::app);
+    ledger << ledgerLine << '\n';
+    ledger.flush();
+    if (!ledger) {
+      std::cerr << "[Checkpoint] Cannot append to " << ledgerPath << "\n";
+      return false;
+    }
+  }
+
+  taskMgr.SetOututDir(outputDirectory);
+  std::cout << "[Checkpoint] All " << nGroups << " group(s) done; stitching partial outputs\n";
+  return MergeShardOutputs(groupDirs, outputDirectory, outputFileNames);
+}
+
+bool EventProcessor::MergeShardOutputs(const std::vector<std::string>& shardDirs,
+                                       const std::string& mergedDir,
+                                       const std::vector<std::string>& rootFileNames) {
+  namespace fs = std::filesystem;
+
+  std::error_code ec;
+  fs::create_directories(mergedDir, ec);
+  if (ec) {
+    std::cerr << "[MergeShardOutputs] Cannot create " << mergedDir << ": " << ec.message() << "\n";
+    return false;
+  }
+
+  // One TFileMerger per thread; EnableThreadSafety covers the shared ROOT
+  // bookkeeping underneath, as hadd -j does.
+  ROOT::EnableThreadSafety();
+
+  std::atomic<bool> allOk{true};
+  std::vector<std::thread> workers;
+  workers.reserve(rootFileNames.size());
+
+  for (const auto& name : rootFileNames) {
+    workers.emplace_back([&shardDirs, &mergedDir, name, &allOk]() {
+      TFileMerger merger(/*isLocal=*/kFALSE);
+      const std::string target = (fs::path(mergedDir) / name).string();
+      if (!merger.OutputFile(target.c_str(), /*force=*/kTRUE)) {
+        std::cerr << "[MergeShardOutputs] Cannot open output " << target << "\n";
+        allOk = false;
+        return;
+      }
+
+      int added = 0;
+      for (const auto& dir : shardDirs) {
+        const std::string input = (fs::path(dir) / name).string();
+        std::error_code fec;
+        if (!fs::exists(input, fec)) {
+          std::cerr << "[MergeShardOutputs] Warning: missing " << input << ", skipped\n";
+          continue;
+        }
+        if (!merger.AddFile(input.c_str())) {
+          std::cerr << "[MergeShardOutputs] Cannot add " << input << "\n";
+          allOk = false;
+          return;
+        }
+        ++added;
+      }
+
+      if (added == 0) {
+        std::cerr << "[MergeShardOutputs] No shard produced " << name << ", skipped\n";
+        return;
+      }
+      if (!merger.Merge()) {
+        std::cerr << "[MergeShardOutputs] Merge failed for " << name << "\n";
+        allOk = false;
+        return;
+      }
+      std::cout << "[MergeShardOutputs] Merged " << added << " shard file(s) into " << target << "\n";
+    });
+  }
+
+  for (auto& w : workers) w.join();
+  return allOk;
+}
@@ -3,23 +3,61 @@
 #include "TROOT.h"
 
 #include "Events.h"
-
+#include "ColumnarCache.h"
+#include "ColumnPrunedHipoDS.h"
+#include "InputManifest.h"
+#include "PipelineTimer.h"
+#include "RemoteInput.h"
+#include "RunEventColumns.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <thread>
 
 namespace fs = std::filesystem;
 
+namespace {
+// Cache location and budget for staged remote inputs: DISANA_REMOTE_CACHE
+// overrides the directory (a fast scratch area shared between jobs),
+// DISANA_REMOTE_CACHE_GB sets the LRU eviction budget (unset/0 keeps
+// everything).
+std::string RemoteCacheDir(const std::string& outputDir) {
+  if (const char* env = std::getenv("DISANA_REMOTE_CACHE")) return env;
+  return (fs::path(outputDir) / "remote_cache").string();
+}
+
+std::uintmax_t RemoteCacheBudget() {
+  if (const char* env = std::getenv("DISANA_REMOTE_CACHE_GB")) {
+    const long gb = std::atol(env);
+    if (gb > 0) return static_cast<std::uintmax_t>(gb) << 30;
+  }
+  return 0;
+}
+}  // namespace
+
 Events::Events(const std::string& directory, const std::string& outputDirectory,
                bool fIsReprocessRootFile,
                const std::string& fInputROOTtreeName,
                const std::string& fOutputROOTfileName,
-               int nfiles, int nthreads)
+               int nfiles, int nthreads,
+               const std::vector<std::string>& requestedColumns,
+               int shardIndex, int nShards, bool balanceInputFiles,
+               long maxEventsHint, bool useColumnarCache, long ioChunkBytes)
   : fOutputDir_(outputDirectory),
     fIsReprocessRootFile_(fIsReprocessRootFile),
     fnfiles_(nfiles),
     fnthreads_(nthreads),
+    fIoChunkBytes_(ioChunkBytes),
     fInputROOTtreeName_(fInputROOTtreeName),
     fOutputROOTfileName_(fOutputROOTfileName)
 {
@@ -28,6 +66,31 @@ Events::Events(const std::string& directory, const std::string& outputDirectory,
     // REPROCESS MODE: read an existing ROOT file / tree
     // ------------------------------------------------------------------------
     if (fIsReprocessRootFile_) {
+      if (IsRemoteInputUrl(directory)) {
+        // Remote reprocess inputs stream through ROOT's XRootD/HTTP clients,
+        // whose TTreeCache read-ahead already overlaps transfer with the
+        // event loop — no staging, and the mmap columnar cache does not apply.
+        finalInputPath_ = directory;
+        if (finalInputPath_.back() != '/') finalInputPath_ += '/';
+        finalInputPath_ += fOutputROOTfileName_;
+
+        fileCount_ = 0;
+        std::cout << "[Events] Streaming remote ROOT file: " << finalInputPath_ << "\n";
+
+        if (fnthreads_ == 0) {
+          ROOT::EnableImplicitMT();
+        } else if (fnthreads_ > 1) {
+          ROOT::EnableImplicitMT(fnthreads_);
+        }
+
+        auto rdf = ROOT::RDataFrame(
+            fInputROOTtreeName_.empty() ? "hipo" : fInputROOTtreeName_, finalInputPath_);
+        dfNode_.emplace(NormalizeRunEventColumns(ROOT::RDF::RNode(rdf)));
+
+        std::cout << "[Events] DataFrame initialized successfully.\n";
+        return;
+      }
+
       finalInputPath_ = (fs::path(directory) / fOutputROOTfileName_).string();
       if (!fs::exists(finalInputPath_)) {
         throw std::runtime_error("Reprocess mode: ROOT file not found: " + finalInputPath_);
@@ -36,19 +99,53 @@ Events::Events(const std::string& directory, const std::string& outputDirectory,
       fileCount_ = 0;
       std::cout << "[Events] Reprocessing existing ROOT file: " << finalInputPath_ << "\n";
 
+      const std::string treeName =
+        fInputROOTtreeName_.empty()
+          ? "hipo"
+          : fInputROOTtreeName_;
+
+      // Columnar cache: materialize the branches into mmap-able flat arrays
+      // on the first pass (single-threaded TTree walk, before IMT goes on),
+      // then serve every later iteration from the mapping.
+      if (useColumnarCache) {
+        const std::string cacheDir = (fs::path(directory) / "colcache").string();
+        bool haveCache = MMapColumnCacheDS::IsValid(cacheDir, finalInputPath_);
+        if (!haveCache) {
+          std::cout << "[Events] Columnar cache missing or stale — materializing " << cacheDir << " ...\n";
+          haveCache = MMapColumnCacheDS::Build(finalInputPath_, treeName, cacheDir);
+        }
+        if (haveCache) {
+          try {
+            auto cacheDS = std::make_unique<MMapColumnCacheDS>(cacheDir);
+            if (fnthreads_ == 0) {
+              ROOT::EnableImplicitMT();
+            } else if (fnthreads_ > 1) {
+              ROOT::EnableImplicitMT(fnthreads_);
+            }
+            std::cout << "[Events] Serving " << cacheDS->GetColumnNames().size()
+                      << " column(s) from the columnar cache: " << cacheDir << "\n";
+            auto rdf = ROOT::RDataFrame(std::move(cacheDS));
+            dfNode_.emplace(NormalizeRunEventColumns(ROOT::RDF::RNode(rdf)));
+            std::cout << "[Events] DataFrame initialized successfully.\n";
+            return;
+          } catch (const std::exception& e) {
+            std::cerr << "[Events] Columnar cache unusable (" << e.what()
+                      << ") — falling back to the ROOT file.\n";
+          }
+        }
+      }
+
       if (fnthreads_ == 0) {
         ROOT::EnableImplicitMT();
       } else if (fnthreads_ > 1) {
         ROOT::EnableImplicitMT(fnthreads_);
       }
 
-      const std::string treeName =
-        fInputROOTtreeName_.empty()
-          ? "hipo"
-          : fInputROOTtreeName_;
-
+      // The dataset-name constructor reads back both TTree and RNTuple
+      // outputs: any ROOT recent enough to have written an RNTuple snapshot
+      // (SetUseRNTuple on the task manager) auto-detects the format here.
       auto rdf = ROOT::RDataFrame(treeName, finalInputPath_);
-      dfNode_.emplace(rdf);
+      dfNode_.emplace(NormalizeRunEventColumns(ROOT::RDF::RNode(rdf)));
 
       std::cout << "[Events] DataFrame initialized successfully.\n";
       return;
@@ -58,33 +155,79 @@ Events::Events(const std::string& directory, const std::string& outputDirectory,
     // HIPO MODE: use RHipoDS directly
     // ------------------------------------------------------------------------
 
-    // Collect .hipo input files
-    inputFiles = this->getHipoFilesInPath(directory, nfiles);
+    // Collect .hipo input files.  A remote URL, or a .list/.txt file of
+    // paths and URLs, is staged through the local cache first (bounded
+    // parallel transfer streams, optional LRU eviction) — the HIPO reader
+    // needs seekable local files.
+    std::vector<std::string> remoteInputs;
+    if (IsRemoteInputUrl(directory)) {
+      remoteInputs.push_back(directory);
+    } else {
+      const fs::path p(directory);
+      if (p.extension() == ".list" || p.extension() == ".txt") {
+        remoteInputs = ReadInputUrlList(directory, nfiles);
+      }
+    }
+    if (!remoteInputs.empty()) {
+      RemoteInputStager stager(RemoteCacheDir(fOutputDir_),
+                               /*maxConcurrentFetches=*/4, RemoteCacheBudget());
+      inputFiles = stager.Stage(remoteInputs);
+    } else {
+      inputFiles = getHipoFilesInPath(directory, nfiles);
+    }
 
     if (inputFiles.empty()) {
       throw std::runtime_error("No .hipo files found in directory: " + directory);
     }
+
+    if (nShards > 1) {
+      if (shardIndex < 0 || shardIndex >= nShards) {
+        throw std::runtime_error("Shard index " + std::to_string(shardIndex) +
+                                 " out of range for " + std::to_string(nShards) + " shards");
+      }
+      inputFiles = ShardFiles(std::move(inputFiles), shardIndex, nShards);
+      std::cout << "[Events] Shard " << shardIndex << "/" << nShards
+                << ": processing " << inputFiles.size() << " file(s)\n";
+      if (inputFiles.empty()) {
+        throw std::runtime_error("Shard " + std::to_string(shardIndex) +
+                                 " received no files (more shards than inputs?)");
+      }
+    } else if (balanceInputFiles && inputFiles.size() > 1) {
+      // ShardFiles already emits its subset largest-first; do the same for
+      // the unsharded path so IMT schedules the big files first.
+      inputFiles = SortBySizeDescending(std::move(inputFiles));
+    }
+    if (maxEventsHint > 0) {
+      inputFiles = TrimToEventBudget(std::move(inputFiles), maxEventsHint);
+    }
     for (const auto& file : inputFiles) {
         std::cout << "Input file: " << file << std::endl;
     }
 
-    fileCount_ = inputFiles.size();
-    finalInputPath_.clear();
+    InitHipoDataFrame(requestedColumns);
+  }
+  catch (const std::exception& e) {
+    std::cerr << "[Events] ERROR: " << e.what() << std::endl;
+    throw;
+  }
+}
 
-    // Enable ROOT MT
-    if (fnthreads_ == 1) {
-      ROOT::EnableImplicitMT(1);
-    } else if (fnthreads_ > 1) {
-      ROOT::EnableImplicitMT(fnthreads_);
+Events::Events(const std::vector<std::string>& hipoFiles,
+               const std::string& outputDirectory,
+               int nthreads,
+               const std::vector<std::string>& requestedColumns,
+               long ioChunkBytes)
+  : fOutputDir_(outputDirectory),
+    fnfiles_(static_cast<int>(hipoFiles.size())),
+    fnthreads_(nthreads),
+    fIoChunkBytes_(ioChunkBytes)
+{
+  try {
+    if (hipoFiles.empty()) {
+      throw std::runtime_error("Events: empty .hipo file list");
     }
-
-    std::cout << "[Events] Creating RHipoDS from " << inputFiles.size() << " input file(s)...\n";
-    dataSource = std::make_unique<RHipoDS>(inputFiles, 1000000);
-
-    auto rdf = ROOT::RDataFrame(std::move(dataSource));
-    dfNode_.emplace(rdf);
-
-    std::cout << "[Events] DataFrame initialized successfully.\n";
+    inputFiles = hipoFiles;
+    InitHipoDataFrame(requestedColumns);
   }
   catch (const std::exception& e) {
     std::cerr << "[Events] ERROR: " << e.what() << std::endl;
@@ -92,6 +235,357 @@ Events::Events(const std::string& directory, const std::string& outputDirectory,
   }
 }
 
+// Shared tail of the HIPO-mode constructors: MT setup and datasource
+// creation over the already-selected inputFiles.
+void Events::InitHipoDataFrame(const std::vector<std::string>& requestedColumns) {
+  fileCount_ = inputFiles.size();
+  finalInputPath_.clear();
+
+  // Enable ROOT MT
+  if (fnthreads_ == 1) {
+    ROOT::EnableImplicitMT(1);
+  } else if (fnthreads_ > 1) {
+    ROOT::EnableImplicitMT(fnthreads_);
+  }
+
+  // Bytes read per input file for the timing report (no-op while disabled).
+  if (PipelineTimer::Instance().Enabled()) {
+    for (const auto& f : inputFiles) {
+      std::error_code ec;
+      const auto size = fs::file_size(f, ec);
+      PipelineTimer::Instance().RecordInputFile(f, ec ? 0 : size);
+    }
+  }
+
+  std::cout << "[Events] Creating RHipoDS from " << inputFiles.size() << " input file(s)...\n";
+  const long chunkEvents = AdaptiveChunkEvents();
+  if (requestedColumns.empty()) {
+    dataSource = std::make_unique<RHipoDS>(inputFiles, chunkEvents);
+  } else {
+    // Advertise only the banks the tasks asked for, so unused banks are
+    // never decoded during the event loop.
+    auto pruned = std::make_unique<ColumnPrunedHipoDS>(inputFiles, chunkEvents, requestedColumns);
+    std::cout << "[Events] Column pruning: keeping " << pruned->GetColumnNames().size()
+              << " of " << pruned->FullColumnCount() << " datasource columns\n";
+    dataSource = std::move(pruned);
+  }
+
+  auto rdf = ROOT::RDataFrame(std::move(dataSource));
+  // Canonical run/event schema: downstream code (QADB, per-run counters)
+  // compiles once against scalar int RUN_run / RUN_event regardless of how
+  // the source spells or types them.
+  dfNode_.emplace(NormalizeRunEventColumns(ROOT::RDF::RNode(rdf)));
+
+  std::cout << "[Events] DataFrame initialized successfully.\n";
+}
+
+namespace {
+struct FileSizeEntry { std::uintmax_t size; std::string path; };
+
+// Stats every file and orders the list largest-first.  File size is the
+// balancing proxy: HIPO record counts would be exact but need a full reader
+// pass per file, and compressed bytes track event counts closely enough.
+std::vector<FileSizeEntry> StatAndSortBySize(std::vector<std::string> files) {
+  std::vector<FileSizeEntry> entries;
+  entries.reserve(files.size());
+  for (auto& f : files) {
+    std::error_code ec;
+    const auto size = fs::file_size(f, ec);
+    entries.push_back({ec ? 0 : size, std::move(f)});
+  }
+  std::sort(entries.begin(), entries.end(), [](const FileSizeEntry& a, const FileSizeEntry& b) {
+    if (a.size != b.size) return a.size > b.size;
+    return a.path < b.path;  // tie-break for a stable order across jobs
+  });
+  return entries;
+}
+}  // namespace
+
+// Largest-first ordering for the datasource: IMT hands out whole files, so
+// starting the big ones first keeps every thread busy until the end instead
+// of leaving one thread alone on a multi-GB straggler.
+std::vector<std::string> Events::SortBySizeDescending(std::vector<std::string> files) {
+  auto entries = StatAndSortBySize(std::move(files));
+  std::vector<std::string> ordered;
+  ordered.reserve(entries.size());
+  for (auto& e : entries) ordered.push_back(std::move(e.path));
+  return ordered;
+}
+
+// Deterministic size-balanced partitioning: sort the files largest-first and
+// greedily assign each to the shard with the fewest bytes so far (LPT
+// scheduling).  Every cooperating job sees the same file list and therefore
+// computes the same assignment — no coordination needed — and size imbalance
+// between shards stays within one file.
+std::vector<std::string> Events::ShardFiles(std::vector<std::string> files,
+                                            int shardIndex, int nShards) {
+  auto entries = StatAndSortBySize(std::move(files));
+
+  std::vector<std::uintmax_t> shardBytes(nShards, 0);
+  std::vector<std::string> mine;
+  for (auto& e : entries) {
+    int lightest = 0;
+    for (int s = 1; s < nShards; ++s) {
+      if (shardBytes[s] < shardBytes[lightest]) lightest = s;
+    }
+    shardBytes[lightest] += e.size;
+    if (lightest == shardIndex) mine.push_back(std::move(e.path));
+  }
+  return mine;
+}
+
+namespace {
+// HIPO4 files use the EVIO-6 record layout: a 14-word file header, then a
+// chain of records whose 14-word headers carry the total record length
+// (word 0, in 32-bit words), the event count (word 3) and a magic number
+// (word 7, 0xc0da0100).  Walking the chain with seeks — read 56 bytes,
+// jump to the next record — yields the exact event count without ever
+// decompressing a payload or decoding a bank.  Returns -1 if the file
+// cannot be read or is not a HIPO/EVIO-6 file.
+long CountEventsInHipoFile(const std::string& path) {
+  constexpr std::uint32_t kMagic = 0xc0da0100u;
+  constexpr int kHeaderWords = 14;
+  constexpr std::uint32_t kLastRecordBit = 0x200u;  // bit-info "trailer" flag
+
+  std::ifstream in(path, std::ios::binary);
+  if (!in) return -1;
+
+  std::uint32_t header[kHeaderWords];
+  auto readHeader = [&]() -> bool {
+    in.read(reinterpret_cast<char*>(header), sizeof(header));
+    return static_cast<bool>(in);
+  };
+
+  if (!readHeader()) return -1;
+
+  // The magic word doubles as the endianness probe.
+  bool swapped = false;
+  if (header[7] != kMagic) {
+    if (__builtin_bswap32(header[7]) != kMagic) return -1;
+    swapped = true;
+  }
+  auto word = [&](int i) -> std::uint32_t {
+    return swapped ? __builtin_bswap32(header[i]) : header[i];
+  };
+
+  // Skip the remainder of the file header: declared header length (word 2,
+  // in words) plus the index array and user-header payloads (words 4 and 6,
+  // in bytes; the writer pads both to word boundaries).  The HIPO schema
+  // dictionary lives in that user header, so it is skipped, not counted.
+  std::streamoff next = static_cast<std::streamoff>(word(2)) * 4 +
+                        word(4) + word(6);
+  long events = 0;
+
+  for (;;) {
+    in.seekg(next, std::ios::beg);
+    if (!readHeader()) break;                 // clean EOF after last record
+    if (word(7) != kMagic) break;             // corrupt/truncated tail
+    const std::uint32_t recordWords = word(0);
+    if (recordWords < static_cast<std::uint32_t>(kHeaderWords)) break;
+    if (word(5) & kLastRecordBit) break;      // trailer: index only, no events
+    events += static_cast<long>(word(3));
+    next += static_cast<std::streamoff>(recordWords) * 4;
+  }
+
+  return events;
+}
+
+// Manifest-aware census: files already listed in a loaded (or freshly
+// written) manifest skip the record-header walk.
+long EventCountFor(const std::string& file) {
+  if (auto cached = InputManifest::CachedEventCount(file)) return *cached;
+  return CountEventsInHipoFile(file);
+}
+
+// Recursive .hipo listing with a parallel work queue of directories: each
+// worker lists one directory per round and feeds the subdirectories back, so
+// the per-entry stat latency of a networked filesystem is overlapped instead
+// of serialized.  The result is sorted, so discovery order (and with it the
+// shard assignment) is independent of traversal interleaving.
+std::vector<std::string> DiscoverHipoFilesParallel(const fs::path& root) {
+  std::deque<fs::path> queue{root};
+  std::vector<std::string> found;
+  std::mutex mtx;
+  std::condition_variable cv;
+  int active = 0;  // directories currently being listed
+
+  auto worker = [&]() {
+    std::unique_lock<std::mutex> lock(mtx);
+    for (;;) {
+      cv.wait(lock, [&] { return !queue.empty() || active == 0; });
+      if (queue.empty()) {
+        if (active == 0) return;  // no work left anywhere
+        continue;
+      }
+      fs::path dir = std::move(queue.front());
+      queue.pop_front();
+      ++active;
+      lock.unlock();
+
+      std::vector<fs::path> subdirs;
+      std::vector<std::string> local;
+      std::error_code ec;
+      for (fs::directory_iterator it(dir, fs::directory_options::skip_permission_denied, ec), end; !ec && it != end; it.increment(ec)) {
+        const fs::directory_entry& de = *it;
+        std::error_code tec;
+        if (de.is_directory(tec)) {
+          subdirs.push_back(de.path());
+        } else if (de.is_regular_file(tec) && de.path().extension() == ".hipo") {
+          local.push_back(de.path().string());
+        }
+      }
+
+      lock.lock();
+      for (auto& d : subdirs) queue.push_back(std::move(d));
+      found.insert(found.end(), std::make_move_iterator(local.begin()), std::make_move_iterator(local.end()));
+      --active;
+      cv.notify_all();
+    }
+  };
+
+  const unsigned hw = std::thread::hardware_concurrency();
+  const unsigned nWorkers = std::min(hw ? hw : 2u, 16u);
+  std::vector<std::thread> threads;
+  threads.reserve(nWorkers);
+  for (unsigned i = 0; i < nWorkers; ++i) threads.emplace_back(worker);
+  for (auto& t : threads) t.join();
+
+  std::sort(found.begin(), found.end());
+  return found;
+}
+
+// One stat plus record-header census per discovered file, in parallel, for
+// the manifest the next job reuses.
+std::vector<InputManifest::Entry> BuildManifestEntries(const std::vector<std::string>& files) {
+  std::vector<InputManifest::Entry> entries(files.size());
+  std::atomic<std::size_t> next{0};
+  const unsigned hw = std::thread::hardware_concurrency();
+  const unsigned nWorkers = std::min<std::size_t>(std::min(hw ? hw : 2u, 16u), std::max<std::size_t>(files.size(), 1));
+  std::vector<std::thread> threads;
+  threads.reserve(nWorkers);
+  for (unsigned w = 0; w < nWorkers; ++w) {
+    threads.emplace_back([&]() {
+      for (;;) {
+        const std::size_t i = next.fetch_add(1);
+        if (i >= entries.size()) break;
+        InputManifest::Entry& e = entries[i];
+        e.path = files[i];
+        std::error_code ec;
+        e.size = fs::file_size(files[i], ec);
+        if (ec) e.size = 0;
+        e.mtime = InputManifest::MtimeTicks(files[i], ec);
+        e.events = CountEventsInHipoFile(files[i]);
+      }
+    });
+  }
+  for (auto& t : threads) t.join();
+  return entries;
+}
+}  // namespace
+
+// Adaptive datasource chunk sizing: the second RHipoDS argument caps how many
+// events one decode chunk covers.  A fixed 1M events is too coarse on narrow
+// skims (too few chunks to keep 64 threads fed) and too wide on raw files
+// (working set far past cache-friendly sizes).  Probe the mean compressed
+// event size from the first file — record-index census plus file size, no
+// bank decode — size chunks to fIoChunkBytes_ bytes, and cap them so the
+// whole dataset still yields at least ~4 chunks per thread.
+long Events::AdaptiveChunkEvents() const {
+  constexpr long kFixedChunk = 1'000'000;  // historical fixed chunk
+  if (fIoChunkBytes_ <= 0 || inputFiles.empty()) return kFixedChunk;
+
+  const std::string& probeFile = inputFiles.front();
+  const long probeEvents = EventCountFor(probeFile);
+  std::error_code ec;
+  const auto probeBytes = fs::file_size(probeFile, ec);
+  if (probeEvents <= 0 || ec || probeBytes == 0) return kFixedChunk;
+  const double bytesPerEvent = static_cast<double>(probeBytes) / probeEvents;
+
+  long chunk = std::max<long>(1, static_cast<long>(fIoChunkBytes_ / bytesPerEvent));
+
+  std::uintmax_t totalBytes = 0;
+  for (const auto& f : inputFiles) {
+    const auto size = fs::file_size(f, ec);
+    if (!ec) totalBytes += size;
+  }
+  const long nThreads = fnthreads_ > 0
+                            ? fnthreads_
+                            : static_cast<long>(std::max(1u, std::thread::hardware_concurrency()));
+  const double totalEvents = totalBytes / bytesPerEvent;
+  const long perThreadCap = std::max<long>(1, static_cast<long>(totalEvents / (4.0 * nThreads)));
+  chunk = std::min(chunk, perThreadCap);
+
+  std::cout << "[Events] Adaptive chunking: ~" << static_cast<long>(bytesPerEvent)
+            << " B/event -> " << chunk << " events/chunk ("
+            << (fIoChunkBytes_ / (1024 * 1024)) << " MiB budget, >= 4 chunks/thread)\n";
+  return chunk;
+}
+
+// Keep the fewest leading files whose header-census event counts cover the
+// requested budget (always at least one).  This is the MT-safe replacement
+// for df.Range(): the bound is approximate — rounded up to whole files — but
+// IMT splits work by file, so a bounded validation pass runs at full
+// parallelism instead of being serialised by Range.
+std::vector<std::string> Events::TrimToEventBudget(std::vector<std::string> files,
+                                                   long maxEvents) {
+  long covered = 0;
+  std::size_t keep = 0;
+  while (keep < files.size()) {
+    const long n = EventCountFor(files[keep]);
+    // An unreadable census makes the budget unenforceable for this file;
+    // keep the file and let the reader report the real problem.
+    covered += n > 0 ? n : 0;
+    ++keep;
+    if (covered >= maxEvents) break;
+  }
+  if (keep == 0) keep = 1;
+  if (keep < files.size()) {
+    std::cout << "[Events] Event budget " << maxEvents << ": keeping " << keep << " of "
+              << files.size() << " file(s) (~" << covered << " events)\n";
+    files.resize(keep);
+  }
+  return files;
+}
+
+std::vector<std::pair<std::string, long>>
+Events::CountEventsFast(const std::string& pathOrPattern, int nfiles) {
+  auto files = getHipoFilesInPath(pathOrPattern, nfiles);
+
+  std::vector<std::pair<std::string, long>> counts;
+  counts.reserve(files.size());
+
+  long total = 0;
+  std::size_t unreadable = 0;
+  for (const auto& f : files) {
+    const long n = EventCountFor(f);
+    if (n < 0) {
+      std::cerr << "[Events] CountEventsFast: cannot read record headers of "
+                << f << "\n";
+      ++unreadable;
+    } else {
+      total += n;
+    }
+    counts.emplace_back(f, n);
+  }
+
+  std::cout << "[Events] CountEventsFast: " << total << " events in "
+            << files.size() << " file(s)";
+  if (unreadable > 0) std::cout << " (" << unreadable << " unreadable)";
+  std::cout << "\n";
+  return counts;
+}
+
+long Events::CountTotalEventsFast() const {
+  if (fIsReprocessRootFile_ || inputFiles.empty()) return -1;
+  long total = 0;
+  for (const auto& f : inputFiles) {
+    const long n = EventCountFor(f);
+    if (n < 0) return -1;
+    total += n;
+  }
+  return total;
+}
+
 Events::~Events() {
   // No temporary files are created in RHipoDS mode.
 }
@@ -100,7 +594,7 @@ std::optional<ROOT::RDF::RNode> Events::getNode() const { return dfNode_; }
 std::size_t Events::getFileCount() const { return fileCount_; }
 std::string Events::getFinalInputPath() const { return finalInputPath_; }
 std::vector<std::string>Events::getHipoFilesInPath(const std::string& pathOrPattern,
-                                        int nfiles) const {
+                                        int nfiles) {
   std::vector<std::string> files;
   std::size_t count = 0;
 
@@ -154,19 +648,26 @@ std::vector<std::string>Events::getHipoFilesInPath(const std::string& pathOrPatt
 
   // CASE 2: existing directory (recursive)
   if (fs::is_directory(p, ec)) {
-    fs::recursive_directory_iterator it(
-        p, fs::directory_options::skip_permission_denied, ec),
-        end;
-
-    for (; !ec && it != end; it.increment(ec)) {
-      const fs::directory_entry& de = *it;
-      if (de.is_regular_file(ec) && de.path().extension() == ".hipo") {
-        if (!push(de.path())) break;
+    // Manifest fast path: reuse the previous scan while the directory is
+    // unchanged, so only the first of the cooperating shards pays for the
+    // stat walk.
+    if (auto cached = InputManifest::Load(p.string())) {
+      for (const auto& e : *cached) {
+        if (!push(e.path)) break;
       }
+      std::cout << "[Converter] Found " << files.size()
+                << " .hipo files (manifest)\n";
+      return files;
     }
 
-    if (ec) std::cerr << "[Converter] Iteration warning: " << ec.message()
-                      << "\n";
+    auto discovered = DiscoverHipoFilesParallel(p);
+    // First discovery publishes the manifest (path, size, mtime, event
+    // census per file); a write failure is non-fatal — the directory may be
+    // read-only for this job — and the next job simply rescans.
+    InputManifest::Write(p.string(), BuildManifestEntries(discovered));
+    for (const auto& f : discovered) {
+      if (!push(f)) break;
+    }
 
     std::cout << "[Converter] Found " << files.size()
               << " .hipo files (dir)\n";
@@ -5,6 +5,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 #include <fnmatch.h>
 
@@ -13,30 +14,113 @@
 
 class Events {
 public:
+  // Default per-chunk compressed-byte budget for the HIPO datasource
+  // (see ioChunkBytes below).
+  static constexpr long kDefaultIoChunkBytes = 64L * 1024 * 1024;
+  // requestedColumns restricts the HIPO datasource schema to the listed
+  // columns / bank prefixes (see ColumnPrunedHipoDS).  An empty list keeps
+  // the full schema.  Ignored in reprocess mode, where the TTree-backed
+  // dataframe already reads only the branches the graph uses.
+  //
+  // shardIndex/nShards partition the input files between cooperating jobs:
+  // with nShards > 1 this instance keeps only its deterministic share of the
+  // .hipo files (size-balanced, see ShardFiles), so K processes over the same
+  // directory together cover every file exactly once.
+  //
+  // balanceInputFiles feeds the files to the datasource largest-first instead
+  // of directory-iteration order.  IMT splits work by file, so a multi-GB
+  // file encountered last would otherwise run alone while every other thread
+  // idles; starting the big files first shrinks that straggler tail.  (With
+  // IMT the event order in outputs is unspecified either way.)
+  //
+  // maxEventsHint > 0 trims the input list to the fewest files covering
+  // roughly that many events (header-only census), the MT-safe replacement
+  // for bounding a run with df.Range().  Ignored in reprocess mode.
+  //
+  // inputDirectory may also be a remote URL (xroot://, root://, http(s)://)
+  // or a local .list/.txt file of paths and URLs, one per line.  In HIPO
+  // mode remote entries are staged through a local LRU cache with bounded
+  // parallel transfer streams (see RemoteInputStager; DISANA_REMOTE_CACHE /
+  // DISANA_REMOTE_CACHE_GB configure the directory and eviction budget).
+  // In reprocess mode a remote URL streams directly through ROOT's own
+  // client, whose TTreeCache read-ahead overlaps transfer with the loop.
+  //
+  // ioChunkBytes sizes the HIPO datasource decode chunks adaptively: the
+  // mean compressed event size is probed from the first file's record index
+  // (header-only) and chunks are sized to roughly this many bytes, capped so
+  // the dataset still yields at least ~4 chunks per thread.  Narrow skims
+  // thus get enough chunks to feed every thread and raw files keep a
+  // cache-friendly working set.  <= 0 restores the fixed 1M-event chunks.
+  //
+  // useColumnarCache (reprocess mode only) serves the input through the
+  // memory-mapped columnar cache (see MMapColumnCacheDS): the first run
+  // materializes every branch into flat arrays under <inputDir>/colcache/,
+  // later runs map them read-only, so repeated cut iterations over the same
+  // dfSelected.root skip TTree decompression entirely and concurrent jobs
+  // share one page-cache copy.  Falls back to the ROOT file when the cache
+  // cannot be built (e.g. an unsupported branch type or RNTuple input).
   Events(const std::string& inputDirectory,
          const std::string& outputDirectory,
          bool fIsReprocessRootFile,
          const std::string& fInputROOTtreeName,
          const std::string& fOutputROOTfileName,
          int nfiles,
-         int nthreads);
+         int nthreads,
+         const std::vector<std::string>& requestedColumns = {},
+         int shardIndex = 0,
+         int nShards = 1,
+         bool balanceInputFiles = true,
+         long maxEventsHint = 0,
+         bool useColumnarCache = false,
+         long ioChunkBytes = kDefaultIoChunkBytes);
+
+  // HIPO mode over an explicit file list, in the given order.  Used by the
+  // checkpointed driver (EventProcessor::ProcessEventsWithCheckpoints),
+  // which hands each file group to its own Events instance.
+  Events(const std::vector<std::string>& hipoFiles,
+         const std::string& outputDirectory,
+         int nthreads,
+         const std::vector<std::string>& requestedColumns = {},
+         long ioChunkBytes = kDefaultIoChunkBytes);
 
   ~Events();
 
   std::optional<ROOT::RDF::RNode> getNode() const;
   std::size_t getFileCount() const;
   std::string getFinalInputPath() const;
-  std::vector<std::string> getHipoFilesInPath(const std::string& pathOrPattern,
-                                              int nfiles) const;
+  // Stateless listing helper, also usable without an Events instance.
+  static std::vector<std::string> getHipoFilesInPath(const std::string& pathOrPattern,
+                                                     int nfiles);
+
+  // Fast dataset census: per-file (path, event count) pairs taken from the
+  // HIPO record index, which the reader builds from record headers alone —
+  // no bank is ever decompressed or decoded.  Intended for bookkeeping and
+  // shard planning, where iterating the banks took hours per dataset.
+  // nfiles = 0 counts every file found.
+  static std::vector<std::pair<std::string, long>> CountEventsFast(
+      const std::string& pathOrPattern, int nfiles = 0);
+
+  // Total event count of this instance's input files via the same
+  // header-only walk; -1 in reprocess mode or when a file is unreadable.
+  // Used by EventProcessor to give the progress line a denominator/ETA.
+  long CountTotalEventsFast() const;
 
 private:
   std::vector<std::string> GetHipoFilesInPath(const std::string& directory, int nfiles);
+  void InitHipoDataFrame(const std::vector<std::string>& requestedColumns);
+  long AdaptiveChunkEvents() const;
+  static std::vector<std::string> SortBySizeDescending(std::vector<std::string> files);
+  static std::vector<std::string> ShardFiles(std::vector<std::string> files,
+                                             int shardIndex, int nShards);
+  static std::vector<std::string> TrimToEventBudget(std::vector<std::string> files,
+                                                    long maxEvents);
 
   std::string fOutputDir_;
 
   bool        fIsReprocessRootFile_{false};
   int         fnfiles_{0};
   int         fnthreads_{0};
+  long        fIoChunkBytes_{kDefaultIoChunkBytes};
   std::string fInputROOTtreeName_;
   std::string fOutputROOTfileName_;
 
@@ -1,21 +1,29 @@
 #include "HipoToRootConverter.h"
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cstdlib>
+#include <deque>
 #include <filesystem>
 #include <fnmatch.h>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <thread>
 #include <unordered_map>
 #include <vector>
 
+#include "TFileMerger.h"
 #include "TInterpreter.h"
+#include "TROOT.h"
 #include "TSystem.h"
 
 #include "hipo4/RHipoDS.hxx"
 
+#include "RunEventColumns.h"
+
 #include <Compression.h>
 #include <RVersion.h>
 #include <ROOT/RDataFrame.hxx>
@@ -29,23 +37,22 @@ static ROOT::RDataFrame makeRDFFromSlice(std::vector<std::string> slice) {
   return ROOT::RDataFrame(std::move(ds));
 }
 
-// Inspect a slice's schema; if the slice has zero entries, return empty (caller will ignore)
+// Inspect a slice's schema from metadata only: constructing the datasource
+// reads just the HIPO dictionaries, so names and types are available without
+// the full decode pass a forced Count() used to cost per slice.  A slice
+// whose files carry no banks advertises no columns and returns empty
+// (caller ignores it in the intersection, as the zero-row slices before).
 static std::unordered_map<std::string, std::string>
 inspectSliceSchema(const std::vector<std::string>& slice) {
-  ROOT::RDataFrame rdf =
-      makeRDFFromSlice(std::vector<std::string>(slice.begin(), slice.end()));
-
-  // Count is lazy; force evaluation
-  auto n = *rdf.Count();
-  if (n == 0) {
-    std::cerr
-        << "[Converter] Schema discovery: slice has 0 rows, ignoring in intersection\n";
-    return {};
-  }
+  RHipoDS ds(std::vector<std::string>(slice.begin(), slice.end()));
 
   std::unordered_map<std::string, std::string> types;
-  for (const auto& c : rdf.GetColumnNames()) {
-    types.emplace(c, rdf.GetColumnType(c));
+  for (const auto& c : ds.GetColumnNames()) {
+    types.emplace(c, ds.GetTypeName(c));
+  }
+  if (types.empty()) {
+    std::cerr
+        << "[Converter] Schema discovery: slice advertises no columns, ignoring in intersection\n";
   }
   return types;
 }
@@ -95,7 +102,8 @@ computeStableColumns(const std::vector<std::vector<std::string>>& slices) {
 static void snapshotSliceToRoot(std::vector<std::string> sliceFiles,
                                 const std::string& outPath,
                                 const std::string& treeName,
-                                const std::vector<std::string>& cols) {
+                                const std::vector<std::string>& cols,
+                                HipoToRootConverter::OutputFormat format) {
   ROOT::RDataFrame rdf = makeRDFFromSlice(std::move(sliceFiles));
 
   // Skip empty slices to avoid producing empty/no-tree files that break the chain
@@ -106,17 +114,41 @@ static void snapshotSliceToRoot(std::vector<std::string> sliceFiles,
     return;
   }
 
+  // Canonical schema: converted files carry scalar int RUN_run / RUN_event,
+  // so reading them back never hits the per-type normalization fallbacks.
+  ROOT::RDF::RNode node = NormalizeRunEventColumns(ROOT::RDF::RNode(rdf));
+  std::vector<std::string> outCols = cols;
+  {
+    auto nodeCols = node.GetColumnNames();
+    for (const char* canonical : {"RUN_run", "RUN_event"}) {
+      if (std::find(outCols.begin(), outCols.end(), canonical) == outCols.end() &&
+          std::find(nodeCols.begin(), nodeCols.end(), canonical) != nodeCols.end()) {
+        outCols.push_back(canonical);
+      }
+    }
+  }
+
   ROOT::RDF::RSnapshotOptions opts;
   opts.fMode = "RECREATE";
 
-  // ROOT 6.36: use RCompressionSetting enum
-  opts.fCompressionAlgorithm = ROOT::RCompressionSetting::EAlgorithm::kLZ4;
-  opts.fCompressionLevel = 4;
-
-  // AutoFlush in entries (50k entries)
-  opts.fAutoFlush = 50'000;
+  if (format == HipoToRootConverter::OutputFormat::kRNTuple) {
+    // Columnar page layout: vector columns are stored as per-element pages
+    // with their offsets split out, so a later pass touching a few branches
+    // reads only those pages.  zstd is the RNTuple house compression and
+    // beats LZ4 on these banks at similar decode speed.
+    opts.fOutputFormat = ROOT::RDF::ESnapshotOutputFormat::kRNTuple;
+    opts.fCompressionAlgorithm = ROOT::RCompressionSetting::EAlgorithm::kZSTD;
+    opts.fCompressionLevel = 5;
+  } else {
+    // ROOT 6.36: use RCompressionSetting enum
+    opts.fCompressionAlgorithm = ROOT::RCompressionSetting::EAlgorithm::kLZ4;
+    opts.fCompressionLevel = 4;
+
+    // AutoFlush in entries (50k entries)
+    opts.fAutoFlush = 50'000;
+  }
 
-  rdf.Snapshot(treeName, outPath, cols, opts);
+  node.Snapshot(treeName, outPath, outCols, opts);
 }
 
 // ---- Constructor and getHipoFilesInPath ----
@@ -212,9 +244,10 @@ HipoToRootConverter::getHipoFilesInPath(const std::string& pathOrPattern,
   return files;
 }
 
-// --- convert(): parallel per-slice snapshots with stable schema & pruning ---
-std::vector<std::string> HipoToRootConverter::convert(
-    const std::string& tempFilePrefix) {
+// --- convertImpl(): parallel per-slice snapshots with a stable schema ---
+std::vector<std::string> HipoToRootConverter::convertImpl(
+    const std::string& tempFilePrefix,
+    const std::function<void(const std::string&)>& onSliceReady) {
 
   std::vector<std::string> hipoFiles = getHipoFilesInPath(fInputDir_, fnFiles_);
   lastInputCount_ = hipoFiles.size();
@@ -232,17 +265,21 @@ std::vector<std::string> HipoToRootConverter::convert(
              fnThreads_ > 0 ? static_cast<std::size_t>(fnThreads_) : 1,
              hipoFiles.size()));
 
-  const std::size_t filesPerThread =
-      (hipoFiles.size() + nWorkers - 1) / nWorkers;
+  // Pipelined slicing: cut the dataset into ~4 slices per worker instead of
+  // exactly one, and let a fixed pool pull them from a shared queue.  Workers
+  // that finish a cheap slice immediately start the next, so decode and
+  // compress/write stay overlapped across the pool for the whole run instead
+  // of every worker idling behind the largest slice at the end.
+  const std::size_t targetSlices = nWorkers * 4;
+  const std::size_t filesPerSlice = std::max<std::size_t>(
+      1, (hipoFiles.size() + targetSlices - 1) / targetSlices);
 
   std::vector<std::vector<std::string>> slices;
-  slices.reserve(nWorkers);
+  slices.reserve((hipoFiles.size() + filesPerSlice - 1) / filesPerSlice);
 
-  for (std::size_t i = 0; i < nWorkers; ++i) {
-    const auto start = i * filesPerThread;
-    const auto end = std::min(start + filesPerThread, hipoFiles.size());
-    if (start < end)
-      slices.emplace_back(hipoFiles.begin() + start, hipoFiles.begin() + end);
+  for (std::size_t start = 0; start < hipoFiles.size(); start += filesPerSlice) {
+    const auto end = std::min(start + filesPerSlice, hipoFiles.size());
+    slices.emplace_back(hipoFiles.begin() + start, hipoFiles.begin() + end);
   }
 
   auto stableCols = computeStableColumns(slices);
@@ -254,24 +291,49 @@ std::vector<std::string> HipoToRootConverter::convert(
   std::vector<std::string> tempRoots;
   tempRoots.reserve(slices.size());
 
-  std::vector<std::thread> threads;
-  threads.reserve(slices.size());
-
   for (std::size_t i = 0; i < slices.size(); ++i) {
-    std::string tmp =
-        (fs::path(fOutputDir_) /
-         (tempFilePrefix + std::to_string(i) + ".root"))
-            .string();
-
-    tempRoots.push_back(tmp);
+    tempRoots.push_back((fs::path(fOutputDir_) /
+                         (tempFilePrefix + std::to_string(i) + ".root"))
+                            .string());
+  }
 
-    threads.emplace_back(snapshotSliceToRoot, std::move(slices[i]), tmp,
-                         std::string(kSnapshotTreeName), stableCols);
+  // Fixed worker pool over the slice queue: at most nWorkers slices are in
+  // flight at a time (bounding memory), and idle workers steal the next
+  // pending slice.
+  ROOT::EnableThreadSafety();
+  std::atomic<std::size_t> nextSlice{0};
+  std::vector<std::thread> threads;
+  threads.reserve(nWorkers);
+
+  for (std::size_t w = 0; w < nWorkers; ++w) {
+    threads.emplace_back([&]() {
+      for (;;) {
+        const std::size_t i = nextSlice.fetch_add(1);
+        if (i >= slices.size()) return;
+        snapshotSliceToRoot(std::move(slices[i]), tempRoots[i],
+                            std::string(kSnapshotTreeName), stableCols, fFormat_);
+        if (onSliceReady) {
+          std::error_code ec2;
+          if (fs::exists(tempRoots[i], ec2) && !ec2 &&
+              fs::file_size(tempRoots[i], ec2) > 0 && !ec2) {
+            onSliceReady(tempRoots[i]);
+          }
+        }
+      }
+    });
   }
 
   for (auto& t : threads)
     if (t.joinable()) t.join();
 
+  return tempRoots;
+}
+
+// --- convert(): parallel per-slice snapshots, returning the pruned temp files ---
+std::vector<std::string> HipoToRootConverter::convert(
+    const std::string& tempFilePrefix) {
+  std::vector<std::string> tempRoots = convertImpl(tempFilePrefix, nullptr);
+
   // Prune any missing or empty files (slices that were empty won't have written a file)
   std::vector<std::string> pruned;
   pruned.reserve(tempRoots.size());
@@ -292,4 +354,115 @@ std::vector<std::string> HipoToRootConverter::convert(
             << tempRoots.size() << " temporary ROOT files." << std::endl;
 
   return tempRoots;
+}
+
+// --- convertMerged(): conversion with the merge pipelined behind it ---
+// The worker pool produces slice files exactly as convert(); a dedicated
+// merger thread folds each one into the final output as soon as it is
+// complete (TFileMerger incremental partial merge — the same basket-level
+// append TBufferMerger drives internally) and deletes it.  The serial merge
+// that used to follow conversion is thereby overlapped with the decode and
+// compression of the remaining slices, which is where the write stalls on
+// shared filesystems used to surface.
+std::string HipoToRootConverter::convertMerged(const std::string& tempFilePrefix,
+                                               const std::string& finalFileName) {
+  const std::string finalPath = (fs::path(fOutputDir_) / finalFileName).string();
+
+  std::mutex mtx;
+  std::condition_variable cv;
+  std::deque<std::string> ready;
+  bool conversionDone = false;
+  std::atomic<bool> mergeOk{true};
+  std::size_t nMerged = 0;
+
+  std::thread mergerThread([&]() {
+    // TFileMerger handles both backends: TTrees through the basket-level
+    // append and RNTuples through RNTuple::Merge (same path hadd uses).
+    TFileMerger merger(/*isLocal=*/kFALSE);
+    if (!merger.OutputFile(finalPath.c_str(), /*force=*/kTRUE)) {
+      std::cerr << "[Converter] Cannot open merge output " << finalPath << "\n";
+      mergeOk = false;
+      return;
+    }
+
+    for (;;) {
+      std::string next;
+      {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait(lock, [&] { return conversionDone || !ready.empty(); });
+        if (ready.empty()) return;  // conversionDone and queue drained
+        next = std::move(ready.front());
+        ready.pop_front();
+      }
+
+      if (!merger.AddFile(next.c_str())) {
+        std::cerr << "[Converter] Cannot add " << next << " to merge\n";
+        mergeOk = false;
+        continue;
+      }
+      if (!merger.PartialMerge(TFileMerger::kAll | TFileMerger::kIncremental)) {
+        std::cerr << "[Converter] Incremental merge failed for " << next << "\n";
+        mergeOk = false;
+        continue;
+      }
+      merger.Reset();  // drop the consumed input from the merger's file list
+
+      std::error_code ec;
+      fs::remove(next, ec);
+      ++nMerged;
+    }
+  });
+
+  std::vector<std::string> tempRoots;
+  try {
+    tempRoots = convertImpl(tempFilePrefix, [&](const std::string& path) {
+      std::lock_guard<std::mutex> lock(mtx);
+      ready.push_back(path);
+      cv.notify_one();
+    });
+  } catch (...) {
+    // Schema discovery can throw before any slice is written; the merger
+    // thread must be drained and joined before the exception propagates.
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      conversionDone = true;
+      cv.notify_one();
+    }
+    mergerThread.join();
+    std::error_code ec;
+    fs::remove(finalPath, ec);
+    throw;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    conversionDone = true;
+    cv.notify_one();
+  }
+  mergerThread.join();
+
+  // Any temp file still on disk was enqueued but failed to merge (or the
+  // merger bailed out before reaching it) — leave it for inspection.
+  for (const auto& f : tempRoots) {
+    std::error_code ec;
+    if (fs::exists(f, ec) && !ec) {
+      std::cerr << "[Converter] Unmerged temp file left behind: " << f << "\n";
+    }
+  }
+
+  if (!mergeOk) {
+    std::cerr << "[Converter] Pipelined merge failed for " << finalPath << "\n";
+    return {};
+  }
+  if (nMerged == 0) {
+    std::cerr << "[Converter] All slices empty -> no merged output written\n";
+    std::error_code ec;
+    fs::remove(finalPath, ec);
+    return {};
+  }
+
+  std::cout << "[Converter] Pipelined conversion+merge complete. Merged "
+            << nMerged << " slice file(s) into " << finalPath << std::endl;
+
+  return finalPath;
 }
\ No newline at end of file
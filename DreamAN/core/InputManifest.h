@@ -0,0 +1,150 @@
+#ifndef INPUTMANIFEST_H
+#define INPUTMANIFEST_H
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Cached input-discovery manifest.
+//
+// On Lustre directories with tens of thousands of .hipo files the recursive
+// stat walk takes minutes and is repeated by every cooperating shard.  The
+// first job to scan a directory writes a manifest (path, size, mtime, event
+// count per file) into the directory itself; subsequent jobs reuse it until
+// the directory mtime changes, so startup no longer depends on
+// metadata-server latency.
+//
+// Validity: the manifest is current while its own mtime is not older than
+// the directory's (adding or removing files bumps the directory mtime and
+// invalidates it; writing the manifest itself bumps both together, so the
+// freshly written file stays valid).  The footer carries an FNV-1a checksum
+// of the entry lines, so a truncated or hand-edited file falls back to a
+// fresh scan.  Event counts ride along because they come from the same header
+// census the event-budget trim needs anyway; CachedEventCount() lets those
+// consumers skip re-reading record headers for files already in a loaded
+// manifest.
+class InputManifest {
+ public:
+  struct Entry {
+    std::string path;
+    std::uintmax_t size = 0;
+    std::int64_t mtime = 0;  ///< fs::last_write_time ticks
+    long events = -1;        ///< header-census event count, -1 if unreadable
+  };
+
+  /// Manifest file location for a scanned directory.
+  static std::string FileFor(const std::string& directory) { return (std::filesystem::path(directory) / ".disana_manifest").string(); }
+
+  /// Load the manifest for \p directory if present, checksum-clean and not
+  /// older than the directory itself; nullopt otherwise.
+  static std::optional<std::vector<Entry>> Load(const std::string& directory) {
+    std::error_code ec;
+    const auto dirMtime = MtimeTicks(directory, ec);
+    if (ec) return std::nullopt;
+    const auto manifestMtime = MtimeTicks(FileFor(directory), ec);
+    if (ec || manifestMtime < dirMtime) return std::nullopt;  // directory changed since the scan
+
+    std::ifstream in(FileFor(directory));
+    if (!in) return std::nullopt;
+
+    std::string line;
+    if (!std::getline(in, line) || line != kHeader) return std::nullopt;
+
+    std::vector<Entry> entries;
+    std::uint64_t checksum = kFnvOffset;
+    while (std::getline(in, line)) {
+      if (line.rfind(kChecksumTag, 0) == 0) {
+        std::uint64_t recorded = 0;
+        if (!(std::istringstream(line.substr(kChecksumTag.size())) >> recorded) || recorded != checksum) return std::nullopt;
+        RegisterEventCounts(entries);
+        return entries;
+      }
+      Entry e;
+      std::istringstream ls(line);
+      if (!(std::getline(ls, e.path, '\t') && ls >> e.size >> e.mtime >> e.events)) return std::nullopt;
+      checksum = FnvLine(checksum, line);
+      entries.push_back(std::move(e));
+    }
+    return std::nullopt;  // no checksum footer: truncated write
+  }
+
+  /// Write the manifest for \p directory.  Failures are non-fatal (the
+  /// directory may be read-only for this job); the next job simply rescans.
+  static void Write(const std::string& directory, const std::vector<Entry>& entries) {
+    std::error_code ec;
+    const std::string path = FileFor(directory);
+    const std::string tmp = path + ".tmp";
+    {
+      std::ofstream out(tmp);
+      if (!out) return;
+      out << kHeader << "\n";
+      std::uint64_t checksum = kFnvOffset;
+      for (const auto& e : entries) {
+        std::ostringstream ls;
+        ls << e.path << '\t' << e.size << ' ' << e.mtime << ' ' << e.events;
+        checksum = FnvLine(checksum, ls.str());
+        out << ls.str() << "\n";
+      }
+      out << kChecksumTag << checksum << "\n";
+      if (!out) return;
+    }
+    // Atomic publish: cooperating shards either see the complete manifest or
+    // none at all.  The rename bumps the directory mtime and the manifest
+    // mtime together, so the new file validates immediately.
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) std::filesystem::remove(tmp, ec);
+    RegisterEventCounts(entries);
+  }
+
+  /// Event count recorded for \p path in any manifest loaded or written by
+  /// this process; nullopt when unknown (falls back to the header census).
+  static std::optional<long> CachedEventCount(const std::string& path) {
+    std::lock_guard<std::mutex> lock(Mutex());
+    auto& counts = Counts();
+    auto it = counts.find(path);
+    if (it == counts.end() || it->second < 0) return std::nullopt;
+    return it->second;
+  }
+
+  static std::int64_t MtimeTicks(const std::string& path, std::error_code& ec) {
+    const auto t = std::filesystem::last_write_time(path, ec);
+    return ec ? 0 : static_cast<std::int64_t>(t.time_since_epoch().count());
+  }
+
+ private:
+  static void RegisterEventCounts(const std::vector<Entry>& entries) {
+    std::lock_guard<std::mutex> lock(Mutex());
+    auto& counts = Counts();
+    for (const auto& e : entries) counts[e.path] = e.events;
+  }
+
+  static std::uint64_t FnvLine(std::uint64_t h, const std::string& line) {
+    for (unsigned char c : line) {
+      h ^= c;
+      h *= 1099511628211ull;
+    }
+    return h;
+  }
+
+  static std::mutex& Mutex() {
+    static std::mutex m;
+    return m;
+  }
+  static std::map<std::string, long>& Counts() {
+    static std::map<std::string, long> c;
+    return c;
+  }
+
+  static constexpr std::uint64_t kFnvOffset = 14695981039346656037ull;
+  static inline const std::string kHeader = "DISANA-MANIFEST v1";
+  static inline const std::string kChecksumTag = "checksum ";
+};
+
+#endif  // INPUTMANIFEST_H
@@ -0,0 +1,303 @@
+#ifndef LUNDTOROOTCONVERTER_H
+#define LUNDTOROOTCONVERTER_H
+
+#include <atomic>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <glob.h>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <TFile.h>
+#include <TFileMerger.h>
+#include <TROOT.h>
+#include <TTree.h>
+
+// LUND-to-ROOT generator ingestion.
+//
+// Replaces the three near-identical rootmacros converters (lund2rdf,
+// lund2rdf2, lund2rdfFirst), which parsed LUND text one getline/stringstream
+// token at a time and processed files serially.  This version reads each
+// file in one buffered gulp, parses numbers with std::from_chars (no locale,
+// no stream state), and converts files in parallel: each worker fills its
+// own temporary tree and the parts are fast-merged at the end.
+//
+// The three old macros differed only in which photons they kept, so that is
+// now a policy switch.  Output schema is unchanged: tree "MC" with the
+// MC_Particle_{pid,px,py,pz} vector branches that InitGenKinematics and
+// DVCSAnalysis::MinimalColumns expect.
+//
+// Header-only (like EventSplitter/PerRunCounter) so rootmacros can use it
+// straight from the interpreter.
+class LundToRootConverter {
+ public:
+  enum class PhotonPolicy {
+    kKeepAll,          ///< keep every photon in the event
+    kFirstPhoton,      ///< keep only the first photon (old lund2rdf/lund2rdfFirst)
+    kMaxEnergyPhoton,  ///< keep only the highest-energy photon (old lund2rdf2)
+  };
+
+  LundToRootConverter(const std::string& inputPattern, const std::string& outputPath)
+      : fInputPattern(inputPattern), fOutputPath(outputPath) {}
+
+  void SetPhotonPolicy(PhotonPolicy policy) { fPolicy = policy; }
+
+  /// Exact basenames to skip (e.g. the corrupt RGA sp2018 nor*M1.dat files).
+  void SetExcludedBasenames(std::unordered_set<std::string> names) { fExcluded = std::move(names); }
+
+  /// Number of converter threads; defaults to the hardware thread count,
+  /// capped at the number of input files.
+  void SetNumWorkers(int n) { fNumWorkers = n; }
+
+  /// Convert every file matching the input pattern into one ROOT file.
+  /// Returns the number of events written (negative on error).  Event order
+  /// across input files is not preserved when running with several workers.
+  long long Run() {
+    std::vector<std::string> files = GlobFiles(fInputPattern);
+    if (files.empty()) {
+      std::cerr << "LundToRootConverter: no files match pattern: " << fInputPattern << std::endl;
+      return -1;
+    }
+
+    std::vector<std::string> accepted;
+    accepted.reserve(files.size());
+    for (const auto& fname : files) {
+      if (fExcluded.count(BasenameOf(fname))) {
+        std::cout << "LundToRootConverter: skipping " << fname << " (in exclude list)" << std::endl;
+        continue;
+      }
+      accepted.push_back(fname);
+    }
+    if (accepted.empty()) {
+      std::cerr << "LundToRootConverter: every matching file is excluded" << std::endl;
+      return -1;
+    }
+
+    unsigned int nWorkers = fNumWorkers > 0 ? static_cast<unsigned int>(fNumWorkers) : std::thread::hardware_concurrency();
+    if (nWorkers == 0) nWorkers = 1;
+    if (nWorkers > accepted.size()) nWorkers = static_cast<unsigned int>(accepted.size());
+
+    ROOT::EnableThreadSafety();
+    std::atomic<std::size_t> nextFile{0};
+    std::vector<long long> workerCounts(nWorkers, 0);
+    std::vector<std::string> partFiles(nWorkers);
+    std::vector<std::thread> threads;
+    threads.reserve(nWorkers);
+
+    for (unsigned int w = 0; w < nWorkers; ++w) {
+      partFiles[w] = fOutputPath + ".part" + std::to_string(w);
+      threads.emplace_back([&, w]() {
+        TFile fout(partFiles[w].c_str(), "RECREATE");
+        if (fout.IsZombie()) {
+          std::cerr << "LundToRootConverter: cannot create " << partFiles[w] << std::endl;
+          return;
+        }
+        std::vector<int> v_pid;
+        std::vector<float> v_px, v_py, v_pz;
+        TTree tree("MC", "MC particles from LUND (dvcsgen)");
+        tree.Branch("MC_Particle_pid", &v_pid);
+        tree.Branch("MC_Particle_px", &v_px);
+        tree.Branch("MC_Particle_py", &v_py);
+        tree.Branch("MC_Particle_pz", &v_pz);
+
+        std::string buffer;
+        while (true) {
+          const std::size_t i = nextFile.fetch_add(1);
+          if (i >= accepted.size()) break;
+          workerCounts[w] += ConvertFile(accepted[i], buffer, tree, v_pid, v_px, v_py, v_pz);
+        }
+        fout.Write();
+        fout.Close();
+      });
+    }
+    for (auto& t : threads) t.join();
+
+    long long evCount = 0;
+    for (long long c : workerCounts) evCount += c;
+
+    // Fast-merge the per-worker parts into the final file (tree baskets are
+    // copied without decompression), then drop the temporaries.
+    TFileMerger merger(false);
+    merger.OutputFile(fOutputPath.c_str(), "RECREATE");
+    for (const auto& part : partFiles) merger.AddFile(part.c_str(), false);
+    const bool ok = merger.Merge();
+    for (const auto& part : partFiles) std::remove(part.c_str());
+    if (!ok) {
+      std::cerr << "LundToRootConverter: merge into " << fOutputPath << " failed" << std::endl;
+      return -1;
+    }
+
+    std::cout << "LundToRootConverter: wrote " << evCount << " events from " << accepted.size() << " files to " << fOutputPath << std::endl;
+    return evCount;
+  }
+
+ private:
+  static std::vector<std::string> GlobFiles(const std::string& pattern) {
+    glob_t results;
+    std::vector<std::string> files;
+    if (glob(pattern.c_str(), 0, nullptr, &results) == 0) {
+      for (size_t i = 0; i < results.gl_pathc; ++i) files.emplace_back(results.gl_pathv[i]);
+    }
+    globfree(&results);
+    return files;
+  }
+
+  static std::string BasenameOf(const std::string& path) {
+    size_t pos = path.find_last_of("/\\");
+    return (pos == std::string::npos) ? path : path.substr(pos + 1);
+  }
+
+  /// Advance past whitespace and return the next token as [begin, end);
+  /// returns false at end of line.
+  static bool NextToken(const char*& p, const char* end, const char*& tokBegin, const char*& tokEnd) {
+    while (p != end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+    if (p == end) return false;
+    tokBegin = p;
+    while (p != end && *p != ' ' && *p != '\t' && *p != '\r') ++p;
+    tokEnd = p;
+    return true;
+  }
+
+  /// Parse one particle line: pid is field 3, px/py/pz are fields 6-8.
+  static bool ParseParticleLine(const char* p, const char* end, int& pid, float& px, float& py, float& pz) {
+    const char *b, *e;
+    for (int field = 0; field < 9; ++field) {
+      if (!NextToken(p, end, b, e)) return false;
+      std::from_chars_result res{};
+      switch (field) {
+        case 3: res = std::from_chars(b, e, pid); break;
+        case 6: res = std::from_chars(b, e, px); break;
+        case 7: res = std::from_chars(b, e, py); break;
+        case 8: res = std::from_chars(b, e, pz); break;
+        default: continue;
+      }
+      if (res.ec != std::errc() || res.ptr != e) return false;
+    }
+    return true;
+  }
+
+  /// Parse one LUND file from a single buffered read and fill \p tree.
+  /// Returns the number of events appended.
+  long long ConvertFile(const std::string& fname, std::string& buffer, TTree& tree, std::vector<int>& v_pid, std::vector<float>& v_px, std::vector<float>& v_py,
+                        std::vector<float>& v_pz) const {
+    std::ifstream fin(fname, std::ios::binary | std::ios::ate);
+    if (!fin.is_open()) {
+      std::cerr << "LundToRootConverter: cannot open " << fname << std::endl;
+      return 0;
+    }
+    const std::streamsize size = fin.tellg();
+    fin.seekg(0);
+    buffer.resize(static_cast<std::size_t>(size));
+    if (!fin.read(buffer.data(), size)) {
+      std::cerr << "LundToRootConverter: read error on " << fname << std::endl;
+      return 0;
+    }
+    std::cout << "LundToRootConverter: processing " << fname << " ..." << std::endl;
+
+    // All particles of the current event, before the photon policy is applied.
+    std::vector<int> e_pid;
+    std::vector<float> e_px, e_py, e_pz;
+
+    long long evCount = 0;
+    const char* p = buffer.data();
+    const char* const bufEnd = p + buffer.size();
+    while (p != bufEnd) {
+      const char* nl = static_cast<const char*>(memchr(p, '\n', bufEnd - p));
+      const char* lineEnd = nl ? nl : bufEnd;
+      const char* linePtr = p;
+      p = nl ? nl + 1 : bufEnd;
+
+      // An event header starts with Npart; anything else is skipped (the
+      // inner loop below consumes the particle lines, so only headers and
+      // junk reach this point).
+      const char *b, *e;
+      if (!NextToken(linePtr, lineEnd, b, e)) continue;
+      int nPart = -1;
+      auto res = std::from_chars(b, e, nPart);
+      if (res.ec != std::errc() || res.ptr != e || nPart <= 0) continue;
+
+      e_pid.clear();
+      e_px.clear();
+      e_py.clear();
+      e_pz.clear();
+      for (int i = 0; i < nPart && p != bufEnd;) {
+        nl = static_cast<const char*>(memchr(p, '\n', bufEnd - p));
+        const char* pEnd = nl ? nl : bufEnd;
+        const char* pPtr = p;
+        p = nl ? nl + 1 : bufEnd;
+
+        if (!NextToken(pPtr, pEnd, b, e)) continue;  // blank line, not counted
+        ++i;
+
+        int pid;
+        float px, py, pz;
+        if (ParseParticleLine(b, pEnd, pid, px, py, pz)) {
+          e_pid.push_back(pid);
+          e_px.push_back(px);
+          e_py.push_back(py);
+          e_pz.push_back(pz);
+        }
+      }
+
+      FillEvent(e_pid, e_px, e_py, e_pz, v_pid, v_px, v_py, v_pz);
+      tree.Fill();
+      ++evCount;
+    }
+    return evCount;
+  }
+
+  /// Apply the photon policy and copy the event into the branch vectors.
+  void FillEvent(const std::vector<int>& e_pid, const std::vector<float>& e_px, const std::vector<float>& e_py, const std::vector<float>& e_pz,
+                 std::vector<int>& v_pid, std::vector<float>& v_px, std::vector<float>& v_py, std::vector<float>& v_pz) const {
+    v_pid.clear();
+    v_px.clear();
+    v_py.clear();
+    v_pz.clear();
+    v_pid.reserve(e_pid.size());
+    v_px.reserve(e_pid.size());
+    v_py.reserve(e_pid.size());
+    v_pz.reserve(e_pid.size());
+
+    int keepPhotonIdx = -1;
+    if (fPolicy == PhotonPolicy::kFirstPhoton) {
+      for (size_t i = 0; i < e_pid.size(); ++i) {
+        if (e_pid[i] == 22) {
+          keepPhotonIdx = static_cast<int>(i);
+          break;
+        }
+      }
+    } else if (fPolicy == PhotonPolicy::kMaxEnergyPhoton) {
+      float bestE2 = -1.f;
+      for (size_t i = 0; i < e_pid.size(); ++i) {
+        if (e_pid[i] != 22) continue;
+        // E ~ |p| for the photon
+        const float E2 = e_px[i] * e_px[i] + e_py[i] * e_py[i] + e_pz[i] * e_pz[i];
+        if (E2 > bestE2) {
+          bestE2 = E2;
+          keepPhotonIdx = static_cast<int>(i);
+        }
+      }
+    }
+
+    for (size_t i = 0; i < e_pid.size(); ++i) {
+      if (fPolicy != PhotonPolicy::kKeepAll && e_pid[i] == 22 && static_cast<int>(i) != keepPhotonIdx) continue;
+      v_pid.push_back(e_pid[i]);
+      v_px.push_back(e_px[i]);
+      v_py.push_back(e_py[i]);
+      v_pz.push_back(e_pz[i]);
+    }
+  }
+
+  std::string fInputPattern;
+  std::string fOutputPath;
+  PhotonPolicy fPolicy = PhotonPolicy::kFirstPhoton;
+  std::unordered_set<std::string> fExcluded;
+  int fNumWorkers = 0;
+};
+
+#endif  // LUNDTOROOTCONVERTER_H
@@ -1,43 +1,82 @@
 // ===== PerRunCounter.h =====
 #pragma once
 #include <ROOT/RDataFrame.hxx>
+#include <ROOT/RDF/RActionImpl.hxx>
 #include <unordered_map>
 #include <vector>
 #include <fstream>
 #include <algorithm>
+#include <memory>
 #include <type_traits>
 #include <string>
+#include <utility>
 
-// 统计 df 上指定 run 列的频次，并写出 CSV: run,count
-// 返回 <run, count> 的升序向量。
-// TRun 必须是整型（int, long, int64_t ...）
+// Streaming per-run counter: a Book'd custom action that keeps one
+// unordered_map per processing slot and merges them in Finalize, so memory is
+// O(unique runs) instead of O(events) as with the old Take-based version.
+// Because it is a regular lazy RDF result it can be booked alongside a
+// Snapshot and computed in the same event loop.
+// TRun must be an integral type (int, long, int64_t ...).
 template <typename TRun>
-std::vector<std::pair<TRun, long long>>
-CountPerRunAndWriteCSV(ROOT::RDF::RNode df,
-                       const std::string& run_col,
-                       const std::string& out_csv_path)
-{
+class PerRunCountAction : public ROOT::Detail::RDF::RActionImpl<PerRunCountAction<TRun>> {
   static_assert(std::is_integral<TRun>::value, "TRun must be an integral type");
 
-  // 触发执行并取出 run 列
-  auto runs_res = df.Take<TRun>(run_col);
-  const std::vector<TRun>& runs = runs_res.GetValue();
+ public:
+  using Result_t = std::vector<std::pair<TRun, long long>>;  // sorted by run
+
+  explicit PerRunCountAction(unsigned int nSlots)
+      : fPerSlot(nSlots), fResult(std::make_shared<Result_t>()) {}
+  PerRunCountAction(PerRunCountAction&&) = default;
+  PerRunCountAction(const PerRunCountAction&) = delete;
+
+  void Initialize() {}
+  void InitTask(TTreeReader*, unsigned int) {}
+
+  void Exec(unsigned int slot, TRun run) { ++fPerSlot[slot][run]; }
+
+  void Finalize() {
+    std::unordered_map<TRun, long long> merged;
+    for (const auto& m : fPerSlot)
+      for (const auto& kv : m) merged[kv.first] += kv.second;
+    fResult->assign(merged.begin(), merged.end());
+    std::sort(fResult->begin(), fResult->end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+  }
+
+  std::shared_ptr<Result_t> GetResultPtr() const { return fResult; }
+  std::string GetActionName() { return "PerRunCount"; }
 
-  // 计数
-  std::unordered_map<TRun, long long> cnt;
-  cnt.reserve(runs.size()/8 + 8);
-  for (auto r : runs) ++cnt[r];
+ private:
+  std::vector<std::unordered_map<TRun, long long>> fPerSlot;
+  std::shared_ptr<Result_t> fResult;
+};
 
-  // 升序整理
-  std::vector<std::pair<TRun, long long>> items(cnt.begin(), cnt.end());
-  std::sort(items.begin(), items.end(),
-            [](const auto& a, const auto& b){ return a.first < b.first; });
+// Book the streaming counter on the given run column (lazy result).
+template <typename TRun>
+ROOT::RDF::RResultPtr<typename PerRunCountAction<TRun>::Result_t>
+BookPerRunCount(ROOT::RDF::RNode df, const std::string& run_col) {
+  const unsigned int nSlots = std::max(1u, df.GetNSlots());
+  return df.Book<TRun>(PerRunCountAction<TRun>(nSlots), {run_col});
+}
 
-  // 写 CSV
+// Write <run, count> pairs as CSV: run,count
+template <typename TRun>
+void WritePerRunCSV(const std::vector<std::pair<TRun, long long>>& items,
+                    const std::string& out_csv_path) {
   std::ofstream ofs(out_csv_path);
   ofs << "run,events_afterFid\n";
   for (const auto& kv : items) ofs << kv.first << "," << kv.second << "\n";
-  ofs.close();
+}
 
-  return items; // 如不需要返回，可改为 void
+// Convenience wrapper with the old signature: books the streaming action,
+// triggers the loop, writes the CSV and returns the sorted counts.
+template <typename TRun>
+std::vector<std::pair<TRun, long long>>
+CountPerRunAndWriteCSV(ROOT::RDF::RNode df,
+                       const std::string& run_col,
+                       const std::string& out_csv_path)
+{
+  auto items = BookPerRunCount<TRun>(df, run_col);
+  WritePerRunCSV(*items, out_csv_path);
+  return *items;
 }
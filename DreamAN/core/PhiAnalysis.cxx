@@ -1,6 +1,9 @@
 #include "PhiAnalysis.h"
 
+#include <TROOT.h>
+
 #include <cmath>
+#include <memory>
 #include <stdexcept>
 #include <unordered_set>
 
@@ -9,20 +12,7 @@
 #include <algorithm>
 #include "ROOT/RVec.hxx"
 
-// Returns the run and event column names from an RHipoDS-backed node.
-// RHipoDS translates "RUN::config.run" -> "RUN_config_run" (:: -> _, . -> _).
-static inline std::pair<std::string,std::string>
-PickRunEventCols(ROOT::RDF::RNode df) {
-  auto cols = df.GetColumnNames();
-  auto has = [&](const std::string& n){
-    return std::find(cols.begin(), cols.end(), n) != cols.end();
-  };
-  if (has("RUN_config_run") && has("RUN_config_event"))
-    return {"RUN_config_run", "RUN_config_event"};
-  if (has("RUN::config.run") && has("RUN::config.event"))
-    return {"RUN::config.run", "RUN::config.event"};
-  throw std::runtime_error("QADB: cannot find run/event columns");
-}
+#include "RunEventColumns.h"
 
 PhiAnalysis::PhiAnalysis(bool IsMC, bool IsReproc, bool IsMinBook) : IsMC(IsMC), IsReproc(IsReproc), IsMinBooking(IsMinBook), fHistPhotonP(nullptr) {}
 PhiAnalysis::~PhiAnalysis() {}
@@ -32,7 +22,10 @@ void PhiAnalysis::UserCreateOutputObjects() {}
 void PhiAnalysis::UserExec(ROOT::RDF::RNode& df) {
   using namespace std;
 
-  if (fMaxEvents > 0) {
+  if (fMaxEvents > 0 && !ROOT::IsImplicitMTEnabled()) {
+    // Range() forces single-threaded execution; under IMT the bound is
+    // applied by Events instead, which trims the input file list to
+    // ~fMaxEvents events via MaxEventsHint and the header-only census.
     df = df.Range(0, fMaxEvents);  // only process the first fMaxEvents
   }
   if (!fTrackCuts || !fEventCuts) throw std::runtime_error("PhiAnalysis: One or more cut not set.");
@@ -74,15 +67,38 @@ void PhiAnalysis::UserExec(ROOT::RDF::RNode& df) {
   // auto colnames = df.GetColumnNames();
   auto dfDefs = df;
   dfDefs = DefineOrRedefine(dfDefs, "REC_Particle_num", [](const std::vector<int>& pid) { return static_cast<int>(pid.size()); }, {"REC_Particle_pid"});
-  dfDefs = DefineOrRedefine(dfDefs, "REC_Particle_theta", RECParticletheta(), RECParticle::All());
-  dfDefs = DefineOrRedefine(dfDefs, "REC_Particle_phi", RECParticlephi(), RECParticle::All());
-  dfDefs = DefineOrRedefine(dfDefs, "REC_Particle_p", RECParticleP(), RECParticle::All());
+  dfDefs = DefineOrRedefine(dfDefs, "REC_Particle_kin", RECParticleKinematics(), RECParticle::All());
+  dfDefs = DefineOrRedefine(dfDefs, "REC_Particle_theta", [](const RECParticleKin& kin) { return kin.theta; }, {"REC_Particle_kin"});
+  dfDefs = DefineOrRedefine(dfDefs, "REC_Particle_phi", [](const RECParticleKin& kin) { return kin.phi; }, {"REC_Particle_kin"});
+  dfDefs = DefineOrRedefine(dfDefs, "REC_Particle_p", [](const RECParticleKin& kin) { return kin.p; }, {"REC_Particle_kin"});
   dfDefs = DefineOrRedefine(dfDefs, "num_events", [](ULong64_t e) { return e; }, {"rdfentry_"});
 
 
   dforginal = dfDefs;
   // Fiducial cuts
   auto dfDefsWithTraj = dfDefs;
+
+  // Topology prefilter: an event whose pid column does not even contain the
+  // required species counts can never satisfy the minCount constraints — the
+  // kinematic and fiducial cuts only shrink the candidate counts — so reject
+  // it with one scan of REC_Particle_pid before the bank walks and kinematic
+  // Defines are ever evaluated.
+  if (fEventCuts) {
+    const auto required = fEventCuts->RequiredPidCounts();
+    if (!required.empty()) {
+      dfDefsWithTraj = dfDefsWithTraj.Filter(
+          [required](const std::vector<int>& pid) {
+            for (const auto& [pidWanted, minCount] : required) {
+              int n = 0;
+              for (int p : pid)
+                if (p == pidWanted && ++n >= minCount) break;
+              if (n < minCount) return false;
+            }
+            return true;
+          },
+          {"REC_Particle_pid"}, "Topology prefilter");
+    }
+  }
   auto trajCols    = CombineColumns(RECTraj::ForFiducialCut(), std::vector<std::string>{"REC_Particle_pid"}, std::vector<std::string>{"REC_Particle_num"});
   auto caloCols    = CombineColumns(RECCalorimeter::ForFiducialCut(), std::vector<std::string>{"REC_Particle_pid"}, std::vector<std::string>{"REC_Particle_p"}, std::vector<std::string>{"REC_Particle_num"});
   auto fwdtagCols  = CombineColumns(RECForwardTagger::ForFiducialCut(), std::vector<std::string>{"REC_Particle_pid"}, std::vector<std::string>{"REC_Particle_num"});
@@ -102,36 +118,65 @@ void PhiAnalysis::UserExec(ROOT::RDF::RNode& df) {
   }
   auto AllCols = CombineColumns(trajCols, caloCols);
 
-  auto cols_track_fid = CombineColumns(RECParticle::All(), std::vector<std::string>{"REC_Track_pass_fid"});
-  auto cols_track_nofid = CombineColumns(RECParticle::All(), std::vector<std::string>{"REC_Track_pass_nofid"});
+  // must be set before the cuts are captured into the Defines below
+  if (fDoInvMassCut) {
+    fEventCuts->SetDoCutMotherInvMass(true);
+  }
+
+  // Same trick as in DVCSAnalysis: the nofid and fid chains differ only in
+  // the fiducial mask, so the per-particle kinematic classification is
+  // computed once and each EventCutResult is derived from it plus the mask.
+  // Classification and results live in per-slot arenas owned by the Define
+  // functors (the columns carry pointers into the current slot's buffer), so
+  // the selection allocates nothing per event in steady state.
+  const EventCut evCuts = *fEventCuts;
+  const unsigned int nSlots = std::max(1u, dfDefsWithTraj.GetNSlots());
+  auto clsArena = std::make_shared<std::vector<EventCutClassification>>(nSlots);
+  dfDefsWithTraj = DefineSlotOrRedefine(
+      dfDefsWithTraj, "EventCutClassification",
+      [evCuts, clsArena](unsigned int slot, const std::vector<int>& pid, const std::vector<float>& px, const std::vector<float>& py, const std::vector<float>& pz,
+                         const std::vector<float>& vx, const std::vector<float>& vy, const std::vector<float>& vz, const std::vector<float>& vt,
+                         const std::vector<short>& charge, const std::vector<float>& beta, const std::vector<float>& chi2pid, const std::vector<short>& status) {
+        EventCutClassification& cls = (*clsArena)[slot];
+        evCuts.Classify(pid, px, py, pz, vx, vy, vz, vt, charge, beta, chi2pid, status, cls);
+        return static_cast<const EventCutClassification*>(&cls);
+      },
+      RECParticle::All());
+  // One result arena per chain: both Defines can run for the same slot/event.
+  auto makeApplyMask = [evCuts, nSlots]() {
+    auto resArena = std::make_shared<std::vector<EventCutResult>>(nSlots);
+    return [evCuts, resArena](unsigned int slot, const EventCutClassification* cls, const std::vector<int>& mask) {
+      EventCutResult& result = (*resArena)[slot];
+      evCuts.ApplyFiducialMask(*cls, mask, result);
+      return static_cast<const EventCutResult*>(&result);
+    };
+  };
 
   dfSelected = dfDefsWithTraj;
-  dfSelected = DefineOrRedefine(*dfSelected, "EventCutResult", *fEventCuts, cols_track_nofid);
-  dfSelected = DefineOrRedefine(*dfSelected, "REC_Event_pass", [](const EventCutResult& result) { return result.eventPass; }, {"EventCutResult"});
-  dfSelected = DefineOrRedefine(*dfSelected, "REC_Particle_pass", [](const EventCutResult& result) { return result.particlePass; }, {"EventCutResult"});
+  dfSelected = DefineSlotOrRedefine(*dfSelected, "EventCutResult", makeApplyMask(), {"EventCutClassification", "REC_Track_pass_nofid"});
+  dfSelected = DefineOrRedefine(*dfSelected, "REC_Event_pass", [](const EventCutResult* result) { return result->eventPass; }, {"EventCutResult"});
+  dfSelected = DefineOrRedefine(*dfSelected, "REC_Particle_pass", [](const EventCutResult* result) { return result->particlePass; }, {"EventCutResult"});
 
   if (fDoInvMassCut) {
-    fEventCuts->SetDoCutMotherInvMass(true);
-    dfSelected = DefineOrRedefine(*dfSelected, "REC_DaughterParticle_pass", [](const EventCutResult& result) { return result.particleDaughterPass; }, {"EventCutResult"});
-    dfSelected = DefineOrRedefine(*dfSelected, "REC_MotherMass", [](const EventCutResult& result) { return result.MotherMass; }, {"EventCutResult"});
+    dfSelected = DefineOrRedefine(*dfSelected, "REC_DaughterParticle_pass", [](const EventCutResult* result) { return result->particleDaughterPass; }, {"EventCutResult"});
+    dfSelected = DefineOrRedefine(*dfSelected, "REC_MotherMass", [](const EventCutResult* result) { return result->MotherMass; }, {"EventCutResult"});
   }
 
-  dfSelected = dfSelected->Filter("REC_Event_pass");
+  dfSelected = dfSelected->Filter([](bool pass) { return pass; }, {"REC_Event_pass"}, "event pass");
   // After fiducial cut
   if (fFiducialCut) {
     dfSelected_afterFid = dfDefsWithTraj;
-    dfSelected_afterFid = DefineOrRedefine(*dfSelected_afterFid, "EventCutResult", *fEventCuts, cols_track_fid);
-    dfSelected_afterFid = DefineOrRedefine(*dfSelected_afterFid, "REC_Event_pass", [](const EventCutResult& result) { return result.eventPass; }, {"EventCutResult"});
-    dfSelected_afterFid = DefineOrRedefine(*dfSelected_afterFid, "REC_Particle_pass", [](const EventCutResult& result) { return result.particlePass; }, {"EventCutResult"});
-  
+    dfSelected_afterFid = DefineSlotOrRedefine(*dfSelected_afterFid, "EventCutResult", makeApplyMask(), {"EventCutClassification", "REC_Track_pass_fid"});
+    dfSelected_afterFid = DefineOrRedefine(*dfSelected_afterFid, "REC_Event_pass", [](const EventCutResult* result) { return result->eventPass; }, {"EventCutResult"});
+    dfSelected_afterFid = DefineOrRedefine(*dfSelected_afterFid, "REC_Particle_pass", [](const EventCutResult* result) { return result->particlePass; }, {"EventCutResult"});
+
     if (fDoInvMassCut) {
-      fEventCuts->SetDoCutMotherInvMass(true);
       dfSelected_afterFid =
-          DefineOrRedefine(*dfSelected_afterFid, "REC_DaughterParticle_pass", [](const EventCutResult& result) { return result.particleDaughterPass; }, {"EventCutResult"});
-      dfSelected_afterFid = DefineOrRedefine(*dfSelected_afterFid, "REC_MotherMass", [](const EventCutResult& result) { return result.MotherMass; }, {"EventCutResult"});
+          DefineOrRedefine(*dfSelected_afterFid, "REC_DaughterParticle_pass", [](const EventCutResult* result) { return result->particleDaughterPass; }, {"EventCutResult"});
+      dfSelected_afterFid = DefineOrRedefine(*dfSelected_afterFid, "REC_MotherMass", [](const EventCutResult* result) { return result->MotherMass; }, {"EventCutResult"});
     }
 
-    dfSelected_afterFid = dfSelected_afterFid->Filter("REC_Event_pass");
+    dfSelected_afterFid = dfSelected_afterFid->Filter([](bool pass) { return pass; }, {"REC_Event_pass"}, "event pass (fid)");
   }
 
   dfSelected_afterFid_afterCorr = dfSelected_afterFid;
@@ -139,24 +184,23 @@ void PhiAnalysis::UserExec(ROOT::RDF::RNode& df) {
     // QADB cuts should be place in the first to reduce the computation load
 if (fIsQADBCut && fQADBCuts) {
   std::cout << "Applying QADB cut..." << std::endl;
+  // Warm start from the shared binary cache if one matching this defect
+  // configuration exists; otherwise decisions are cached as we go.
+  QADBCuts::LoadDecisionCache();
 
   auto node = *dfSelected_afterFid_afterCorr;
-  auto [runCol, evCol] = PickRunEventCols(node);
+  // Canonical scalar int run/event columns — a no-op on dataframes coming
+  // from Events, which normalizes them up front.
+  node = NormalizeRunEventColumns(node);
 
   // Use a typed lambda wrapping the functor so ROOT can deduce the return type.
-  // QADBCuts has multiple operator() overloads which prevents ROOT's CallableTraits
-  // from deducing ret_type if the functor is passed directly.
-  // RHipoDS exposes RUN::config.run as a scalar int (nrows=1 bank).
-  // We pass the source columns directly — no intermediate Define nodes — so that
-  // GetColumnReadersImpl for these columns is called in the single-threaded init
-  // phase together with all other source columns, not lazily from worker threads.
   auto qadb = *fQADBCuts;
   node = node.Define("REC_QADB_pass",
                      [qadb](int run, int ev) mutable -> bool {
                        return qadb(run, ev);
                      },
-                     {runCol, evCol})
-             .Filter("REC_QADB_pass", "QADB pass");
+                     {"RUN_run", "RUN_event"})
+             .Filter([](bool pass) { return pass; }, {"REC_QADB_pass"}, "QADB pass");
 
   dfSelected_afterFid_afterCorr = node;
 }
@@ -164,12 +208,16 @@ if (fIsQADBCut && fQADBCuts) {
 
   if (fMomCorr && fDoMomentumCorrection) {
     std::cout << "Applying momentum correction..." << std::endl;
-    dfSelected_afterFid_afterCorr = DefineOrRedefine(*dfSelected_afterFid_afterCorr, "REC_Particle_px", fMomCorr->RECParticlePxCorrected(), RECParticle::Extend());
-    dfSelected_afterFid_afterCorr = DefineOrRedefine(*dfSelected_afterFid_afterCorr, "REC_Particle_py", fMomCorr->RECParticlePyCorrected(), RECParticle::Extend());
-    dfSelected_afterFid_afterCorr = DefineOrRedefine(*dfSelected_afterFid_afterCorr, "REC_Particle_pz", fMomCorr->RECParticlePzCorrected(), RECParticle::Extend());
-    dfSelected_afterFid_afterCorr = DefineOrRedefine(*dfSelected_afterFid_afterCorr, "REC_Particle_theta", RECParticletheta(), RECParticle::All());
-    dfSelected_afterFid_afterCorr = DefineOrRedefine(*dfSelected_afterFid_afterCorr, "REC_Particle_phi", RECParticlephi(), RECParticle::All());
-    dfSelected_afterFid_afterCorr = DefineOrRedefine(*dfSelected_afterFid_afterCorr, "REC_Particle_p", RECParticleP(), RECParticle::All());
+    // Fused correction kernel, as in DVCSAnalysis: one traversal per event
+    // instead of three, and no kinematics re-Define afterwards.
+    using CorrKin = MomentumCorrection::CorrectedKinematics;
+    dfSelected_afterFid_afterCorr = DefineOrRedefine(*dfSelected_afterFid_afterCorr, "REC_Particle_corr", fMomCorr->RECParticleCorrected(), RECParticle::Extend());
+    dfSelected_afterFid_afterCorr = DefineOrRedefine(*dfSelected_afterFid_afterCorr, "REC_Particle_px", [](const CorrKin& c) { return c.px; }, {"REC_Particle_corr"});
+    dfSelected_afterFid_afterCorr = DefineOrRedefine(*dfSelected_afterFid_afterCorr, "REC_Particle_py", [](const CorrKin& c) { return c.py; }, {"REC_Particle_corr"});
+    dfSelected_afterFid_afterCorr = DefineOrRedefine(*dfSelected_afterFid_afterCorr, "REC_Particle_pz", [](const CorrKin& c) { return c.pz; }, {"REC_Particle_corr"});
+    dfSelected_afterFid_afterCorr = DefineOrRedefine(*dfSelected_afterFid_afterCorr, "REC_Particle_theta", [](const CorrKin& c) { return c.theta; }, {"REC_Particle_corr"});
+    dfSelected_afterFid_afterCorr = DefineOrRedefine(*dfSelected_afterFid_afterCorr, "REC_Particle_phi", [](const CorrKin& c) { return c.phi; }, {"REC_Particle_corr"});
+    dfSelected_afterFid_afterCorr = DefineOrRedefine(*dfSelected_afterFid_afterCorr, "REC_Particle_p", [](const CorrKin& c) { return c.p; }, {"REC_Particle_corr"});
   }
 }
 // ---------------------------------------------------------------------------
@@ -233,7 +281,42 @@ std::vector<std::string> PhiAnalysis::MinimalColumns() const {
   return cols;
 }
 
+// ---------------------------------------------------------------------------
+// RequestedColumns – the HIPO banks this task reads, as prefixes for the
+// datasource pruning in Events (see ColumnPrunedHipoDS).  Only active when
+// column optimisation is on; the full-snapshot path writes every input
+// column and therefore still needs the complete schema.
+// ---------------------------------------------------------------------------
+std::vector<std::string> PhiAnalysis::RequestedColumns() const {
+  if (!fOptimizeColumns) return {};
+
+  std::vector<std::string> banks = {"REC_Particle", "REC_Track", "REC_Traj", "REC_Calorimeter", "REC_Event",
+                                    "RUN_config", "RUN::config.run", "RUN::config.event"};
+  if (fFTonConfig) banks.push_back("REC_ForwardTagger");
+  if (IsMC) {
+    for (const char* b : {"MC_Particle", "MC_Event", "MC_Lund", "MC_RecMatch", "MC_GenMatch"})
+      banks.emplace_back(b);
+  }
+  return banks;
+}
+
 void PhiAnalysis::SaveOutput() {
+  // Shared-loop mode: the manager's RunGraphs already drove every handle
+  // booked in BookLazyOutputs, so only the bookkeeping prints remain.
+  if (fOutputsBooked) {
+    if (fCntSel.has_value()) std::cout << "Events selected: " << *(*fCntSel) << std::endl;
+    if (fCntFid.has_value()) std::cout << "Events after fiducial   : " << *(*fCntFid) << std::endl;
+    if (fCntCorr.has_value())
+      std::cout << "Events selected after fiducial and momentum correction: " << *(*fCntCorr) << std::endl;
+    if (fIsQADBCut) {
+      std::cout << "\n[QADB] total accumulated charge analyzed: "
+                << fQADBCuts->GetAccumulatedCharge() / 1e6
+                << " mC (per-bin accounting, safe with MT)\n";
+      QADBCuts::SaveDecisionCache();
+    }
+    return;
+  }
+
   // If UserExec returned early (missing bank columns), dforginal and dfSelected
   // are both unset. Nothing to write — exit silently.
   if (!dforginal.has_value()) {
@@ -252,7 +335,8 @@ void PhiAnalysis::SaveOutput() {
          "MC_Lund_parent", "MC_Lund_daughter",
          "MC_RecMatch_pindex", "MC_RecMatch_mcindex",
          "MC_GenMatch_pindex", "MC_GenMatch_mcindex", "MC_GenMatch_quality",
-         "MC_Event_weight", "MC_Event_pbeam", "MC_Event_ptarget", "MC_Event_ebeam"});
+         "MC_Event_weight", "MC_Event_pbeam", "MC_Event_ptarget", "MC_Event_ebeam"},
+        MakeSnapshotOptions(/*lazy=*/false, SnapshotProfile::kArchival));
   }
 
   if (!dfSelected.has_value()) {
@@ -266,19 +350,7 @@ void PhiAnalysis::SaveOutput() {
     std::cout << "[SaveOutput] Column optimisation OFF — writing all columns.\n";
   }
 
-  // -----------------------------------------------------------------------
-  // Helper: resolve the output column list for a given dataframe node.
-  //   fOptimizeColumns = true  → MinimalColumns() filtered to what exists
-  //   fOptimizeColumns = false → every column except EventCutResult (the
-  //                              internal struct ROOT cannot serialise)
-  // -----------------------------------------------------------------------
-  auto resolveColumns = [this](ROOT::RDF::RNode& node) -> std::vector<std::string> {
-    if (fOptimizeColumns) {
-      return ResolveSnapshotColumns(node, MinimalColumns());
-    } else {
-      return SafeSnapshotColumns(node, {"EventCutResult"});
-    }
-  };
+  auto resolveColumns = [this](ROOT::RDF::RNode& node) { return OutputColumns(node); };
 
   // -----------------------------------------------------------------------
   // Count() in RDF is always lazy — it books an action but waits for a loop
@@ -294,7 +366,7 @@ void PhiAnalysis::SaveOutput() {
     auto cols = resolveColumns(*dfSelected);
     auto cnt  = dfSelected->Count();           // book (lazy) — shares the loop below
     dfSelected->Snapshot("dfSelected",
-                    Form("%s/%s", fOutputDir.c_str(), "dfSelected.root"), cols);  // triggers loop
+                    Form("%s/%s", fOutputDir.c_str(), "dfSelected.root"), cols, MakeSnapshotOptions());  // triggers loop
     if (fFiducialCut)
       std::cout << "Events selected: " << *cnt << std::endl;  // already computed
   }
@@ -322,7 +394,7 @@ void PhiAnalysis::SaveOutput() {
       dfSelected_afterFid_afterCorr->Snapshot(
           "dfSelected_afterFid_afterCorr",
           Form("%s/%s", fOutputDir.c_str(), "dfSelected_afterFid_afterCorr.root"),
-          cols_corr);                                       // triggers loop → computes cnt
+          cols_corr, MakeSnapshotOptions());                // triggers loop → computes cnt
       std::cout << "Events selected after fiducial and momentum correction: " << *cnt << std::endl;
     } else {
       std::cout << "Events selected after fiducial and momentum correction: "
@@ -333,7 +405,75 @@ void PhiAnalysis::SaveOutput() {
   if (fIsQADBCut) {
     std::cout << "\n[QADB] total accumulated charge analyzed: "
               << fQADBCuts->GetAccumulatedCharge() / 1e6
-              << " mC (Do NOT use this number if you enable MT)\n";
+              << " mC (per-bin accounting, safe with MT)\n";
+    QADBCuts::SaveDecisionCache();
+  }
+}
+
+// Output column list for one snapshot node:
+//   fOptimizeColumns = true  → MinimalColumns() filtered to what exists
+//   fOptimizeColumns = false → every column except EventCutResult (the
+//                              internal struct ROOT cannot serialise)
+std::vector<std::string> PhiAnalysis::OutputColumns(ROOT::RDF::RNode& node) {
+  if (fOptimizeColumns) {
+    return ResolveSnapshotColumns(node, MinimalColumns());
   }
+  return SafeSnapshotColumns(node, {"EventCutResult", "EventCutClassification", "REC_Particle_kin", "REC_Particle_corr"});
+}
+
+bool PhiAnalysis::BookLazyOutputs(std::vector<ROOT::RDF::RResultHandle>& handles) {
+  if (!dforginal.has_value() || !dfSelected.has_value()) return false;
+
+  fSnapHandles.clear();
+  fCntSel.reset();
+  fCntFid.reset();
+  fCntCorr.reset();
+
+  if (IsMC) {
+    auto snapMC = dforginal->Snapshot(
+        "dfSelectedMC", Form("%s/%s", fOutputDir.c_str(), "dfSelectedMC.root"),
+        {"num_events",
+         "MC_Particle_pid", "MC_Particle_px", "MC_Particle_py", "MC_Particle_pz",
+         "MC_Particle_vx",  "MC_Particle_vy", "MC_Particle_vz", "MC_Particle_vt",
+         "MC_Lund_pid", "MC_Lund_px", "MC_Lund_py", "MC_Lund_pz",
+         "MC_Lund_parent", "MC_Lund_daughter",
+         "MC_RecMatch_pindex", "MC_RecMatch_mcindex",
+         "MC_GenMatch_pindex", "MC_GenMatch_mcindex", "MC_GenMatch_quality",
+         "MC_Event_weight", "MC_Event_pbeam", "MC_Event_ptarget", "MC_Event_ebeam"},
+        MakeSnapshotOptions(/*lazy=*/true, SnapshotProfile::kArchival));
+    fSnapHandles.emplace_back(snapMC);
+  }
+
+  if (!IsReproc && !IsMinBooking) {
+    fCntSel = dfSelected->Count();
+    auto snap = dfSelected->Snapshot("dfSelected", Form("%s/%s", fOutputDir.c_str(), "dfSelected.root"),
+                                     OutputColumns(*dfSelected), MakeSnapshotOptions(/*lazy=*/true));
+    fSnapHandles.emplace_back(*fCntSel);
+    fSnapHandles.emplace_back(snap);
+  }
+
+  if (fFiducialCut && dfSelected_afterFid.has_value() && IsReproc) {
+    // Counts only, as in the eager path: afterCorr is the authoritative output.
+    fCntSel = dfSelected->Count();
+    fCntFid = dfSelected_afterFid->Count();
+    fSnapHandles.emplace_back(*fCntSel);
+    fSnapHandles.emplace_back(*fCntFid);
+  }
+
+  if (fDoMomentumCorrection && dfSelected_afterFid_afterCorr.has_value()) {
+    fCntCorr = dfSelected_afterFid_afterCorr->Count();
+    fSnapHandles.emplace_back(*fCntCorr);
+    if (!IsMinBooking) {
+      auto snap = dfSelected_afterFid_afterCorr->Snapshot(
+          "dfSelected_afterFid_afterCorr",
+          Form("%s/%s", fOutputDir.c_str(), "dfSelected_afterFid_afterCorr.root"),
+          OutputColumns(*dfSelected_afterFid_afterCorr), MakeSnapshotOptions(/*lazy=*/true));
+      fSnapHandles.emplace_back(snap);
+    }
+  }
+
+  handles.insert(handles.end(), fSnapHandles.begin(), fSnapHandles.end());
+  fOutputsBooked = true;
+  return true;
 }
 void PhiAnalysis::SetOutputDir(const std::string& dir) { fOutputDir = dir; }
\ No newline at end of file
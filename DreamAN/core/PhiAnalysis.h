@@ -30,7 +30,14 @@ class PhiAnalysis : public AnalysisTask {
   void UserCreateOutputObjects() override;
   void UserExec(ROOT::RDF::RNode& df) override;
   void SaveOutput() override;
+  // Shared-loop support: books the snapshots and counts lazily and hands the
+  // handles to the manager's single RunGraphs pass, so a DVCS + Phi job
+  // reads the input once for both channels.  SaveOutput then only prints the
+  // already-materialized counts.
+  bool BookLazyOutputs(std::vector<ROOT::RDF::RResultHandle>& handles) override;
+  std::vector<std::string> RequestedColumns() const override;
   void SetMaxEvents(size_t n) { fMaxEvents = n; }
+  size_t MaxEventsHint() const override { return fMaxEvents; }
   // Bad for raw pointer setup
   void SetTrackCuts(std::shared_ptr<TrackCut> cuts) { fTrackCuts = std::move(cuts); };
 
@@ -62,6 +69,8 @@ class PhiAnalysis : public AnalysisTask {
   // Returns the minimal set of columns needed to re-run the analysis.
   // Only used when fOptimizeColumns is true.
   std::vector<std::string> MinimalColumns() const;
+  // Output column list for one snapshot node, honouring fOptimizeColumns.
+  std::vector<std::string> OutputColumns(ROOT::RDF::RNode& node);
 
   bool IsMC = false;
   bool fDoInvMassCut = false;
@@ -82,6 +91,12 @@ class PhiAnalysis : public AnalysisTask {
   std::optional<ROOT::RDF::RNode> dfSelected_afterFid_afterCorr;  // DataFrame after fiducial cuts and momentum correction
   std::string fOutputDir;
 
+  // Shared-loop state: handles booked by BookLazyOutputs and the counts
+  // SaveOutput prints once the manager's RunGraphs has materialized them.
+  std::vector<ROOT::RDF::RResultHandle> fSnapHandles;
+  std::optional<ROOT::RDF::RResultPtr<ULong64_t>> fCntSel, fCntFid, fCntCorr;
+  bool fOutputsBooked = false;
+
   float fbeam_energy = 10.6;
 
   TH1F* fHistPhotonP = nullptr;
@@ -0,0 +1,138 @@
+#include "PipelineTimer.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+// VmRSS / VmHWM from /proc/self/status, in MB; -1 where the file or the
+// field is unavailable (non-Linux builds keep working, just without RSS).
+long ReadProcStatusMB(const char* field) {
+  std::ifstream status("/proc/self/status");
+  if (!status.is_open()) return -1;
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.compare(0, std::string(field).size(), field) != 0) continue;
+    std::istringstream ss(line.substr(std::string(field).size() + 1));
+    long kb = -1;
+    ss >> kb;
+    return kb >= 0 ? kb / 1024 : -1;
+  }
+  return -1;
+}
+
+}  // namespace
+
+PipelineTimer& PipelineTimer::Instance() {
+  static PipelineTimer timer;
+  return timer;
+}
+
+PipelineTimer::Sampler PipelineTimer::MakeSampler(const std::string& name,
+                                                  unsigned int sampleEvery) {
+  if (!fEnabled) return Sampler();
+
+  std::lock_guard<std::mutex> lock(fMutex);
+  for (auto& node : fNodes) {
+    if (node->name == name) return Sampler(node.get());
+  }
+  auto node = std::make_unique<NodeStats>();
+  node->name = name;
+  node->sampleEvery = sampleEvery > 0 ? sampleEvery : 1;
+  fNodes.push_back(std::move(node));
+  return Sampler(fNodes.back().get());
+}
+
+void PipelineTimer::RecordInputFile(const std::string& path,
+                                    unsigned long long bytes) {
+  if (!fEnabled) return;
+  std::lock_guard<std::mutex> lock(fMutex);
+  fInputFiles.emplace_back(path, bytes);
+}
+
+void PipelineTimer::RecordStage(const std::string& name, double seconds) {
+  if (!fEnabled) return;
+  // RSS is read outside the lock; both are cheap but neither needs it.
+  const long rss = CurrentRssMB();
+  const long peak = PeakRssMB();
+  std::lock_guard<std::mutex> lock(fMutex);
+  fStages.push_back({name, seconds, rss, peak});
+}
+
+void PipelineTimer::RecordColumnEstimate(const std::string& label,
+                                         const std::string& column,
+                                         const std::string& type,
+                                         std::size_t elemBytes,
+                                         bool variableLength) {
+  if (!fEnabled) return;
+  std::lock_guard<std::mutex> lock(fMutex);
+  fColumns.push_back({label + "/" + column,
+                      variableLength ? type + " (per element)" : type,
+                      static_cast<unsigned long long>(elemBytes)});
+}
+
+void PipelineTimer::RecordSnapshotBuffers(const std::string& label,
+                                          std::size_t nColumns,
+                                          unsigned int nSlots,
+                                          unsigned long long estBytes) {
+  if (!fEnabled) return;
+  std::ostringstream detail;
+  detail << "ncols=" << nColumns << ";nslots=" << nSlots;
+  std::lock_guard<std::mutex> lock(fMutex);
+  fBuffers.push_back({label, detail.str(), estBytes});
+}
+
+long PipelineTimer::CurrentRssMB() { return ReadProcStatusMB("VmRSS:"); }
+
+long PipelineTimer::PeakRssMB() { return ReadProcStatusMB("VmHWM:"); }
+
+void PipelineTimer::WriteReport(const std::string& path) const {
+  if (!fEnabled) return;
+
+  std::ofstream out(path);
+  if (!out.is_open()) {
+    std::cerr << "[PipelineTimer] Cannot open timing report: " << path << "\n";
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(fMutex);
+  out << "kind,name,detail,calls,sampled_calls,sampled_seconds,est_seconds,"
+         "est_rate_hz,rss_mb,peak_rss_mb,bytes\n";
+
+  for (const auto& node : fNodes) {
+    const auto calls = node->calls.load();
+    const auto sampled = node->sampledCalls.load();
+    const double sampledSec = node->sampledNs.load() * 1e-9;
+    // Scale the sampled time back up by the fraction of calls timed.
+    const double estSec = sampled > 0 ? sampledSec * (static_cast<double>(calls) / sampled) : 0.0;
+    const double rate = estSec > 0.0 ? calls / estSec : 0.0;
+    out << "node," << node->name << ",," << calls << "," << sampled << ","
+        << sampledSec << "," << estSec << "," << rate << ",,,\n";
+  }
+  for (const auto& stage : fStages) {
+    out << "stage," << stage.name << ",,,,," << stage.seconds << ",,"
+        << stage.rssMB << "," << stage.peakRssMB << ",\n";
+  }
+  for (const auto& [file, bytes] : fInputFiles) {
+    out << "input_file," << file << ",,,,,,,,," << bytes << "\n";
+  }
+  for (const auto& col : fColumns) {
+    out << "column," << col.name << "," << col.type << ",,,,,,,," << col.elemBytes << "\n";
+  }
+  for (const auto& buf : fBuffers) {
+    out << "snapshot_buffers," << buf.label << "," << buf.detail
+        << ",,,,,,,," << buf.estBytes << "\n";
+  }
+
+  std::cout << "[PipelineTimer] Timing report written to " << path << "\n";
+}
+
+void PipelineTimer::Reset() {
+  std::lock_guard<std::mutex> lock(fMutex);
+  fNodes.clear();
+  fInputFiles.clear();
+  fStages.clear();
+  fColumns.clear();
+  fBuffers.clear();
+}
@@ -0,0 +1,159 @@
+#ifndef PIPELINETIMER_H
+#define PIPELINETIMER_H
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Lightweight instrumentation surface for the RDataFrame pipeline.
+//
+// Hot functors (fiducial masks, event classification, the correction kernel)
+// register a named Sampler and time every Nth call; the sampled time is
+// scaled back up in the report, so steady-state overhead is one relaxed
+// atomic increment per call.  Whole stages (UserExec graph construction,
+// SaveOutput event loops) and per-input-file byte counts are recorded
+// directly.  WriteReport emits one CSV that downstream tooling can diff
+// between DISANA versions to catch throughput regressions.
+//
+// Everything is a no-op until SetEnabled(true) — typically via
+// AnalysisTaskManager::SetTimingReport — so production jobs pay nothing.
+class PipelineTimer {
+ public:
+  static PipelineTimer& Instance();
+
+  void SetEnabled(bool on) { fEnabled = on; }
+  bool Enabled() const { return fEnabled; }
+
+  struct NodeStats {
+    std::string name;
+    unsigned int sampleEvery = 64;
+    std::atomic<unsigned long long> calls{0};
+    std::atomic<unsigned long long> sampledCalls{0};
+    std::atomic<unsigned long long> sampledNs{0};
+  };
+
+  // RAII sample: times the enclosing scope when this call was selected.
+  class ScopedSample {
+   public:
+    ScopedSample() = default;
+    explicit ScopedSample(NodeStats* stats)
+        : fStats(stats), fStart(std::chrono::steady_clock::now()) {}
+    ScopedSample(const ScopedSample&) = delete;
+    ScopedSample& operator=(const ScopedSample&) = delete;
+    ScopedSample(ScopedSample&& other) noexcept
+        : fStats(other.fStats), fStart(other.fStart) {
+      other.fStats = nullptr;
+    }
+    ~ScopedSample() {
+      if (!fStats) return;
+      const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now() - fStart)
+                          .count();
+      fStats->sampledNs.fetch_add(static_cast<unsigned long long>(ns),
+                                  std::memory_order_relaxed);
+      fStats->sampledCalls.fetch_add(1, std::memory_order_relaxed);
+    }
+
+   private:
+    NodeStats* fStats = nullptr;
+    std::chrono::steady_clock::time_point fStart;
+  };
+
+  // Copyable handle captured into RDF functors.  Sample() costs one relaxed
+  // increment per call and starts a timed scope every sampleEvery-th call.
+  class Sampler {
+   public:
+    Sampler() = default;
+    explicit Sampler(NodeStats* stats) : fStats(stats) {}
+    ScopedSample Sample() const {
+      if (!fStats) return ScopedSample();
+      const auto n = fStats->calls.fetch_add(1, std::memory_order_relaxed);
+      if (n % fStats->sampleEvery != 0) return ScopedSample();
+      return ScopedSample(fStats);
+    }
+
+   private:
+    NodeStats* fStats = nullptr;
+  };
+
+  // Returns an inactive Sampler while disabled, so call sites need no guard.
+  Sampler MakeSampler(const std::string& name, unsigned int sampleEvery = 64);
+
+  // Wrap a std::function-typed functor so every invocation passes through the
+  // sampler; the returned object has the same signature and can be handed to
+  // Define unchanged.
+  template <typename R, typename... Args>
+  static std::function<R(Args...)> Wrap(Sampler sampler,
+                                        std::function<R(Args...)> func) {
+    return [sampler, func = std::move(func)](Args... args) -> R {
+      auto scope = sampler.Sample();
+      return func(std::forward<Args>(args)...);
+    };
+  }
+
+  void RecordInputFile(const std::string& path, unsigned long long bytes);
+  // Also snapshots current and peak RSS at the end of the stage, giving a
+  // per-phase memory profile alongside the wall clock.
+  void RecordStage(const std::string& name, double seconds);
+
+  // Memory telemetry for snapshot column sets: per-column element-size
+  // estimates (variable-length columns are flagged — their in-memory size is
+  // elem_bytes x multiplicity) and an estimate of the per-slot basket
+  // buffers a TTree snapshot holds (ROOT's default basket per branch per
+  // slot).  Labelled by the caller; AnalysisTask labels follow snapshot
+  // booking order.
+  void RecordColumnEstimate(const std::string& label, const std::string& column,
+                            const std::string& type, std::size_t elemBytes,
+                            bool variableLength);
+  void RecordSnapshotBuffers(const std::string& label, std::size_t nColumns,
+                             unsigned int nSlots, unsigned long long estBytes);
+
+  // Current/peak resident set size in MB from /proc/self/status, -1 where
+  // unavailable.
+  static long CurrentRssMB();
+  static long PeakRssMB();
+
+  // One CSV, one header, several record kinds (unused fields left empty):
+  //   node,<name>,,<calls>,<sampled_calls>,<sampled_s>,<est_s>,<est_rate_hz>,,,
+  //   stage,<name>,,,,,<seconds>,,<rss_mb>,<peak_rss_mb>,
+  //   input_file,<path>,,,,,,,,,<bytes>
+  //   column,<label>/<column>,<type>,,,,,,,,<elem_bytes>
+  //   snapshot_buffers,<label>,ncols=..;nslots=..,,,,,,,,<est_bytes>
+  void WriteReport(const std::string& path) const;
+  void Reset();
+
+ private:
+  PipelineTimer() = default;
+
+  struct StageRecord {
+    std::string name;
+    double seconds;
+    long rssMB;
+    long peakRssMB;
+  };
+  struct ColumnRecord {
+    std::string name;  // <label>/<column>
+    std::string type;
+    unsigned long long elemBytes;
+  };
+  struct BufferRecord {
+    std::string label;
+    std::string detail;
+    unsigned long long estBytes;
+  };
+
+  std::atomic<bool> fEnabled{false};
+  mutable std::mutex fMutex;
+  std::vector<std::unique_ptr<NodeStats>> fNodes;
+  std::vector<std::pair<std::string, unsigned long long>> fInputFiles;
+  std::vector<StageRecord> fStages;
+  std::vector<ColumnRecord> fColumns;
+  std::vector<BufferRecord> fBuffers;
+};
+
+#endif  // PIPELINETIMER_H
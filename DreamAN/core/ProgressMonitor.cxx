@@ -0,0 +1,85 @@
+#include "ProgressMonitor.h"
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+namespace {
+std::string FormatHMS(double seconds) {
+  if (seconds < 0) return "--:--:--";
+  const long s = static_cast<long>(seconds + 0.5);
+  char buf[32];
+  std::snprintf(buf, sizeof(buf), "%02ld:%02ld:%02ld", s / 3600, (s / 60) % 60, s % 60);
+  return buf;
+}
+}  // namespace
+
+ProgressMonitor::ProgressMonitor(long totalEvents, std::size_t totalFiles, int intervalSeconds)
+    : fTotalEvents(totalEvents),
+      fTotalFiles(totalFiles),
+      fIntervalSeconds(intervalSeconds > 0 ? intervalSeconds : 30),
+      fCounter(std::make_shared<std::atomic<unsigned long long>>(0)) {}
+
+ProgressMonitor::~ProgressMonitor() { Stop(); }
+
+void ProgressMonitor::Start() {
+  if (fThread.joinable()) return;
+  fStart = std::chrono::steady_clock::now();
+  fStopRequested = false;
+  fThread = std::thread(&ProgressMonitor::Loop, this);
+}
+
+void ProgressMonitor::Stop() {
+  if (!fThread.joinable()) return;
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fStopRequested = true;
+  }
+  fCv.notify_all();
+  fThread.join();
+
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - fStart;
+  const auto events = fCounter->load(std::memory_order_relaxed);
+  const double rate = elapsed.count() > 0 ? events / elapsed.count() : 0.0;
+  std::cout << "[Progress] Done: " << events << " events in " << FormatHMS(elapsed.count())
+            << " (" << static_cast<long>(rate) << " ev/s)\n";
+}
+
+void ProgressMonitor::Loop() {
+  unsigned long long lastEvents = 0;
+  auto lastTime = fStart;
+
+  std::unique_lock<std::mutex> lock(fMutex);
+  while (!fCv.wait_for(lock, std::chrono::seconds(fIntervalSeconds),
+                       [this] { return fStopRequested; })) {
+    const auto now = std::chrono::steady_clock::now();
+    const auto events = fCounter->load(std::memory_order_relaxed);
+    const std::chrono::duration<double> sinceLast = now - lastTime;
+    const std::chrono::duration<double> sinceStart = now - fStart;
+
+    const double rateNow = sinceLast.count() > 0 ? (events - lastEvents) / sinceLast.count() : 0.0;
+
+    std::string line = "[Progress] " + std::to_string(events) + " events, " +
+                       std::to_string(static_cast<long>(rateNow)) + " ev/s";
+
+    if (events == lastEvents) {
+      line += " (no progress in the last interval!)";
+    } else if (fTotalEvents > 0) {
+      const double frac = static_cast<double>(events) / fTotalEvents;
+      if (fTotalFiles > 0) {
+        line += ", ~files " + std::to_string(static_cast<long>(frac * fTotalFiles)) + "/" +
+                std::to_string(fTotalFiles);
+      }
+      const double avgRate = sinceStart.count() > 0 ? events / sinceStart.count() : 0.0;
+      const double remaining = avgRate > 0 ? (fTotalEvents - static_cast<long>(events)) / avgRate : -1.0;
+      char pct[16];
+      std::snprintf(pct, sizeof(pct), "%.1f%%", 100.0 * frac);
+      line += std::string(", ") + pct + ", ETA " + FormatHMS(remaining);
+    }
+
+    std::cout << line << std::endl;
+    lastEvents = events;
+    lastTime = now;
+  }
+}
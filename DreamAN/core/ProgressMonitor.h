@@ -0,0 +1,52 @@
+#ifndef PROGRESSMONITOR_H
+#define PROGRESSMONITOR_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Periodic progress line for long event loops.
+//
+// The event loop bumps a shared relaxed atomic once per event (hooked in as a
+// pass-through Filter by EventProcessor); a detached reporter thread wakes
+// every interval and prints events processed, events/sec, an estimate of the
+// files completed and — when the total event count is known, e.g. from
+// Events::CountEventsFast — an ETA.  A stalled counter is reported as such,
+// so the batch wrapper can kill genuinely stuck jobs instead of wasting
+// node-hours.
+class ProgressMonitor {
+ public:
+  // totalEvents <= 0 means unknown (no percentage/ETA, counts only).
+  ProgressMonitor(long totalEvents, std::size_t totalFiles, int intervalSeconds = 30);
+  ~ProgressMonitor();
+
+  ProgressMonitor(const ProgressMonitor&) = delete;
+  ProgressMonitor& operator=(const ProgressMonitor&) = delete;
+
+  // Counter to increment once per processed event (relaxed is sufficient).
+  std::shared_ptr<std::atomic<unsigned long long>> Counter() const { return fCounter; }
+
+  void Start();
+  void Stop();  // prints a final summary line
+
+ private:
+  void Loop();
+
+  long fTotalEvents;
+  std::size_t fTotalFiles;
+  int fIntervalSeconds;
+
+  std::shared_ptr<std::atomic<unsigned long long>> fCounter;
+  std::chrono::steady_clock::time_point fStart;
+
+  std::thread fThread;
+  std::mutex fMutex;
+  std::condition_variable fCv;
+  bool fStopRequested = false;
+};
+
+#endif  // PROGRESSMONITOR_H
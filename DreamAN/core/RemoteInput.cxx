@@ -0,0 +1,241 @@
+#include "RemoteInput.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include <TFile.h>
+#include <TROOT.h>
+
+namespace fs = std::filesystem;
+
+bool IsRemoteInputUrl(const std::string& path) {
+  for (const char* scheme : {"root://", "xroot://", "xrootd://", "http://", "https://"}) {
+    if (path.rfind(scheme, 0) == 0) return true;
+  }
+  return false;
+}
+
+std::vector<std::string> ReadInputUrlList(const std::string& listPath, int nfiles) {
+  std::vector<std::string> urls;
+  std::ifstream in(listPath);
+  if (!in) {
+    std::cerr << "[RemoteInput] Cannot open input list: " << listPath << "\n";
+    return urls;
+  }
+  for (std::string line; std::getline(in, line);) {
+    const auto b = line.find_first_not_of(" \t\r");
+    if (b == std::string::npos) continue;
+    const auto e = line.find_last_not_of(" \t\r");
+    line = line.substr(b, e - b + 1);
+    if (line.empty() || line[0] == '#') continue;
+    urls.push_back(std::move(line));
+    if (nfiles > 0 && static_cast<int>(urls.size()) >= nfiles) break;
+  }
+  std::cout << "[RemoteInput] Input list " << listPath << ": " << urls.size()
+            << " entrie(s)\n";
+  return urls;
+}
+
+RemoteInputStager::RemoteInputStager(const std::string& cacheDir,
+                                     std::size_t maxConcurrentFetches,
+                                     std::uintmax_t maxCacheBytes)
+  : cacheDir_(cacheDir),
+    maxConcurrent_(std::max<std::size_t>(1, maxConcurrentFetches)),
+    maxCacheBytes_(maxCacheBytes) {}
+
+RemoteInputStager::~RemoteInputStager() { Wait(); }
+
+// Cache entries are keyed by the full URL (FNV-1a, as the derived-column
+// fingerprint uses) so the same filename served from two endpoints never
+// collides; the original basename is kept for readability.
+std::string RemoteInputStager::CachePathFor(const std::string& url) const {
+  unsigned long long h = 1469598103934665603ull;
+  for (const unsigned char c : url) {
+    h ^= c;
+    h *= 1099511628211ull;
+  }
+  char hex[17];
+  std::snprintf(hex, sizeof(hex), "%016llx", h);
+
+  const auto slash = url.find_last_of('/');
+  const std::string base =
+      (slash == std::string::npos || slash + 1 == url.size())
+          ? std::string("file")
+          : url.substr(slash + 1);
+
+  return (fs::path(cacheDir_) / (std::string(hex) + "_" + base)).string();
+}
+
+// Downloads to a uniquely-named .part file and renames into place, so a
+// half-written file never masquerades as a cache hit and two stagers racing
+// on the same URL both end with a complete copy (one rename loses, which is
+// fine — the winner's file is identical).
+bool RemoteInputStager::FetchOne(const std::string& url, const std::string& localPath) {
+  static std::atomic<unsigned> partSerial{0};
+  const std::string part =
+      localPath + ".part" + std::to_string(partSerial.fetch_add(1));
+
+  if (!TFile::Cp(url.c_str(), part.c_str(), /*progressbar=*/kFALSE)) {
+    std::error_code ec;
+    fs::remove(part, ec);
+    return false;
+  }
+
+  std::error_code ec;
+  fs::rename(part, localPath, ec);
+  if (ec) {
+    fs::remove(part, ec);
+    std::error_code ec2;
+    return fs::exists(localPath, ec2) && !ec2;  // lost the race — other copy is complete
+  }
+  return true;
+}
+
+void RemoteInputStager::Pin(const std::string& localPath) {
+  std::lock_guard<std::mutex> lock(mtx_);
+  pinned_.insert(localPath);
+}
+
+std::vector<std::string> RemoteInputStager::Stage(const std::vector<std::string>& urls) {
+  std::vector<std::string> local(urls.size());
+  std::vector<char> ok(urls.size(), 0);
+  std::vector<std::size_t> misses;
+
+  for (std::size_t i = 0; i < urls.size(); ++i) {
+    if (!IsRemoteInputUrl(urls[i])) {
+      local[i] = urls[i];
+      ok[i] = 1;
+      continue;
+    }
+    const std::string cached = CachePathFor(urls[i]);
+    std::error_code ec;
+    if (fs::exists(cached, ec) && !ec && fs::file_size(cached, ec) > 0 && !ec) {
+      fs::last_write_time(cached, fs::file_time_type::clock::now(), ec);  // LRU touch
+      Pin(cached);
+      local[i] = cached;
+      ok[i] = 1;
+    } else {
+      misses.push_back(i);
+    }
+  }
+
+  if (!misses.empty()) {
+    std::error_code ec;
+    fs::create_directories(cacheDir_, ec);
+
+    std::cout << "[RemoteInput] Fetching " << misses.size() << " file(s) with "
+              << std::min(maxConcurrent_, misses.size()) << " stream(s) into "
+              << cacheDir_ << "\n";
+
+    // Bounded transfer pool, same shape as the converter's slice workers:
+    // idle streams pull the next pending URL.
+    ROOT::EnableThreadSafety();
+    const std::size_t nWorkers = std::min(maxConcurrent_, misses.size());
+    std::atomic<std::size_t> next{0};
+    std::vector<std::thread> threads;
+    threads.reserve(nWorkers);
+
+    for (std::size_t w = 0; w < nWorkers; ++w) {
+      threads.emplace_back([&]() {
+        for (;;) {
+          const std::size_t j = next.fetch_add(1);
+          if (j >= misses.size()) return;
+          const std::size_t i = misses[j];
+          const std::string cached = CachePathFor(urls[i]);
+          if (FetchOne(urls[i], cached)) {
+            Pin(cached);
+            local[i] = cached;
+            ok[i] = 1;
+          } else {
+            std::cerr << "[RemoteInput] Fetch failed: " << urls[i] << "\n";
+          }
+        }
+      });
+    }
+    for (auto& t : threads)
+      if (t.joinable()) t.join();
+
+    EvictToBudget();
+  }
+
+  std::vector<std::string> staged;
+  staged.reserve(urls.size());
+  std::size_t failed = 0;
+  for (std::size_t i = 0; i < urls.size(); ++i) {
+    if (ok[i]) staged.push_back(std::move(local[i]));
+    else ++failed;
+  }
+  if (failed > 0) {
+    std::cerr << "[RemoteInput] " << failed << " input(s) could not be staged and were dropped\n";
+  }
+  return staged;
+}
+
+void RemoteInputStager::PrefetchAsync(std::vector<std::string> urls) {
+  Wait();
+  if (urls.empty()) return;
+  prefetchThread_ = std::thread([this, batch = std::move(urls)]() { Stage(batch); });
+}
+
+void RemoteInputStager::Wait() {
+  if (prefetchThread_.joinable()) prefetchThread_.join();
+}
+
+// Oldest-mtime-first eviction down to the byte budget.  Files pinned by this
+// session and in-flight .part files are never candidates; pinned bytes still
+// count against the budget, so a budget smaller than one session's working
+// set simply evicts nothing.
+void RemoteInputStager::EvictToBudget() {
+  if (maxCacheBytes_ == 0) return;
+
+  struct Entry {
+    fs::file_time_type mtime;
+    std::uintmax_t size;
+    std::string path;
+  };
+
+  std::set<std::string> pinned;
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    pinned = pinned_;
+  }
+
+  std::uintmax_t total = 0;
+  std::vector<Entry> evictable;
+  std::error_code ec;
+  for (fs::directory_iterator it(cacheDir_, ec), end; !ec && it != end; it.increment(ec)) {
+    if (!it->is_regular_file(ec)) continue;
+    const std::string p = it->path().string();
+    std::error_code fec;
+    const auto size = fs::file_size(it->path(), fec);
+    if (fec) continue;
+    total += size;
+    if (pinned.count(p) || p.find(".part") != std::string::npos) continue;
+    const auto mtime = fs::last_write_time(it->path(), fec);
+    if (fec) continue;
+    evictable.push_back({mtime, size, p});
+  }
+  if (total <= maxCacheBytes_) return;
+
+  std::sort(evictable.begin(), evictable.end(),
+            [](const Entry& a, const Entry& b) { return a.mtime < b.mtime; });
+
+  std::size_t removed = 0;
+  for (const auto& e : evictable) {
+    if (total <= maxCacheBytes_) break;
+    std::error_code rec;
+    if (fs::remove(e.path, rec) && !rec) {
+      total -= e.size;
+      ++removed;
+    }
+  }
+  if (removed > 0) {
+    std::cout << "[RemoteInput] Evicted " << removed
+              << " least-recently-used cached file(s) to stay under the budget\n";
+  }
+}
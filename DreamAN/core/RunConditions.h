@@ -0,0 +1,82 @@
+#ifndef RUNCONDITIONS_H
+#define RUNCONDITIONS_H
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Per-run beam/detector conditions table.
+//
+// RunDVCSAnalysis.C used to hardcode one dataconfig (and so one beam energy
+// and FT configuration) per job, forcing datasets that span several beam
+// periods into separate campaigns with separate output merges.  With a
+// RunConditions table registered on the task, the beam energy is looked up
+// per event from the RUN_run column, so one pass can consume a mixed file
+// list.
+//
+// FT on/off cannot be per-event: it decides which banks are read and which
+// fiducial columns exist when the dataframe graph is built.  AnyFTon()
+// therefore reports the superset over the registered periods, and the task
+// reads the FT bank whenever at least one period has it (FT-off runs simply
+// contribute empty bank rows).
+//
+// Header-only (like EventSplitter/PerRunCounter) so rootmacros can build the
+// table from the interpreter.
+class RunConditions {
+ public:
+  struct Period {
+    int runLo = 0;          ///< first run of the period (inclusive)
+    int runHi = 0;          ///< last run of the period (inclusive)
+    float beamEnergy = 0;   ///< beam energy in GeV
+    int torus = 0;          ///< torus polarity: -1 inbending, +1 outbending
+    bool ftOn = true;       ///< forward tagger in the readout
+    std::string label;      ///< dataconfig-style tag, for logging
+  };
+
+  /// Register one run period.  Periods must not overlap; they are kept
+  /// sorted so per-event lookups are a binary search.
+  void AddPeriod(int runLo, int runHi, float beamEnergy, int torus, bool ftOn, const std::string& label) {
+    if (runHi < runLo) {
+      throw std::invalid_argument("RunConditions::AddPeriod: runHi < runLo for " + label);
+    }
+    for (const auto& p : fPeriods) {
+      if (runLo <= p.runHi && p.runLo <= runHi) {
+        throw std::invalid_argument("RunConditions::AddPeriod: " + label + " overlaps " + p.label);
+      }
+    }
+    fPeriods.push_back({runLo, runHi, beamEnergy, torus, ftOn, label});
+    std::sort(fPeriods.begin(), fPeriods.end(), [](const Period& a, const Period& b) { return a.runLo < b.runLo; });
+  }
+
+  /// Period containing \p run, or nullptr when the run is outside the table.
+  const Period* Find(int run) const {
+    auto it = std::upper_bound(fPeriods.begin(), fPeriods.end(), run, [](int r, const Period& p) { return r < p.runLo; });
+    if (it == fPeriods.begin()) return nullptr;
+    --it;
+    return (run <= it->runHi) ? &*it : nullptr;
+  }
+
+  /// Beam energy for \p run; \p fallback covers runs outside the table
+  /// (the task passes its configured fbeam_energy).
+  float BeamEnergy(int run, float fallback) const {
+    const Period* p = Find(run);
+    return p ? p->beamEnergy : fallback;
+  }
+
+  /// True when at least one registered period has the forward tagger on.
+  bool AnyFTon() const {
+    for (const auto& p : fPeriods) {
+      if (p.ftOn) return true;
+    }
+    return false;
+  }
+
+  bool Empty() const { return fPeriods.empty(); }
+  const std::vector<Period>& Periods() const { return fPeriods; }
+
+ private:
+  std::vector<Period> fPeriods;
+};
+
+#endif  // RUNCONDITIONS_H
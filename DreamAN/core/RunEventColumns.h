@@ -0,0 +1,115 @@
+#ifndef RUNEVENTCOLUMNS_H
+#define RUNEVENTCOLUMNS_H
+
+#include <ROOT/RDF/RInterface.hxx>
+#include "ROOT/RVec.hxx"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Canonical run/event schema.
+//
+// Depending on the source, the run and event numbers arrive under different
+// names ("RUN_config_run" from RHipoDS, "RUN::config.run" from older
+// converters) and different types (scalar int/short/long, RVec<T> or
+// std::vector<T> with one entry).  NormalizeRunEventColumns defines the
+// canonical scalar int columns RUN_run / RUN_event from whatever variant is
+// present, so everything downstream — QADB, per-run counters, snapshots —
+// compiles once against (int, int) instead of carrying per-type fallback
+// machinery.  Events applies it to every dataframe it hands out; calling it
+// again is a no-op.
+
+// Returns the source column names carrying run/event, or empty strings when
+// the dataset has no RUN bank at all.
+static inline std::pair<std::string, std::string> PickRunEventCols(ROOT::RDF::RNode df) {
+  auto cols = df.GetColumnNames();
+  auto has = [&](const std::string& n) { return std::find(cols.begin(), cols.end(), n) != cols.end(); };
+
+  if (has("RUN_config_run") && has("RUN_config_event")) return {"RUN_config_run", "RUN_config_event"};
+
+  if (has("RUN::config.run") && has("RUN::config.event")) return {"RUN::config.run", "RUN::config.event"};
+
+  return {"", ""};
+}
+
+static inline ROOT::RDF::RNode NormalizeRunEventColumns(ROOT::RDF::RNode df) {
+  {
+    auto cols = df.GetColumnNames();
+    auto has = [&](const std::string& n) { return std::find(cols.begin(), cols.end(), n) != cols.end(); };
+    if (has("RUN_run") && has("RUN_event")) return df;  // already canonical
+  }
+
+  auto [runCol, evCol] = PickRunEventCols(df);
+  if (runCol.empty()) return df;  // no RUN bank in this dataset
+
+  const auto runType = df.GetColumnType(runCol);
+  const auto evType  = df.GetColumnType(evCol);
+
+  auto has_substr = [](const std::string& s, const std::string& sub) {
+    return s.find(sub) != std::string::npos;
+  };
+
+  // ----- scalar cases -----
+  auto is_scalar_int = [&](const std::string& t){
+    return t=="int" || t=="Int_t" || t=="unsigned int" || t=="UInt_t";
+  };
+  auto is_scalar_long = [&](const std::string& t){
+    return t=="Long64_t" || t=="long" || t=="long long" || t=="ULong64_t" || t=="unsigned long long";
+  };
+  auto is_scalar_short = [&](const std::string& t){
+    return t=="short" || t=="Short_t" || t=="unsigned short" || t=="UShort_t";
+  };
+
+  if (is_scalar_int(runType) && is_scalar_int(evType)) {
+    return df.Define("RUN_run",  [](int r){ return r; }, {runCol})
+             .Define("RUN_event",[](int e){ return e; }, {evCol});
+  }
+  if (is_scalar_long(runType) && is_scalar_long(evType)) {
+    return df.Define("RUN_run",  [](Long64_t r){ return (int)r; }, {runCol})
+             .Define("RUN_event",[](Long64_t e){ return (int)e; }, {evCol});
+  }
+  if (is_scalar_short(runType) && is_scalar_short(evType)) {
+    return df.Define("RUN_run",  [](Short_t r){ return (int)r; }, {runCol})
+             .Define("RUN_event",[](Short_t e){ return (int)e; }, {evCol});
+  }
+
+  // ----- RVec cases -----
+  auto is_rvec = [&](const std::string& t){ return has_substr(t, "ROOT::VecOps::RVec"); };
+
+  // RVec<int> / RVec<Int_t> / etc (match by substring)
+  if (is_rvec(runType) && is_rvec(evType) && (has_substr(runType,"<int") || has_substr(runType,"<Int_t"))) {
+    return df.Define("RUN_run",  [](const ROOT::VecOps::RVec<int>& v){ return v.empty() ? -1 : (int)v[0]; }, {runCol})
+             .Define("RUN_event",[](const ROOT::VecOps::RVec<int>& v){ return v.empty() ? -1 : (int)v[0]; }, {evCol});
+  }
+  if (is_rvec(runType) && is_rvec(evType) && (has_substr(runType,"<Long64_t") || has_substr(runType,"<long long") || has_substr(runType,"<long"))) {
+    return df.Define("RUN_run",  [](const ROOT::VecOps::RVec<Long64_t>& v){ return v.empty() ? -1 : (int)v[0]; }, {runCol})
+             .Define("RUN_event",[](const ROOT::VecOps::RVec<Long64_t>& v){ return v.empty() ? -1 : (int)v[0]; }, {evCol});
+  }
+  if (is_rvec(runType) && is_rvec(evType) && (has_substr(runType,"<Short_t") || has_substr(runType,"<short"))) {
+    return df.Define("RUN_run",  [](const ROOT::VecOps::RVec<Short_t>& v){ return v.empty() ? -1 : (int)v[0]; }, {runCol})
+             .Define("RUN_event",[](const ROOT::VecOps::RVec<Short_t>& v){ return v.empty() ? -1 : (int)v[0]; }, {evCol});
+  }
+
+  // ----- std::vector cases -----
+  auto is_stdvec = [&](const std::string& t){ return has_substr(t, "std::vector") || has_substr(t, "vector<"); };
+
+  if (is_stdvec(runType) && is_stdvec(evType) && (has_substr(runType,"<int") || has_substr(runType,"<Int_t"))) {
+    return df.Define("RUN_run",  [](const std::vector<int>& v){ return v.empty() ? -1 : (int)v[0]; }, {runCol})
+             .Define("RUN_event",[](const std::vector<int>& v){ return v.empty() ? -1 : (int)v[0]; }, {evCol});
+  }
+  if (is_stdvec(runType) && is_stdvec(evType) && (has_substr(runType,"<Long64_t") || has_substr(runType,"<long long") || has_substr(runType,"<long"))) {
+    return df.Define("RUN_run",  [](const std::vector<Long64_t>& v){ return v.empty() ? -1 : (int)v[0]; }, {runCol})
+             .Define("RUN_event",[](const std::vector<Long64_t>& v){ return v.empty() ? -1 : (int)v[0]; }, {evCol});
+  }
+  if (is_stdvec(runType) && is_stdvec(evType) && (has_substr(runType,"<Short_t") || has_substr(runType,"<short"))) {
+    return df.Define("RUN_run",  [](const std::vector<Short_t>& v){ return v.empty() ? -1 : (int)v[0]; }, {runCol})
+             .Define("RUN_event",[](const std::vector<Short_t>& v){ return v.empty() ? -1 : (int)v[0]; }, {evCol});
+  }
+
+  throw std::runtime_error("RunEventColumns: unsupported run/event types: run=" + runType + " ev=" + evType);
+}
+
+#endif  // RUNEVENTCOLUMNS_H
@@ -0,0 +1,45 @@
+#ifndef SLOTSCRATCH_H
+#define SLOTSCRATCH_H
+
+#include <cstddef>
+#include <vector>
+
+// Per-thread scratch buffers for the hot event-loop functors.
+//
+// Nearly every pass/selection kernel needs per-event working vectors (SF
+// accumulators, sector maps, gathered CVT hits).  Declaring them as locals
+// costs a heap allocation per event per kernel; the CVT paths in TrackCut
+// already avoided that with ad-hoc thread_local vectors.  SlotScratch is
+// that idiom as a facility: buffers are keyed by element type plus a small
+// call-site tag, live per thread, and keep their capacity across events, so
+// steady-state processing reuses the same allocations.  RDF runs each
+// functor invocation on one thread, which makes thread_local equivalent to
+// slot-local here.
+//
+// Rules: tags must be distinct for buffers of the same element type that are
+// alive at the same time within one call; a buffer is only valid until the
+// next Get with the same key on the same thread, so never return or store a
+// reference to it.  (Define results themselves must still be returned by
+// value — RDF owns the column storage — so the win is the internal
+// temporaries and regrowth, not the final handoff.)
+namespace SlotScratch {
+
+/// Cleared scratch vector (size 0, capacity retained) for gather/push_back use.
+template <typename T, int Tag = 0>
+std::vector<T>& Cleared() {
+  thread_local std::vector<T> buf;
+  buf.clear();
+  return buf;
+}
+
+/// Scratch vector assigned to \p n copies of \p value (capacity retained).
+template <typename T, int Tag = 0>
+std::vector<T>& Assigned(std::size_t n, const T& value) {
+  thread_local std::vector<T> buf;
+  buf.assign(n, value);
+  return buf;
+}
+
+}  // namespace SlotScratch
+
+#endif  // SLOTSCRATCH_H
@@ -248,13 +248,42 @@ def ensure_reduced_xs(df, beam_energy=None, prefer_csv_gamma=True):
             df["ReducedCrossSection_Err"] = np.where(G > 0, xe/G, np.nan)
     return df
 
+# Columnar input (preferred): CSVs/<model>/dsdt.root carries the same columns
+# as the per-bin CSVs plus iq/iw branches; uproot hands them to numpy without
+# any text parsing.  Falls back to the CSVs when uproot or the file is absent.
+try:
+    import uproot
+    _HAVE_UPROOT = True
+except ImportError:
+    _HAVE_UPROOT = False
+
+_COLUMNAR_CACHE = {}
+
+def _load_columnar(csv_root, model):
+    """Full dsdt table for a model as one DataFrame (cached), or None."""
+    path = os.path.join(csv_root, "CSVs", _sanitise(model), "dsdt.root")
+    if not _HAVE_UPROOT or not os.path.isfile(path):
+        return None
+    if path not in _COLUMNAR_CACHE:
+        with uproot.open(path) as f:
+            _COLUMNAR_CACHE[path] = f["dsdt"].arrays(library="pd")
+    return _COLUMNAR_CACHE[path]
+
 def load_csv(csv_root, model, iq, iw=None, beam_energy=None):
     safe = _sanitise(model)
-    fname = os.path.join(csv_root, "CSVs", safe,
-                         f"dsdt_Q{iq}.csv" if iw is None else f"dsdt_Q{iq}_W{iw}.csv")
-    if not os.path.isfile(fname):
-        return None
-    df = pd.read_csv(fname)
+    tab = _load_columnar(csv_root, model)
+    if tab is not None:
+        mask = tab["iq"] == iq
+        mask &= tab["iw"] == (-1 if iw is None else iw)
+        df = tab[mask].reset_index(drop=True).copy()
+        if df.empty:
+            return None
+    else:
+        fname = os.path.join(csv_root, "CSVs", safe,
+                             f"dsdt_Q{iq}.csv" if iw is None else f"dsdt_Q{iq}_W{iw}.csv")
+        if not os.path.isfile(fname):
+            return None
+        df = pd.read_csv(fname)
     df = _derive_centers(df)
     df = ensure_q2_w_centers(df, iq=iq)
     df = compute_tmin_for_df(df)
@@ -265,6 +294,11 @@ def discover_bin_keys(csv_root, models):
     keys = set()
     for m in models:
         safe = _sanitise(m)
+        tab = _load_columnar(csv_root, m)
+        if tab is not None:
+            for iq, iw in set(zip(tab["iq"], tab["iw"])):
+                keys.add((int(iq), None if int(iw) < 0 else int(iw)))
+            continue
         for f in glob(os.path.join(csv_root, "CSVs", safe, "dsdt_Q*.csv")):
             base = os.path.basename(f).replace("dsdt_", "").replace(".csv", "")
             parts = base.split("_")
@@ -570,7 +604,8 @@ def main():
     present = []
     for m in models:
         d = os.path.join(csv_root, "CSVs", _sanitise(m))
-        if os.path.isdir(d) and glob(os.path.join(d, "dsdt_Q*.csv")):
+        if os.path.isdir(d) and (os.path.isfile(os.path.join(d, "dsdt.root"))
+                                 or glob(os.path.join(d, "dsdt_Q*.csv"))):
             present.append(m)
     if not present:
         print("[ERROR] No model CSV directories found under CSVs/.")
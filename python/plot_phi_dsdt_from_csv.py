@@ -969,16 +969,49 @@ def _fmt_pm(val, err, unit="", vsig=3, esig=2):
     if unit:
         return f"{v} ± {e} {unit}"
     return f"{v} ± {e}"
+# -----------------------------------------------------------------------------
+#  Columnar input (preferred): the comparer writes CSVs/<model>/dsdt.root with
+#  the same columns as the per-bin CSVs plus iq/iw branches.  uproot hands the
+#  branches to numpy directly, so the global-fit loop skips pandas.read_csv
+#  (and the per-file glob) entirely.  Falls back to the CSVs when uproot or
+#  the file is absent.
+# -----------------------------------------------------------------------------
+try:
+    import uproot
+    _HAVE_UPROOT = True
+except ImportError:
+    _HAVE_UPROOT = False
+
+_COLUMNAR_CACHE = {}
+
+def _load_columnar(csv_root, model):
+    """Full dsdt table for a model as one DataFrame (cached), or None."""
+    path = os.path.join(csv_root, "CSVs", _sanitise(model), "dsdt.root")
+    if not _HAVE_UPROOT or not os.path.isfile(path):
+        return None
+    if path not in _COLUMNAR_CACHE:
+        with uproot.open(path) as f:
+            _COLUMNAR_CACHE[path] = f["dsdt"].arrays(library="pd")
+    return _COLUMNAR_CACHE[path]
+
 def load_csv(csv_root, model, iq, iw=None):
     safe  = _sanitise(model)
-    fname = os.path.join(
-        csv_root, "CSVs", safe,
-        f"dsdt_Q{iq}.csv" if iw is None else f"dsdt_Q{iq}_W{iw}.csv"
-    )
-    if not os.path.isfile(fname):
-        return None
 
-    df = pd.read_csv(fname)
+    tab = _load_columnar(csv_root, model)
+    if tab is not None:
+        mask = tab["iq"] == iq
+        mask &= tab["iw"] == (-1 if iw is None else iw)
+        df = tab[mask].reset_index(drop=True).copy()
+        if df.empty:
+            return None
+    else:
+        fname = os.path.join(
+            csv_root, "CSVs", safe,
+            f"dsdt_Q{iq}.csv" if iw is None else f"dsdt_Q{iq}_W{iw}.csv"
+        )
+        if not os.path.isfile(fname):
+            return None
+        df = pd.read_csv(fname)
 
     # -- derive center columns from lo/hi if possible ----------------------
     df = _derive_centers(df)
@@ -1007,6 +1040,11 @@ def load_csv(csv_root, model, iq, iw=None):
 def discover_bin_keys(csv_root, models):
     keys = set()
     for m in models:
+        tab = _load_columnar(csv_root, m)
+        if tab is not None:
+            for iq, iw in set(zip(tab["iq"], tab["iw"])):
+                keys.add((int(iq), None if int(iw) < 0 else int(iw)))
+            continue
         for f in glob(os.path.join(csv_root, "CSVs", _sanitise(m), "dsdt_Q*.csv")):
             base  = os.path.basename(f).replace("dsdt_", "").replace(".csv", "")
             parts = base.split("_")
@@ -3505,7 +3543,8 @@ def main():
     present = [
         m for m in models
         if os.path.isdir(os.path.join(csv_root, "CSVs", _sanitise(m)))
-        and glob(os.path.join(csv_root, "CSVs", _sanitise(m), "dsdt_Q*.csv"))
+        and (os.path.isfile(os.path.join(csv_root, "CSVs", _sanitise(m), "dsdt.root"))
+             or glob(os.path.join(csv_root, "CSVs", _sanitise(m), "dsdt_Q*.csv")))
     ]
     if not present:
         print("[ERROR] No models found.")
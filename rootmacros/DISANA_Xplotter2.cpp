@@ -245,6 +245,40 @@ void DISANA_Xplotter2() {
 ROOT::RDF::RNode InitKinematics(const std::string& filename_, const std::string& treename_, float beam_energy) {
   ROOT::RDataFrame rdf(treename_, filename_);
   auto df_ = std::make_unique<ROOT::RDF::RNode>(rdf);
+  // Per-particle region codes in the plot convention (0 = FT, 1 = FD, 2 = CD,
+  // -1 other).  Newer snapshots carry the packed "REC_Particle_regsec" byte
+  // written by DVCSAnalysis, so this is a two-bit unpack; older files fall
+  // back to decoding the status word.
+  if (df_->HasColumn("REC_Particle_regsec")) {
+    *df_ = df_->Define("REC_Particle_detregion",
+                       [](const ROOT::VecOps::RVec<unsigned char>& regsec) {
+                         ROOT::VecOps::RVec<int> out(regsec.size());
+                         for (size_t i = 0; i < regsec.size(); ++i) {
+                           const int r = regsec[i] & 0x3;
+                           out[i] = (r == 3) ? -1 : r;
+                         }
+                         return out;
+                       },
+                       {"REC_Particle_regsec"});
+  } else {
+    *df_ = df_->Define("REC_Particle_detregion",
+                       [](const ROOT::VecOps::RVec<short>& status) {
+                         ROOT::VecOps::RVec<int> out(status.size());
+                         for (size_t i = 0; i < status.size(); ++i) {
+                           const int abs_status = std::abs(status[i]);
+                           if (abs_status >= 1000 && abs_status < 2000)
+                             out[i] = 0;  // FT
+                           else if (abs_status >= 2000 && abs_status < 3000)
+                             out[i] = 1;  // FD
+                           else if (abs_status >= 4000 && abs_status < 5000)
+                             out[i] = 2;  // CD
+                           else
+                             out[i] = -1;  // Unknown/Other
+                         }
+                         return out;
+                       },
+                       {"REC_Particle_status"});
+  }
   *df_ = df_->Define("ele_px",
                      [](const ROOT::VecOps::RVec<int>& pid, const ROOT::VecOps::RVec<float>& px, const ROOT::VecOps::RVec<int>& trackpass) {
                        for (size_t i = 0; i < pid.size(); ++i)
@@ -347,60 +381,27 @@ ROOT::RDF::RNode InitKinematics(const std::string& filename_, const std::string&
              .Define("recpro_theta", ThetaFunc, {"pro_px", "pro_py", "pro_pz"})
              .Define("recpro_phi", PhiFunc, {"pro_px", "pro_py"})
              .Define("pho_det_region",
-                     [](const ROOT::VecOps::RVec<int>& pid, const ROOT::VecOps::RVec<short>& status, const ROOT::VecOps::RVec<int>& pass, const ROOT::VecOps::RVec<int>& maxEpass) {
-                       for (size_t i = 0; i < pid.size(); ++i) {
-                         if (pid[i] == 22 && pass[i] && maxEpass[i]) {
-                           int abs_status = std::abs(status[i]);
-                           if (abs_status >= 1000 && abs_status < 2000)
-                             return 0;  // FT
-                           else if (abs_status >= 2000 && abs_status < 3000)
-                             return 1;  // FD
-                           else if (abs_status >= 4000 && abs_status < 5000)
-                             return 2;  // CD
-                           else
-                             return -1;  // Unknown/Other
-                         }
-                       }
+                     [](const ROOT::VecOps::RVec<int>& pid, const ROOT::VecOps::RVec<int>& region, const ROOT::VecOps::RVec<int>& pass, const ROOT::VecOps::RVec<int>& maxEpass) {
+                       for (size_t i = 0; i < pid.size(); ++i)
+                         if (pid[i] == 22 && pass[i] && maxEpass[i]) return region[i];
                        return -1;
                      },
-                     {"REC_Particle_pid", "REC_Particle_status", "REC_Particle_pass", "REC_Photon_MaxE"})
+                     {"REC_Particle_pid", "REC_Particle_detregion", "REC_Particle_pass", "REC_Photon_MaxE"})
 
              .Define("pro_det_region",
-                     [](const ROOT::VecOps::RVec<int>& pid, const ROOT::VecOps::RVec<short>& status, const ROOT::VecOps::RVec<int>& pass) {
-                       for (size_t i = 0; i < pid.size(); ++i) {
-                         if (pid[i] == 2212 && pass[i]) {
-                           int abs_status = std::abs(status[i]);
-                           if (abs_status >= 1000 && abs_status < 2000)
-                             return 0;  // FT (probably rare for protons)
-                           else if (abs_status >= 2000 && abs_status < 3000)
-                             return 1;  // FD
-                           else if (abs_status >= 4000 && abs_status < 5000)
-                             return 2;  // CD
-                           else
-                             return -1;
-                         }
-                       }
+                     [](const ROOT::VecOps::RVec<int>& pid, const ROOT::VecOps::RVec<int>& region, const ROOT::VecOps::RVec<int>& pass) {
+                       for (size_t i = 0; i < pid.size(); ++i)
+                         if (pid[i] == 2212 && pass[i]) return region[i];
                        return -1;
                      },
-                     {"REC_Particle_pid", "REC_Particle_status", "REC_Particle_pass"})
+                     {"REC_Particle_pid", "REC_Particle_detregion", "REC_Particle_pass"})
              .Define("ele_det_region",
-                     [](const ROOT::VecOps::RVec<int>& pid, const ROOT::VecOps::RVec<short>& status, const ROOT::VecOps::RVec<int>& pass) {
-                       for (size_t i = 0; i < pid.size(); ++i) {
-                         if (pid[i] == 11 && pass[i]) {
-                           int abs_status = std::abs(status[i]);
-                           if (abs_status >= 1000 && abs_status < 2000)
-                             return 0;  // FT (probably rare for protons)
-                           else if (abs_status >= 2000 && abs_status < 3000)
-                             return 1;  // FD
-                           else if (abs_status >= 4000 && abs_status < 5000)
-                             return 2;  // CD
-                           else
-                             return -1;
-                         }
-                       }
+                     [](const ROOT::VecOps::RVec<int>& pid, const ROOT::VecOps::RVec<int>& region, const ROOT::VecOps::RVec<int>& pass) {
+                       for (size_t i = 0; i < pid.size(); ++i)
+                         if (pid[i] == 11 && pass[i]) return region[i];
                        return -1;
                      },
-                     {"REC_Particle_pid", "REC_Particle_status", "REC_Particle_pass"});
+                     {"REC_Particle_pid", "REC_Particle_detregion", "REC_Particle_pass"});
 
   *df_ = define_DISCAT(*df_, "Q2", &DISANAMath::GetQ2, beam_energy);
   *df_ = define_DISCAT(*df_, "xB", &DISANAMath::GetxB, beam_energy);
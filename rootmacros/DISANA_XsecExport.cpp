@@ -0,0 +1,89 @@
+// Unified cross-section/CSV export driver.
+//
+// Replaces the DISANA_Xplotter2csv* macro family: every per-energy knob is
+// an XsecExport::EnergyConfig below, and one invocation produces the CSV
+// and plot products for all configured energies through a single
+// DISANAcomparer (one lazy event loop per input sample instead of one full
+// macro run per energy).
+
+#include <ROOT/RDataFrame.hxx>
+#include <TApplication.h>
+
+#include "../DreamAN/DrawHist/DISANAXsecExporter.h"
+
+void DISANA_XsecExport() {
+  ROOT::EnableImplicitMT(40);
+
+  using XsecExport::EnergyConfig;
+  using XsecExport::ExportOptions;
+
+  XsecExport::DISANAXsecExporter exporter("./");
+
+  // Common cross-section binning (all energies share one grid so the
+  // comparer can overlay them).
+  BinManager xBins;
+  xBins.SetQ2Bins({1.00, 1.25, 1.50, 1.75, 2.00, 2.40, 2.90, 3.50});
+  xBins.SetTBins({0.13, 0.2, 0.3, 0.4, 0.5, 0.6, 0.8, 1.0});
+  xBins.SetXBBins({0.150, 0.180, 0.210, 0.240, 0.285, 0.350, 0.430});
+  exporter.SetBins(xBins);
+
+  const std::string base = "/work/clas12/yijie/clas12ana/analysis1301/DISANA/build/";
+
+  // ----- RGK 6.5 GeV (data + GEMC chain from File6535) -----
+  EnergyConfig cfg6p5;
+  cfg6p5.label = "RGK 6.5GeV";
+  cfg6p5.beam_energy = 6.535;
+  cfg6p5.slim_prefix = "dfSlim_6535";
+  cfg6p5.data_file = base + "File6535BSA/dfSelected_afterFid_afterCorr.root";
+  cfg6p5.pi0mc_file = base + "File6535BSA/Pi0MC/dfSelected_afterFid_afterCorr.root";
+  cfg6p5.dvcsmc_rec_file = base + "File6535/nobkg/dfSelected_afterFid_afterCorr.root";
+  cfg6p5.dvcsmc_gen_file = base + "File6535/nobkgall/dfSelected.root";
+  cfg6p5.bkg_file = base + "File6535/bkg/dfSelected_afterFid_afterCorr.root";
+  cfg6p5.nobkg_file = base + "File6535/nobkg/dfSelected_afterFid_afterCorr.root";
+  cfg6p5.rad_file = base + "File6535/radandP1gen/rad6535v0p4.root";
+  cfg6p5.norad_file = base + "File6535/radandP1gen/nor6535.root";
+  cfg6p5.p1cut_file = base + "File6535/radandP1gen/nor6535P1.root";
+  cfg6p5.rec_cut_csv = "dvcs_cuts_rec_6p5_corr.csv";
+  cfg6p5.gen_cut_csv = "dvcs_cuts_gen_6p5_corr.csv";
+  cfg6p5.charge_mC = 17.644;  // mC, run 5919 removed
+  cfg6p5.polarisation = 0.8517;
+  cfg6p5.apply_momentum_corr = true;
+  cfg6p5.eff_corr = 0.8335;
+  cfg6p5.write_run_counts = true;
+  cfg6p5.run_counts_prefix = "run6p5";
+  // Systematic variations: set e.g. cfg6p5.momentum_corr_scale = 0.9,
+  // cfg6p5.dvcs_window_scale = 1.25 or cfg6p5.dvpi0_window_scale = 1.25.
+  exporter.AddEnergy(cfg6p5);
+
+  // ----- RGK 8.5 GeV (File8477 data, shared 6535 MC chain) -----
+  EnergyConfig cfg8p5;
+  cfg8p5.label = "RGK 8.5GeV";
+  cfg8p5.beam_energy = 8.477;
+  cfg8p5.slim_prefix = "dfSlim_8477";
+  cfg8p5.data_file = base + "File8477/dfSelected_afterFid_afterCorr.root";
+  cfg8p5.pi0mc_file = base + "File6535/pi0/dfSelected_afterFid_afterCorr.root";
+  cfg8p5.dvcsmc_rec_file = base + "File6535/nobkg/dfSelected_afterFid_afterCorr.root";
+  cfg8p5.dvcsmc_gen_file = base + "File6535/nobkgall/dfSelected.root";
+  cfg8p5.bkg_file = base + "File6535/bkg/dfSelected_afterFid_afterCorr.root";
+  cfg8p5.nobkg_file = base + "File6535/nobkg/dfSelected_afterFid_afterCorr.root";
+  cfg8p5.rad_file = base + "File6535/radandP1gen/rad6535v0p4.root";
+  cfg8p5.norad_file = base + "File6535/radandP1gen/nor6535.root";
+  cfg8p5.p1cut_file = base + "File6535/radandP1gen/nor6535P1.root";
+  cfg8p5.rec_cut_csv = "dvcs_cuts_rec.csv";
+  cfg8p5.gen_cut_csv = "dvcs_cuts_gen.csv";
+  cfg8p5.charge_mC = 17.644;
+  cfg8p5.polarisation = 0.85;
+  cfg8p5.pi0_correction = false;
+  cfg8p5.acceptance_correction = false;
+  cfg8p5.efficiency_correction = false;
+  cfg8p5.radiative_correction = false;
+  cfg8p5.p1cut_correction = false;
+  cfg8p5.eff_corr = 0.8280 / 0.9495;
+  exporter.AddEnergy(cfg8p5);
+
+  // One pass: every CSV/plot product for every configured energy.
+  ExportOptions opts;
+  exporter.Export(opts);
+
+  gApplication->Terminate(0);
+}
@@ -1,26 +1,30 @@
 #include <ROOT/RDataFrame.hxx>
-#include <TFile.h>
 #include <iostream>
 
+#include "../DreamAN/core/EventSplitter.h"
+
+// Split a dataset into several outputs in ONE pass over the source tree.
+// Every partition is a lazy Snapshot on the same RDataFrame, so K splits
+// cost one read instead of K (the old version re-ran a filtered Snapshot
+// per output file).
 void SplitRDF(const std::string& inputFile = "../build/qadbcut/dfSelected_afterFid_afterCorr.root", const std::string& treeName = "dfSelected_afterFid_afterCorr") {
-  // 开启多线程（可选）
   ROOT::EnableImplicitMT();
 
-  // 直接用完整命名空间
-  ROOT::RDataFrame df(treeName, inputFile);
+  EventSplitter splitter(inputFile, treeName);
 
-  // 按 run 分割
-  auto df_low  = df.Filter("RUN_config_run <= 5757", "run <= 5757");
-  auto df_high = df.Filter("RUN_config_run > 5757",  "run > 5757");
+  // Split at the run-5757 boundary with the same filters and file names as
+  // before; the two open-ended partitions together cover every run.
+  splitter.AddPartition("output_runLE5757.root", "RUN_config_run <= 5757");
+  splitter.AddPartition("output_runGT5757.root", "RUN_config_run > 5757");
 
-  // 打印统计信息
-  std::cout << "Total entries: " << *df.Count() << std::endl;
-  std::cout << "Entries run<=5757: " << *df_low.Count() << std::endl;
-  std::cout << "Entries run>5757 : " << *df_high.Count() << std::endl;
+  // Other partition styles, booked on the same single pass:
+  //   splitter.SplitByRunRanges("RUN_config_run", {5600, 5758, 6000}, "output");  // bounded [lo,hi) run periods
+  //   splitter.AddPartition("output_inbending.root", "RUN_config_torus < 0");
+  //   splitter.SplitByHash("RUN_config_event", 6, "mc_sample");  // 6-fold MC split
 
-  // 保存两个文件
-  df_low.Snapshot(treeName, "output_runLE5757.root");
-  df_high.Snapshot(treeName, "output_runGT5757.root");
+  const auto counts = splitter.Run();
 
-  std::cout << "✅ Saved: output_runLE5757.root and output_runGT5757.root" << std::endl;
+  for (size_t i = 0; i < counts.size(); ++i)
+    std::cout << "  " << splitter.OutputFiles()[i] << ": " << counts[i] << " events" << std::endl;
+  std::cout << "Saved " << splitter.OutputFiles().size() << " partitions." << std::endl;
 }
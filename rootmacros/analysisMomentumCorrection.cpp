@@ -27,6 +27,10 @@
 #include <TLatex.h>
 #include <array>
 #include <limits>
+#include <atomic>
+#include <thread>
+#include <TFile.h>
+#include <TROOT.h>
 
 
 using namespace ROOT::VecOps;
@@ -2183,7 +2187,8 @@ void DrawDeltaPByThetaPhiBins(
     bool isOutBend = false,
     bool drawDeltaPFitCurve = true,
     const std::map<std::string, std::string>& paramVsThetaFormulaMap = {},
-    const std::map<std::string, std::string>& paramVsPhiFormulaMap   = {})
+    const std::map<std::string, std::string>& paramVsPhiFormulaMap   = {},
+    bool useHistCache = true)
 {
     TStopwatch timer;
     timer.Start();
@@ -2489,6 +2494,65 @@ void DrawDeltaPByThetaPhiBins(
         "MC_Particle_pid", "MC_Particle_px", "MC_Particle_py", "MC_Particle_pz"
     };
 
+    // ── Histogram cache ──────────────────────────────────────────────────
+    // Filling the (phi, theta) grid is a full pass over the RDF, but when
+    // only the fit stage changes (windows, formulas) the refilled histograms
+    // are identical.  Persist them once per output directory and reload on
+    // the next invocation; delete the cache file (or pass useHistCache =
+    // false) to force a refill, e.g. after the input snapshot changed.
+    gSystem->Exec(("mkdir -p " + outDir).c_str());
+    const std::string histCachePath = outDir + "/deltaP_hist_cache.root";
+
+    auto LoadHistogramCache = [&]() -> bool {
+        std::unique_ptr<TFile> fin(TFile::Open(histCachePath.c_str(), "READ"));
+        if (!fin || fin->IsZombie()) return false;
+        auto fetch = [&](TH2D*& slot) -> bool {
+            auto* cached = fin->Get<TH2D>(slot->GetName());
+            if (!cached) return false;
+            if (cached->GetNbinsX() != slot->GetNbinsX() ||
+                cached->GetNbinsY() != slot->GetNbinsY()) return false;
+            cached->SetDirectory(nullptr);
+            delete slot;
+            slot = cached;
+            return true;
+        };
+        for (auto &v : vars) {
+            if (!fetch(v.overall)) return false;
+            for (auto &h : v.phiOverall) if (!fetch(h)) return false;
+            for (auto &row : v.binHists)
+                for (auto &h : row) if (!fetch(h)) return false;
+        }
+        return true;
+    };
+
+    auto WriteHistogramCache = [&]() {
+        std::unique_ptr<TFile> fcache(TFile::Open(histCachePath.c_str(), "RECREATE"));
+        if (!fcache || fcache->IsZombie()) {
+            std::cerr << "Cannot write histogram cache " << histCachePath << "\n";
+            return;
+        }
+        for (auto &v : vars) {
+            fcache->WriteTObject(v.overall, v.overall->GetName());
+            for (auto *h : v.phiOverall) fcache->WriteTObject(h, h->GetName());
+            for (auto &row : v.binHists)
+                for (auto *h : row) fcache->WriteTObject(h, h->GetName());
+        }
+        std::cout << "Wrote histogram cache: " << histCachePath << std::endl;
+    };
+
+    const bool filledFromCache =
+        useHistCache && !gSystem->AccessPathName(histCachePath.c_str()) && LoadHistogramCache();
+    if (filledFromCache) {
+        std::cout << "Loaded histograms from cache: " << histCachePath << std::endl;
+    } else {
+    // A partial cache load may have replaced some histograms; start clean.
+    for (auto &v : vars) {
+        v.overall->Reset();
+        for (auto *h : v.phiOverall) h->Reset();
+        for (auto &row : v.binHists)
+            for (auto *h : row) h->Reset();
+    }
+
     df.Foreach([&](const ROOT::VecOps::RVec<int> &pid,
                    const ROOT::VecOps::RVec<float> &theta,
                    const ROOT::VecOps::RVec<float> &phi,
@@ -2546,9 +2610,134 @@ void DrawDeltaPByThetaPhiBins(
         }
     }, colNames);
 
-    gSystem->Exec(("mkdir -p " + outDir).c_str());
+    if (useHistCache) WriteHistogramCache();
+    }
 
-    for (auto &v : vars) {
+    // ── Parallel fit stage ────────────────────────────────────────
+    // Peak extraction and the per-bin deltaP fits are independent across
+    // (variable, phi, theta) bins, so they run on a worker pool before any
+    // canvas is touched — graphics stay on the main thread, each job writes
+    // only its own text files.  The drawing loops below just consume the
+    // stored graphs and fit models.
+    struct DeltaPFitOutcome {
+        TGraph* peakGraph = nullptr;
+        TF1* fitModel = nullptr;
+        std::string formula;
+        bool fitted = false;
+    };
+
+    std::vector<std::vector<std::vector<DeltaPFitOutcome>>> fitOutcomes(vars.size());
+    for (auto &byPhi : fitOutcomes) {
+        byPhi.resize(nPhiBins);
+        for (auto &byTheta : byPhi) byTheta.resize(thetaCuts.size() + 1);
+    }
+
+    for (int phiBinIdx = 0; phiBinIdx < nPhiBins; ++phiBinIdx) {
+        std::string phiDir = outDir + "/" + GetPhiBinTag(phiBinIdx);
+        gSystem->Exec(("mkdir -p " + phiDir).c_str());
+        gSystem->Exec(("mkdir -p " + phiDir + "/ParamFits").c_str());
+    }
+
+    std::string deltaPFitFormula;
+    if (selectedPid == 2212) {
+        if (selecteddetector == "FD") {
+            deltaPFitFormula = "[0] + [1]/x + [2]/(x*x)";
+        } else if (selecteddetector == "CD" || selecteddetector == "ALL") {
+            deltaPFitFormula = "[0] + [1]*x + [2]*x*x";
+        } else {
+            std::cerr << "Unknown detector for proton: " << selecteddetector << "\n";
+        }
+    } else if (selectedPid == 11 || selectedPid == 22) {
+        deltaPFitFormula = "[0] + [1]*x + [2]*x*x";
+    } else {
+        std::cerr << "Unknown pid for fitting: " << selectedPid << "\n";
+        deltaPFitFormula = "[0] + [1]*x + [2]*x*x";
+    }
+
+    {
+        struct FitJob { size_t varIdx; int phiBinIdx; size_t thetaBinIdx; };
+        std::vector<FitJob> jobs;
+        for (size_t varIdx = 0; varIdx < vars.size(); ++varIdx)
+            for (int phiBinIdx = 0; phiBinIdx < nPhiBins; ++phiBinIdx)
+                for (size_t thetaBinIdx = 0; thetaBinIdx <= thetaCuts.size(); ++thetaBinIdx)
+                    jobs.push_back({varIdx, phiBinIdx, thetaBinIdx});
+
+        ROOT::EnableThreadSafety();
+        std::atomic<size_t> nextJob{0};
+        auto RunFitJobs = [&]() {
+            for (size_t j = nextJob.fetch_add(1); j < jobs.size(); j = nextJob.fetch_add(1)) {
+                const FitJob &job = jobs[j];
+                auto &v = vars[job.varIdx];
+                TH2D* h2 = v.binHists[job.phiBinIdx][job.thetaBinIdx];
+                std::string phiTag = GetPhiBinTag(job.phiBinIdx);
+                std::string phiDir = outDir + "/" + phiTag;
+
+                DeltaPFitOutcome &outcome = fitOutcomes[job.varIdx][job.phiBinIdx][job.thetaBinIdx];
+                outcome.formula = deltaPFitFormula;
+                outcome.peakGraph = MakePeakGraph(
+                    h2,
+                    phiDir + "/" + v.saveName + "_" + selecteddetector + "_" + phiTag +
+                        Form("_T%zu.txt", job.thetaBinIdx));
+                if (deltaPFitFormula.empty()) continue;
+
+                std::string fitName = "deltaPFitModel_" + phiTag + Form("_T%zu", job.thetaBinIdx);
+                TF1* deltaPFitModel = new TF1(
+                    fitName.c_str(),
+                    deltaPFitFormula.c_str(),
+                    h2->GetXaxis()->GetXmin(),
+                    h2->GetXaxis()->GetXmax()
+                );
+
+                if (outcome.peakGraph && outcome.peakGraph->GetN() > 2) {
+                    outcome.peakGraph->Fit(deltaPFitModel, "Q0N");
+
+                    if (selectedPid == 2212 && selecteddetector == "FD" &&
+                        !HasPhysicalLowPMomentumTrend(deltaPFitModel, outcome.peakGraph)) {
+                        TF1* constrainedFitModel = new TF1(
+                            (fitName + "_constrained").c_str(),
+                            deltaPFitFormula.c_str(),
+                            h2->GetXaxis()->GetXmin(),
+                            h2->GetXaxis()->GetXmax()
+                        );
+
+                        const double seedA = deltaPFitModel->GetParameter(0);
+                        const double seedB = std::min(deltaPFitModel->GetParameter(1), -1e-6);
+                        const double seedC = std::max(deltaPFitModel->GetParameter(2), 1e-6);
+                        constrainedFitModel->SetParameters(seedA, seedB, seedC);
+
+                        // Enforce the low-p upturn shape for FD protons.
+                        constrainedFitModel->SetParLimits(1, -10.0, 0.0);
+                        constrainedFitModel->SetParLimits(2, 0.0, 10.0);
+
+                        const int constrainedStatus = outcome.peakGraph->Fit(constrainedFitModel, "Q0N");
+                        if (constrainedStatus == 0) {
+                            delete deltaPFitModel;
+                            deltaPFitModel = constrainedFitModel;
+                        } else {
+                            delete constrainedFitModel;
+                        }
+                    }
+
+                    std::string fitParFile = phiDir + "/" + v.saveName + "_" + selecteddetector + "_" + phiTag +
+                                             Form("_T%zu_fit.txt", job.thetaBinIdx);
+                    WriteFitParameters(fitParFile, deltaPFitFormula, deltaPFitModel);
+                    outcome.fitted = true;
+                }
+                outcome.fitModel = deltaPFitModel;
+            }
+        };
+
+        const unsigned int nWorkers = std::max(1u,
+            std::min<unsigned int>(std::thread::hardware_concurrency(),
+                                   static_cast<unsigned int>(jobs.size())));
+        std::vector<std::thread> workers;
+        workers.reserve(nWorkers);
+        for (unsigned int w = 0; w < nWorkers; ++w) workers.emplace_back(RunFitJobs);
+        for (auto &w : workers) w.join();
+    }
+
+    for (size_t varIdx = 0; varIdx < vars.size(); ++varIdx) {
+        auto &v = vars[varIdx];
         {
             TCanvas *c = new TCanvas(("c_" + v.saveName + "_overall").c_str(), "", 3000, 1500);
             v.overall->SetTitle((selecteddetector + " " + v.title + " (all #phi)").c_str());
@@ -2614,75 +2803,20 @@ void DrawDeltaPByThetaPhiBins(
                 gPad->SetLogz();
                 h2->Draw("COLZ");
 
-                TGraph* gPeak2 = MakePeakGraph(
-                    h2,
-                    phiDir + "/" + v.saveName + "_" + selecteddetector + "_" + phiTag + Form("_T%zu.txt", thetaBinIdx)
-                );
+                DeltaPFitOutcome &outcome = fitOutcomes[varIdx][phiBinIdx][thetaBinIdx];
+                TGraph* gPeak2 = outcome.peakGraph;
                 if (gPeak2 && gPeak2->GetN() > 0) gPeak2->Draw("PEZ SAME");
 
-                TF1* deltaPFitModel = nullptr;
-                std::string deltaPFitFormula;
-
-                if (selectedPid == 2212) {
-                    if (selecteddetector == "FD") {
-                        deltaPFitFormula = "[0] + [1]/x + [2]/(x*x)";
-                    } else if (selecteddetector == "CD" || selecteddetector == "ALL") {
-                        deltaPFitFormula = "[0] + [1]*x + [2]*x*x";
-                    } else {
-                        std::cerr << "Unknown detector for proton: " << selecteddetector << "\n";
-                        if (gPeak2) delete gPeak2;
-                        delete c;
-                        continue;
-                    }
-                } else if (selectedPid == 11 || selectedPid == 22) {
-                    deltaPFitFormula = "[0] + [1]*x + [2]*x*x";
-                } else {
-                    std::cerr << "Unknown pid for fitting: " << selectedPid << "\n";
-                    deltaPFitFormula = "[0] + [1]*x + [2]*x*x";
+                if (outcome.formula.empty()) {
+                    if (gPeak2) delete gPeak2;
+                    outcome.peakGraph = nullptr;
+                    delete c;
+                    continue;
                 }
 
-                std::string fitName = "deltaPFitModel_" + phiTag + Form("_T%zu", thetaBinIdx);
-                deltaPFitModel = new TF1(
-                    fitName.c_str(),
-                    deltaPFitFormula.c_str(),
-                    h2->GetXaxis()->GetXmin(),
-                    h2->GetXaxis()->GetXmax()
-                );
-
-                if (gPeak2 && gPeak2->GetN() > 2) {
-                    gPeak2->Fit(deltaPFitModel, "Q0N");
-
-                    if (selectedPid == 2212 && selecteddetector == "FD" &&
-                        !HasPhysicalLowPMomentumTrend(deltaPFitModel, gPeak2)) {
-                        TF1* constrainedFitModel = new TF1(
-                            (fitName + "_constrained").c_str(),
-                            deltaPFitFormula.c_str(),
-                            h2->GetXaxis()->GetXmin(),
-                            h2->GetXaxis()->GetXmax()
-                        );
-
-                        const double seedA = deltaPFitModel->GetParameter(0);
-                        const double seedB = std::min(deltaPFitModel->GetParameter(1), -1e-6);
-                        const double seedC = std::max(deltaPFitModel->GetParameter(2), 1e-6);
-                        constrainedFitModel->SetParameters(seedA, seedB, seedC);
-
-                        // Enforce the low-p upturn shape for FD protons.
-                        constrainedFitModel->SetParLimits(1, -10.0, 0.0);
-                        constrainedFitModel->SetParLimits(2, 0.0, 10.0);
-
-                        const int constrainedStatus = gPeak2->Fit(constrainedFitModel, "Q0N");
-                        if (constrainedStatus == 0) {
-                            delete deltaPFitModel;
-                            deltaPFitModel = constrainedFitModel;
-                        } else {
-                            delete constrainedFitModel;
-                        }
-                    }
-
-                    std::string fitParFile = phiDir + "/" + v.saveName + "_" + selecteddetector + "_" + phiTag +
-                                             Form("_T%zu_fit.txt", thetaBinIdx);
-                    WriteFitParameters(fitParFile, deltaPFitFormula, deltaPFitModel);
+                TF1* deltaPFitModel = outcome.fitModel;
 
+                if (outcome.fitted) {
                     if (drawDeltaPFitCurve) {
                         deltaPFitModel->SetLineColor(kBlue + 2);
                         deltaPFitModel->SetLineWidth(4);
@@ -2741,7 +2875,9 @@ void DrawDeltaPByThetaPhiBins(
                 c->SaveAs(out.c_str());
 
                 delete deltaPFitModel;
+                outcome.fitModel = nullptr;
                 if (gPeak2) delete gPeak2;
+                outcome.peakGraph = nullptr;
                 delete c;
 
                 std::cout << "Saved: " << out << std::endl;
@@ -3367,11 +3503,13 @@ void analysisMomentumCorrection() {
     PlotMomentumCorrectionVsPhi_MultiP_FromParamVsPhiPoints(2212,"FD",{0.8, 1.0, 1.5, 2.0},"ProtonMomCorrPhi36","from_txt");
     PlotMomentumCorrectionVsPhi_MultiP_FromParamVsPhiPoints(2212,"FD",{0.8, 1.0, 1.5, 2.0},"ProtonMomCorrPhiCorrected36","from_txt");
 
-    //GeneratePiecewiseProtonCorrectionFunctionFromParamVsPhi(
-    //    "ProtonMomCorrPhi36",
-    //    "ProtonMomCorrPhi36/GeneratedPiecewiseProtonCorrection_RunDVCSAnalysis.inc",
-    //    "AddProtonFDPiecewiseCorrection_FromProtonMomCorrPhi36"
-    //);
+    // Emit the derived corrections in AddPiecewiseCorrection form so they
+    // load directly into production jobs (see macros/RunDVCSAnalysis.C).
+    GeneratePiecewiseProtonCorrectionFunctionFromParamVsPhi(
+        "ProtonMomCorrPhi36",
+        "ProtonMomCorrPhi36/GeneratedPiecewiseProtonCorrection_RunDVCSAnalysis.inc",
+        "AddProtonFDPiecewiseCorrection_FromProtonMomCorrPhi36"
+    );
 
 
     //DrawDeltaPByThetaPhiBins(2212,thetaCutsCDproton,"CD",6,-37,{{"proton_deltaP_vs_p","proton #delta p vs p","deltaP:p",100,0.01,2.5,100,-0.2,0.2}},filename,treename,"ProtonMomCorrPhi",isOutBend);